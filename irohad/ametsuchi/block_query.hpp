@@ -103,6 +103,16 @@ namespace iroha {
       virtual boost::optional<TxCacheStatusType> checkTxPresence(
           const shared_model::crypto::Hash &hash) = 0;
 
+      /**
+       * Synchronously checks presence of several transactions with a single
+       * storage query
+       * @param hashes - transactions' hashes
+       * @return statuses of transactions in the order of hashes if storage
+       * query was successful, boost::none otherwise
+       */
+      virtual boost::optional<std::vector<TxCacheStatusType>> checkTxPresence(
+          const std::vector<shared_model::crypto::Hash> &hashes) = 0;
+
       /**
        * Get the top-most block
        * @return result of Model Block or error message
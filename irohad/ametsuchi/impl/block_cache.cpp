@@ -0,0 +1,119 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_cache.hpp"
+
+#include <boost/format.hpp>
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    BlockCache::BlockCache(size_t capacity)
+        : capacity_(capacity), size_(0), hits_(0), misses_(0) {}
+
+    boost::optional<BlockCache::BlockPtr> BlockCache::get(
+        shared_model::interface::types::HeightType height) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(height);
+      if (it == index_.end()) {
+        ++misses_;
+        return boost::none;
+      }
+      ++hits_;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->block;
+    }
+
+    void BlockCache::put(BlockPtr block, size_t size) {
+      if (size > capacity_) {
+        return;
+      }
+      // hashes are computed lazily on first access, so they are computed here
+      // before the block becomes visible to concurrent readers
+      block->hash();
+      for (const auto &tx : block->transactions()) {
+        tx.hash();
+      }
+
+      const auto height = block->height();
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(height);
+      if (it != index_.end()) {
+        size_ -= it->second->size;
+        entries_.erase(it->second);
+      }
+      entries_.push_front(Entry{height, std::move(block), size});
+      index_[height] = entries_.begin();
+      size_ += size;
+      evict();
+    }
+
+    void BlockCache::clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries_.clear();
+      index_.clear();
+      size_ = 0;
+    }
+
+    size_t BlockCache::hits() const {
+      return hits_.load();
+    }
+
+    size_t BlockCache::misses() const {
+      return misses_.load();
+    }
+
+    size_t BlockCache::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return size_;
+    }
+
+    void BlockCache::evict() {
+      while (size_ > capacity_) {
+        const auto &last = entries_.back();
+        size_ -= last.size;
+        index_.erase(last.height);
+        entries_.pop_back();
+      }
+    }
+
+    expected::Result<BlockCache::BlockPtr, std::string> loadBlock(
+        shared_model::interface::types::HeightType height,
+        const KeyValueStorage &block_store,
+        const BlockStorageFormat &block_format,
+        BlockCache *block_cache) {
+      if (block_cache) {
+        if (auto block = block_cache->get(height)) {
+          return expected::makeValue(std::move(*block));
+        }
+      }
+
+      auto serialized_block = block_store.getView(height);
+      if (not serialized_block) {
+        auto error =
+            boost::format("Failed to retrieve block with id %d") % height;
+        return expected::makeError(error.str());
+      }
+      auto block = block_format.deserialize(serialized_block->data,
+                                            serialized_block->size);
+      return block.match(
+          [&](expected::Value<std::unique_ptr<shared_model::interface::Block>>
+                  &v) -> expected::Result<BlockCache::BlockPtr, std::string> {
+            BlockCache::BlockPtr result = std::move(v.value);
+            if (block_cache) {
+              block_cache->put(result, serialized_block->size);
+            }
+            return expected::makeValue(std::move(result));
+          },
+          [](expected::Error<std::string> &e)
+              -> expected::Result<BlockCache::BlockPtr, std::string> {
+            return expected::makeError(std::move(e.error));
+          });
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
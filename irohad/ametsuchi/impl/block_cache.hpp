@@ -0,0 +1,122 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_CACHE_HPP
+#define IROHA_BLOCK_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+#include "ametsuchi/impl/block_storage_format.hpp"
+#include "ametsuchi/key_value_storage.hpp"
+#include "common/result.hpp"
+#include "interfaces/common_objects/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Least recently used cache of decoded blocks keyed by height.
+     *
+     * Capacity is bounded in bytes. Every block is accounted with the size of
+     * its record in block store, which is proportional to the memory taken by
+     * the decoded block. Cached blocks are shared between readers on different
+     * threads, so they must not be modified.
+     */
+    class BlockCache {
+     public:
+      using BlockPtr = std::shared_ptr<shared_model::interface::Block>;
+
+      /**
+       * @param capacity - maximal total size of cached blocks in bytes
+       */
+      explicit BlockCache(size_t capacity);
+
+      /**
+       * Get block and mark it as the most recently used
+       * @param height - height of block
+       * @return block, if it is cached
+       */
+      boost::optional<BlockPtr> get(
+          shared_model::interface::types::HeightType height);
+
+      /**
+       * Put block to cache, evicting least recently used blocks which do not
+       * fit in capacity
+       * @param block - block to put
+       * @param size - size of block record in bytes
+       */
+      void put(BlockPtr block, size_t size);
+
+      /**
+       * Remove all blocks, counters are kept
+       */
+      void clear();
+
+      /**
+       * @return number of get() calls which found a block
+       */
+      size_t hits() const;
+
+      /**
+       * @return number of get() calls which did not find a block
+       */
+      size_t misses() const;
+
+      /**
+       * @return total size of cached blocks in bytes
+       */
+      size_t size() const;
+
+     private:
+      struct Entry {
+        shared_model::interface::types::HeightType height;
+        BlockPtr block;
+        size_t size;
+      };
+
+      void evict();
+
+      const size_t capacity_;
+
+      /**
+       * Entries ordered from the most to the least recently used
+       */
+      std::list<Entry> entries_;
+
+      std::unordered_map<shared_model::interface::types::HeightType,
+                         std::list<Entry>::iterator>
+          index_;
+
+      size_t size_;
+
+      std::atomic<size_t> hits_;
+      std::atomic<size_t> misses_;
+
+      mutable std::mutex mutex_;
+    };
+
+    /**
+     * Get block from cache, or read it from block store and put it to cache
+     * @param height - height of block
+     * @param block_store - storage of block records
+     * @param block_format - format of block records
+     * @param block_cache - cache of decoded blocks, may be null
+     * @return block with given height or an error
+     */
+    expected::Result<BlockCache::BlockPtr, std::string> loadBlock(
+        shared_model::interface::types::HeightType height,
+        const KeyValueStorage &block_store,
+        const BlockStorageFormat &block_format,
+        BlockCache *block_cache);
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_CACHE_HPP
@@ -38,8 +38,9 @@ namespace iroha {
       /**
        * Create necessary indexes for block
        * @param block to be indexed
+       * @return true if block is indexed, false if indexing failed
        */
-      virtual void index(const shared_model::interface::Block &) = 0;
+      virtual bool index(const shared_model::interface::Block &) = 0;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
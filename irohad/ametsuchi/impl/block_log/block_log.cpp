@@ -0,0 +1,433 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_log/block_log.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/mapped_file.hpp"
+#include "common/files.hpp"
+
+using namespace iroha::ametsuchi;
+using Identifier = BlockLog::Identifier;
+
+namespace {
+  const size_t kHeaderSize = sizeof(BlockLog::RecordHeader);
+
+  uint32_t checksum(const uint8_t *data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+  }
+
+  /**
+   * Read exactly size bytes from file at given offset
+   * @return true on success
+   */
+  bool readAt(int fd, void *buf, size_t size, uint64_t offset) {
+    auto ptr = static_cast<uint8_t *>(buf);
+    while (size > 0) {
+      auto n = ::pread(fd, ptr, size, offset);
+      if (n < 0 and errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      ptr += n;
+      size -= n;
+      offset += n;
+    }
+    return true;
+  }
+
+  /**
+   * Write exactly size bytes to file at given offset
+   * @return true on success
+   */
+  bool writeAt(int fd, const void *buf, size_t size, uint64_t offset) {
+    auto ptr = static_cast<const uint8_t *>(buf);
+    while (size > 0) {
+      auto n = ::pwrite(fd, ptr, size, offset);
+      if (n < 0 and errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      ptr += n;
+      size -= n;
+      offset += n;
+    }
+    return true;
+  }
+
+  uint64_t fileSize(int fd) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      return 0;
+    }
+    return st.st_size;
+  }
+}  // namespace
+
+// ----------| public API |----------
+
+const std::string BlockLog::kIndexFileName = "index";
+
+std::string BlockLog::segment_name(uint32_t segment) {
+  std::ostringstream os;
+  os << "segment_" << std::setw(10) << std::setfill('0') << segment << ".log";
+  return os.str();
+}
+
+boost::optional<std::unique_ptr<BlockLog>> BlockLog::create(
+    const std::string &path, uint64_t segment_size, SyncOptions sync) {
+  auto log_ = logger::log("BlockLog::create()");
+
+  boost::system::error_code err;
+  if (not boost::filesystem::is_directory(path, err)
+      and not boost::filesystem::create_directory(path, err)) {
+    log_->error("Cannot create storage dir: {}\n{}", path, err.message());
+    return boost::none;
+  }
+
+  std::unique_ptr<BlockStoreFlusher> flusher;
+  if (sync.mode != SyncMode::kNone) {
+    auto created = BlockStoreFlusher::create(path, sync);
+    if (not created) {
+      return boost::none;
+    }
+    flusher = std::move(*created);
+  }
+
+  auto storage = std::make_unique<BlockLog>(
+      path, segment_size, std::move(flusher), private_tag{});
+  if (not storage->open()) {
+    log_->error("Cannot open block log in {}", path);
+    return boost::none;
+  }
+  return boost::optional<std::unique_ptr<BlockLog>>(std::move(storage));
+}
+
+bool BlockLog::add(Identifier id, const Bytes &blob) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
+  if (id != current_id_ + 1) {
+    log_->warn("Cannot append non-consecutive block");
+    return false;
+  }
+
+  const auto record_size = kHeaderSize + blob.size();
+  if (tail_size_ > 0 and tail_size_ + record_size > segment_size_) {
+    if (not openSegment(segments_.size())) {
+      return false;
+    }
+    tail_size_ = 0;
+  }
+
+  RecordHeader header{id,
+                      static_cast<uint32_t>(blob.size()),
+                      checksum(blob.data(), blob.size())};
+  Position position{
+      tail_size_, static_cast<uint32_t>(segments_.size() - 1), header.length};
+
+  // record is written before its index entry, so the entry never points to
+  // missing data, and a record without entry is restored by replay
+  if (not writeAt(segments_.back(), &header, kHeaderSize, position.offset)
+      or not writeAt(segments_.back(),
+                     blob.data(),
+                     blob.size(),
+                     position.offset + kHeaderSize)) {
+    log_->warn("Cannot write block {} to segment {}: {}",
+               id,
+               position.segment,
+               std::strerror(errno));
+    return false;
+  }
+  if (not writeAt(index_fd_,
+                  &position,
+                  sizeof(position),
+                  index_.size() * sizeof(Position))) {
+    log_->warn("Cannot write index entry for block {}: {}",
+               id,
+               std::strerror(errno));
+    return false;
+  }
+
+  // a record which failed to sync is not indexed, and is overwritten by the
+  // next one
+  if (flusher_ and not sync(id)) {
+    return false;
+  }
+
+  index_.push_back(position);
+  tail_size_ += record_size;
+  current_id_ = id;
+  return true;
+}
+
+boost::optional<BlockLog::Bytes> BlockLog::get(Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  if (id == 0 or id > index_.size()) {
+    log_->info("get({}) block not found", id);
+    return boost::none;
+  }
+  const auto &position = index_[id - 1];
+  Bytes blob(position.length);
+  if (not readAt(segments_[position.segment],
+                 blob.data(),
+                 blob.size(),
+                 position.offset + kHeaderSize)) {
+    log_->info(
+        "get({}) problem with reading segment {}", id, position.segment);
+    return boost::none;
+  }
+  return blob;
+}
+
+boost::optional<BlockLog::BytesView> BlockLog::getView(Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  if (id == 0 or id > index_.size()) {
+    log_->info("get({}) block not found", id);
+    return boost::none;
+  }
+  const auto &position = index_[id - 1];
+  const auto end = position.offset + kHeaderSize + position.length;
+
+  std::lock_guard<std::mutex> mappings_lock(mappings_mutex_);
+  mappings_.resize(segments_.size());
+  auto &mapping = mappings_[position.segment];
+  // the last segment grows, so it is mapped again when a record appended
+  // after the current mapping is requested
+  if (not mapping or mapping->size() < end) {
+    auto new_mapping = MappedFile::map(segments_[position.segment],
+                                       fileSize(segments_[position.segment]));
+    if (not new_mapping or (*new_mapping)->size() < end) {
+      log_->info(
+          "get({}) problem with mapping segment {}", id, position.segment);
+      return boost::none;
+    }
+    mapping = std::move(*new_mapping);
+  }
+  return BytesView{mapping,
+                   mapping->data() + position.offset + kHeaderSize,
+                   position.length};
+}
+
+std::string BlockLog::directory() const {
+  return dump_dir_;
+}
+
+Identifier BlockLog::last_id() const {
+  return current_id_.load();
+}
+
+void BlockLog::dropAll() {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  if (flusher_) {
+    flusher_->flush();
+  }
+  close();
+  iroha::remove_dir_contents(dump_dir_);
+  if (not open()) {
+    log_->error("Cannot reopen block log in {}", dump_dir_);
+  }
+}
+
+// ----------| private API |----------
+
+BlockLog::BlockLog(std::string path,
+                   uint64_t segment_size,
+                   std::unique_ptr<BlockStoreFlusher> flusher,
+                   BlockLog::private_tag)
+    : dump_dir_(std::move(path)),
+      segment_size_(segment_size),
+      index_fd_(-1),
+      tail_size_(0),
+      current_id_(0),
+      flusher_(std::move(flusher)),
+      new_files_(false),
+      log_(logger::log("BlockLog")) {}
+
+BlockLog::~BlockLog() {
+  close();
+}
+
+bool BlockLog::open() {
+  const boost::filesystem::path dir{dump_dir_};
+
+  uint32_t segment_count = 0;
+  while (boost::filesystem::exists(dir / segment_name(segment_count))) {
+    ++segment_count;
+  }
+  for (uint32_t segment = 0; segment < std::max(segment_count, 1u);
+       ++segment) {
+    if (not openSegment(segment)) {
+      return false;
+    }
+  }
+
+  const auto index_file = dir / kIndexFileName;
+  new_files_ = new_files_ or not boost::filesystem::exists(index_file);
+  index_fd_ = ::open(index_file.c_str(), O_RDWR | O_CREAT, 0644);
+  if (index_fd_ < 0) {
+    log_->error("Cannot open index {}: {}",
+                index_file.string(),
+                std::strerror(errno));
+    return false;
+  }
+
+  // load index and drop trailing entries which point past the end of segments
+  index_.resize(fileSize(index_fd_) / sizeof(Position));
+  if (not readAt(
+          index_fd_, index_.data(), index_.size() * sizeof(Position), 0)) {
+    log_->error("Cannot read index {}", index_file.string());
+    return false;
+  }
+  while (not index_.empty()) {
+    const auto &last = index_.back();
+    if (last.segment < segments_.size()
+        and last.offset + kHeaderSize + last.length
+            <= fileSize(segments_[last.segment])) {
+      break;
+    }
+    index_.pop_back();
+  }
+
+  const auto indexed = index_.size();
+  auto tail = index_.empty()
+      ? std::make_pair(0u, uint64_t{0})
+      : std::make_pair(index_.back().segment,
+                       index_.back().offset + kHeaderSize
+                           + index_.back().length);
+  tail = replay(tail.first, tail.second);
+  if (index_.size() != indexed) {
+    log_->info("restored {} blocks missing in index", index_.size() - indexed);
+  }
+
+  // cut off partially written record and segments following it
+  if (::ftruncate(segments_[tail.first], tail.second) != 0) {
+    log_->error("Cannot truncate segment {}: {}",
+                tail.first,
+                std::strerror(errno));
+    return false;
+  }
+  while (segments_.size() > tail.first + 1) {
+    ::close(segments_.back());
+    segments_.pop_back();
+    boost::filesystem::remove(dir / segment_name(segments_.size()));
+  }
+  tail_size_ = tail.second;
+
+  if (::ftruncate(index_fd_, indexed * sizeof(Position)) != 0
+      or not writeAt(index_fd_,
+                     index_.data() + indexed,
+                     (index_.size() - indexed) * sizeof(Position),
+                     indexed * sizeof(Position))) {
+    log_->error("Cannot update index {}: {}",
+                index_file.string(),
+                std::strerror(errno));
+    return false;
+  }
+
+  current_id_.store(index_.size());
+  return true;
+}
+
+void BlockLog::close() {
+  {
+    std::lock_guard<std::mutex> mappings_lock(mappings_mutex_);
+    mappings_.clear();
+  }
+  for (auto fd : segments_) {
+    ::close(fd);
+  }
+  segments_.clear();
+  if (index_fd_ >= 0) {
+    ::close(index_fd_);
+    index_fd_ = -1;
+  }
+  index_.clear();
+  tail_size_ = 0;
+  current_id_.store(0);
+}
+
+std::pair<uint32_t, uint64_t> BlockLog::replay(uint32_t segment,
+                                               uint64_t offset) {
+  RecordHeader header;
+  Bytes blob;
+  while (segment < segments_.size()) {
+    const auto fd = segments_[segment];
+    const auto size = fileSize(fd);
+    if (offset == size and segment + 1 < segments_.size()) {
+      ++segment;
+      offset = 0;
+      continue;
+    }
+    if (offset + kHeaderSize > size
+        or not readAt(fd, &header, kHeaderSize, offset)
+        or header.id != index_.size() + 1
+        or offset + kHeaderSize + header.length > size) {
+      break;
+    }
+    blob.resize(header.length);
+    if (not readAt(fd, blob.data(), blob.size(), offset + kHeaderSize)
+        or checksum(blob.data(), blob.size()) != header.checksum) {
+      break;
+    }
+    index_.push_back(Position{offset, segment, header.length});
+    offset += kHeaderSize + header.length;
+  }
+  return {segment, offset};
+}
+
+bool BlockLog::openSegment(uint32_t segment) {
+  const auto file_name =
+      boost::filesystem::path{dump_dir_} / segment_name(segment);
+  new_files_ = new_files_ or not boost::filesystem::exists(file_name);
+  auto fd = ::open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    log_->error(
+        "Cannot open segment {}: {}", file_name.string(), std::strerror(errno));
+    return false;
+  }
+  segments_.push_back(fd);
+  return true;
+}
+
+bool BlockLog::sync(Identifier id) {
+  // flusher closes its descriptors, which may outlive ours after dropAll()
+  std::vector<int> fds;
+  for (auto fd : {segments_.back(), index_fd_}) {
+    auto copy = ::dup(fd);
+    if (copy < 0) {
+      log_->error("Cannot sync block {}: {}", id, std::strerror(errno));
+      for (auto opened : fds) {
+        ::close(opened);
+      }
+      return false;
+    }
+    fds.push_back(copy);
+  }
+  const bool new_files = new_files_;
+  new_files_ = false;
+  if (not flusher_->written(std::move(fds), new_files)) {
+    log_->error("Cannot sync block {}", id);
+    return false;
+  }
+  return true;
+}
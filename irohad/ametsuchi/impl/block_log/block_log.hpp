@@ -0,0 +1,217 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_LOG_HPP
+#define IROHA_BLOCK_LOG_HPP
+
+#include "ametsuchi/key_value_storage.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "ametsuchi/impl/block_store_flusher.hpp"
+#include "ametsuchi/impl/mapped_file.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Solid storage which appends blocks to large segment files.
+     *
+     * Each record in a segment is a RecordHeader followed by the blob. Record
+     * positions are kept in memory and in a separate index file of fixed-size
+     * entries, so opening the storage does not list or read the segments.
+     * Only the records after the last indexed one are replayed from the last
+     * segment, which restores index entries lost in a crash and cuts off a
+     * partially written record.
+     */
+    class BlockLog : public KeyValueStorage {
+      /**
+       * Private tag used to construct unique and shared pointers
+       * without new operator
+       */
+      struct private_tag {};
+
+     public:
+      // ----------| public API |----------
+
+      /**
+       * Location of a blob in segment files
+       */
+      struct Position {
+        uint64_t offset;
+        uint32_t segment;
+        uint32_t length;
+      };
+
+      /**
+       * Header preceding every blob in a segment
+       */
+      struct RecordHeader {
+        Identifier id;
+        uint32_t length;
+        uint32_t checksum;
+      };
+
+      /// segment size after which a new segment is started
+      static const uint64_t kDefaultSegmentSize = 64 * 1024 * 1024;
+
+      /// name of the index file in storage folder
+      static const std::string kIndexFileName;
+
+      /**
+       * Convert segment number to the name of segment file
+       * @param segment - number of segment
+       * @return file name, e.g. "segment_0000000012.log"
+       */
+      static std::string segment_name(uint32_t segment);
+
+      /**
+       * Create storage in path
+       * @param path - target path for creating
+       * @param segment_size - size of a segment which triggers creation of
+       * the next one
+       * @param sync - when written blocks are synced to disk
+       * @return created storage
+       */
+      static boost::optional<std::unique_ptr<BlockLog>> create(
+          const std::string &path,
+          uint64_t segment_size = kDefaultSegmentSize,
+          SyncOptions sync = SyncOptions());
+
+      bool add(Identifier id, const Bytes &blob) override;
+
+      boost::optional<Bytes> get(Identifier id) const override;
+
+      boost::optional<BytesView> getView(Identifier id) const override;
+
+      std::string directory() const override;
+
+      Identifier last_id() const override;
+
+      void dropAll() override;
+
+      // ----------| modify operations |----------
+
+      BlockLog(const BlockLog &rhs) = delete;
+
+      BlockLog(BlockLog &&rhs) = delete;
+
+      BlockLog &operator=(const BlockLog &rhs) = delete;
+
+      BlockLog &operator=(BlockLog &&rhs) = delete;
+
+      // ----------| private API |----------
+
+      /**
+       * Create storage in path. Storage is not usable until open() succeeds
+       * @param path - folder of storage
+       * @param segment_size - size of a segment which triggers creation of
+       * the next one
+       * @param flusher - syncs written blocks, nullptr if they are not synced
+       */
+      BlockLog(std::string path,
+               uint64_t segment_size,
+               std::unique_ptr<BlockStoreFlusher> flusher,
+               private_tag);
+
+      ~BlockLog() override;
+
+     private:
+      /**
+       * Load index, replay tail of the last segment and open files for
+       * appending
+       * @return true on success
+       */
+      bool open();
+
+      /**
+       * Close all open files
+       */
+      void close();
+
+      /**
+       * Read records of segments starting from given position and append them
+       * to index, until end of segments or first broken record
+       * @param segment - number of segment to start from
+       * @param offset - offset in segment to start from
+       * @return position right after the last valid record
+       */
+      std::pair<uint32_t, uint64_t> replay(uint32_t segment, uint64_t offset);
+
+      /**
+       * Open segment file and add it to the list of segments
+       * @param segment - number of segment
+       * @return true on success
+       */
+      bool openSegment(uint32_t segment);
+
+      /**
+       * Pass files of the last written record to flusher
+       * @param id - identifier of the record
+       * @return false if the record failed to sync
+       */
+      bool sync(Identifier id);
+
+      // ----------| private fields |----------
+
+      /**
+       * Folder of storage
+       */
+      const std::string dump_dir_;
+
+      const uint64_t segment_size_;
+
+      /**
+       * Position of every stored blob, blob with id N is at N - 1
+       */
+      std::vector<Position> index_;
+
+      /**
+       * Descriptors of segment files, segment N is at N
+       */
+      std::vector<int> segments_;
+
+      /**
+       * Descriptor of index file
+       */
+      int index_fd_;
+
+      /**
+       * Size of the last segment
+       */
+      uint64_t tail_size_;
+
+      /**
+       * Last written key
+       */
+      std::atomic<Identifier> current_id_;
+
+      mutable std::shared_timed_mutex mutex_;
+
+      /**
+       * Read-only mappings of segments created by getView(), segment N is
+       * at N. Views share ownership, so remapped or dropped segments stay
+       * mapped until their views are released
+       */
+      mutable std::vector<std::shared_ptr<const MappedFile>> mappings_;
+
+      mutable std::mutex mappings_mutex_;
+
+      std::unique_ptr<BlockStoreFlusher> flusher_;
+
+      /**
+       * Whether files were created in storage folder since its last sync
+       */
+      bool new_files_;
+
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOCK_LOG_HPP
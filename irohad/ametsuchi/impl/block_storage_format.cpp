@@ -0,0 +1,252 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_storage_format.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+
+#include "ametsuchi/impl/block_log/block_log.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "backend/protobuf/block.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    const std::array<uint8_t, 4> BlockStorageFormat::kMagic = {
+        {0x00, 'I', 'R', 'B'}};
+
+    const size_t BlockStorageFormat::kHeaderSize =
+        BlockStorageFormat::kMagic.size() + 1;
+
+    const BlockStorageFormat::Version BlockStorageFormat::kCurrentVersion =
+        BlockStorageFormat::Version::kProtobufV1;
+
+    BlockStorageFormat::BlockStorageFormat(
+        std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+            json_deserializer)
+        : json_deserializer_(std::move(json_deserializer)) {}
+
+    expected::Result<BlockStorageFormat::Bytes, std::string>
+    BlockStorageFormat::serialize(
+        const shared_model::interface::Block &block) const {
+      const auto &proto_block_v1 =
+          static_cast<const shared_model::proto::Block &>(block)
+              .getTransport();
+      iroha::protocol::Block proto_block;
+      *proto_block.mutable_block_v1() = proto_block_v1;
+
+      const auto payload_size = proto_block.ByteSizeLong();
+      Bytes result(kHeaderSize + payload_size);
+      std::copy(kMagic.begin(), kMagic.end(), result.begin());
+      result[kMagic.size()] = static_cast<uint8_t>(kCurrentVersion);
+      if (not proto_block.SerializeToArray(result.data() + kHeaderSize,
+                                           payload_size)) {
+        return expected::makeError(
+            (boost::format("Failed to serialize block %d") % block.height())
+                .str());
+      }
+      return expected::makeValue(std::move(result));
+    }
+
+    expected::Result<std::unique_ptr<shared_model::interface::Block>,
+                     std::string>
+    BlockStorageFormat::deserialize(const uint8_t *data, size_t size) const {
+      auto record_version = version(data, size);
+      if (not record_version) {
+        return expected::makeError(
+            std::string("Unknown block storage format"));
+      }
+
+      switch (*record_version) {
+        case Version::kJson:
+          return json_deserializer_->deserialize(
+              std::string(reinterpret_cast<const char *>(data), size));
+        case Version::kProtobufV1: {
+          iroha::protocol::Block block;
+          if (not block.ParseFromArray(data + kHeaderSize,
+                                       size - kHeaderSize)) {
+            return expected::makeError(
+                std::string("Failed to parse block from binary record"));
+          }
+          std::unique_ptr<shared_model::interface::Block> result =
+              std::make_unique<shared_model::proto::Block>(
+                  std::move(*block.mutable_block_v1()));
+          return expected::makeValue(std::move(result));
+        }
+      }
+      return expected::makeError(std::string("Unknown block storage format"));
+    }
+
+    expected::Result<std::unique_ptr<shared_model::interface::Block>,
+                     std::string>
+    BlockStorageFormat::deserialize(const Bytes &blob) const {
+      return deserialize(blob.data(), blob.size());
+    }
+
+    boost::optional<BlockStorageFormat::Version> BlockStorageFormat::version(
+        const uint8_t *data, size_t size) {
+      if (size >= kHeaderSize
+          and std::equal(kMagic.begin(), kMagic.end(), data)) {
+        if (data[kMagic.size()]
+            == static_cast<uint8_t>(Version::kProtobufV1)) {
+          return Version::kProtobufV1;
+        }
+        return boost::none;
+      }
+
+      // legacy records are json documents, which may start with whitespace
+      auto first = std::find_if(
+          data, data + size, [](uint8_t c) { return not std::isspace(c); });
+      if (first != data + size and *first == '{') {
+        return Version::kJson;
+      }
+      return boost::none;
+    }
+
+    expected::Result<void, std::string> migrateBlockStore(
+        const std::string &block_store_dir, const BlockStorageFormat &format) {
+      namespace fs = boost::filesystem;
+      auto log = logger::log("migrateBlockStore");
+
+      auto dir = fs::path{block_store_dir};
+      dir.remove_trailing_separator();
+      const fs::path backup_dir = dir.string() + ".json";
+      const fs::path migration_dir = dir.string() + ".migration";
+
+      boost::system::error_code err;
+      // previous migration was interrupted while swapping directories
+      if (fs::exists(backup_dir, err)) {
+        if (fs::exists(dir, err)) {
+          fs::remove_all(backup_dir, err);
+        } else {
+          log->warn("restoring block store from {}", backup_dir.string());
+          fs::rename(backup_dir, dir, err);
+        }
+        if (err) {
+          return expected::makeError(err.message());
+        }
+      }
+      fs::remove_all(migration_dir, err);
+
+      if (not fs::is_directory(dir, err)) {
+        return expected::Value<void>();
+      }
+
+      auto source = FlatFile::create(dir.string());
+      if (not source) {
+        return expected::makeError(
+            (boost::format("Cannot open block store in %s") % dir.string())
+                .str());
+      }
+      const auto last_id = (*source)->last_id();
+      if (last_id == 0) {
+        return expected::Value<void>();
+      }
+      auto first_block = (*source)->get(1);
+      if (not first_block
+          or BlockStorageFormat::version(first_block->data(),
+                                         first_block->size())
+              != BlockStorageFormat::Version::kJson) {
+        return expected::Value<void>();
+      }
+
+      log->info("converting {} blocks from json to binary format", last_id);
+      auto target = FlatFile::create(migration_dir.string());
+      if (not target) {
+        return expected::makeError(
+            (boost::format("Cannot create block store in %s")
+             % migration_dir.string())
+                .str());
+      }
+
+      for (FlatFile::Identifier id = 1; id <= last_id; ++id) {
+        auto blob = (*source)->get(id);
+        if (not blob) {
+          return expected::makeError(
+              (boost::format("Failed to retrieve block with id %d") % id)
+                  .str());
+        }
+        boost::optional<std::string> error;
+        format.deserialize(*blob).match(
+            [&](expected::Value<std::unique_ptr<shared_model::interface::Block>>
+                    &block) {
+              format.serialize(*block.value)
+                  .match(
+                      [&](const expected::Value<BlockStorageFormat::Bytes>
+                              &bytes) {
+                        if (not(*target)->add(id, bytes.value)) {
+                          error = (boost::format("Failed to store block %d")
+                                   % id)
+                                      .str();
+                        }
+                      },
+                      [&](const expected::Error<std::string> &e) {
+                        error = e.error;
+                      });
+            },
+            [&](const expected::Error<std::string> &e) { error = e.error; });
+        if (error) {
+          return expected::makeError(*error);
+        }
+      }
+      source->reset();
+      target->reset();
+
+      fs::rename(dir, backup_dir, err);
+      if (not err) {
+        fs::rename(migration_dir, dir, err);
+      }
+      if (err) {
+        return expected::makeError(err.message());
+      }
+      fs::remove_all(backup_dir, err);
+
+      log->info("block store migration finished");
+      return expected::Value<void>();
+    }
+
+    expected::Result<std::unique_ptr<KeyValueStorage>, std::string>
+    createBlockStore(const std::string &block_store_dir,
+                     const BlockStorageFormat &format,
+                     BlockStorageType type,
+                     SyncOptions sync) {
+      std::unique_ptr<KeyValueStorage> block_store;
+      switch (type) {
+        case BlockStorageType::kFlatFile: {
+          auto migration_result = migrateBlockStore(block_store_dir, format);
+          if (auto error = boost::get<expected::Error<std::string>>(
+                  &migration_result)) {
+            return expected::makeError(
+                (boost::format("Cannot migrate block store in %s: %s")
+                 % block_store_dir % error->error)
+                    .str());
+          }
+          if (auto flat_file = FlatFile::create(block_store_dir, sync)) {
+            block_store = std::move(*flat_file);
+          }
+          break;
+        }
+        case BlockStorageType::kBlockLog:
+          if (auto block_log = BlockLog::create(
+                  block_store_dir, BlockLog::kDefaultSegmentSize, sync)) {
+            block_store = std::move(*block_log);
+          }
+          break;
+      }
+      if (not block_store) {
+        return expected::makeError(
+            (boost::format("Cannot create block store in %s") % block_store_dir)
+                .str());
+      }
+      return expected::makeValue(std::move(block_store));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,138 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_STORAGE_FORMAT_HPP
+#define IROHA_BLOCK_STORAGE_FORMAT_HPP
+
+#include <array>
+#include <memory>
+
+#include <boost/optional.hpp>
+#include "ametsuchi/impl/block_store_flusher.hpp"
+#include "ametsuchi/key_value_storage.hpp"
+#include "common/result.hpp"
+#include "interfaces/iroha_internal/block_json_deserializer.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+  }
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Layout of block store on disk
+     */
+    enum class BlockStorageType {
+      /// one file per block, see FlatFile
+      kFlatFile,
+      /// blocks appended to segment files with an offset index, see BlockLog
+      kBlockLog
+    };
+
+    /**
+     * Converts blocks to and from the representation kept in block store.
+     *
+     * Blocks are written as a versioned binary record: kMagic, one byte of
+     * format version and the wire bytes of iroha::protocol::Block. Blocks
+     * written by previous versions of the daemon are plain JSON; they are
+     * still readable, and migrateBlockStore converts them at startup.
+     */
+    class BlockStorageFormat {
+     public:
+      using Bytes = KeyValueStorage::Bytes;
+
+      enum class Version : uint8_t { kJson = 0, kProtobufV1 = 1 };
+
+      /// prefix of every binary record, never a valid start of JSON text
+      static const std::array<uint8_t, 4> kMagic;
+
+      /// size of magic and version byte preceding the protobuf payload
+      static const size_t kHeaderSize;
+
+      /// version used for newly written blocks
+      static const Version kCurrentVersion;
+
+      /**
+       * @param json_deserializer - used to read blocks in legacy JSON format
+       */
+      explicit BlockStorageFormat(
+          std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+              json_deserializer);
+
+      /**
+       * Serialize block in current storage format
+       * @param block - block to serialize
+       * @return record to be put to block store or an error
+       */
+      expected::Result<Bytes, std::string> serialize(
+          const shared_model::interface::Block &block) const;
+
+      /**
+       * Deserialize block record of any supported format
+       * @param data - pointer to the beginning of record
+       * @param size - record size in bytes
+       * @return block or an error
+       */
+      expected::Result<std::unique_ptr<shared_model::interface::Block>,
+                       std::string>
+      deserialize(const uint8_t *data, size_t size) const;
+
+      /**
+       * Deserialize block record of any supported format
+       * @param blob - record from block store
+       * @return block or an error
+       */
+      expected::Result<std::unique_ptr<shared_model::interface::Block>,
+                       std::string>
+      deserialize(const Bytes &blob) const;
+
+      /**
+       * Detect format of the record
+       * @param data - pointer to the beginning of record
+       * @param size - record size in bytes
+       * @return version of the record or boost::none if it is not recognized
+       */
+      static boost::optional<Version> version(const uint8_t *data,
+                                              size_t size);
+
+     private:
+      std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+          json_deserializer_;
+    };
+
+    /**
+     * Convert all blocks in block store directory to the current format.
+     * Conversion is done into a sibling directory which then replaces the
+     * original one, so an interrupted migration is restarted from scratch on
+     * the next call and never leaves a store with mixed formats.
+     * @param block_store_dir - folder of block store
+     * @param format - format used to read and write blocks
+     * @return error message if block store could not be converted
+     */
+    expected::Result<void, std::string> migrateBlockStore(
+        const std::string &block_store_dir, const BlockStorageFormat &format);
+
+    /**
+     * Open block store of given type, migrating blocks of flat file store to
+     * the current format first
+     * @param block_store_dir - folder of block store
+     * @param format - format used to read and write blocks
+     * @param type - layout of block store
+     * @param sync - when written blocks are synced to disk
+     * @return block store or error message
+     */
+    expected::Result<std::unique_ptr<KeyValueStorage>, std::string>
+    createBlockStore(const std::string &block_store_dir,
+                     const BlockStorageFormat &format,
+                     BlockStorageType type,
+                     SyncOptions sync = SyncOptions());
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_STORAGE_FORMAT_HPP
@@ -0,0 +1,168 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_store_flusher.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    boost::optional<std::unique_ptr<BlockStoreFlusher>>
+    BlockStoreFlusher::create(const std::string &directory,
+                              SyncOptions options) {
+      auto fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+      if (fd < 0) {
+        logger::log("BlockStoreFlusher::create()")
+            ->error("Cannot open directory {}: {}",
+                    directory,
+                    std::strerror(errno));
+        return boost::none;
+      }
+      return std::unique_ptr<BlockStoreFlusher>(
+          new BlockStoreFlusher(fd, options));
+    }
+
+    BlockStoreFlusher::BlockStoreFlusher(int directory_fd,
+                                         SyncOptions options)
+        : directory_fd_(directory_fd),
+          options_(options),
+          new_files_(false),
+          written_seq_(0),
+          synced_seq_(0),
+          pending_blocks_(0),
+          flush_requests_(0),
+          syncs_(0),
+          failures_(0),
+          stopped_(false),
+          log_(logger::log("BlockStoreFlusher")),
+          thread_([this] { this->run(); }) {}
+
+    BlockStoreFlusher::~BlockStoreFlusher() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+      written_.notify_one();
+      thread_.join();
+      ::close(directory_fd_);
+    }
+
+    bool BlockStoreFlusher::written(std::vector<int> fds, bool new_file) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (pending_blocks_ == 0) {
+        first_pending_ = std::chrono::steady_clock::now();
+      }
+      pending_.insert(pending_.end(), fds.begin(), fds.end());
+      new_files_ = new_files_ or new_file;
+      ++pending_blocks_;
+      const auto seq = ++written_seq_;
+      written_.notify_one();
+
+      if (options_.mode != SyncMode::kBlock) {
+        return true;
+      }
+      synced_.wait(lock, [this, seq] { return synced_seq_ >= seq; });
+      return failures_ == 0;
+    }
+
+    bool BlockStoreFlusher::flush() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      const auto seq = written_seq_;
+      ++flush_requests_;
+      written_.notify_one();
+      synced_.wait(lock, [this, seq] { return synced_seq_ >= seq; });
+      --flush_requests_;
+      return failures_ == 0;
+    }
+
+    uint64_t BlockStoreFlusher::syncs() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return syncs_;
+    }
+
+    uint64_t BlockStoreFlusher::failures() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return failures_;
+    }
+
+    const SyncOptions &BlockStoreFlusher::options() const {
+      return options_;
+    }
+
+    void BlockStoreFlusher::run() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        written_.wait(lock,
+                      [this] { return stopped_ or pending_blocks_ > 0; });
+        if (pending_blocks_ == 0) {
+          return;
+        }
+        if (options_.mode == SyncMode::kGroup) {
+          written_.wait_until(
+              lock, first_pending_ + options_.group_interval, [this] {
+                return stopped_ or flush_requests_ > 0
+                    or pending_blocks_ >= options_.group_blocks;
+              });
+        }
+
+        auto fds = std::move(pending_);
+        pending_.clear();
+        const bool sync_directory = std::exchange(new_files_, false);
+        const auto seq = written_seq_;
+        pending_blocks_ = 0;
+
+        lock.unlock();
+        const bool synced = sync(fds, sync_directory);
+        lock.lock();
+
+        ++syncs_;
+        if (not synced) {
+          // pages which failed to be written may be dropped from page cache
+          // without another error, so no later block is reported as synced
+          ++failures_;
+        }
+        synced_seq_ = seq;
+        synced_.notify_all();
+      }
+    }
+
+    bool BlockStoreFlusher::sync(const std::vector<int> &fds,
+                                 bool sync_directory) {
+      bool synced = true;
+      // blocks appended to the same file share one sync
+      std::vector<std::pair<dev_t, ino_t>> files;
+      for (auto fd : fds) {
+        struct stat st;
+        if (::fstat(fd, &st) == 0) {
+          auto file = std::make_pair(st.st_dev, st.st_ino);
+          if (std::find(files.begin(), files.end(), file) != files.end()) {
+            ::close(fd);
+            continue;
+          }
+          files.push_back(file);
+        }
+        if (::fsync(fd) != 0) {
+          log_->error("Cannot sync block store file: {}", std::strerror(errno));
+          synced = false;
+        }
+        ::close(fd);
+      }
+      if (sync_directory and ::fsync(directory_fd_) != 0) {
+        log_->error("Cannot sync block store directory: {}",
+                    std::strerror(errno));
+        synced = false;
+      }
+      return synced;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,145 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_STORE_FLUSHER_HPP
+#define IROHA_BLOCK_STORE_FLUSHER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * When written blocks are synced to disk
+     */
+    enum class SyncMode {
+      /// never, blocks are left in page cache until the system writes them
+      kNone,
+      /// every block is synced before it is reported as written
+      kBlock,
+      /// blocks are synced in groups, after a time interval or a number of
+      /// blocks, whichever comes first
+      kGroup
+    };
+
+    /**
+     * Durability settings of block store
+     */
+    struct SyncOptions {
+      SyncMode mode = SyncMode::kNone;
+      /// longest time a block waits for sync in group mode
+      std::chrono::milliseconds group_interval = std::chrono::milliseconds(10);
+      /// number of written blocks which triggers sync in group mode
+      size_t group_blocks = 100;
+    };
+
+    /**
+     * Syncs files of written blocks and their directory on a background
+     * thread.
+     *
+     * Files written since the last sync are synced together, so in block mode
+     * a writer waits for a single sync of all its files, and in group mode
+     * many blocks share one sync. A block acknowledged in group mode is lost
+     * on power loss if it is not synced yet, at most group_interval or
+     * group_blocks back.
+     */
+    class BlockStoreFlusher {
+     public:
+      /**
+       * Create flusher of block store files
+       * @param directory - folder of block store
+       * @param options - when blocks are synced, mode must not be kNone
+       * @return flusher or boost::none if the folder cannot be opened
+       */
+      static boost::optional<std::unique_ptr<BlockStoreFlusher>> create(
+          const std::string &directory, SyncOptions options);
+
+      /**
+       * Sync remaining files and stop the background thread
+       */
+      ~BlockStoreFlusher();
+
+      /**
+       * Schedule sync of a written block
+       * @param fds - descriptors of files the block is written to, owned by
+       * the flusher and closed after sync
+       * @param new_file - whether a file was created in the folder, so the
+       * folder is synced too
+       * @return false if the block was not synced in block mode
+       */
+      bool written(std::vector<int> fds, bool new_file);
+
+      /**
+       * Sync all written blocks and wait for it
+       * @return false if any sync has failed
+       */
+      bool flush();
+
+      /**
+       * @return number of syncs done
+       */
+      uint64_t syncs() const;
+
+      /**
+       * @return number of failed syncs
+       */
+      uint64_t failures() const;
+
+      const SyncOptions &options() const;
+
+      BlockStoreFlusher(const BlockStoreFlusher &) = delete;
+      BlockStoreFlusher &operator=(const BlockStoreFlusher &) = delete;
+
+     private:
+      BlockStoreFlusher(int directory_fd, SyncOptions options);
+
+      /**
+       * Sync written files until the flusher is stopped
+       */
+      void run();
+
+      /**
+       * Sync files, close them, and sync the folder
+       * @return true on success
+       */
+      bool sync(const std::vector<int> &fds, bool sync_directory);
+
+      const int directory_fd_;
+      const SyncOptions options_;
+
+      mutable std::mutex mutex_;
+      /// signalled when a block is written, flush requested or flusher stops
+      std::condition_variable written_;
+      /// signalled when a sync is done
+      std::condition_variable synced_;
+      /// descriptors of files written since the last sync
+      std::vector<int> pending_;
+      bool new_files_;
+      std::chrono::steady_clock::time_point first_pending_;
+      /// sequence numbers of written and of synced blocks
+      uint64_t written_seq_;
+      uint64_t synced_seq_;
+      size_t pending_blocks_;
+      size_t flush_requests_;
+      uint64_t syncs_;
+      uint64_t failures_;
+      bool stopped_;
+
+      logger::Logger log_;
+      std::thread thread_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_STORE_FLUSHER_HPP
@@ -0,0 +1,184 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/commit_pipeline.hpp"
+
+#include <algorithm>
+
+namespace {
+  /// number of times a written block is indexed before the pipeline fails
+  const int kAttempts = 3;
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    CommitPipeline::CommitPipeline(
+        std::unique_ptr<KeyValueStorage> block_store,
+        IndexFunction index,
+        CommittedFunction committed)
+        : block_store_(std::move(block_store)),
+          index_(std::move(index)),
+          committed_(std::move(committed)),
+          failures_(0),
+          failed_(false),
+          stopped_(false),
+          log_(logger::log("CommitPipeline")),
+          thread_([this] { this->run(); }) {}
+
+    CommitPipeline::~CommitPipeline() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+      pushed_.notify_one();
+      thread_.join();
+    }
+
+    void CommitPipeline::push(
+        std::shared_ptr<shared_model::interface::Block> block,
+        std::shared_ptr<const Bytes> bytes) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (bytes) {
+          pending_[block->height()] = bytes;
+        }
+        queue_.push_back(Entry{std::move(block), std::move(bytes)});
+      }
+      pushed_.notify_one();
+    }
+
+    void CommitPipeline::flush() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      processed_.wait(lock, [this] { return queue_.empty(); });
+    }
+
+    uint64_t CommitPipeline::failures() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return failures_;
+    }
+
+    bool CommitPipeline::failed() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return failed_;
+    }
+
+    bool CommitPipeline::add(Identifier id, const Bytes &blob) {
+      flush();
+      return block_store_->add(id, blob);
+    }
+
+    boost::optional<KeyValueStorage::Bytes> CommitPipeline::get(
+        Identifier id) const {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(id);
+        if (it != pending_.end()) {
+          return *it->second;
+        }
+      }
+      return block_store_->get(id);
+    }
+
+    boost::optional<KeyValueStorage::BytesView> CommitPipeline::getView(
+        Identifier id) const {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(id);
+        if (it != pending_.end()) {
+          const auto &bytes = it->second;
+          return BytesView{bytes, bytes->data(), bytes->size()};
+        }
+      }
+      return block_store_->getView(id);
+    }
+
+    std::string CommitPipeline::directory() const {
+      return block_store_->directory();
+    }
+
+    KeyValueStorage::Identifier CommitPipeline::last_id() const {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (not pending_.empty()) {
+          return std::max(pending_.rbegin()->first, block_store_->last_id());
+        }
+      }
+      return block_store_->last_id();
+    }
+
+    void CommitPipeline::dropAll() {
+      flush();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.clear();
+      }
+      block_store_->dropAll();
+    }
+
+    void CommitPipeline::run() {
+      while (true) {
+        Entry entry;
+        bool failed;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          pushed_.wait(lock, [this] { return stopped_ or not queue_.empty(); });
+          if (queue_.empty()) {
+            return;
+          }
+          // entry stays queued until it is processed, so flush waits for it
+          entry = queue_.front();
+          failed = failed_;
+        }
+
+        const auto height = entry.block->height();
+        // block store rejects a block after a missing one, and index of a
+        // block after an unindexed one misses its transactions, so neither
+        // is tried after a failure
+        const bool written = not failed
+            and (not entry.bytes or block_store_->add(height, *entry.bytes));
+        if (not failed and not written) {
+          // block stays readable from pending blocks until restart
+          log_->error("cannot write block {}, blocks are not committed until "
+                      "restart",
+                      height);
+        }
+        bool indexed = false;
+        for (int attempt = 0; written and not indexed and attempt < kAttempts;
+             ++attempt) {
+          indexed = index_(*entry.block);
+          if (not indexed) {
+            log_->warn("cannot index block {}, attempt {} of {}",
+                       height,
+                       attempt + 1,
+                       kAttempts);
+          }
+        }
+        if (written and not indexed) {
+          log_->error("cannot index block {}, blocks are not committed until "
+                      "restart",
+                      height);
+        }
+        if (indexed) {
+          committed_(entry.block);
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (written) {
+            pending_.erase(height);
+          }
+          if (not indexed) {
+            failed_ = true;
+            ++failures_;
+          }
+          queue_.pop_front();
+        }
+        processed_.notify_all();
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,139 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_COMMIT_PIPELINE_HPP
+#define IROHA_COMMIT_PIPELINE_HPP
+
+#include "ametsuchi/key_value_storage.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "interfaces/iroha_internal/block.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Block store, which writes and indexes blocks committed to WSV in
+     * background, so the next round is validated while the previous block is
+     * written.
+     *
+     * Blocks are written, indexed and reported as committed one by one in
+     * commit order. Pushed blocks are readable from this storage at once, so
+     * block queries see the committed top block before it is written. WSV
+     * is committed before its blocks are pushed, and restored from block
+     * store on start, so a block lost on crash is downloaded again and WSV
+     * never stays ahead of block store.
+     *
+     * Block store accepts only consecutive blocks, so after a block is not
+     * written no later block is written either, and the pipeline reports
+     * itself as failed. A written block which is not indexed after a few
+     * attempts fails the pipeline the same way, so index never skips a
+     * block. Owner has to stop committing WSV then.
+     */
+    class CommitPipeline : public KeyValueStorage {
+     public:
+      /// indexes written block, returns false if it is not indexed
+      using IndexFunction =
+          std::function<bool(const shared_model::interface::Block &)>;
+      /// called for every written block after it is indexed, never for a
+      /// block which is not indexed
+      using CommittedFunction =
+          std::function<void(std::shared_ptr<shared_model::interface::Block>)>;
+
+      CommitPipeline(std::unique_ptr<KeyValueStorage> block_store,
+                     IndexFunction index,
+                     CommittedFunction committed);
+
+      /**
+       * Write pending blocks and stop the background thread
+       */
+      ~CommitPipeline() override;
+
+      /**
+       * Queue committed block for writing and indexing
+       * @param block - block committed to WSV
+       * @param bytes - serialized block, nullptr if block is already in
+       * block store and is only indexed
+       */
+      void push(std::shared_ptr<shared_model::interface::Block> block,
+                std::shared_ptr<const Bytes> bytes);
+
+      /**
+       * Wait until all pushed blocks are written, indexed and reported
+       */
+      void flush();
+
+      /**
+       * @return number of pushed blocks not written or indexed because of
+       * an error
+       */
+      uint64_t failures() const;
+
+      /**
+       * @return true if a pushed block was not written or indexed, so later
+       * blocks are neither persisted nor reported
+       */
+      bool failed() const;
+
+      /**
+       * Write block directly to block store, after pending blocks
+       */
+      bool add(Identifier id, const Bytes &blob) override;
+
+      boost::optional<Bytes> get(Identifier id) const override;
+
+      boost::optional<BytesView> getView(Identifier id) const override;
+
+      std::string directory() const override;
+
+      /**
+       * @return height of last pushed or written block
+       */
+      Identifier last_id() const override;
+
+      void dropAll() override;
+
+     private:
+      struct Entry {
+        std::shared_ptr<shared_model::interface::Block> block;
+        std::shared_ptr<const Bytes> bytes;
+      };
+
+      /**
+       * Process queued blocks until the pipeline is stopped
+       */
+      void run();
+
+      std::unique_ptr<KeyValueStorage> block_store_;
+      IndexFunction index_;
+      CommittedFunction committed_;
+
+      mutable std::mutex mutex_;
+      /// signalled when a block is pushed or the pipeline is stopped
+      std::condition_variable pushed_;
+      /// signalled when a queued block is processed
+      std::condition_variable processed_;
+      std::deque<Entry> queue_;
+      /// serialized blocks not yet written to block store, by height
+      std::map<Identifier, std::shared_ptr<const Bytes>> pending_;
+      uint64_t failures_;
+      bool failed_;
+      bool stopped_;
+
+      logger::Logger log_;
+      std::thread thread_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_COMMIT_PIPELINE_HPP
@@ -0,0 +1,168 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/connection_pool.hpp"
+
+#include <algorithm>
+
+#include <soci/postgresql/soci-postgresql.h>
+#include <boost/format.hpp>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    constexpr size_t WaitHistogram::kBuckets;
+
+    const std::array<std::chrono::microseconds, WaitHistogram::kBuckets - 1>
+        WaitHistogram::kBounds = {{std::chrono::microseconds(100),
+                                   std::chrono::milliseconds(1),
+                                   std::chrono::milliseconds(10),
+                                   std::chrono::milliseconds(100),
+                                   std::chrono::seconds(1)}};
+
+    void WaitHistogram::record(std::chrono::microseconds wait) {
+      size_t bucket = 0;
+      while (bucket != kBounds.size() and wait >= kBounds[bucket]) {
+        ++bucket;
+      }
+      counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::array<uint64_t, WaitHistogram::kBuckets> WaitHistogram::counts()
+        const {
+      std::array<uint64_t, kBuckets> result;
+      for (size_t i = 0; i != kBuckets; ++i) {
+        result[i] = counts_[i].load(std::memory_order_relaxed);
+      }
+      return result;
+    }
+
+    std::string WaitHistogram::toString() const {
+      auto milliseconds = [](std::chrono::microseconds bound) {
+        return (boost::format("%gms") % (bound.count() / 1000.)).str();
+      };
+      auto counts = this->counts();
+      std::string result;
+      for (size_t i = 0; i != kBuckets; ++i) {
+        if (i != 0) {
+          result += ", ";
+        }
+        result += i != kBounds.size() ? "<" + milliseconds(kBounds[i])
+                                      : ">=" + milliseconds(kBounds.back());
+        result += ": " + std::to_string(counts[i]);
+      }
+      return result;
+    }
+
+    ConnectionPool::ConnectionPool(std::string name,
+                                   size_t size,
+                                   std::chrono::milliseconds checkout_timeout)
+        : name_(std::move(name)),
+          size_(size),
+          checkout_timeout_(checkout_timeout),
+          pool_(size),
+          timeouts_(0),
+          log_(logger::log("ConnectionPool " + name_)) {}
+
+    expected::Result<std::shared_ptr<ConnectionPool>, std::string>
+    ConnectionPool::create(std::string name,
+                           size_t size,
+                           std::chrono::milliseconds checkout_timeout,
+                           const std::string &options) {
+      if (size == 0) {
+        return expected::makeError("Pool " + name + " has no connections");
+      }
+      std::shared_ptr<ConnectionPool> pool(
+          new ConnectionPool(std::move(name), size, checkout_timeout));
+      try {
+        for (size_t i = 0; i != size; ++i) {
+          pool->pool_.at(i).open(soci::postgresql, options);
+        }
+      } catch (const std::exception &e) {
+        return expected::makeError("Pool " + pool->name_
+                                   + " cannot connect: " + e.what());
+      }
+      return expected::makeValue(pool);
+    }
+
+    expected::Result<std::unique_ptr<soci::session>, std::string>
+    ConnectionPool::checkout() {
+      const auto start = std::chrono::steady_clock::now();
+      const auto deadline = start + checkout_timeout_;
+      auto timeout = [&] {
+        ++timeouts_;
+        log_->warn("no connection returned in {} ms",
+                   checkout_timeout_.count());
+        return expected::makeError(
+            (boost::format("Pool %s has no free connection in %d ms") % name_
+             % checkout_timeout_.count())
+                .str());
+      };
+
+      std::unique_lock<std::timed_mutex> lock(checkout_mutex_,
+                                              std::defer_lock);
+      if (not lock.try_lock_until(deadline)) {
+        return timeout();
+      }
+      // soci pool waits for a connection with timeout only when the
+      // position is leased directly, so wait for it that way and give it
+      // back to be leased by the session. Other waiters are blocked by the
+      // mutex, so the session gets the connection without waiting.
+      const auto left = std::max(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              deadline - std::chrono::steady_clock::now()),
+          std::chrono::milliseconds::zero());
+      std::size_t position;
+      if (not pool_.try_lease(position, static_cast<int>(left.count()))) {
+        return timeout();
+      }
+      pool_.give_back(position);
+      auto session = std::make_unique<soci::session>(pool_);
+      lock.unlock();
+
+      wait_histogram_.record(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start));
+      return expected::makeValue(std::move(session));
+    }
+
+    void ConnectionPool::forEach(
+        const std::function<void(soci::session &)> &function) {
+      for (size_t i = 0; i != size_; ++i) {
+        function(pool_.at(i));
+      }
+    }
+
+    void ConnectionPool::close() {
+      std::lock_guard<std::timed_mutex> lock(checkout_mutex_);
+      std::vector<std::unique_ptr<soci::session>> sessions;
+      for (size_t i = 0; i != size_; ++i) {
+        sessions.push_back(std::make_unique<soci::session>(pool_));
+        sessions.back()->close();
+        log_->debug("Closed connection {}", i);
+      }
+      log_->info("waits for connection: {}, timeouts: {}",
+                 wait_histogram_.toString(),
+                 timeouts_.load());
+    }
+
+    const std::string &ConnectionPool::name() const {
+      return name_;
+    }
+
+    size_t ConnectionPool::size() const {
+      return size_;
+    }
+
+    const WaitHistogram &ConnectionPool::waitHistogram() const {
+      return wait_histogram_;
+    }
+
+    uint64_t ConnectionPool::timeouts() const {
+      return timeouts_;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,134 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_CONNECTION_POOL_HPP
+#define IROHA_CONNECTION_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <soci/soci.h>
+#include "common/result.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Sizes of database connection pools of storage, and how long a
+     * connection is waited for before the request fails
+     */
+    struct PoolOptions {
+      /// connections of block and WSV queries and of query executors
+      size_t query_pool_size = 4;
+      /// connections of temporary WSVs of stateful validation
+      size_t validation_pool_size = 4;
+      /// connections of mutable storages and other commit work
+      size_t commit_pool_size = 2;
+      std::chrono::milliseconds checkout_timeout = std::chrono::seconds(10);
+    };
+
+    /**
+     * Counts of waits for a connection by duration. Bucket i counts waits
+     * shorter than kBounds[i], the last one counts all longer waits.
+     */
+    class WaitHistogram {
+     public:
+      static constexpr size_t kBuckets = 6;
+      static const std::array<std::chrono::microseconds, kBuckets - 1>
+          kBounds;
+
+      void record(std::chrono::microseconds wait);
+
+      /**
+       * @return counts of waits in every bucket
+       */
+      std::array<uint64_t, kBuckets> counts() const;
+
+      /**
+       * @return counts formatted as "<0.1ms: 3, <1ms: 1, ..."
+       */
+      std::string toString() const;
+
+     private:
+      std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+    };
+
+    /**
+     * Pool of database connections with bounded checkout waiting and
+     * statistics of waits. Connections are returned to the pool when
+     * checked out sessions are destroyed.
+     */
+    class ConnectionPool {
+     public:
+      /**
+       * Open pool connections
+       * @param name - name of the pool in logs and errors
+       * @param size - number of connections
+       * @param checkout_timeout - maximal time to wait for a connection
+       * @param options - connection options of Postgres
+       * @return opened pool or error if a connection cannot be opened
+       */
+      static expected::Result<std::shared_ptr<ConnectionPool>, std::string>
+      create(std::string name,
+             size_t size,
+             std::chrono::milliseconds checkout_timeout,
+             const std::string &options);
+
+      /**
+       * Take a connection from the pool, waiting at most checkout timeout
+       * for one to be returned if all are in use
+       * @return session over the connection or error on timeout
+       */
+      expected::Result<std::unique_ptr<soci::session>, std::string>
+      checkout();
+
+      /**
+       * Call function for every connection of the pool, must be called
+       * when no connections are checked out
+       */
+      void forEach(const std::function<void(soci::session &)> &function);
+
+      /**
+       * Wait until all connections are returned and close them
+       */
+      void close();
+
+      const std::string &name() const;
+
+      size_t size() const;
+
+      const WaitHistogram &waitHistogram() const;
+
+      /**
+       * @return number of checkouts failed by timeout
+       */
+      uint64_t timeouts() const;
+
+     private:
+      ConnectionPool(std::string name,
+                     size_t size,
+                     std::chrono::milliseconds checkout_timeout);
+
+      const std::string name_;
+      const size_t size_;
+      const std::chrono::milliseconds checkout_timeout_;
+      soci::connection_pool pool_;
+      /// lets a single waiter at a time lease from pool
+      std::timed_mutex checkout_mutex_;
+      WaitHistogram wait_histogram_;
+      std::atomic<uint64_t> timeouts_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_CONNECTION_POOL_HPP
@@ -5,17 +5,44 @@
 
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <boost/filesystem.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/algorithm/find_if.hpp>
+#include <cerrno>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include "ametsuchi/impl/mapped_file.hpp"
 #include "common/files.hpp"
 
 using namespace iroha::ametsuchi;
 using Identifier = FlatFile::Identifier;
 
+namespace {
+  /**
+   * Write exactly size bytes to file
+   * @return true on success
+   */
+  bool writeAll(int fd, const uint8_t *data, size_t size) {
+    while (size > 0) {
+      auto n = ::write(fd, data, size);
+      if (n < 0 and errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      data += n;
+      size -= n;
+    }
+    return true;
+  }
+}  // namespace
+
 // ----------| public API |----------
 
 std::string FlatFile::id_to_name(Identifier id) {
@@ -25,7 +52,7 @@ std::string FlatFile::id_to_name(Identifier id) {
 }
 
 boost::optional<std::unique_ptr<FlatFile>> FlatFile::create(
-    const std::string &path) {
+    const std::string &path, SyncOptions sync) {
   auto log_ = logger::log("FlatFile::create()");
 
   boost::system::error_code err;
@@ -35,8 +62,18 @@ boost::optional<std::unique_ptr<FlatFile>> FlatFile::create(
     return boost::none;
   }
 
+  std::unique_ptr<BlockStoreFlusher> flusher;
+  if (sync.mode != SyncMode::kNone) {
+    auto created = BlockStoreFlusher::create(path, sync);
+    if (not created) {
+      return boost::none;
+    }
+    flusher = std::move(*created);
+  }
+
   auto res = FlatFile::check_consistency(path);
-  return std::make_unique<FlatFile>(*res, path, private_tag{});
+  return std::make_unique<FlatFile>(
+      *res, path, std::move(flusher), private_tag{});
 }
 
 bool FlatFile::add(Identifier id, const Bytes &block) {
@@ -50,24 +87,30 @@ bool FlatFile::add(Identifier id, const Bytes &block) {
   auto next_id = id;
   const auto file_name = boost::filesystem::path{dump_dir_} / id_to_name(id);
 
-  // Write block to binary file
-  if (boost::filesystem::exists(file_name)) {
-    // File already exist
-    log_->warn("insertion for {} failed, because file already exists", id);
+  // Write block to binary file, new file is created
+  auto fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    if (errno == EEXIST) {
+      log_->warn("insertion for {} failed, because file already exists", id);
+    } else {
+      log_->warn("Cannot open file by index {} for writing", id);
+    }
     return false;
   }
-  // New file will be created
-  boost::filesystem::ofstream file(file_name.native(), std::ofstream::binary);
-  if (not file.is_open()) {
-    log_->warn("Cannot open file by index {} for writing", id);
+  if (not writeAll(fd, block.data(), block.size())) {
+    log_->warn("Cannot write file by index {}: {}", id, std::strerror(errno));
+    ::close(fd);
+    ::unlink(file_name.c_str());
     return false;
   }
 
-  auto val_size =
-      sizeof(std::remove_reference<decltype(block)>::type::value_type);
-
-  file.write(reinterpret_cast<const char *>(block.data()),
-             block.size() * val_size);
+  if (not flusher_) {
+    ::close(fd);
+  } else if (not flusher_->written({fd}, true)) {
+    log_->error("Cannot sync file by index {}", id);
+    ::unlink(file_name.c_str());
+    return false;
+  }
 
   // Update internals, release lock
   current_id_ = next_id;
@@ -93,6 +136,35 @@ boost::optional<FlatFile::Bytes> FlatFile::get(Identifier id) const {
   return buf;
 }
 
+boost::optional<FlatFile::BytesView> FlatFile::getView(Identifier id) const {
+  const auto filename =
+      boost::filesystem::path{dump_dir_} / FlatFile::id_to_name(id);
+  auto fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    log_->info("get({}) file not found", id);
+    return boost::none;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    log_->info("get({}) problem with opening file", id);
+    return boost::none;
+  }
+  if (st.st_size == 0) {
+    ::close(fd);
+    return BytesView{nullptr, nullptr, 0};
+  }
+  // mapping keeps its own reference to the file
+  auto mapping = MappedFile::map(fd, st.st_size);
+  ::close(fd);
+  if (not mapping) {
+    log_->info("get({}) problem with mapping file", id);
+    return boost::none;
+  }
+  const auto &file = *mapping;
+  return BytesView{file, file->data(), file->size()};
+}
+
 std::string FlatFile::directory() const {
   return dump_dir_;
 }
@@ -102,6 +174,9 @@ Identifier FlatFile::last_id() const {
 }
 
 void FlatFile::dropAll() {
+  if (flusher_) {
+    flusher_->flush();
+  }
   iroha::remove_dir_contents(dump_dir_);
   auto res = FlatFile::check_consistency(dump_dir_);
   current_id_.store(*res);
@@ -111,8 +186,9 @@ void FlatFile::dropAll() {
 
 FlatFile::FlatFile(Identifier current_id,
                    const std::string &path,
+                   std::unique_ptr<BlockStoreFlusher> flusher,
                    FlatFile::private_tag)
-    : dump_dir_(path) {
+    : dump_dir_(path), flusher_(std::move(flusher)) {
   log_ = logger::log("FlatFile");
   current_id_.store(current_id);
 }
@@ -11,6 +11,7 @@
 #include <atomic>
 #include <memory>
 
+#include "ametsuchi/impl/block_store_flusher.hpp"
 #include "logger/logger.hpp"
 
 namespace iroha {
@@ -48,15 +49,18 @@ namespace iroha {
       /**
        * Create storage in paths
        * @param path - target path for creating
+       * @param sync - when written blocks are synced to disk
        * @return created storage
        */
       static boost::optional<std::unique_ptr<FlatFile>> create(
-          const std::string &path);
+          const std::string &path, SyncOptions sync = SyncOptions());
 
       bool add(Identifier id, const Bytes &blob) override;
 
       boost::optional<Bytes> get(Identifier id) const override;
 
+      boost::optional<BytesView> getView(Identifier id) const override;
+
       std::string directory() const override;
 
       Identifier last_id() const override;
@@ -89,9 +93,11 @@ namespace iroha {
        * Create storage in path with respect to last key
        * @param last_id - maximal key written in storage
        * @param path - folder of storage
+       * @param flusher - syncs written blocks, nullptr if they are not synced
        */
       FlatFile(Identifier last_id,
                const std::string &path,
+               std::unique_ptr<BlockStoreFlusher> flusher,
                FlatFile::private_tag);
 
      private:
@@ -107,6 +113,8 @@ namespace iroha {
        */
       const std::string dump_dir_;
 
+      std::unique_ptr<BlockStoreFlusher> flusher_;
+
       logger::Logger log_;
 
      public:
@@ -0,0 +1,125 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_COW_MAP_HPP
+#define IROHA_COW_MAP_HPP
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Hash map with constant time copies, which share unchanged data.
+     *
+     * Entries are split into a fixed number of shards by key hash. A copy of
+     * the map shares all shards with the original, and a shard is cloned on
+     * the first write through a map which does not own it exclusively.
+     * Values are immutable and shared by pointer, so cloning a shard copies
+     * only pointers, and a replaced value stays valid for everyone holding
+     * the old pointer.
+     *
+     * Different copies can be used from different threads, a single copy is
+     * not thread-safe.
+     */
+    template <typename Key, typename Value>
+    class CowMap {
+     public:
+      using ValuePtr = std::shared_ptr<const Value>;
+
+      /// number of shards, cloning a shard takes size() / kShards copies
+      static constexpr size_t kShards = 256;
+
+      CowMap() : size_(0) {
+        for (auto &shard : shards_) {
+          shard = std::make_shared<Shard>();
+        }
+      }
+
+      /**
+       * @return value with given key, nullptr if there is none
+       */
+      ValuePtr get(const Key &key) const {
+        const auto &shard = *shards_[shardIndex(key)];
+        auto it = shard.find(key);
+        return it == shard.end() ? nullptr : it->second;
+      }
+
+      /**
+       * Set or remove value with given key
+       * @param value - new value, the key is removed if it is nullptr
+       * @return previous value, nullptr if there was none
+       */
+      ValuePtr put(const Key &key, ValuePtr value) {
+        auto &shard = exclusiveShard(key);
+        auto it = shard.find(key);
+        ValuePtr previous;
+        if (it != shard.end()) {
+          previous = std::move(it->second);
+          if (value) {
+            it->second = std::move(value);
+          } else {
+            shard.erase(it);
+            --size_;
+          }
+        } else if (value) {
+          shard.emplace(key, std::move(value));
+          ++size_;
+        }
+        return previous;
+      }
+
+      /**
+       * Call function for every key and value in unspecified order
+       * @param f - function taking key and value
+       */
+      void forEach(
+          const std::function<void(const Key &, const Value &)> &f) const {
+        for (const auto &shard : shards_) {
+          for (const auto &entry : *shard) {
+            f(entry.first, *entry.second);
+          }
+        }
+      }
+
+      /**
+       * @return number of keys
+       */
+      size_t size() const {
+        return size_;
+      }
+
+     private:
+      using Shard = std::unordered_map<Key, ValuePtr>;
+
+      size_t shardIndex(const Key &key) const {
+        return std::hash<Key>{}(key) % kShards;
+      }
+
+      /**
+       * @return shard of given key, which is not shared with other maps
+       */
+      Shard &exclusiveShard(const Key &key) {
+        auto &shard = shards_[shardIndex(key)];
+        if (shard.use_count() > 1) {
+          shard = std::make_shared<Shard>(*shard);
+        }
+        return *shard;
+      }
+
+      std::array<std::shared_ptr<Shard>, kShards> shards_;
+      size_t size_;
+    };
+
+    template <typename Key, typename Value>
+    constexpr size_t CowMap<Key, Value>::kShards;
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_COW_MAP_HPP
@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_block_index.hpp"
+
+#include <tuple>
+
+#include <boost/range/adaptor/indexed.hpp>
+#include "common/visitor.hpp"
+#include "interfaces/commands/command.hpp"
+#include "interfaces/commands/transfer_asset.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace {
+  /**
+   * Append position unless it is already the last one, positions of a
+   * block are appended in order, so duplicates are adjacent
+   */
+  void append(std::vector<iroha::ametsuchi::InMemoryBlockIndex::Position>
+                  &positions,
+              const iroha::ametsuchi::InMemoryBlockIndex::Position &position) {
+    if (positions.empty() or not(positions.back() == position)) {
+      positions.push_back(position);
+    }
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    bool InMemoryBlockIndex::Position::operator==(
+        const Position &other) const {
+      return height == other.height and index == other.index;
+    }
+
+    bool InMemoryBlockIndex::Position::operator<(
+        const Position &other) const {
+      return std::tie(height, index) < std::tie(other.height, other.index);
+    }
+
+    bool InMemoryBlockIndex::index(
+        const shared_model::interface::Block &block) {
+      std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+      for (const auto &tx :
+           block.transactions() | boost::adaptors::indexed(0)) {
+        const auto &creator_id = tx.value().creatorAccountId();
+        const Position position{block.height(),
+                                static_cast<uint32_t>(tx.index())};
+
+        append(by_creator_[creator_id], position);
+        for (const auto &command : tx.value().commands()) {
+          visit_in_place(
+              command.get(),
+              [&](const shared_model::interface::TransferAsset &transfer) {
+                for (const auto &account_id : {creator_id,
+                                               transfer.srcAccountId(),
+                                               transfer.destAccountId()}) {
+                  append(by_account_asset_[std::make_pair(
+                             account_id, transfer.assetId())],
+                         position);
+                }
+              },
+              [](const auto &) {});
+        }
+      }
+      return true;
+    }
+
+    std::vector<InMemoryBlockIndex::Position>
+    InMemoryBlockIndex::creatorPositions(
+        const shared_model::interface::types::AccountIdType &account_id)
+        const {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      auto it = by_creator_.find(account_id);
+      if (it == by_creator_.end()) {
+        return {};
+      }
+      return it->second;
+    }
+
+    std::vector<InMemoryBlockIndex::Position>
+    InMemoryBlockIndex::accountAssetPositions(
+        const shared_model::interface::types::AccountIdType &account_id,
+        const shared_model::interface::types::AssetIdType &asset_id) const {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      auto it = by_account_asset_.find(std::make_pair(account_id, asset_id));
+      if (it == by_account_asset_.end()) {
+        return {};
+      }
+      return it->second;
+    }
+
+    void InMemoryBlockIndex::clear() {
+      std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+      by_creator_.clear();
+      by_account_asset_.clear();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_BLOCK_INDEX_HPP
+#define IROHA_IN_MEMORY_BLOCK_INDEX_HPP
+
+#include "ametsuchi/impl/block_index.hpp"
+
+#include <map>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "interfaces/common_objects/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Index of transactions by account kept in memory, same as the one
+     * built by PostgresBlockIndex except for hashes, which are kept in
+     * TxHashIndex. Blocks must be indexed in order of height.
+     */
+    class InMemoryBlockIndex : public BlockIndex {
+     public:
+      /**
+       * Position of transaction in the ledger
+       */
+      struct Position {
+        shared_model::interface::types::HeightType height;
+        uint32_t index;
+
+        bool operator==(const Position &other) const;
+
+        bool operator<(const Position &other) const;
+      };
+
+      /**
+       * Index transactions of block by creator, and by (account, asset) for
+       * creator, source and destination of each Transfer Asset command
+       */
+      bool index(const shared_model::interface::Block &block) override;
+
+      /**
+       * @return positions of transactions created by the account in order
+       */
+      std::vector<Position> creatorPositions(
+          const shared_model::interface::types::AccountIdType &account_id)
+          const;
+
+      /**
+       * @return positions of transactions transferring the asset, which
+       * involve the account, in order
+       */
+      std::vector<Position> accountAssetPositions(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id) const;
+
+      /**
+       * Remove all positions
+       */
+      void clear();
+
+     private:
+      std::unordered_map<shared_model::interface::types::AccountIdType,
+                         std::vector<Position>>
+          by_creator_;
+      std::map<std::pair<shared_model::interface::types::AccountIdType,
+                         shared_model::interface::types::AssetIdType>,
+               std::vector<Position>>
+          by_account_asset_;
+
+      mutable std::shared_timed_mutex mutex_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_BLOCK_INDEX_HPP
@@ -0,0 +1,163 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_block_query.hpp"
+
+#include "interfaces/iroha_internal/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    InMemoryBlockQuery::InMemoryBlockQuery(
+        KeyValueStorage &block_store,
+        std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+            converter,
+        std::shared_ptr<BlockCache> block_cache,
+        std::shared_ptr<const TxHashIndex> tx_hash_index,
+        std::shared_ptr<const InMemoryBlockIndex> block_index)
+        : block_store_(block_store),
+          block_format_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
+          tx_hash_index_(std::move(tx_hash_index)),
+          block_index_(std::move(block_index)),
+          log_(logger::log("InMemoryBlockQuery")) {}
+
+    std::vector<BlockQuery::wBlock> InMemoryBlockQuery::getBlocks(
+        shared_model::interface::types::HeightType height, uint32_t count) {
+      shared_model::interface::types::HeightType last_id =
+          block_store_.last_id();
+      auto to = std::min(last_id, height + count - 1);
+      std::vector<BlockQuery::wBlock> result;
+      if (height > to or count == 0) {
+        return result;
+      }
+      for (auto i = height; i <= to; i++) {
+        getBlock(i).match(
+            [&result](expected::Value<wBlock> &v) {
+              result.emplace_back(std::move(v.value));
+            },
+            [this](const expected::Error<std::string> &e) {
+              log_->error(e.error);
+            });
+      }
+      return result;
+    }
+
+    std::vector<BlockQuery::wBlock> InMemoryBlockQuery::getBlocksFrom(
+        shared_model::interface::types::HeightType height) {
+      return getBlocks(height, block_store_.last_id());
+    }
+
+    std::vector<BlockQuery::wBlock> InMemoryBlockQuery::getTopBlocks(
+        uint32_t count) {
+      auto last_id = block_store_.last_id();
+      count = std::min(count, last_id);
+      return getBlocks(last_id - count + 1, count);
+    }
+
+    std::vector<BlockQuery::wTransaction> InMemoryBlockQuery::getTransactions(
+        const std::vector<InMemoryBlockIndex::Position> &positions) {
+      std::vector<BlockQuery::wTransaction> result;
+      wBlock block;
+      for (const auto &position : positions) {
+        if (not block or block->height() != position.height) {
+          block = nullptr;
+          getBlock(position.height)
+              .match([&block](expected::Value<wBlock> &v) { block = v.value; },
+                     [this](const expected::Error<std::string> &e) {
+                       log_->error(e.error);
+                     });
+          if (not block) {
+            continue;
+          }
+        }
+        result.emplace_back(clone(block->transactions()[position.index]));
+      }
+      return result;
+    }
+
+    std::vector<BlockQuery::wTransaction>
+    InMemoryBlockQuery::getAccountTransactions(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      return getTransactions(block_index_->creatorPositions(account_id));
+    }
+
+    std::vector<BlockQuery::wTransaction>
+    InMemoryBlockQuery::getAccountAssetTransactions(
+        const shared_model::interface::types::AccountIdType &account_id,
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      return getTransactions(
+          block_index_->accountAssetPositions(account_id, asset_id));
+    }
+
+    std::vector<boost::optional<BlockQuery::wTransaction>>
+    InMemoryBlockQuery::getTransactions(
+        const std::vector<shared_model::crypto::Hash> &tx_hashes) {
+      std::vector<boost::optional<BlockQuery::wTransaction>> result;
+      result.reserve(tx_hashes.size());
+      for (const auto &tx_hash : tx_hashes) {
+        result.push_back(getTxByHashSync(tx_hash));
+      }
+      return result;
+    }
+
+    boost::optional<BlockQuery::wTransaction>
+    InMemoryBlockQuery::getTxByHashSync(
+        const shared_model::crypto::Hash &hash) {
+      auto entry = tx_hash_index_->find(hash);
+      if (not entry or not entry->committed) {
+        log_->info("No block with transaction {}", hash);
+        return boost::none;
+      }
+      auto transactions = getTransactions({{entry->height, entry->index}});
+      if (transactions.empty()) {
+        return boost::none;
+      }
+      return std::move(transactions.front());
+    }
+
+    boost::optional<TxCacheStatusType> InMemoryBlockQuery::checkTxPresence(
+        const shared_model::crypto::Hash &hash) {
+      auto entry = tx_hash_index_->find(hash);
+      if (not entry) {
+        return boost::make_optional<TxCacheStatusType>(
+            tx_cache_status_responses::Missing{hash});
+      }
+      if (entry->committed) {
+        return boost::make_optional<TxCacheStatusType>(
+            tx_cache_status_responses::Committed{hash});
+      }
+      return boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Rejected{hash});
+    }
+
+    boost::optional<std::vector<TxCacheStatusType>>
+    InMemoryBlockQuery::checkTxPresence(
+        const std::vector<shared_model::crypto::Hash> &hashes) {
+      std::vector<TxCacheStatusType> statuses;
+      statuses.reserve(hashes.size());
+      for (const auto &hash : hashes) {
+        statuses.push_back(*checkTxPresence(hash));
+      }
+      return statuses;
+    }
+
+    uint32_t InMemoryBlockQuery::getTopBlockHeight() {
+      return block_store_.last_id();
+    }
+
+    expected::Result<BlockQuery::wBlock, std::string>
+    InMemoryBlockQuery::getTopBlock() {
+      return getBlock(block_store_.last_id());
+    }
+
+    expected::Result<BlockQuery::wBlock, std::string>
+    InMemoryBlockQuery::getBlock(
+        shared_model::interface::types::HeightType id) const {
+      return loadBlock(id, block_store_, block_format_, block_cache_.get());
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
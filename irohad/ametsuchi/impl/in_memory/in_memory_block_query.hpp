@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_BLOCK_QUERY_HPP
+#define IROHA_IN_MEMORY_BLOCK_QUERY_HPP
+
+#include "ametsuchi/block_query.hpp"
+
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_block_index.hpp"
+#include "ametsuchi/impl/tx_hash_index.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * BlockQuery which reads blocks from block store and finds them with
+     * indexes kept in memory
+     */
+    class InMemoryBlockQuery : public BlockQuery {
+     public:
+      InMemoryBlockQuery(
+          KeyValueStorage &block_store,
+          std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+              converter,
+          std::shared_ptr<BlockCache> block_cache,
+          std::shared_ptr<const TxHashIndex> tx_hash_index,
+          std::shared_ptr<const InMemoryBlockIndex> block_index);
+
+      std::vector<wTransaction> getAccountTransactions(
+          const shared_model::interface::types::AccountIdType &account_id)
+          override;
+
+      std::vector<wTransaction> getAccountAssetTransactions(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id) override;
+
+      std::vector<boost::optional<wTransaction>> getTransactions(
+          const std::vector<shared_model::crypto::Hash> &tx_hashes) override;
+
+      boost::optional<wTransaction> getTxByHashSync(
+          const shared_model::crypto::Hash &hash) override;
+
+      std::vector<wBlock> getBlocks(
+          shared_model::interface::types::HeightType height,
+          uint32_t count) override;
+
+      std::vector<wBlock> getBlocksFrom(
+          shared_model::interface::types::HeightType height) override;
+
+      std::vector<wBlock> getTopBlocks(uint32_t count) override;
+
+      uint32_t getTopBlockHeight() override;
+
+      boost::optional<TxCacheStatusType> checkTxPresence(
+          const shared_model::crypto::Hash &hash) override;
+
+      boost::optional<std::vector<TxCacheStatusType>> checkTxPresence(
+          const std::vector<shared_model::crypto::Hash> &hashes) override;
+
+      expected::Result<wBlock, std::string> getTopBlock() override;
+
+     private:
+      /**
+       * @return transactions at given positions, which are in order
+       */
+      std::vector<wTransaction> getTransactions(
+          const std::vector<InMemoryBlockIndex::Position> &positions);
+
+      /**
+       * Retrieve block with given id from block cache or block storage
+       * @param id - height of a block to retrieve
+       * @return block with given height
+       */
+      expected::Result<wBlock, std::string> getBlock(
+          shared_model::interface::types::HeightType id) const;
+
+      KeyValueStorage &block_store_;
+      BlockStorageFormat block_format_;
+      std::shared_ptr<BlockCache> block_cache_;
+      std::shared_ptr<const TxHashIndex> tx_hash_index_;
+      std::shared_ptr<const InMemoryBlockIndex> block_index_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_BLOCK_QUERY_HPP
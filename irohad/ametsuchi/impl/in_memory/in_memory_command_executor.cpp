@@ -0,0 +1,709 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_command_executor.hpp"
+
+#include <algorithm>
+
+#include "cryptography/public_key.hpp"
+#include "interfaces/commands/add_asset_quantity.hpp"
+#include "interfaces/commands/add_peer.hpp"
+#include "interfaces/commands/add_signatory.hpp"
+#include "interfaces/commands/append_role.hpp"
+#include "interfaces/commands/create_account.hpp"
+#include "interfaces/commands/create_asset.hpp"
+#include "interfaces/commands/create_domain.hpp"
+#include "interfaces/commands/create_role.hpp"
+#include "interfaces/commands/detach_role.hpp"
+#include "interfaces/commands/grant_permission.hpp"
+#include "interfaces/commands/remove_signatory.hpp"
+#include "interfaces/commands/revoke_permission.hpp"
+#include "interfaces/commands/set_account_detail.hpp"
+#include "interfaces/commands/set_quorum.hpp"
+#include "interfaces/commands/subtract_asset_quantity.hpp"
+#include "interfaces/commands/transfer_asset.hpp"
+#include "interfaces/permission_to_string.hpp"
+#include "utils/string_builder.hpp"
+
+using shared_model::interface::permissions::Grantable;
+using shared_model::interface::permissions::Role;
+
+namespace {
+  /// Error codes of commands, see PostgresCommandExecutor
+  using ErrorCode = iroha::ametsuchi::CommandError::ErrorCodeType;
+
+  template <typename QueryArgsCallable>
+  iroha::ametsuchi::CommandResult makeCommandError(
+      std::string command_name,
+      ErrorCode code,
+      QueryArgsCallable &&query_args) {
+    return iroha::expected::makeError(iroha::ametsuchi::CommandError{
+        std::move(command_name), code, query_args()});
+  }
+
+  /**
+   * Get a pretty string builder initialized for query arguments append,
+   * arguments are the same as of PostgresCommandExecutor
+   * @return string builder
+   */
+  shared_model::detail::PrettyStringBuilder getQueryArgsStringBuilder() {
+    return shared_model::detail::PrettyStringBuilder().init("Query arguments");
+  }
+
+  std::string domainOf(const std::string &id, char separator) {
+    return id.substr(id.find(separator) + 1);
+  }
+
+  template <typename Container, typename Value>
+  bool contains(const Container &container, const Value &value) {
+    return std::find(container.begin(), container.end(), value)
+        != container.end();
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    InMemoryCommandExecutor::InMemoryCommandExecutor(
+        MutableWsvState &state,
+        std::shared_ptr<shared_model::interface::PermissionToString>
+            perm_converter)
+        : state_(state),
+          perm_converter_(std::move(perm_converter)),
+          do_validation_(true) {}
+
+    void InMemoryCommandExecutor::setCreatorAccountId(
+        const shared_model::interface::types::AccountIdType
+            &creator_account_id) {
+      creator_account_id_ = creator_account_id;
+    }
+
+    void InMemoryCommandExecutor::doValidation(bool do_validation) {
+      do_validation_ = do_validation;
+    }
+
+    bool InMemoryCommandExecutor::hasPermission(Role perm) const {
+      return state_.state().accountPermissions(creator_account_id_).test(perm);
+    }
+
+    bool InMemoryCommandExecutor::hasPermission(
+        Role global_perm,
+        Role domain_perm,
+        const shared_model::interface::types::AssetIdType &asset_id) const {
+      const auto permissions =
+          state_.state().accountPermissions(creator_account_id_);
+      return permissions.test(global_perm)
+          or (domainOf(creator_account_id_, '@') == domainOf(asset_id, '#')
+              and permissions.test(domain_perm));
+    }
+
+    bool InMemoryCommandExecutor::hasGrantedPermission(
+        Grantable perm,
+        const shared_model::interface::types::AccountIdType &account_id)
+        const {
+      auto account = state_.state().accounts.get(account_id);
+      if (not account) {
+        return false;
+      }
+      auto it = account->granted_permissions.find(creator_account_id_);
+      return it != account->granted_permissions.end() and it->second.test(perm);
+    }
+
+    bool InMemoryCommandExecutor::hasRoleOrGrantedPermission(
+        Role role,
+        Grantable grantable,
+        const shared_model::interface::types::AccountIdType &account_id)
+        const {
+      return hasGrantedPermission(grantable, account_id)
+          or (creator_account_id_ == account_id and hasPermission(role));
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::AddAssetQuantity &command) {
+      auto &account_id = creator_account_id_;
+      auto &asset_id = command.assetId();
+      auto amount = command.amount().toStringRepr();
+      const auto precision = command.amount().precision();
+      auto str_args = [&account_id, &asset_id, &amount, precision] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("asset_id", asset_id)
+            .append("amount", amount)
+            .append("precision", std::to_string(precision))
+            .finalize();
+      };
+      auto error = [&str_args](ErrorCode code) {
+        return makeCommandError("AddAssetQuantity", code, str_args);
+      };
+
+      if (do_validation_
+          and not hasPermission(
+                  Role::kAddAssetQty, Role::kAddDomainAssetQty, asset_id)) {
+        return error(2);
+      }
+      const auto &wsv = state_.state();
+      auto asset = wsv.assets.get(asset_id);
+      if (not asset or asset->precision < precision) {
+        return error(3);
+      }
+      auto account = wsv.accounts.get(account_id);
+      Balance balance;
+      if (account) {
+        auto it = account->assets.find(asset_id);
+        if (it != account->assets.end()) {
+          balance = it->second;
+        }
+      }
+      balance = balance.add(command.amount());
+      if (not balance.lessThanPowerOfTwo(256 - precision)) {
+        return error(4);
+      }
+      if (not account) {
+        return error(1);
+      }
+      auto updated = *account;
+      updated.assets[asset_id] = std::move(balance);
+      state_.putAccount(account_id, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::AddPeer &command) {
+      auto &peer = command.peer();
+      auto str_args = [&peer] {
+        return getQueryArgsStringBuilder()
+            .append("peer", peer.toString())
+            .finalize();
+      };
+
+      if (do_validation_ and not hasPermission(Role::kAddPeer)) {
+        return makeCommandError("AddPeer", 2, str_args);
+      }
+      const auto public_key = peer.pubkey().hex();
+      const auto &peers = *state_.state().peers;
+      if (std::any_of(peers.begin(), peers.end(), [&](const auto &p) {
+            return p.public_key == public_key or p.address == peer.address();
+          })) {
+        return makeCommandError("AddPeer", 1, str_args);
+      }
+      auto updated = peers;
+      updated.push_back(PeerRecord{public_key, peer.address()});
+      state_.putPeers(std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::AddSignatory &command) {
+      auto &account_id = command.accountId();
+      auto pubkey = command.pubkey().hex();
+      auto str_args = [&account_id, &pubkey] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("pubkey", pubkey)
+            .finalize();
+      };
+
+      if (do_validation_
+          and not hasRoleOrGrantedPermission(Role::kAddSignatory,
+                                             Grantable::kAddMySignatory,
+                                             account_id)) {
+        return makeCommandError("AddSignatory", 2, str_args);
+      }
+      auto account = state_.state().accounts.get(account_id);
+      if (not account) {
+        return makeCommandError("AddSignatory", 3, str_args);
+      }
+      if (contains(account->signatories, pubkey)) {
+        return makeCommandError("AddSignatory", 4, str_args);
+      }
+      auto updated = *account;
+      updated.signatories.push_back(pubkey);
+      state_.putAccount(account_id, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::AppendRole &command) {
+      auto &account_id = command.accountId();
+      auto &role_name = command.roleName();
+      auto str_args = [&account_id, &role_name] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("role_name", role_name)
+            .finalize();
+      };
+
+      const auto &wsv = state_.state();
+      auto role = wsv.roles.get(role_name);
+      if (not role) {
+        return makeCommandError("AppendRole", 4, str_args);
+      }
+      if (do_validation_) {
+        auto creator = wsv.accounts.get(creator_account_id_);
+        const auto permissions = wsv.accountPermissions(creator_account_id_);
+        if (not creator or creator->roles.empty()
+            or not role->isSubsetOf(permissions)
+            or not permissions.test(Role::kAppendRole)) {
+          return makeCommandError("AppendRole", 2, str_args);
+        }
+      }
+      auto account = wsv.accounts.get(account_id);
+      if (not account) {
+        return makeCommandError("AppendRole", 3, str_args);
+      }
+      if (contains(account->roles, role_name)) {
+        return makeCommandError("AppendRole", 1, str_args);
+      }
+      auto updated = *account;
+      updated.roles.push_back(role_name);
+      state_.putAccount(account_id, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::CreateAccount &command) {
+      auto &domain_id = command.domainId();
+      auto pubkey = command.pubkey().hex();
+      const auto account_id = command.accountName() + "@" + domain_id;
+      auto str_args = [&account_id, &domain_id, &pubkey] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("domain_id", domain_id)
+            .append("pubkey", pubkey)
+            .finalize();
+      };
+
+      if (do_validation_ and not hasPermission(Role::kCreateAccount)) {
+        return makeCommandError("CreateAccount", 2, str_args);
+      }
+      const auto &wsv = state_.state();
+      auto default_role = wsv.domains.get(domain_id);
+      if (not default_role) {
+        return makeCommandError("CreateAccount", 3, str_args);
+      }
+      if (wsv.accounts.get(account_id)) {
+        return makeCommandError("CreateAccount", 4, str_args);
+      }
+      AccountRecord account;
+      account.domain_id = domain_id;
+      account.quorum = 1;
+      account.signatories.push_back(pubkey);
+      account.roles.push_back(*default_role);
+      state_.putAccount(account_id, std::move(account));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::CreateAsset &command) {
+      auto &domain_id = command.domainId();
+      auto asset_id = command.assetName() + "#" + domain_id;
+      const auto precision = command.precision();
+      auto str_args = [&domain_id, &asset_id, precision] {
+        return getQueryArgsStringBuilder()
+            .append("domain_id", domain_id)
+            .append("asset_id", asset_id)
+            .append("precision", std::to_string(precision))
+            .finalize();
+      };
+
+      if (do_validation_ and not hasPermission(Role::kCreateAsset)) {
+        return makeCommandError("CreateAsset", 2, str_args);
+      }
+      const auto &wsv = state_.state();
+      if (not wsv.domains.get(domain_id)) {
+        return makeCommandError("CreateAsset", 3, str_args);
+      }
+      if (wsv.assets.get(asset_id)) {
+        return makeCommandError("CreateAsset", 4, str_args);
+      }
+      state_.putAsset(asset_id, AssetRecord{domain_id, precision});
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::CreateDomain &command) {
+      auto &domain_id = command.domainId();
+      auto &default_role = command.userDefaultRole();
+      auto str_args = [&domain_id, &default_role] {
+        return getQueryArgsStringBuilder()
+            .append("domain_id", domain_id)
+            .append("default_role", default_role)
+            .finalize();
+      };
+
+      if (do_validation_ and not hasPermission(Role::kCreateDomain)) {
+        return makeCommandError("CreateDomain", 2, str_args);
+      }
+      const auto &wsv = state_.state();
+      if (wsv.domains.get(domain_id)) {
+        return makeCommandError("CreateDomain", 3, str_args);
+      }
+      if (not wsv.roles.get(default_role)) {
+        return makeCommandError("CreateDomain", 4, str_args);
+      }
+      state_.putDomain(domain_id, default_role);
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::CreateRole &command) {
+      auto &role_id = command.roleName();
+      auto &permissions = command.rolePermissions();
+      auto str_args = [&role_id, perm_str = permissions.toBitstring()] {
+        return getQueryArgsStringBuilder()
+            .append("role_id", role_id)
+            .append("perm_str", perm_str)
+            .finalize();
+      };
+
+      if (do_validation_) {
+        const auto creator_permissions =
+            state_.state().accountPermissions(creator_account_id_);
+        if (not permissions.isSubsetOf(creator_permissions)
+            or not creator_permissions.test(Role::kCreateRole)) {
+          return makeCommandError("CreateRole", 2, str_args);
+        }
+      }
+      if (state_.state().roles.get(role_id)) {
+        return makeCommandError("CreateRole", 3, str_args);
+      }
+      state_.putRole(role_id, permissions);
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::DetachRole &command) {
+      auto &account_id = command.accountId();
+      auto &role_name = command.roleName();
+      auto str_args = [&account_id, &role_name] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("role_name", role_name)
+            .finalize();
+      };
+
+      const auto &wsv = state_.state();
+      auto account = wsv.accounts.get(account_id);
+      if (not account) {
+        return makeCommandError("DetachRole", 3, str_args);
+      }
+      if (not wsv.roles.get(role_name)) {
+        return makeCommandError("DetachRole", 5, str_args);
+      }
+      auto role = std::find(
+          account->roles.begin(), account->roles.end(), role_name);
+      if (role == account->roles.end()) {
+        return makeCommandError("DetachRole", 4, str_args);
+      }
+      if (do_validation_ and not hasPermission(Role::kDetachRole)) {
+        return makeCommandError("DetachRole", 2, str_args);
+      }
+      auto updated = *account;
+      updated.roles.erase(updated.roles.begin()
+                          + std::distance(account->roles.begin(), role));
+      state_.putAccount(account_id, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::GrantPermission &command) {
+      auto &permittee_account_id = command.accountId();
+      const auto permission = command.permissionName();
+      auto str_args = [&creator_account_id = creator_account_id_,
+                       &permittee_account_id,
+                       permission = perm_converter_->toString(permission)] {
+        return getQueryArgsStringBuilder()
+            .append("creator_account_id_", creator_account_id)
+            .append("permittee_account_id", permittee_account_id)
+            .append("permission", permission)
+            .finalize();
+      };
+
+      if (do_validation_
+          and not hasPermission(
+                  shared_model::interface::permissions::permissionFor(
+                      permission))) {
+        return makeCommandError("GrantPermission", 2, str_args);
+      }
+      const auto &wsv = state_.state();
+      if (not wsv.accounts.get(permittee_account_id)) {
+        return makeCommandError("GrantPermission", 3, str_args);
+      }
+      auto creator = wsv.accounts.get(creator_account_id_);
+      if (not creator) {
+        return makeCommandError("GrantPermission", 1, str_args);
+      }
+      auto it = creator->granted_permissions.find(permittee_account_id);
+      if (it != creator->granted_permissions.end()
+          and it->second.test(permission)) {
+        return makeCommandError("GrantPermission", 1, str_args);
+      }
+      auto updated = *creator;
+      updated.granted_permissions[permittee_account_id].set(permission);
+      state_.putAccount(creator_account_id_, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::RemoveSignatory &command) {
+      auto &account_id = command.accountId();
+      auto pubkey = command.pubkey().hex();
+      auto str_args = [&account_id, &pubkey] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("pubkey", pubkey)
+            .finalize();
+      };
+
+      auto account = state_.state().accounts.get(account_id);
+      if (do_validation_) {
+        if (not account) {
+          return makeCommandError("RemoveSignatory", 3, str_args);
+        }
+        if (not hasRoleOrGrantedPermission(Role::kRemoveSignatory,
+                                           Grantable::kRemoveMySignatory,
+                                           account_id)) {
+          return makeCommandError("RemoveSignatory", 2, str_args);
+        }
+      }
+      if (not account or not contains(account->signatories, pubkey)) {
+        return makeCommandError(
+            "RemoveSignatory", do_validation_ ? 4 : 1, str_args);
+      }
+      if (do_validation_ and account->quorum >= account->signatories.size()) {
+        return makeCommandError("RemoveSignatory", 5, str_args);
+      }
+      auto updated = *account;
+      updated.signatories.erase(std::find(
+          updated.signatories.begin(), updated.signatories.end(), pubkey));
+      state_.putAccount(account_id, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::RevokePermission &command) {
+      auto &permittee_account_id = command.accountId();
+      const auto permission = command.permissionName();
+      auto str_args = [&creator_account_id = creator_account_id_,
+                       &permittee_account_id,
+                       permission = perm_converter_->toString(permission)] {
+        return getQueryArgsStringBuilder()
+            .append("creator_account_id_", creator_account_id)
+            .append("permittee_account_id", permittee_account_id)
+            .append("permission", permission)
+            .finalize();
+      };
+
+      auto creator = state_.state().accounts.get(creator_account_id_);
+      auto is_granted = [&] {
+        if (not creator) {
+          return false;
+        }
+        auto it = creator->granted_permissions.find(permittee_account_id);
+        return it != creator->granted_permissions.end()
+            and it->second.test(permission);
+      };
+      if (not is_granted()) {
+        return makeCommandError(
+            "RevokePermission", do_validation_ ? 2 : 1, str_args);
+      }
+      auto updated = *creator;
+      updated.granted_permissions[permittee_account_id].unset(permission);
+      state_.putAccount(creator_account_id_, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::SetAccountDetail &command) {
+      auto &account_id = command.accountId();
+      auto &key = command.key();
+      auto &value = command.value();
+      if (creator_account_id_.empty()) {
+        // When creator is not known, it is genesis block
+        creator_account_id_ = "genesis";
+      }
+      auto str_args = [&account_id, &key, &value] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("key", key)
+            .append("value", value)
+            .finalize();
+      };
+
+      if (do_validation_
+          and not(hasGrantedPermission(Grantable::kSetMyAccountDetail,
+                                       account_id)
+                  or creator_account_id_ == account_id
+                  or hasPermission(Role::kSetDetail))) {
+        return makeCommandError("SetAccountDetail", 2, str_args);
+      }
+      auto account = state_.state().accounts.get(account_id);
+      if (not account) {
+        return makeCommandError("SetAccountDetail", 3, str_args);
+      }
+      auto updated = *account;
+      updated.details[creator_account_id_][key] = value;
+      state_.putAccount(account_id, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::SetQuorum &command) {
+      auto &account_id = command.accountId();
+      const auto quorum = command.newQuorum();
+      auto str_args = [&account_id, quorum] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("quorum", std::to_string(quorum))
+            .finalize();
+      };
+
+      auto account = state_.state().accounts.get(account_id);
+      if (do_validation_) {
+        if (not hasRoleOrGrantedPermission(
+                Role::kSetQuorum, Grantable::kSetMyQuorum, account_id)) {
+          return makeCommandError("SetQuorum", 2, str_args);
+        }
+        if (not account or account->signatories.empty()) {
+          return makeCommandError("SetQuorum", 4, str_args);
+        }
+        if (quorum > account->signatories.size()) {
+          return makeCommandError("SetQuorum", 5, str_args);
+        }
+      }
+      if (not account) {
+        return makeCommandError("SetQuorum", 1, str_args);
+      }
+      auto updated = *account;
+      updated.quorum = quorum;
+      state_.putAccount(account_id, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::SubtractAssetQuantity &command) {
+      auto &asset_id = command.assetId();
+      auto amount = command.amount().toStringRepr();
+      const auto precision = command.amount().precision();
+      auto str_args = [&creator_account_id = creator_account_id_,
+                       &asset_id,
+                       &amount,
+                       precision] {
+        return getQueryArgsStringBuilder()
+            .append("creator_account_id", creator_account_id)
+            .append("asset_id", asset_id)
+            .append("amount", amount)
+            .append("precision", std::to_string(precision))
+            .finalize();
+      };
+      auto error = [&str_args](ErrorCode code) {
+        return makeCommandError("SubtractAssetQuantity", code, str_args);
+      };
+
+      if (do_validation_
+          and not hasPermission(Role::kSubtractAssetQty,
+                                Role::kSubtractDomainAssetQty,
+                                asset_id)) {
+        return error(2);
+      }
+      const auto &wsv = state_.state();
+      auto asset = wsv.assets.get(asset_id);
+      if (not asset or asset->precision < precision) {
+        return error(3);
+      }
+      auto account = wsv.accounts.get(creator_account_id_);
+      Balance balance;
+      if (account) {
+        auto it = account->assets.find(asset_id);
+        if (it != account->assets.end()) {
+          balance = it->second;
+        }
+      }
+      auto new_balance = balance.subtract(command.amount());
+      if (not new_balance) {
+        return error(4);
+      }
+      if (not account) {
+        return error(1);
+      }
+      auto updated = *account;
+      updated.assets[asset_id] = std::move(*new_balance);
+      state_.putAccount(creator_account_id_, std::move(updated));
+      return {};
+    }
+
+    CommandResult InMemoryCommandExecutor::operator()(
+        const shared_model::interface::TransferAsset &command) {
+      auto &src_account_id = command.srcAccountId();
+      auto &dest_account_id = command.destAccountId();
+      auto &asset_id = command.assetId();
+      auto amount = command.amount().toStringRepr();
+      const auto precision = command.amount().precision();
+      auto str_args =
+          [&src_account_id, &dest_account_id, &asset_id, &amount, precision] {
+            return getQueryArgsStringBuilder()
+                .append("src_account_id", src_account_id)
+                .append("dest_account_id", dest_account_id)
+                .append("asset_id", asset_id)
+                .append("amount", amount)
+                .append("precision", std::to_string(precision))
+                .finalize();
+          };
+      auto error = [&str_args](ErrorCode code) {
+        return makeCommandError("TransferAsset", code, str_args);
+      };
+
+      const auto &wsv = state_.state();
+      if (do_validation_) {
+        const bool can_transfer = creator_account_id_ != src_account_id
+            ? hasGrantedPermission(Grantable::kTransferMyAssets,
+                                   src_account_id)
+            : hasPermission(Role::kTransfer);
+        if (not wsv.accountPermissions(dest_account_id).test(Role::kReceive)
+            or not can_transfer) {
+          return error(2);
+        }
+      }
+      auto dest = wsv.accounts.get(dest_account_id);
+      if (not dest) {
+        return error(4);
+      }
+      auto src = wsv.accounts.get(src_account_id);
+      if (not src) {
+        return error(3);
+      }
+      auto asset = wsv.assets.get(asset_id);
+      if (not asset or asset->precision < precision) {
+        return error(5);
+      }
+      auto balanceOf = [&asset_id](const AccountRecord &account) {
+        auto it = account.assets.find(asset_id);
+        return it == account.assets.end() ? Balance() : it->second;
+      };
+      auto new_src_balance = balanceOf(*src).subtract(command.amount());
+      if (not new_src_balance) {
+        return error(6);
+      }
+      auto new_dest_balance = balanceOf(*dest).add(command.amount());
+      if (not new_dest_balance.lessThanPowerOfTwo(256 - precision)) {
+        return error(7);
+      }
+      // forbidden by stateless validation, and Postgres executor fails to
+      // update the same balance twice in one statement
+      if (src_account_id == dest_account_id) {
+        return error(1);
+      }
+      // both records are copied before the state is changed
+      auto updated_src = *src;
+      auto updated_dest = *dest;
+      updated_src.assets[asset_id] = std::move(*new_src_balance);
+      updated_dest.assets[asset_id] = std::move(new_dest_balance);
+      state_.putAccount(src_account_id, std::move(updated_src));
+      state_.putAccount(dest_account_id, std::move(updated_dest));
+      return {};
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_COMMAND_EXECUTOR_HPP
+#define IROHA_IN_MEMORY_COMMAND_EXECUTOR_HPP
+
+#include "ametsuchi/command_executor.hpp"
+
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class PermissionToString;
+  }
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Executes commands against in-memory WSV state. Checks and error codes
+     * are the same as of PostgresCommandExecutor, so a transaction gets the
+     * same result on both backends.
+     */
+    class InMemoryCommandExecutor : public CommandExecutor {
+     public:
+      InMemoryCommandExecutor(
+          MutableWsvState &state,
+          std::shared_ptr<shared_model::interface::PermissionToString>
+              perm_converter);
+
+      void setCreatorAccountId(
+          const shared_model::interface::types::AccountIdType
+              &creator_account_id) override;
+
+      void doValidation(bool do_validation) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddAssetQuantity &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddPeer &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddSignatory &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AppendRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateAccount &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateAsset &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateDomain &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::DetachRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::GrantPermission &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::RemoveSignatory &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::RevokePermission &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SetAccountDetail &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SetQuorum &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SubtractAssetQuantity &command)
+          override;
+
+      CommandResult operator()(
+          const shared_model::interface::TransferAsset &command) override;
+
+     private:
+      /**
+       * @return whether creator has the role permission
+       */
+      bool hasPermission(shared_model::interface::permissions::Role perm) const;
+
+      /**
+       * @return whether creator has the global permission, or the domain one
+       * if the asset is in the domain of creator
+       */
+      bool hasPermission(
+          shared_model::interface::permissions::Role global_perm,
+          shared_model::interface::permissions::Role domain_perm,
+          const shared_model::interface::types::AssetIdType &asset_id) const;
+
+      /**
+       * @return whether the account granted the permission to creator
+       */
+      bool hasGrantedPermission(
+          shared_model::interface::permissions::Grantable perm,
+          const shared_model::interface::types::AccountIdType &account_id)
+          const;
+
+      /**
+       * @return whether creator has the grantable permission from the
+       * account, or it is the account itself and has the role permission
+       */
+      bool hasRoleOrGrantedPermission(
+          shared_model::interface::permissions::Role role,
+          shared_model::interface::permissions::Grantable grantable,
+          const shared_model::interface::types::AccountIdType &account_id)
+          const;
+
+      MutableWsvState &state_;
+      std::shared_ptr<shared_model::interface::PermissionToString>
+          perm_converter_;
+      shared_model::interface::types::AccountIdType creator_account_id_;
+      bool do_validation_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_COMMAND_EXECUTOR_HPP
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_mutable_storage.hpp"
+
+#include <boost/variant/apply_visitor.hpp>
+#include "ametsuchi/impl/in_memory/in_memory_wsv_query.hpp"
+#include "ametsuchi/impl/peer_query_wsv.hpp"
+#include "interfaces/commands/command.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    InMemoryMutableStorage::InMemoryMutableStorage(
+        shared_model::interface::types::HashType top_hash,
+        std::shared_ptr<const WsvState> base,
+        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
+        std::shared_ptr<shared_model::interface::PermissionToString>
+            perm_converter)
+        : top_hash_(std::move(top_hash)),
+          state_(*base),
+          // the query does not own the state, which outlives it
+          peer_query_(std::make_unique<PeerQueryWsv>(
+              std::make_shared<InMemoryWsvQuery>(
+                  std::shared_ptr<const WsvState>(std::shared_ptr<void>(),
+                                                  &state_.state()),
+                  std::move(factory)))),
+          command_executor_(state_, std::move(perm_converter)),
+          log_(logger::log("InMemoryMutableStorage")) {}
+
+    bool InMemoryMutableStorage::apply(
+        const shared_model::interface::Block &block,
+        MutableStoragePredicate predicate) {
+      auto execute_transaction = [this](auto &transaction) {
+        command_executor_.setCreatorAccountId(transaction.creatorAccountId());
+        command_executor_.doValidation(false);
+
+        auto execute_command = [this](const auto &command) {
+          auto command_applied =
+              boost::apply_visitor(command_executor_, command.get());
+
+          return command_applied.match(
+              [](expected::Value<void> &) { return true; },
+              [&](expected::Error<CommandError> &e) {
+                log_->error(e.error.toString());
+                return false;
+              });
+        };
+
+        return std::all_of(transaction.commands().begin(),
+                           transaction.commands().end(),
+                           execute_command);
+      };
+
+      log_->info("Applying block: height {}, hash {}",
+                 block.height(),
+                 block.hash().hex());
+
+      auto block_applied = predicate(block, *peer_query_, top_hash_)
+          and std::all_of(block.transactions().begin(),
+                          block.transactions().end(),
+                          execute_transaction);
+      if (block_applied) {
+        block_store_.insert(std::make_pair(block.height(), clone(block)));
+        top_hash_ = block.hash();
+      }
+
+      return block_applied;
+    }
+
+    template <typename Function>
+    bool InMemoryMutableStorage::withSavepoint(Function &&function) {
+      const auto savepoint = state_.savepoint();
+
+      auto function_executed = std::forward<Function>(function)();
+
+      if (function_executed) {
+        state_.releaseSavepoint(savepoint);
+      } else {
+        state_.rollbackTo(savepoint);
+      }
+
+      return function_executed;
+    }
+
+    bool InMemoryMutableStorage::apply(
+        const shared_model::interface::Block &block) {
+      return withSavepoint([&] {
+        return this->apply(
+            block, [](const auto &, auto &, const auto &) { return true; });
+      });
+    }
+
+    bool InMemoryMutableStorage::apply(
+        rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+            blocks,
+        MutableStoragePredicate predicate) {
+      return withSavepoint([&] {
+        return blocks
+            .all([&](auto block) { return this->apply(*block, predicate); })
+            .as_blocking()
+            .first();
+      });
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
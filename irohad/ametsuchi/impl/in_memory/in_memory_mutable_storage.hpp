@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_MUTABLE_STORAGE_HPP
+#define IROHA_IN_MEMORY_MUTABLE_STORAGE_HPP
+
+#include "ametsuchi/mutable_storage.hpp"
+
+#include <map>
+
+#include "ametsuchi/impl/in_memory/in_memory_command_executor.hpp"
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+#include "interfaces/common_objects/common_objects_factory.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class InMemoryMutableStorage : public MutableStorage {
+      friend class InMemoryStorage;
+
+     public:
+      /**
+       * @param top_hash - hash of top block in block store
+       * @param base - committed state, which is copied and left unchanged
+       * @param factory - factory of common objects
+       * @param perm_converter - converter of permissions to strings
+       */
+      InMemoryMutableStorage(
+          shared_model::interface::types::HashType top_hash,
+          std::shared_ptr<const WsvState> base,
+          std::shared_ptr<shared_model::interface::CommonObjectsFactory>
+              factory,
+          std::shared_ptr<shared_model::interface::PermissionToString>
+              perm_converter);
+
+      bool apply(const shared_model::interface::Block &block) override;
+
+      bool apply(rxcpp::observable<
+                     std::shared_ptr<shared_model::interface::Block>> blocks,
+                 MutableStoragePredicate predicate) override;
+
+     private:
+      /**
+       * Performs a function inside savepoint, does a rollback if function
+       * returned false, and removes the savepoint otherwise. Returns function
+       * result
+       */
+      template <typename Function>
+      bool withSavepoint(Function &&function);
+
+      /**
+       * Verifies whether the block is applicable using predicate, and applies
+       * the block
+       */
+      bool apply(const shared_model::interface::Block &block,
+                 MutableStoragePredicate predicate);
+
+      shared_model::interface::types::HashType top_hash_;
+      // ordered collection is used to enforce block insertion order in
+      // InMemoryStorage::commit
+      std::map<uint32_t, std::shared_ptr<shared_model::interface::Block>>
+          block_store_;
+
+      MutableWsvState state_;
+      std::unique_ptr<PeerQuery> peer_query_;
+      InMemoryCommandExecutor command_executor_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_MUTABLE_STORAGE_HPP
@@ -0,0 +1,34 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_os_persistent_state.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    const size_t InMemoryOrderingServicePersistentState::kInitialProposalHeight;
+
+    InMemoryOrderingServicePersistentState::
+        InMemoryOrderingServicePersistentState()
+        : proposal_height_(kInitialProposalHeight) {}
+
+    bool InMemoryOrderingServicePersistentState::saveProposalHeight(
+        size_t height) {
+      proposal_height_ = height;
+      return true;
+    }
+
+    boost::optional<size_t>
+    InMemoryOrderingServicePersistentState::loadProposalHeight() const {
+      return proposal_height_.load();
+    }
+
+    bool InMemoryOrderingServicePersistentState::resetState() {
+      proposal_height_ = kInitialProposalHeight;
+      return true;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
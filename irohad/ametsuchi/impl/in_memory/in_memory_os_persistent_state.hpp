@@ -0,0 +1,41 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_OS_PERSISTENT_STATE_HPP
+#define IROHA_IN_MEMORY_OS_PERSISTENT_STATE_HPP
+
+#include "ametsuchi/ordering_service_persistent_state.hpp"
+
+#include <atomic>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Proposal height kept in memory, it starts from the initial value
+     * after restart, like a freshly created Postgres state
+     */
+    class InMemoryOrderingServicePersistentState
+        : public OrderingServicePersistentState {
+     public:
+      /// height of the first proposal
+      static const size_t kInitialProposalHeight = 2;
+
+      InMemoryOrderingServicePersistentState();
+
+      bool saveProposalHeight(size_t height) override;
+
+      boost::optional<size_t> loadProposalHeight() const override;
+
+      bool resetState() override;
+
+     private:
+      std::atomic<size_t> proposal_height_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_OS_PERSISTENT_STATE_HPP
@@ -0,0 +1,493 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_query_executor.hpp"
+
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+
+#include <boost/format.hpp>
+#include "cryptography/public_key.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/queries/blocks_query.hpp"
+#include "interfaces/queries/get_account.hpp"
+#include "interfaces/queries/get_account_asset_transactions.hpp"
+#include "interfaces/queries/get_account_assets.hpp"
+#include "interfaces/queries/get_account_detail.hpp"
+#include "interfaces/queries/get_account_transactions.hpp"
+#include "interfaces/queries/get_asset_info.hpp"
+#include "interfaces/queries/get_pending_transactions.hpp"
+#include "interfaces/queries/get_role_permissions.hpp"
+#include "interfaces/queries/get_roles.hpp"
+#include "interfaces/queries/get_signatories.hpp"
+#include "interfaces/queries/get_transactions.hpp"
+#include "interfaces/queries/query.hpp"
+#include "interfaces/queries/tx_pagination_meta.hpp"
+
+using namespace shared_model::interface::permissions;
+
+namespace {
+  shared_model::interface::types::DomainIdType getDomainFromName(
+      const shared_model::interface::types::AccountIdType &account_id) {
+    auto at = account_id.find('@');
+    return at == std::string::npos ? "" : account_id.substr(at + 1);
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    InMemoryQueryExecutor::InMemoryQueryExecutor(
+        std::shared_ptr<const WsvState> state,
+        KeyValueStorage &block_store,
+        std::shared_ptr<BlockCache> block_cache,
+        std::shared_ptr<const TxHashIndex> tx_hash_index,
+        std::shared_ptr<const InMemoryBlockIndex> block_index,
+        std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
+        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::QueryResponseFactory>
+            response_factory,
+        std::shared_ptr<shared_model::interface::PermissionToString>
+            perm_converter)
+        : state_(state),
+          visitor_(std::move(state),
+                   block_store,
+                   std::move(block_cache),
+                   std::move(tx_hash_index),
+                   std::move(block_index),
+                   std::move(pending_txs_storage),
+                   std::move(converter),
+                   std::move(response_factory),
+                   std::move(perm_converter)) {}
+
+    QueryExecutorResult InMemoryQueryExecutor::validateAndExecute(
+        const shared_model::interface::Query &query) {
+      visitor_.setCreatorId(query.creatorAccountId());
+      visitor_.setQueryHash(query.hash());
+      return boost::apply_visitor(visitor_, query.get());
+    }
+
+    bool InMemoryQueryExecutor::validate(
+        const shared_model::interface::BlocksQuery &query) {
+      return state_->accountPermissions(query.creatorAccountId())
+          .test(Role::kGetBlocks);
+    }
+
+    InMemoryQueryExecutorVisitor::InMemoryQueryExecutorVisitor(
+        std::shared_ptr<const WsvState> state,
+        KeyValueStorage &block_store,
+        std::shared_ptr<BlockCache> block_cache,
+        std::shared_ptr<const TxHashIndex> tx_hash_index,
+        std::shared_ptr<const InMemoryBlockIndex> block_index,
+        std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
+        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::QueryResponseFactory>
+            response_factory,
+        std::shared_ptr<shared_model::interface::PermissionToString>
+            perm_converter)
+        : state_(std::move(state)),
+          block_store_(block_store),
+          block_format_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
+          tx_hash_index_(std::move(tx_hash_index)),
+          block_index_(std::move(block_index)),
+          pending_txs_storage_(std::move(pending_txs_storage)),
+          query_response_factory_{std::move(response_factory)},
+          perm_converter_(std::move(perm_converter)),
+          log_(logger::log("InMemoryQueryExecutorVisitor")) {}
+
+    void InMemoryQueryExecutorVisitor::setCreatorId(
+        const shared_model::interface::types::AccountIdType &creator_id) {
+      creator_id_ = creator_id;
+    }
+
+    void InMemoryQueryExecutorVisitor::setQueryHash(
+        const shared_model::interface::types::HashType &query_hash) {
+      query_hash_ = query_hash;
+    }
+
+    bool InMemoryQueryExecutorVisitor::hasQueryPermission(
+        const shared_model::interface::types::AccountIdType &target_account,
+        Role my_permission,
+        Role all_permission,
+        Role domain_permission) const {
+      const auto permissions = state_->accountPermissions(creator_id_);
+      return (creator_id_ == target_account
+              and permissions.test(my_permission))
+          or permissions.test(all_permission)
+          or (getDomainFromName(creator_id_)
+                  == getDomainFromName(target_account)
+              and permissions.test(domain_permission));
+    }
+
+    std::unique_ptr<shared_model::interface::QueryResponse>
+    InMemoryQueryExecutorVisitor::notEnoughPermissionsResponse(
+        std::initializer_list<Role> roles) const {
+      std::string error = "user must have at least one of the permissions: ";
+      for (auto role : roles) {
+        error += perm_converter_->toString(role) + ", ";
+      }
+      return logAndReturnErrorResponse(
+          QueryErrorType::kStatefulFailed, error, 2);
+    }
+
+    std::unique_ptr<shared_model::interface::QueryResponse>
+    InMemoryQueryExecutorVisitor::logAndReturnErrorResponse(
+        QueryErrorType error_type,
+        QueryErrorMessageType error_body,
+        QueryErrorCodeType error_code) const {
+      std::string error;
+      switch (error_type) {
+        case QueryErrorType::kNoAccount:
+          error = "could find account with such id: " + error_body;
+          break;
+        case QueryErrorType::kNoSignatories:
+          error = "no signatories found in account with such id: " + error_body;
+          break;
+        case QueryErrorType::kNoAccountDetail:
+          error = "no details in account with such id: " + error_body;
+          break;
+        case QueryErrorType::kNoRoles:
+          error =
+              "no role with such name in account with such id: " + error_body;
+          break;
+        case QueryErrorType::kNoAsset:
+          error =
+              "no asset with such name in account with such id: " + error_body;
+          break;
+        default:
+          error = "failed to execute query: " + error_body;
+          break;
+      }
+
+      log_->error(error);
+      return query_response_factory_->createErrorQueryResponse(
+          error_type, error, error_code, query_hash_);
+    }
+
+    std::vector<std::unique_ptr<shared_model::interface::Transaction>>
+    InMemoryQueryExecutorVisitor::getTransactions(
+        const std::vector<InMemoryBlockIndex::Position> &positions) const {
+      std::vector<std::unique_ptr<shared_model::interface::Transaction>> result;
+      BlockCache::BlockPtr block;
+      for (const auto &position : positions) {
+        if (not block or block->height() != position.height) {
+          auto loaded_block = loadBlock(
+              position.height, block_store_, block_format_, block_cache_.get());
+          // boost::get of pointer returns pointer to requested type, or
+          // nullptr
+          if (auto e =
+                  boost::get<expected::Error<std::string>>(&loaded_block)) {
+            log_->error(e->error);
+            block = nullptr;
+            continue;
+          }
+          block = boost::get<expected::Value<BlockCache::BlockPtr>>(
+                      loaded_block)
+                      .value;
+        }
+        result.push_back(clone(block->transactions()[position.index]));
+      }
+      return result;
+    }
+
+    template <typename Query>
+    QueryExecutorResult InMemoryQueryExecutorVisitor::executeTransactionsQuery(
+        const Query &q,
+        const std::vector<InMemoryBlockIndex::Position> &positions,
+        Role my_permission,
+        Role all_permission,
+        Role domain_permission) {
+      if (not hasQueryPermission(q.accountId(),
+                                 my_permission,
+                                 all_permission,
+                                 domain_permission)) {
+        return notEnoughPermissionsResponse(
+            {my_permission, all_permission, domain_permission});
+      }
+
+      const auto &pagination_info = q.paginationMeta();
+      auto first_hash = pagination_info.firstTxHash();
+      // retrieve one extra transaction to populate next_hash
+      auto query_size = pagination_info.pageSize() + 1u;
+
+      // page starts from transaction with the hash, which may be any
+      // committed transaction, or from the first transaction in the ledger
+      auto begin = positions.begin();
+      if (first_hash) {
+        auto entry = tx_hash_index_->find(*first_hash);
+        if (entry and entry->committed) {
+          begin = std::lower_bound(
+              positions.begin(),
+              positions.end(),
+              InMemoryBlockIndex::Position{entry->height, entry->index});
+        } else {
+          begin = positions.end();
+        }
+      }
+      auto end = begin
+          + std::min<size_t>(query_size, std::distance(begin, positions.end()));
+
+      auto response_txs = getTransactions({begin, end});
+      // If 0 transactions are returned, we assume that hash is invalid.
+      // Since query with valid hash is guaranteed to return at least one
+      // transaction
+      if (first_hash and response_txs.empty()) {
+        auto error = (boost::format("invalid pagination hash: %s")
+                      % first_hash->hex())
+                         .str();
+        return this->logAndReturnErrorResponse(
+            QueryErrorType::kStatefulFailed, error, 4);
+      }
+
+      // if the number of returned transactions is equal to the
+      // page size + 1, it means that the last transaction is the
+      // first one in the next page and we need to return it as
+      // the next hash
+      if (response_txs.size() == query_size) {
+        auto next_hash = response_txs.back()->hash();
+        response_txs.pop_back();
+        return query_response_factory_->createTransactionsPageResponse(
+            std::move(response_txs), next_hash, positions.size(), query_hash_);
+      }
+
+      return query_response_factory_->createTransactionsPageResponse(
+          std::move(response_txs), positions.size(), query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetAccount &q) {
+      if (not hasQueryPermission(q.accountId(),
+                                 Role::kGetMyAccount,
+                                 Role::kGetAllAccounts,
+                                 Role::kGetDomainAccounts)) {
+        return notEnoughPermissionsResponse({Role::kGetMyAccount,
+                                             Role::kGetAllAccounts,
+                                             Role::kGetDomainAccounts});
+      }
+
+      auto account = state_->accounts.get(q.accountId());
+      // account without roles is not found by Postgres query as well
+      if (not account or account->roles.empty()) {
+        return this->logAndReturnErrorResponse(
+            QueryErrorType::kNoAccount, q.accountId(), 0);
+      }
+      return query_response_factory_->createAccountResponse(
+          q.accountId(),
+          account->domain_id,
+          account->quorum,
+          detailsJson(account->details),
+          account->roles,
+          query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetSignatories &q) {
+      if (not hasQueryPermission(q.accountId(),
+                                 Role::kGetMySignatories,
+                                 Role::kGetAllSignatories,
+                                 Role::kGetDomainSignatories)) {
+        return notEnoughPermissionsResponse({Role::kGetMySignatories,
+                                             Role::kGetAllSignatories,
+                                             Role::kGetDomainSignatories});
+      }
+
+      auto account = state_->accounts.get(q.accountId());
+      if (not account or account->signatories.empty()) {
+        return this->logAndReturnErrorResponse(
+            QueryErrorType::kNoSignatories, q.accountId(), 0);
+      }
+      std::vector<shared_model::interface::types::PubkeyType> pubkeys;
+      for (const auto &public_key : account->signatories) {
+        pubkeys.emplace_back(
+            shared_model::crypto::Blob::fromHexString(public_key));
+      }
+      return query_response_factory_->createSignatoriesResponse(pubkeys,
+                                                                query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetAccountTransactions &q) {
+      return executeTransactionsQuery(
+          q,
+          block_index_->creatorPositions(q.accountId()),
+          Role::kGetMyAccTxs,
+          Role::kGetAllAccTxs,
+          Role::kGetDomainAccTxs);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetTransactions &q) {
+      const auto permissions = state_->accountPermissions(creator_id_);
+      const bool my_perm = permissions.test(Role::kGetMyTxs);
+      const bool all_perm = permissions.test(Role::kGetAllTxs);
+      if (not my_perm and not all_perm) {
+        return notEnoughPermissionsResponse(
+            {Role::kGetMyTxs, Role::kGetAllTxs});
+      }
+
+      std::map<shared_model::interface::types::HeightType,
+               std::unordered_set<std::string>>
+          index;
+      for (const auto &hash : q.transactionHashes()) {
+        auto entry = tx_hash_index_->find(hash);
+        if (entry and entry->committed) {
+          index[entry->height].insert(hash.hex());
+        }
+      }
+
+      std::vector<std::unique_ptr<shared_model::interface::Transaction>>
+          response_txs;
+      for (const auto &block : index) {
+        auto loaded_block = loadBlock(
+            block.first, block_store_, block_format_, block_cache_.get());
+        if (auto e = boost::get<expected::Error<std::string>>(&loaded_block)) {
+          log_->error(e->error);
+          continue;
+        }
+        const auto &transactions =
+            boost::get<expected::Value<BlockCache::BlockPtr>>(loaded_block)
+                .value->transactions();
+        for (const auto &tx : transactions) {
+          if (block.second.count(tx.hash().hex()) > 0
+              and (all_perm
+                   or (my_perm and tx.creatorAccountId() == creator_id_))) {
+            response_txs.push_back(clone(tx));
+          }
+        }
+      }
+
+      return query_response_factory_->createTransactionsResponse(
+          std::move(response_txs), query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetAccountAssetTransactions &q) {
+      return executeTransactionsQuery(
+          q,
+          block_index_->accountAssetPositions(q.accountId(), q.assetId()),
+          Role::kGetMyAccAstTxs,
+          Role::kGetAllAccAstTxs,
+          Role::kGetDomainAccAstTxs);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetAccountAssets &q) {
+      if (not hasQueryPermission(q.accountId(),
+                                 Role::kGetMyAccAst,
+                                 Role::kGetAllAccAst,
+                                 Role::kGetDomainAccAst)) {
+        return notEnoughPermissionsResponse({Role::kGetMyAccAst,
+                                             Role::kGetAllAccAst,
+                                             Role::kGetDomainAccAst});
+      }
+
+      std::vector<std::tuple<shared_model::interface::types::AccountIdType,
+                             shared_model::interface::types::AssetIdType,
+                             shared_model::interface::Amount>>
+          assets;
+      if (auto account = state_->accounts.get(q.accountId())) {
+        for (const auto &balance : account->assets) {
+          assets.push_back(std::make_tuple(
+              q.accountId(),
+              balance.first,
+              shared_model::interface::Amount(balance.second.toString())));
+        }
+      }
+      return query_response_factory_->createAccountAssetResponse(assets,
+                                                                 query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetAccountDetail &q) {
+      if (not hasQueryPermission(q.accountId(),
+                                 Role::kGetMyAccDetail,
+                                 Role::kGetAllAccDetail,
+                                 Role::kGetDomainAccDetail)) {
+        return notEnoughPermissionsResponse({Role::kGetMyAccDetail,
+                                             Role::kGetAllAccDetail,
+                                             Role::kGetDomainAccDetail});
+      }
+
+      auto account = state_->accounts.get(q.accountId());
+      auto json = selectDetails(
+          account.get(), q.key().value_or(""), q.writer().value_or(""));
+      if (not json) {
+        return this->logAndReturnErrorResponse(
+            QueryErrorType::kNoAccountDetail, q.accountId(), 0);
+      }
+      return query_response_factory_->createAccountDetailResponse(
+          *json, query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetRoles &q) {
+      if (not state_->accountPermissions(creator_id_).test(Role::kGetRoles)) {
+        return notEnoughPermissionsResponse({Role::kGetRoles});
+      }
+
+      std::vector<shared_model::interface::types::RoleIdType> roles;
+      state_->roles.forEach(
+          [&roles](const auto &role_id, const auto &) {
+            roles.push_back(role_id);
+          });
+      std::sort(roles.begin(), roles.end());
+      return query_response_factory_->createRolesResponse(roles, query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetRolePermissions &q) {
+      if (not state_->accountPermissions(creator_id_).test(Role::kGetRoles)) {
+        return notEnoughPermissionsResponse({Role::kGetRoles});
+      }
+
+      auto permissions = state_->roles.get(q.roleId());
+      if (not permissions) {
+        return this->logAndReturnErrorResponse(
+            QueryErrorType::kNoRoles,
+            "{" + q.roleId() + ", " + creator_id_ + "}",
+            0);
+      }
+      return query_response_factory_->createRolePermissionsResponse(
+          *permissions, query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetAssetInfo &q) {
+      if (not state_->accountPermissions(creator_id_)
+                  .test(Role::kReadAssets)) {
+        return notEnoughPermissionsResponse({Role::kReadAssets});
+      }
+
+      auto asset = state_->assets.get(q.assetId());
+      if (not asset) {
+        return this->logAndReturnErrorResponse(
+            QueryErrorType::kNoAsset,
+            "{" + q.assetId() + ", " + creator_id_ + "}",
+            0);
+      }
+      return query_response_factory_->createAssetResponse(
+          q.assetId(), asset->domain_id, asset->precision, query_hash_);
+    }
+
+    QueryExecutorResult InMemoryQueryExecutorVisitor::operator()(
+        const shared_model::interface::GetPendingTransactions &q) {
+      std::vector<std::unique_ptr<shared_model::interface::Transaction>>
+          response_txs;
+      auto interface_txs =
+          pending_txs_storage_->getPendingTransactions(creator_id_);
+      response_txs.reserve(interface_txs.size());
+
+      std::transform(interface_txs.begin(),
+                     interface_txs.end(),
+                     std::back_inserter(response_txs),
+                     [](auto &tx) { return clone(*tx); });
+      return query_response_factory_->createTransactionsResponse(
+          std::move(response_txs), query_hash_);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
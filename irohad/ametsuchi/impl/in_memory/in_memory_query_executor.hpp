@@ -0,0 +1,183 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_QUERY_EXECUTOR_HPP
+#define IROHA_IN_MEMORY_QUERY_EXECUTOR_HPP
+
+#include "ametsuchi/query_executor.hpp"
+
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_block_index.hpp"
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+#include "ametsuchi/impl/postgres_query_executor.hpp"
+#include "ametsuchi/impl/tx_hash_index.hpp"
+#include "interfaces/iroha_internal/query_response_factory.hpp"
+#include "interfaces/permission_to_string.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Executes queries against in-memory WSV state and block store, with
+     * the same permission checks and responses as
+     * PostgresQueryExecutorVisitor
+     */
+    class InMemoryQueryExecutorVisitor
+        : public boost::static_visitor<QueryExecutorResult> {
+     public:
+      InMemoryQueryExecutorVisitor(
+          std::shared_ptr<const WsvState> state,
+          KeyValueStorage &block_store,
+          std::shared_ptr<BlockCache> block_cache,
+          std::shared_ptr<const TxHashIndex> tx_hash_index,
+          std::shared_ptr<const InMemoryBlockIndex> block_index,
+          std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
+          std::shared_ptr<shared_model::interface::BlockJsonConverter>
+              converter,
+          std::shared_ptr<shared_model::interface::QueryResponseFactory>
+              response_factory,
+          std::shared_ptr<shared_model::interface::PermissionToString>
+              perm_converter);
+
+      void setCreatorId(
+          const shared_model::interface::types::AccountIdType &creator_id);
+
+      void setQueryHash(const shared_model::crypto::Hash &query_hash);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetAccount &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetSignatories &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetAccountTransactions &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetTransactions &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetAccountAssetTransactions &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetAccountAssets &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetAccountDetail &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetRoles &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetRolePermissions &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetAssetInfo &q);
+
+      QueryExecutorResult operator()(
+          const shared_model::interface::GetPendingTransactions &q);
+
+     private:
+      /**
+       * @return whether creator has the permission for the target account:
+       * own permission for itself, domain permission for accounts of the
+       * same domain, or the permission for all accounts
+       */
+      bool hasQueryPermission(
+          const shared_model::interface::types::AccountIdType &target_account,
+          shared_model::interface::permissions::Role my_permission,
+          shared_model::interface::permissions::Role all_permission,
+          shared_model::interface::permissions::Role domain_permission) const;
+
+      /**
+       * @return response about lack of any of given permissions
+       */
+      std::unique_ptr<shared_model::interface::QueryResponse>
+      notEnoughPermissionsResponse(
+          std::initializer_list<shared_model::interface::permissions::Role>
+              roles) const;
+
+      /**
+       * Create a query error response and log it
+       * @param error_type - type of query error
+       * @param error_body - stringified error of the query
+       * @param error_code of the query
+       * @return ptr to created error response
+       */
+      std::unique_ptr<shared_model::interface::QueryResponse>
+      logAndReturnErrorResponse(QueryErrorType error_type,
+                                QueryErrorMessageType error_body,
+                                QueryErrorCodeType error_code) const;
+
+      /**
+       * @return transactions at given positions, which are in order
+       */
+      std::vector<std::unique_ptr<shared_model::interface::Transaction>>
+      getTransactions(
+          const std::vector<InMemoryBlockIndex::Position> &positions) const;
+
+      /**
+       * Execute query which returns a page of transactions
+       * @param query - query object
+       * @param positions - positions of transactions relevant to the query
+       * @param perms - permissions, necessary to execute the query
+       * @return Result of a query execution
+       */
+      template <typename Query>
+      QueryExecutorResult executeTransactionsQuery(
+          const Query &query,
+          const std::vector<InMemoryBlockIndex::Position> &positions,
+          shared_model::interface::permissions::Role my_permission,
+          shared_model::interface::permissions::Role all_permission,
+          shared_model::interface::permissions::Role domain_permission);
+
+      std::shared_ptr<const WsvState> state_;
+      KeyValueStorage &block_store_;
+      BlockStorageFormat block_format_;
+      std::shared_ptr<BlockCache> block_cache_;
+      std::shared_ptr<const TxHashIndex> tx_hash_index_;
+      std::shared_ptr<const InMemoryBlockIndex> block_index_;
+      shared_model::interface::types::AccountIdType creator_id_;
+      shared_model::interface::types::HashType query_hash_;
+      std::shared_ptr<PendingTransactionStorage> pending_txs_storage_;
+      std::shared_ptr<shared_model::interface::QueryResponseFactory>
+          query_response_factory_;
+      std::shared_ptr<shared_model::interface::PermissionToString>
+          perm_converter_;
+      logger::Logger log_;
+    };
+
+    class InMemoryQueryExecutor : public QueryExecutor {
+     public:
+      InMemoryQueryExecutor(
+          std::shared_ptr<const WsvState> state,
+          KeyValueStorage &block_store,
+          std::shared_ptr<BlockCache> block_cache,
+          std::shared_ptr<const TxHashIndex> tx_hash_index,
+          std::shared_ptr<const InMemoryBlockIndex> block_index,
+          std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
+          std::shared_ptr<shared_model::interface::BlockJsonConverter>
+              converter,
+          std::shared_ptr<shared_model::interface::QueryResponseFactory>
+              response_factory,
+          std::shared_ptr<shared_model::interface::PermissionToString>
+              perm_converter);
+
+      QueryExecutorResult validateAndExecute(
+          const shared_model::interface::Query &query) override;
+
+      bool validate(const shared_model::interface::BlocksQuery &query) override;
+
+     private:
+      std::shared_ptr<const WsvState> state_;
+      InMemoryQueryExecutorVisitor visitor_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_QUERY_EXECUTOR_HPP
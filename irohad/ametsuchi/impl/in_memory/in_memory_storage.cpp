@@ -0,0 +1,346 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_storage.hpp"
+
+#include "ametsuchi/impl/in_memory/in_memory_block_query.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_mutable_storage.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_os_persistent_state.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_query_executor.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_temporary_wsv.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_wsv_query.hpp"
+#include "ametsuchi/impl/peer_query_wsv.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    const size_t InMemoryStorage::kBlockCacheSize;
+
+    InMemoryStorage::InMemoryStorage(
+        std::unique_ptr<KeyValueStorage> block_store,
+        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
+        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::PermissionToString>
+            perm_converter)
+        : block_store_(std::move(block_store)),
+          block_cache_(std::make_shared<BlockCache>(kBlockCacheSize)),
+          tx_hash_index_(std::make_shared<TxHashIndex>()),
+          block_index_(std::make_shared<InMemoryBlockIndex>()),
+          os_state_(std::make_shared<InMemoryOrderingServicePersistentState>()),
+          factory_(std::move(factory)),
+          converter_(std::move(converter)),
+          block_format_(converter_),
+          perm_converter_(std::move(perm_converter)),
+          log_(logger::log("InMemoryStorage")),
+          committed_state_(std::make_shared<const WsvState>()) {}
+
+    expected::Result<std::shared_ptr<InMemoryStorage>, std::string>
+    InMemoryStorage::create(
+        std::string block_store_dir,
+        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
+        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::PermissionToString>
+            perm_converter,
+        BlockStorageType block_storage_type,
+        SyncOptions block_store_sync) {
+      auto block_store = createBlockStore(block_store_dir,
+                                          BlockStorageFormat(converter),
+                                          block_storage_type,
+                                          block_store_sync);
+      if (auto error = boost::get<expected::Error<std::string>>(&block_store)) {
+        return *error;
+      }
+      return expected::makeValue(std::shared_ptr<InMemoryStorage>(
+          new InMemoryStorage(
+              std::move(
+                  boost::get<expected::Value<std::unique_ptr<KeyValueStorage>>>(
+                      block_store)
+                      .value),
+              std::move(factory),
+              std::move(converter),
+              std::move(perm_converter))));
+    }
+
+    std::shared_ptr<const WsvState> InMemoryStorage::committedState() const {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      return committed_state_;
+    }
+
+    expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
+    InMemoryStorage::createTemporaryWsv() {
+      return expected::makeValue<std::unique_ptr<TemporaryWsv>>(
+          std::make_unique<InMemoryTemporaryWsv>(committedState(),
+                                                 perm_converter_));
+    }
+
+    expected::Result<std::unique_ptr<MutableStorage>, std::string>
+    InMemoryStorage::createMutableStorage() {
+      {
+        // state is about to be changed, so prepared one is not needed
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        prepared_base_ = nullptr;
+        prepared_state_ = nullptr;
+      }
+      auto block_result = getBlockQuery()->getTopBlock();
+      return expected::makeValue<std::unique_ptr<MutableStorage>>(
+          std::make_unique<InMemoryMutableStorage>(
+              block_result.match(
+                  [](expected::Value<
+                      std::shared_ptr<shared_model::interface::Block>> &block) {
+                    return block.value->hash();
+                  },
+                  [](expected::Error<std::string> &) {
+                    return shared_model::interface::types::HashType("");
+                  }),
+              committedState(),
+              factory_,
+              perm_converter_));
+    }
+
+    boost::optional<std::shared_ptr<PeerQuery>>
+    InMemoryStorage::createPeerQuery() const {
+      return boost::make_optional<std::shared_ptr<PeerQuery>>(
+          std::make_shared<PeerQueryWsv>(getWsvQuery()));
+    }
+
+    boost::optional<std::shared_ptr<BlockQuery>>
+    InMemoryStorage::createBlockQuery() const {
+      return boost::make_optional(getBlockQuery());
+    }
+
+    boost::optional<std::shared_ptr<OrderingServicePersistentState>>
+    InMemoryStorage::createOsPersistentState() const {
+      return boost::make_optional<
+          std::shared_ptr<OrderingServicePersistentState>>(os_state_);
+    }
+
+    boost::optional<std::shared_ptr<QueryExecutor>>
+    InMemoryStorage::createQueryExecutor(
+        std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
+        std::shared_ptr<shared_model::interface::QueryResponseFactory>
+            response_factory) const {
+      return boost::make_optional<std::shared_ptr<QueryExecutor>>(
+          std::make_shared<InMemoryQueryExecutor>(
+              committedState(),
+              *block_store_,
+              block_cache_,
+              tx_hash_index_,
+              block_index_,
+              std::move(pending_txs_storage),
+              converter_,
+              std::move(response_factory),
+              perm_converter_));
+    }
+
+    bool InMemoryStorage::insertBlock(
+        const shared_model::interface::Block &block) {
+      log_->info("create mutable storage");
+      auto storageResult = createMutableStorage();
+      bool inserted = false;
+      storageResult.match(
+          [&](expected::Value<std::unique_ptr<ametsuchi::MutableStorage>>
+                  &storage) {
+            inserted = storage.value->apply(block);
+            log_->info("block inserted: {}", inserted);
+            commit(std::move(storage.value));
+          },
+          [&](expected::Error<std::string> &error) {
+            log_->error(error.error);
+          });
+
+      return inserted;
+    }
+
+    bool InMemoryStorage::insertBlocks(
+        const std::vector<std::shared_ptr<shared_model::interface::Block>>
+            &blocks) {
+      log_->info("create mutable storage");
+      bool inserted = true;
+      auto storageResult = createMutableStorage();
+      storageResult.match(
+          [&](iroha::expected::Value<std::unique_ptr<MutableStorage>>
+                  &mutableStorage) {
+            std::for_each(blocks.begin(), blocks.end(), [&](auto block) {
+              inserted &= mutableStorage.value->apply(*block);
+            });
+            commit(std::move(mutableStorage.value));
+          },
+          [&](iroha::expected::Error<std::string> &error) {
+            log_->error(error.error);
+            inserted = false;
+          });
+
+      log_->info("insert blocks finished");
+      return inserted;
+    }
+
+    void InMemoryStorage::reset() {
+      resetWsv();
+
+      log_->info("drop blocks from disk");
+      block_store_->dropAll();
+      block_cache_->clear();
+      tx_hash_index_->clear();
+    }
+
+    void InMemoryStorage::resetWsv() {
+      log_->info("drop wsv state");
+      {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        committed_state_ = std::make_shared<const WsvState>();
+        prepared_base_ = nullptr;
+        prepared_state_ = nullptr;
+      }
+      block_index_->clear();
+    }
+
+    shared_model::interface::types::HeightType
+    InMemoryStorage::loadWsvSnapshot() {
+      return 0;
+    }
+
+    void InMemoryStorage::dropStorage() {
+      log_->info("drop storage");
+      reset();
+      os_state_->resetState();
+    }
+
+    void InMemoryStorage::freeConnections() {}
+
+    void InMemoryStorage::commit(
+        std::unique_ptr<MutableStorage> mutableStorage) {
+      auto storage_ptr = std::move(mutableStorage);  // get ownership of storage
+      auto storage = static_cast<InMemoryMutableStorage *>(storage_ptr.get());
+      std::vector<std::shared_ptr<shared_model::interface::Block>> blocks;
+      for (const auto &block : storage->block_store_) {
+        blocks.push_back(block.second);
+      }
+      auto state = std::make_shared<const WsvState>(
+          std::move(storage->state_).release());
+      commitState(std::move(state), blocks);
+    }
+
+    bool InMemoryStorage::commitPrepared(
+        const shared_model::interface::Block &block) {
+      std::shared_ptr<const WsvState> state;
+      {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (prepared_state_ and prepared_base_ == committed_state_) {
+          state = std::move(prepared_state_);
+        }
+        prepared_base_ = nullptr;
+        prepared_state_ = nullptr;
+      }
+      if (not state) {
+        log_->info("there are no prepared blocks");
+        return false;
+      }
+      log_->info("applying prepared block");
+      return commitState(std::move(state), {clone(block)});
+    }
+
+    bool InMemoryStorage::commitState(
+        std::shared_ptr<const WsvState> state,
+        const std::vector<std::shared_ptr<shared_model::interface::Block>>
+            &blocks) {
+      // state is rebuilt only from stored blocks, so it must not get ahead
+      // of them
+      for (const auto &block : blocks) {
+        if (not storeBlock(*block)) {
+          log_->error("cannot store block {}, WSV is not committed",
+                      block->height());
+          return false;
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        committed_state_ = std::move(state);
+      }
+      for (const auto &block : blocks) {
+        block_index_->index(*block);
+        tx_hash_index_->insert(*block);
+        notifier_.get_subscriber().on_next(block);
+      }
+      return true;
+    }
+
+    std::shared_ptr<WsvQuery> InMemoryStorage::getWsvQuery() const {
+      return std::make_shared<InMemoryWsvQuery>(committedState(), factory_);
+    }
+
+    std::shared_ptr<BlockQuery> InMemoryStorage::getBlockQuery() const {
+      return std::make_shared<InMemoryBlockQuery>(*block_store_,
+                                                  converter_,
+                                                  block_cache_,
+                                                  tx_hash_index_,
+                                                  block_index_);
+    }
+
+    rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+    InMemoryStorage::on_commit() {
+      return notifier_.get_observable();
+    }
+
+    std::shared_ptr<const TxHashIndex> InMemoryStorage::txHashIndex() const {
+      return tx_hash_index_;
+    }
+
+    void InMemoryStorage::prepareBlock(std::unique_ptr<TemporaryWsv> wsv) {
+      auto &wsv_impl = static_cast<InMemoryTemporaryWsv &>(*wsv);
+      auto state = std::make_shared<const WsvState>(
+          std::move(wsv_impl.state_).release());
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      prepared_base_ = wsv_impl.base_;
+      prepared_state_ = std::move(state);
+      log_->info("state prepared successfully");
+    }
+
+    bool InMemoryStorage::storeBlock(
+        const shared_model::interface::Block &block) {
+      // blocks applied again while WSV is restored are already in block
+      // store, any other block of a stored height is rejected
+      if (block.height() <= block_store_->last_id()) {
+        auto stored = block_store_->get(block.height());
+        if (not stored) {
+          log_->error("cannot read stored block {}", block.height());
+          return false;
+        }
+        auto stored_block = block_format_.deserialize(*stored);
+        return stored_block.match(
+            [this, &block](const expected::Value<
+                           std::unique_ptr<shared_model::interface::Block>>
+                               &v) {
+              if (v.value->hash() != block.hash()) {
+                log_->error("block {} differs from the stored one",
+                            block.height());
+                return false;
+              }
+              return true;
+            },
+            [this](const expected::Error<std::string> &e) {
+              log_->error(e.error);
+              return false;
+            });
+      }
+      auto serialized_block = block_format_.serialize(block);
+      return serialized_block.match(
+          [this, &block](const expected::Value<BlockStorageFormat::Bytes> &v) {
+            if (not block_store_->add(block.height(), v.value)) {
+              log_->error("cannot write block {}", block.height());
+              return false;
+            }
+            // committed block is the most likely to be requested next, e.g.
+            // as top block by simulator and mutable storage
+            block_cache_->put(clone(block), v.value.size());
+            return true;
+          },
+          [this](const expected::Error<std::string> &e) {
+            log_->error(e.error);
+            return false;
+          });
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,191 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_STORAGE_HPP
+#define IROHA_IN_MEMORY_STORAGE_HPP
+
+#include "ametsuchi/storage.hpp"
+
+#include <mutex>
+
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_block_index.hpp"
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+#include "ametsuchi/impl/tx_hash_index.hpp"
+#include "ametsuchi/key_value_storage.hpp"
+#include "interfaces/common_objects/common_objects_factory.hpp"
+#include "interfaces/iroha_internal/block_json_converter.hpp"
+#include "interfaces/permission_to_string.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class InMemoryOrderingServicePersistentState;
+
+    /**
+     * Storage which keeps WSV and block indexes in memory, and only blocks
+     * on disk. WSV is not persisted, it is restored from block store on
+     * start, so the storage needs no database and validates and commits
+     * blocks faster than StorageImpl.
+     *
+     * Committed state is immutable and replaced as a whole on commit, so
+     * queries work on a consistent snapshot without locking, and temporary
+     * and mutable storages make a cheap copy of it.
+     */
+    class InMemoryStorage : public Storage {
+     public:
+      /// total size of block records kept decoded in block cache
+      static const size_t kBlockCacheSize = 64 * 1024 * 1024;
+
+      static expected::Result<std::shared_ptr<InMemoryStorage>, std::string>
+      create(std::string block_store_dir,
+             std::shared_ptr<shared_model::interface::CommonObjectsFactory>
+                 factory,
+             std::shared_ptr<shared_model::interface::BlockJsonConverter>
+                 converter,
+             std::shared_ptr<shared_model::interface::PermissionToString>
+                 perm_converter,
+             BlockStorageType block_storage_type = BlockStorageType::kFlatFile,
+             SyncOptions block_store_sync = SyncOptions());
+
+      expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
+      createTemporaryWsv() override;
+
+      expected::Result<std::unique_ptr<MutableStorage>, std::string>
+      createMutableStorage() override;
+
+      boost::optional<std::shared_ptr<PeerQuery>> createPeerQuery()
+          const override;
+
+      boost::optional<std::shared_ptr<BlockQuery>> createBlockQuery()
+          const override;
+
+      boost::optional<std::shared_ptr<OrderingServicePersistentState>>
+      createOsPersistentState() const override;
+
+      boost::optional<std::shared_ptr<QueryExecutor>> createQueryExecutor(
+          std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
+          std::shared_ptr<shared_model::interface::QueryResponseFactory>
+              response_factory) const override;
+
+      bool insertBlock(const shared_model::interface::Block &block) override;
+
+      bool insertBlocks(
+          const std::vector<std::shared_ptr<shared_model::interface::Block>>
+              &blocks) override;
+
+      void reset() override;
+
+      void resetWsv() override;
+
+      /**
+       * WSV snapshots are not supported, state is always restored from
+       * blocks
+       * @return 0
+       */
+      shared_model::interface::types::HeightType loadWsvSnapshot() override;
+
+      void dropStorage() override;
+
+      void freeConnections() override;
+
+      void commit(std::unique_ptr<MutableStorage> mutableStorage) override;
+
+      bool commitPrepared(const shared_model::interface::Block &block) override;
+
+      std::shared_ptr<WsvQuery> getWsvQuery() const override;
+
+      std::shared_ptr<BlockQuery> getBlockQuery() const override;
+
+      rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+      on_commit() override;
+
+      /**
+       * @return index of all transaction hashes in the ledger, updated on
+       * every commit
+       */
+      std::shared_ptr<const TxHashIndex> txHashIndex() const;
+
+      /**
+       * Keep state of temporary WSV to commit the block it was validated
+       * for with commitPrepared, if nothing is committed in between
+       */
+      void prepareBlock(std::unique_ptr<TemporaryWsv> wsv) override;
+
+     private:
+      InMemoryStorage(
+          std::unique_ptr<KeyValueStorage> block_store,
+          std::shared_ptr<shared_model::interface::CommonObjectsFactory>
+              factory,
+          std::shared_ptr<shared_model::interface::BlockJsonConverter>
+              converter,
+          std::shared_ptr<shared_model::interface::PermissionToString>
+              perm_converter);
+
+      /**
+       * @return current committed state
+       */
+      std::shared_ptr<const WsvState> committedState() const;
+
+      /**
+       * Add blocks to block store, then make the state they lead to
+       * committed, add blocks to indexes and notify about them. The state
+       * is not committed if a block is not stored
+       * @return true if all blocks are stored
+       */
+      bool commitState(
+          std::shared_ptr<const WsvState> state,
+          const std::vector<std::shared_ptr<shared_model::interface::Block>>
+              &blocks);
+
+      /**
+       * add block to block storage, a block of a stored height must be the
+       * same as the stored one
+       * @return true if the block is stored
+       */
+      bool storeBlock(const shared_model::interface::Block &block);
+
+      std::unique_ptr<KeyValueStorage> block_store_;
+
+      std::shared_ptr<BlockCache> block_cache_;
+
+      std::shared_ptr<TxHashIndex> tx_hash_index_;
+
+      std::shared_ptr<InMemoryBlockIndex> block_index_;
+
+      std::shared_ptr<InMemoryOrderingServicePersistentState> os_state_;
+
+      std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
+
+      rxcpp::subjects::subject<std::shared_ptr<shared_model::interface::Block>>
+          notifier_;
+
+      std::shared_ptr<shared_model::interface::BlockJsonConverter> converter_;
+
+      BlockStorageFormat block_format_;
+
+      std::shared_ptr<shared_model::interface::PermissionToString>
+          perm_converter_;
+
+      logger::Logger log_;
+
+      /// guards committed and prepared states
+      mutable std::mutex state_mutex_;
+
+      std::shared_ptr<const WsvState> committed_state_;
+
+      /// committed state prepared block was validated against
+      std::shared_ptr<const WsvState> prepared_base_;
+
+      /// state with prepared block applied, nullptr if there is none
+      std::shared_ptr<const WsvState> prepared_state_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_STORAGE_HPP
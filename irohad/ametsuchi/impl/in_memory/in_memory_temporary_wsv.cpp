@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_temporary_wsv.hpp"
+
+#include <algorithm>
+
+#include <boost/range/size.hpp>
+#include "cryptography/public_key.hpp"
+#include "interfaces/commands/command.hpp"
+#include "interfaces/permission_to_string.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    InMemoryTemporaryWsv::InMemoryTemporaryWsv(
+        std::shared_ptr<const WsvState> base,
+        std::shared_ptr<shared_model::interface::PermissionToString>
+            perm_converter)
+        : base_(std::move(base)),
+          state_(*base_),
+          command_executor_(state_, std::move(perm_converter)),
+          log_(logger::log("InMemoryTemporaryWsv")) {}
+
+    expected::Result<void, validation::CommandError>
+    InMemoryTemporaryWsv::validateSignatures(
+        const shared_model::interface::Transaction &transaction) {
+      auto account =
+          state_.state().accounts.get(transaction.creatorAccountId());
+      auto is_signatory = [&account](const auto &signature) {
+        return std::find(account->signatories.begin(),
+                         account->signatories.end(),
+                         signature.publicKey().hex())
+            != account->signatories.end();
+      };
+      const auto &signatures = transaction.signatures();
+      if (account
+          and std::all_of(signatures.begin(), signatures.end(), is_signatory)
+          and boost::size(signatures) >= account->quorum) {
+        return {};
+      }
+      auto error_str = "Transaction " + transaction.toString()
+          + " failed signatures validation";
+      return expected::makeError(validation::CommandError{
+          "signatures validation", 2, error_str, false});
+    }
+
+    expected::Result<void, validation::CommandError>
+    InMemoryTemporaryWsv::apply(
+        const shared_model::interface::Transaction &transaction) {
+      command_executor_.setCreatorAccountId(transaction.creatorAccountId());
+      command_executor_.doValidation(true);
+
+      return validateSignatures(transaction) |
+                 [this, &transaction]()
+                 -> expected::Result<void, validation::CommandError> {
+        auto savepoint = createSavepoint("savepoint_temp_wsv");
+        const auto &commands = transaction.commands();
+        for (size_t i = 0; i < commands.size(); ++i) {
+          auto result =
+              boost::apply_visitor(command_executor_, commands[i].get());
+          if (auto error = boost::get<expected::Error<CommandError>>(&result)) {
+            // savepoint is rolled back on destruction
+            return expected::makeError(
+                validation::CommandError{error->error.command_name,
+                                         error->error.error_code,
+                                         error->error.error_extra,
+                                         true,
+                                         i});
+          }
+        }
+        savepoint->release();
+        return {};
+      };
+    }
+
+    std::unique_ptr<TemporaryWsv::SavepointWrapper>
+    InMemoryTemporaryWsv::createSavepoint(const std::string &) {
+      return std::make_unique<SavepointWrapperImpl>(state_,
+                                                    state_.savepoint());
+    }
+
+    InMemoryTemporaryWsv::SavepointWrapperImpl::SavepointWrapperImpl(
+        MutableWsvState &state, size_t savepoint)
+        : state_(state), savepoint_(savepoint), is_released_(false) {}
+
+    void InMemoryTemporaryWsv::SavepointWrapperImpl::release() {
+      is_released_ = true;
+    }
+
+    InMemoryTemporaryWsv::SavepointWrapperImpl::~SavepointWrapperImpl() {
+      if (not is_released_) {
+        state_.rollbackTo(savepoint_);
+      } else {
+        state_.releaseSavepoint(savepoint_);
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
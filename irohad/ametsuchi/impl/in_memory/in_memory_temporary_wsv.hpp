@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_TEMPORARY_WSV_HPP
+#define IROHA_IN_MEMORY_TEMPORARY_WSV_HPP
+
+#include "ametsuchi/temporary_wsv.hpp"
+
+#include "ametsuchi/impl/in_memory/in_memory_command_executor.hpp"
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class InMemoryTemporaryWsv : public TemporaryWsv {
+      friend class InMemoryStorage;
+
+     public:
+      struct SavepointWrapperImpl : public TemporaryWsv::SavepointWrapper {
+        SavepointWrapperImpl(MutableWsvState &state, size_t savepoint);
+
+        void release() override;
+
+        ~SavepointWrapperImpl() override;
+
+       private:
+        MutableWsvState &state_;
+        size_t savepoint_;
+        bool is_released_;
+      };
+
+      /**
+       * @param base - committed state, which is copied and left unchanged
+       * @param perm_converter - converter of permissions to strings
+       */
+      InMemoryTemporaryWsv(
+          std::shared_ptr<const WsvState> base,
+          std::shared_ptr<shared_model::interface::PermissionToString>
+              perm_converter);
+
+      expected::Result<void, validation::CommandError> apply(
+          const shared_model::interface::Transaction &transaction) override;
+
+      std::unique_ptr<TemporaryWsv::SavepointWrapper> createSavepoint(
+          const std::string &name) override;
+
+     private:
+      /**
+       * Verifies whether transaction has at least quorum signatures and they
+       * are a subset of creator account signatories
+       */
+      expected::Result<void, validation::CommandError> validateSignatures(
+          const shared_model::interface::Transaction &transaction);
+
+      /// state the temporary WSV was created from
+      std::shared_ptr<const WsvState> base_;
+      MutableWsvState state_;
+      InMemoryCommandExecutor command_executor_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_TEMPORARY_WSV_HPP
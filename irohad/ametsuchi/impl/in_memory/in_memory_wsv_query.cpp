@@ -0,0 +1,192 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_wsv_query.hpp"
+
+#include <algorithm>
+#include "common/result.hpp"
+#include "cryptography/public_key.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::interface::types::AccountDetailKeyType;
+    using shared_model::interface::types::AccountIdType;
+    using shared_model::interface::types::AssetIdType;
+    using shared_model::interface::types::DomainIdType;
+    using shared_model::interface::types::PubkeyType;
+    using shared_model::interface::types::RoleIdType;
+
+    InMemoryWsvQuery::InMemoryWsvQuery(
+        std::shared_ptr<const WsvState> state,
+        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory)
+        : state_(std::move(state)),
+          factory_(std::move(factory)),
+          log_(logger::log("InMemoryWsvQuery")) {}
+
+    template <typename T>
+    boost::optional<std::shared_ptr<T>> InMemoryWsvQuery::fromResult(
+        shared_model::interface::CommonObjectsFactory::FactoryResult<
+            std::unique_ptr<T>> &&result) {
+      return result.match(
+          [](iroha::expected::Value<std::unique_ptr<T>> &v) {
+            return boost::make_optional(std::shared_ptr<T>(std::move(v.value)));
+          },
+          [&](iroha::expected::Error<std::string> &e)
+              -> boost::optional<std::shared_ptr<T>> {
+            log_->error(e.error);
+            return boost::none;
+          });
+    }
+
+    bool InMemoryWsvQuery::hasAccountGrantablePermission(
+        const AccountIdType &permitee_account_id,
+        const AccountIdType &account_id,
+        shared_model::interface::permissions::Grantable permission) {
+      auto account = state_->accounts.get(account_id);
+      if (not account) {
+        return false;
+      }
+      auto granted = account->granted_permissions.find(permitee_account_id);
+      return granted != account->granted_permissions.end()
+          and granted->second.test(permission);
+    }
+
+    boost::optional<std::vector<RoleIdType>> InMemoryWsvQuery::getAccountRoles(
+        const AccountIdType &account_id) {
+      auto account = state_->accounts.get(account_id);
+      if (not account) {
+        return std::vector<RoleIdType>{};
+      }
+      return account->roles;
+    }
+
+    boost::optional<shared_model::interface::RolePermissionSet>
+    InMemoryWsvQuery::getRolePermissions(const RoleIdType &role_name) {
+      auto role = state_->roles.get(role_name);
+      if (not role) {
+        return shared_model::interface::RolePermissionSet{};
+      }
+      return *role;
+    }
+
+    boost::optional<std::vector<RoleIdType>> InMemoryWsvQuery::getRoles() {
+      std::vector<RoleIdType> roles;
+      state_->roles.forEach(
+          [&roles](const auto &role_id, const auto &) {
+            roles.push_back(role_id);
+          });
+      std::sort(roles.begin(), roles.end());
+      return roles;
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Account>>
+    InMemoryWsvQuery::getAccount(const AccountIdType &account_id) {
+      auto account = state_->accounts.get(account_id);
+      if (not account) {
+        return boost::none;
+      }
+      return this->fromResult(
+          factory_->createAccount(account_id,
+                                  account->domain_id,
+                                  account->quorum,
+                                  detailsJson(account->details)));
+    }
+
+    boost::optional<std::string> InMemoryWsvQuery::getAccountDetail(
+        const std::string &account_id,
+        const AccountDetailKeyType &key,
+        const AccountIdType &writer) {
+      auto account = state_->accounts.get(account_id);
+      return selectDetails(account.get(), key, writer);
+    }
+
+    boost::optional<std::vector<PubkeyType>> InMemoryWsvQuery::getSignatories(
+        const AccountIdType &account_id) {
+      std::vector<PubkeyType> signatories;
+      if (auto account = state_->accounts.get(account_id)) {
+        for (const auto &public_key : account->signatories) {
+          signatories.emplace_back(
+              shared_model::crypto::Blob::fromHexString(public_key));
+        }
+      }
+      return signatories;
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Asset>>
+    InMemoryWsvQuery::getAsset(const AssetIdType &asset_id) {
+      auto asset = state_->assets.get(asset_id);
+      if (not asset) {
+        return boost::none;
+      }
+      return this->fromResult(
+          factory_->createAsset(asset_id, asset->domain_id, asset->precision));
+    }
+
+    boost::optional<
+        std::vector<std::shared_ptr<shared_model::interface::AccountAsset>>>
+    InMemoryWsvQuery::getAccountAssets(const AccountIdType &account_id) {
+      std::vector<std::shared_ptr<shared_model::interface::AccountAsset>>
+          assets;
+      auto account = state_->accounts.get(account_id);
+      if (not account) {
+        return assets;
+      }
+      for (const auto &balance : account->assets) {
+        auto asset = this->fromResult(factory_->createAccountAsset(
+            account_id,
+            balance.first,
+            shared_model::interface::Amount(balance.second.toString())));
+        if (not asset) {
+          return boost::none;
+        }
+        assets.push_back(std::move(*asset));
+      }
+      return assets;
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::AccountAsset>>
+    InMemoryWsvQuery::getAccountAsset(const AccountIdType &account_id,
+                                      const AssetIdType &asset_id) {
+      auto account = state_->accounts.get(account_id);
+      if (not account) {
+        return boost::none;
+      }
+      auto balance = account->assets.find(asset_id);
+      if (balance == account->assets.end()) {
+        return boost::none;
+      }
+      return this->fromResult(factory_->createAccountAsset(
+          account_id,
+          asset_id,
+          shared_model::interface::Amount(balance->second.toString())));
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Domain>>
+    InMemoryWsvQuery::getDomain(const DomainIdType &domain_id) {
+      auto default_role = state_->domains.get(domain_id);
+      if (not default_role) {
+        return boost::none;
+      }
+      return this->fromResult(factory_->createDomain(domain_id, *default_role));
+    }
+
+    boost::optional<std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+    InMemoryWsvQuery::getPeers() {
+      std::vector<std::shared_ptr<shared_model::interface::Peer>> peers;
+      for (const auto &peer : *state_->peers) {
+        auto result = this->fromResult(factory_->createPeer(
+            peer.address,
+            shared_model::crypto::PublicKey{
+                shared_model::crypto::Blob::fromHexString(peer.public_key)}));
+        if (not result) {
+          return boost::none;
+        }
+        peers.push_back(std::move(*result));
+      }
+      return peers;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
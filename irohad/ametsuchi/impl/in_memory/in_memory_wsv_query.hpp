@@ -0,0 +1,105 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_WSV_QUERY_HPP
+#define IROHA_IN_MEMORY_WSV_QUERY_HPP
+
+#include "ametsuchi/wsv_query.hpp"
+
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+#include "interfaces/common_objects/common_objects_factory.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * WsvQuery over a snapshot of in-memory WSV state, changes committed
+     * after the query object is created are not visible to it
+     */
+    class InMemoryWsvQuery : public WsvQuery {
+     public:
+      InMemoryWsvQuery(
+          std::shared_ptr<const WsvState> state,
+          std::shared_ptr<shared_model::interface::CommonObjectsFactory>
+              factory);
+
+      boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
+      getAccountRoles(const shared_model::interface::types::AccountIdType
+                          &account_id) override;
+
+      boost::optional<shared_model::interface::RolePermissionSet>
+      getRolePermissions(
+          const shared_model::interface::types::RoleIdType &role_name) override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::Account>>
+      getAccount(const shared_model::interface::types::AccountIdType
+                     &account_id) override;
+
+      boost::optional<std::string> getAccountDetail(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AccountDetailKeyType &key = "",
+          const shared_model::interface::types::AccountIdType &writer =
+              "") override;
+
+      boost::optional<std::vector<shared_model::interface::types::PubkeyType>>
+      getSignatories(const shared_model::interface::types::AccountIdType
+                         &account_id) override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::Asset>>
+      getAsset(const shared_model::interface::types::AssetIdType &asset_id)
+          override;
+
+      boost::optional<
+          std::vector<std::shared_ptr<shared_model::interface::AccountAsset>>>
+      getAccountAssets(const shared_model::interface::types::AccountIdType
+                           &account_id) override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::AccountAsset>>
+      getAccountAsset(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id) override;
+
+      boost::optional<
+          std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+      getPeers() override;
+
+      boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
+      getRoles() override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::Domain>>
+      getDomain(const shared_model::interface::types::DomainIdType &domain_id)
+          override;
+
+      bool hasAccountGrantablePermission(
+          const shared_model::interface::types::AccountIdType
+              &permitee_account_id,
+          const shared_model::interface::types::AccountIdType &account_id,
+          shared_model::interface::permissions::Grantable permission)
+          override;
+
+     private:
+      /**
+       * Transforms result to optional
+       * value -> optional<value>
+       * error -> nullopt
+       * @tparam T type of object inside
+       * @param result BuilderResult
+       * @return optional<T>
+       */
+      template <typename T>
+      boost::optional<std::shared_ptr<T>> fromResult(
+          shared_model::interface::CommonObjectsFactory::FactoryResult<
+              std::unique_ptr<T>> &&result);
+
+      std::shared_ptr<const WsvState> state_;
+      std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_WSV_QUERY_HPP
@@ -0,0 +1,287 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+  boost::multiprecision::cpp_int powerOfTen(
+      shared_model::interface::types::PrecisionType exponent) {
+    return boost::multiprecision::pow(boost::multiprecision::cpp_int(10),
+                                      exponent);
+  }
+
+  /**
+   * @return string as JSON string literal
+   */
+  std::string jsonString(const std::string &str) {
+    std::string result = "\"";
+    for (unsigned char c : str) {
+      switch (c) {
+        case '"':
+          result += "\\\"";
+          break;
+        case '\\':
+          result += "\\\\";
+          break;
+        case '\n':
+          result += "\\n";
+          break;
+        case '\t':
+          result += "\\t";
+          break;
+        default:
+          if (c < 0x20) {
+            char escaped[7];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            result += escaped;
+          } else {
+            result += static_cast<char>(c);
+          }
+      }
+    }
+    return result + "\"";
+  }
+
+  /**
+   * @return object as text of jsonb, which puts a space after separators
+   */
+  std::string jsonbObject(const iroha::ametsuchi::DetailValues &values) {
+    std::string result = "{";
+    for (const auto &value : values) {
+      if (result.size() > 1) {
+        result += ", ";
+      }
+      result += jsonString(value.first) + ": " + jsonString(value.second);
+    }
+    return result + "}";
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    Balance::Balance() : Balance(0, 0) {}
+
+    Balance::Balance(const shared_model::interface::Amount &amount)
+        : Balance(boost::multiprecision::cpp_int(amount.intValue()),
+                  amount.precision()) {}
+
+    Balance::Balance(boost::multiprecision::cpp_int value,
+                     shared_model::interface::types::PrecisionType precision)
+        : value_(std::move(value)), precision_(precision) {}
+
+    boost::multiprecision::cpp_int Balance::scaled(
+        shared_model::interface::types::PrecisionType precision) const {
+      return value_ * powerOfTen(precision - precision_);
+    }
+
+    Balance Balance::add(const shared_model::interface::Amount &amount) const {
+      const auto precision = std::max(precision_, amount.precision());
+      return Balance(scaled(precision) + Balance(amount).scaled(precision),
+                     precision);
+    }
+
+    boost::optional<Balance> Balance::subtract(
+        const shared_model::interface::Amount &amount) const {
+      const auto precision = std::max(precision_, amount.precision());
+      auto value = scaled(precision) - Balance(amount).scaled(precision);
+      if (value < 0) {
+        return boost::none;
+      }
+      return Balance(std::move(value), precision);
+    }
+
+    bool Balance::lessThanPowerOfTwo(unsigned exponent) const {
+      return value_
+          < (boost::multiprecision::cpp_int(1) << exponent)
+          * powerOfTen(precision_);
+    }
+
+    std::string Balance::toString() const {
+      auto str = value_.str();
+      if (precision_ == 0) {
+        return str;
+      }
+      if (str.size() <= precision_) {
+        str.insert(0, precision_ + 1 - str.size(), '0');
+      }
+      str.insert(str.size() - precision_, 1, '.');
+      return str;
+    }
+
+    bool JsonbKeyLess::operator()(const std::string &a,
+                                  const std::string &b) const {
+      if (a.size() != b.size()) {
+        return a.size() < b.size();
+      }
+      return a < b;
+    }
+
+    std::string detailsJson(const AccountDetails &details) {
+      std::string result = "{";
+      for (const auto &writer : details) {
+        if (result.size() > 1) {
+          result += ", ";
+        }
+        result += jsonString(writer.first) + ": " + jsonbObject(writer.second);
+      }
+      return result + "}";
+    }
+
+    boost::optional<std::string> selectDetails(const AccountRecord *account,
+                                               const std::string &key,
+                                               const std::string &writer) {
+      auto writer_details =
+          [account](const std::string &writer) -> const DetailValues * {
+        if (not account) {
+          return nullptr;
+        }
+        auto it = account->details.find(writer);
+        return it == account->details.end() ? nullptr : &it->second;
+      };
+
+      if (key.empty() and writer.empty()) {
+        if (not account) {
+          return boost::none;
+        }
+        return detailsJson(account->details);
+      }
+      // the rest are built with json_build_object and json_object_agg,
+      // which put spaces around colons
+      if (key.empty()) {
+        auto values = writer_details(writer);
+        return "{" + jsonString(writer) + " : "
+            + (values ? jsonbObject(*values) : "null") + "}";
+      }
+      if (not writer.empty()) {
+        std::string value = "null";
+        if (auto values = writer_details(writer)) {
+          auto it = values->find(key);
+          if (it != values->end()) {
+            value = jsonString(it->second);
+          }
+        }
+        return "{" + jsonString(writer) + " : {" + jsonString(key) + " : "
+            + value + "}}";
+      }
+      if (not account) {
+        return boost::none;
+      }
+      std::string result;
+      for (const auto &values : account->details) {
+        auto value = values.second.find(key);
+        if (value == values.second.end()) {
+          continue;
+        }
+        result += (result.empty() ? "{ " : ", ") + jsonString(values.first)
+            + " : {" + jsonString(key) + " : " + jsonString(value->second)
+            + "}";
+      }
+      if (result.empty()) {
+        return boost::none;
+      }
+      return result + " }";
+    }
+
+    shared_model::interface::RolePermissionSet WsvState::accountPermissions(
+        const shared_model::interface::types::AccountIdType &account_id)
+        const {
+      shared_model::interface::RolePermissionSet permissions;
+      if (auto account = accounts.get(account_id)) {
+        for (const auto &role_id : account->roles) {
+          if (auto role = roles.get(role_id)) {
+            permissions |= *role;
+          }
+        }
+      }
+      return permissions;
+    }
+
+    MutableWsvState::MutableWsvState(WsvState state)
+        : state_(std::move(state)), open_savepoints_(0) {}
+
+    const WsvState &MutableWsvState::state() const {
+      return state_;
+    }
+
+    WsvState MutableWsvState::release() && {
+      undo_log_.clear();
+      open_savepoints_ = 0;
+      return std::move(state_);
+    }
+
+    template <typename Map, typename Key, typename Value>
+    void MutableWsvState::put(Map WsvState::*map, const Key &key, Value value) {
+      auto previous = (state_.*map).put(
+          key, std::make_shared<const Value>(std::move(value)));
+      if (open_savepoints_ != 0) {
+        undo_log_.emplace_back(
+            [map, key, previous = std::move(previous)](WsvState &state) {
+              (state.*map).put(key, previous);
+            });
+      }
+    }
+
+    void MutableWsvState::putRole(
+        const shared_model::interface::types::RoleIdType &role_id,
+        shared_model::interface::RolePermissionSet permissions) {
+      put(&WsvState::roles, role_id, std::move(permissions));
+    }
+
+    void MutableWsvState::putDomain(
+        const shared_model::interface::types::DomainIdType &domain_id,
+        shared_model::interface::types::RoleIdType default_role) {
+      put(&WsvState::domains, domain_id, std::move(default_role));
+    }
+
+    void MutableWsvState::putAccount(
+        const shared_model::interface::types::AccountIdType &account_id,
+        AccountRecord account) {
+      put(&WsvState::accounts, account_id, std::move(account));
+    }
+
+    void MutableWsvState::putAsset(
+        const shared_model::interface::types::AssetIdType &asset_id,
+        AssetRecord asset) {
+      put(&WsvState::assets, asset_id, std::move(asset));
+    }
+
+    void MutableWsvState::putPeers(std::vector<PeerRecord> peers) {
+      auto previous = std::move(state_.peers);
+      state_.peers =
+          std::make_shared<const std::vector<PeerRecord>>(std::move(peers));
+      if (open_savepoints_ != 0) {
+        undo_log_.emplace_back(
+            [previous = std::move(previous)](WsvState &state) {
+              state.peers = previous;
+            });
+      }
+    }
+
+    size_t MutableWsvState::savepoint() {
+      ++open_savepoints_;
+      return undo_log_.size();
+    }
+
+    void MutableWsvState::rollbackTo(size_t savepoint) {
+      while (undo_log_.size() > savepoint) {
+        undo_log_.back()(state_);
+        undo_log_.pop_back();
+      }
+      releaseSavepoint(savepoint);
+    }
+
+    void MutableWsvState::releaseSavepoint(size_t) {
+      if (open_savepoints_ != 0 and --open_savepoints_ == 0) {
+        // changes cannot be reverted anymore
+        undo_log_.clear();
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
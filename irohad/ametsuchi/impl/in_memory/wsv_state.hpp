@@ -0,0 +1,221 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_WSV_STATE_HPP
+#define IROHA_IN_MEMORY_WSV_STATE_HPP
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/optional.hpp>
+#include "ametsuchi/impl/in_memory/cow_map.hpp"
+#include "interfaces/common_objects/amount.hpp"
+#include "interfaces/common_objects/types.hpp"
+#include "interfaces/permissions.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Asset balance with arbitrary precision. Like numeric values in
+     * Postgres, the result of an operation has the largest precision of its
+     * operands, so balances are printed the same way by both backends.
+     */
+    class Balance {
+     public:
+      /// zero with precision 0
+      Balance();
+
+      explicit Balance(const shared_model::interface::Amount &amount);
+
+      /**
+       * @return sum of balance and amount
+       */
+      Balance add(const shared_model::interface::Amount &amount) const;
+
+      /**
+       * @return difference of balance and amount, none if it is negative
+       */
+      boost::optional<Balance> subtract(
+          const shared_model::interface::Amount &amount) const;
+
+      /**
+       * @return whether balance is less than 2 ^ exponent
+       */
+      bool lessThanPowerOfTwo(unsigned exponent) const;
+
+      /**
+       * @return decimal representation, e.g. "1.50"
+       */
+      std::string toString() const;
+
+     private:
+      Balance(boost::multiprecision::cpp_int value,
+              shared_model::interface::types::PrecisionType precision);
+
+      /**
+       * @return value scaled to given precision, which is not less than the
+       * precision of the balance
+       */
+      boost::multiprecision::cpp_int scaled(
+          shared_model::interface::types::PrecisionType precision) const;
+
+      /// value multiplied by 10 ^ precision
+      boost::multiprecision::cpp_int value_;
+      shared_model::interface::types::PrecisionType precision_;
+    };
+
+    /**
+     * Orders keys of JSON objects the way jsonb does: shorter keys first,
+     * keys of the same length bytewise
+     */
+    struct JsonbKeyLess {
+      bool operator()(const std::string &a, const std::string &b) const;
+    };
+
+    /// key to value, both are plain strings
+    using DetailValues = std::map<std::string, std::string, JsonbKeyLess>;
+
+    /// writer account to its details
+    using AccountDetails =
+        std::map<shared_model::interface::types::AccountIdType,
+                 DetailValues,
+                 JsonbKeyLess>;
+
+    struct AccountRecord {
+      shared_model::interface::types::DomainIdType domain_id;
+      shared_model::interface::types::QuorumType quorum;
+      /// hex of public keys in the order they were added
+      std::vector<std::string> signatories;
+      std::vector<shared_model::interface::types::RoleIdType> roles;
+      std::map<shared_model::interface::types::AssetIdType, Balance> assets;
+      AccountDetails details;
+      /// permittee account to permissions granted to it by this account
+      std::map<shared_model::interface::types::AccountIdType,
+               shared_model::interface::GrantablePermissionSet>
+          granted_permissions;
+    };
+
+    /**
+     * @return details as text of jsonb column, e.g. {"w": {"k": "v"}}
+     */
+    std::string detailsJson(const AccountDetails &details);
+
+    /**
+     * Select account details in the JSON format of Postgres queries
+     * @param account - account with the details, nullptr if there is none
+     * @param key - key of details to select, empty to select all
+     * @param writer - writer of details to select, empty to select all
+     * @return JSON of selected details, none if Postgres returns no value
+     */
+    boost::optional<std::string> selectDetails(const AccountRecord *account,
+                                               const std::string &key,
+                                               const std::string &writer);
+
+    struct AssetRecord {
+      shared_model::interface::types::DomainIdType domain_id;
+      shared_model::interface::types::PrecisionType precision;
+    };
+
+    struct PeerRecord {
+      /// hex of public key
+      std::string public_key;
+      shared_model::interface::types::AddressType address;
+    };
+
+    /**
+     * World state view kept in memory. Copies are cheap and share unchanged
+     * data, so every temporary and mutable storage works on its own copy of
+     * the committed state.
+     */
+    struct WsvState {
+      CowMap<shared_model::interface::types::RoleIdType,
+             shared_model::interface::RolePermissionSet>
+          roles;
+      /// domain to its default role
+      CowMap<shared_model::interface::types::DomainIdType,
+             shared_model::interface::types::RoleIdType>
+          domains;
+      CowMap<shared_model::interface::types::AccountIdType, AccountRecord>
+          accounts;
+      CowMap<shared_model::interface::types::AssetIdType, AssetRecord> assets;
+      std::shared_ptr<const std::vector<PeerRecord>> peers =
+          std::make_shared<const std::vector<PeerRecord>>();
+
+      /**
+       * @return union of permissions of all roles of the account, empty set
+       * if there is no such account
+       */
+      shared_model::interface::RolePermissionSet accountPermissions(
+          const shared_model::interface::types::AccountIdType &account_id)
+          const;
+    };
+
+    /**
+     * WSV state which is being changed, with savepoints. Every change made
+     * while a savepoint is open is recorded in an undo log as the previous
+     * value of the changed entry, so rolling back takes the time of the
+     * changes to revert and not of the state size.
+     */
+    class MutableWsvState {
+     public:
+      explicit MutableWsvState(WsvState state);
+
+      const WsvState &state() const;
+
+      /**
+       * @return state with all changes, the object is left unusable
+       */
+      WsvState release() &&;
+
+      void putRole(const shared_model::interface::types::RoleIdType &role_id,
+                   shared_model::interface::RolePermissionSet permissions);
+
+      void putDomain(
+          const shared_model::interface::types::DomainIdType &domain_id,
+          shared_model::interface::types::RoleIdType default_role);
+
+      void putAccount(
+          const shared_model::interface::types::AccountIdType &account_id,
+          AccountRecord account);
+
+      void putAsset(const shared_model::interface::types::AssetIdType &asset_id,
+                    AssetRecord asset);
+
+      void putPeers(std::vector<PeerRecord> peers);
+
+      /**
+       * Open a savepoint
+       * @return its position to be passed to rollbackTo or releaseSavepoint
+       */
+      size_t savepoint();
+
+      /**
+       * Revert all changes made after the savepoint and close it
+       */
+      void rollbackTo(size_t savepoint);
+
+      /**
+       * Close the savepoint keeping the changes
+       */
+      void releaseSavepoint(size_t savepoint);
+
+     private:
+      template <typename Map, typename Key, typename Value>
+      void put(Map WsvState::*map, const Key &key, Value value);
+
+      WsvState state_;
+      std::vector<std::function<void(WsvState &)>> undo_log_;
+      size_t open_savepoints_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_WSV_STATE_HPP
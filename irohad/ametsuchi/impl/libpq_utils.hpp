@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_LIBPQ_UTILS_HPP
+#define IROHA_LIBPQ_UTILS_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <soci/postgresql/soci-postgresql.h>
+#include <soci/soci.h>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /// result of libpq query which is cleared when going out of scope
+    using PgResultPtr = std::unique_ptr<PGresult, decltype(&PQclear)>;
+
+    /**
+     * @return libpq connection of soci session to PostgreSQL, for operations
+     * not supported by soci
+     */
+    inline PGconn *getPgConnection(soci::session &sql) {
+      return static_cast<soci::postgresql_session_backend *>(
+                 sql.get_backend())
+          ->conn_;
+    }
+
+    /**
+     * Quote and escape value to be put into query text as a string literal
+     * @throws std::runtime_error if value cannot be escaped
+     */
+    inline std::string escapeLiteral(PGconn *conn, const std::string &value) {
+      std::unique_ptr<char, decltype(&PQfreemem)> escaped(
+          PQescapeLiteral(conn, value.data(), value.size()), &PQfreemem);
+      if (not escaped) {
+        throw std::runtime_error(PQerrorMessage(conn));
+      }
+      return escaped.get();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_LIBPQ_UTILS_HPP
@@ -0,0 +1,38 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/mapped_file.hpp"
+
+#include <sys/mman.h>
+
+using namespace iroha::ametsuchi;
+
+boost::optional<std::shared_ptr<const MappedFile>> MappedFile::map(
+    int fd, size_t size) {
+  if (size == 0) {
+    return boost::none;
+  }
+  auto address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    return boost::none;
+  }
+  return std::shared_ptr<const MappedFile>(
+      std::make_shared<MappedFile>(address, size, private_tag{}));
+}
+
+const uint8_t *MappedFile::data() const {
+  return static_cast<const uint8_t *>(address_);
+}
+
+size_t MappedFile::size() const {
+  return size_;
+}
+
+MappedFile::MappedFile(void *address, size_t size, private_tag)
+    : address_(address), size_(size) {}
+
+MappedFile::~MappedFile() {
+  ::munmap(address_, size_);
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_MAPPED_FILE_HPP
+#define IROHA_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <boost/optional.hpp>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Read-only memory mapping of a file region, unmapped on destruction.
+     * Mapping stays valid after the file is closed or removed
+     */
+    class MappedFile {
+      /**
+       * Private tag used to construct shared pointers without new operator
+       */
+      struct private_tag {};
+
+     public:
+      /**
+       * Map first size bytes of an open file
+       * @param fd - descriptor of file opened for reading
+       * @param size - number of bytes to map, must be positive
+       * @return mapping, if mmap succeeded
+       */
+      static boost::optional<std::shared_ptr<const MappedFile>> map(
+          int fd, size_t size);
+
+      /**
+       * @return pointer to the first mapped byte
+       */
+      const uint8_t *data() const;
+
+      /**
+       * @return number of mapped bytes
+       */
+      size_t size() const;
+
+      MappedFile(const MappedFile &rhs) = delete;
+
+      MappedFile &operator=(const MappedFile &rhs) = delete;
+
+      MappedFile(void *address, size_t size, private_tag);
+
+      ~MappedFile();
+
+     private:
+      void *address_;
+      size_t size_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_MAPPED_FILE_HPP
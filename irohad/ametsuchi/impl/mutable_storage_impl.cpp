@@ -20,12 +20,15 @@ namespace iroha {
         shared_model::interface::types::HashType top_hash,
         std::shared_ptr<PostgresCommandExecutor> cmd_executor,
         std::unique_ptr<soci::session> sql,
-        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory)
+        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
+        bool index_blocks)
         : top_hash_(top_hash),
           sql_(std::move(sql)),
           peer_query_(std::make_unique<PeerQueryWsv>(
               std::make_shared<PostgresWsvQuery>(*sql_, std::move(factory)))),
-          block_index_(std::make_unique<PostgresBlockIndex>(*sql_)),
+          block_index_(index_blocks
+                           ? std::make_unique<PostgresBlockIndex>(*sql_)
+                           : nullptr),
           command_executor_(std::move(cmd_executor)),
           committed(false),
           log_(logger::log("MutableStorage")) {
@@ -63,10 +66,12 @@ namespace iroha {
           and std::all_of(block.transactions().begin(),
                           block.transactions().end(),
                           execute_transaction);
+      // failed index aborts the transaction, which is rolled back to the
+      // savepoint by the caller
+      block_applied = block_applied
+          and (not block_index_ or block_index_->index(block));
       if (block_applied) {
         block_store_.insert(std::make_pair(block.height(), clone(block)));
-        block_index_->index(block);
-
         top_hash_ = block.hash();
       }
 
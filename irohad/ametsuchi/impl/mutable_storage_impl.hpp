@@ -29,7 +29,8 @@ namespace iroha {
           std::shared_ptr<PostgresCommandExecutor> cmd_executor,
           std::unique_ptr<soci::session> sql,
           std::shared_ptr<shared_model::interface::CommonObjectsFactory>
-              factory);
+              factory,
+          bool index_blocks = true);
 
       bool apply(const shared_model::interface::Block &block) override;
 
@@ -63,6 +64,7 @@ namespace iroha {
 
       std::unique_ptr<soci::session> sql_;
       std::unique_ptr<PeerQuery> peer_query_;
+      /// nullptr if applied blocks are indexed after commit
       std::unique_ptr<BlockIndex> block_index_;
       std::shared_ptr<CommandExecutor> command_executor_;
 
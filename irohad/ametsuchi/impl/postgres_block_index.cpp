@@ -5,6 +5,11 @@
 
 #include "ametsuchi/impl/postgres_block_index.hpp"
 
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+
+#include <soci/postgresql/soci-postgresql.h>
 #include <boost/range/adaptor/indexed.hpp>
 
 #include "ametsuchi/tx_cache_response.hpp"
@@ -27,92 +32,155 @@ namespace {
         [](const auto &) -> ReturnType { return boost::none; });
   }
 
-  // make index tx hash -> block where hash is stored
-  std::string makeHashIndex(
-      const shared_model::interface::types::HashType &hash,
-      shared_model::interface::types::HeightType height,
-      size_t index) {
-    boost::format base(
-        "INSERT INTO position_by_hash(hash, height, index) VALUES ('%s', "
-        "'%s', '%s');");
-    return (base % hash.hex() % height % index).str();
-  }
+  /**
+   * Rows of a table in COPY text format
+   */
+  class CopyRows {
+   public:
+    /**
+     * @param target - table with the list of copied columns
+     */
+    explicit CopyRows(std::string target) : target_(std::move(target)) {}
+
+    template <typename... Values>
+    void add(const Values &... values) {
+      auto separator = "";
+      (void)std::initializer_list<int>{
+          (data_ += separator, append(values), separator = "\t", 0)...};
+      data_ += '\n';
+    }
 
-  std::string makeCommittedTxHashIndex(
-      const shared_model::interface::types::HashType &rejected_tx_hash) {
-    boost::format base(
-        "INSERT INTO tx_status_by_hash(hash, status) VALUES ('%s', "
-        "TRUE);");
-    return (base % rejected_tx_hash.hex()).str();
-  }
+    const std::string &target() const {
+      return target_;
+    }
 
-  std::string makeRejectedTxHashIndex(
-      const shared_model::interface::types::HashType &rejected_tx_hash) {
-    boost::format base(
-        "INSERT INTO tx_status_by_hash(hash, status) VALUES ('%s', "
-        "FALSE);");
-    return (base % rejected_tx_hash.hex()).str();
-  }
+    const std::string &data() const {
+      return data_;
+    }
 
-  // make index account_id:height -> list of tx indexes
-  // (where tx is placed in the block)
-  std::string makeCreatorHeightIndex(
-      const shared_model::interface::types::AccountIdType creator,
-      shared_model::interface::types::HeightType height,
-      size_t tx_index) {
-    boost::format base(
-        "INSERT INTO index_by_creator_height(creator_id, height, index) VALUES "
-        "('%s', '%s', '%s');");
-    return (base % creator % height % tx_index).str();
-  }
+   private:
+    void append(const std::string &value) {
+      for (auto c : value) {
+        switch (c) {
+          case '\\':
+            data_ += "\\\\";
+            break;
+          case '\t':
+            data_ += "\\t";
+            break;
+          case '\n':
+            data_ += "\\n";
+            break;
+          case '\r':
+            data_ += "\\r";
+            break;
+          default:
+            data_ += c;
+        }
+      }
+    }
 
-  // Make index account_id -> list of blocks where his txs exist
-  std::string makeAccountHeightIndex(
-      const shared_model::interface::types::AccountIdType &account_id,
-      shared_model::interface::types::HeightType height) {
-    boost::format base(
-        "INSERT INTO height_by_account_set(account_id, "
-        "height) VALUES "
-        "('%s', '%s');");
-    return (base % account_id % height).str();
+    void append(const shared_model::interface::types::HashType &value) {
+      // bytea in hex format, with escaped backslash
+      data_ += "\\\\x";
+      data_ += value.hex();
+    }
+
+    void append(bool value) {
+      data_ += value ? 't' : 'f';
+    }
+
+    void append(uint64_t value) {
+      data_ += std::to_string(value);
+    }
+
+    std::string target_;
+    std::string data_;
+  };
+
+  using ResultPtr = std::unique_ptr<PGresult, decltype(&PQclear)>;
+
+  /**
+   * Send rows to the server with a single COPY command
+   * @throws std::runtime_error if the server rejects the rows
+   */
+  void copy(PGconn *conn, const CopyRows &rows) {
+    if (rows.data().empty()) {
+      return;
+    }
+    auto error = [conn, &rows] {
+      return std::runtime_error("COPY " + rows.target()
+                                + " failed: " + PQerrorMessage(conn));
+    };
+
+    ResultPtr start(
+        PQexec(conn, ("COPY " + rows.target() + " FROM STDIN").c_str()),
+        &PQclear);
+    if (PQresultStatus(start.get()) != PGRES_COPY_IN) {
+      throw error();
+    }
+    const bool sent = PQputCopyData(conn,
+                                    rows.data().data(),
+                                    static_cast<int>(rows.data().size()))
+            == 1
+        and PQputCopyEnd(conn, nullptr) == 1;
+
+    ExecStatusType status = PGRES_COMMAND_OK;
+    while (ResultPtr result{PQgetResult(conn), &PQclear}) {
+      if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+        status = PQresultStatus(result.get());
+      }
+    }
+    if (not sent or status != PGRES_COMMAND_OK) {
+      throw error();
+    }
   }
 
+  /**
+   * Index rows of a block, one set per index table
+   */
+  struct IndexRows {
+    // tx hash -> block where hash is stored
+    CopyRows position_by_hash{"position_by_hash(hash, height, index)"};
+    // tx hash -> whether tx is committed or rejected
+    CopyRows tx_status_by_hash{"tx_status_by_hash(hash, status)"};
+    // account_id:height -> list of tx indexes (where tx is placed in the
+    // block)
+    CopyRows index_by_creator_height{
+        "index_by_creator_height(creator_id, height, index)"};
+    // account_id -> list of blocks where his txs exist
+    CopyRows height_by_account_set{"height_by_account_set(account_id, height)"};
+    // account_id:height:asset_id -> list of tx indexes for transfer asset
+    CopyRows position_by_account_asset{
+        "position_by_account_asset(account_id, height, asset_id, index)"};
+  };
+
   // Collect all assets belonging to creator, sender, and receiver
   // to make account_id:height:asset_id -> list of tx indexes
   // for transfer asset in command
-  std::string makeAccountAssetIndex(
+  void addAccountAssetIndex(
+      IndexRows &rows,
       const shared_model::interface::types::AccountIdType &account_id,
-      shared_model::interface::types::HeightType height,
-      size_t index,
+      uint64_t height,
+      uint64_t index,
       const shared_model::interface::Transaction::CommandsType &commands) {
-    return std::accumulate(
-        commands.begin(),
-        commands.end(),
-        std::string{},
-        [&](auto query, const auto &cmd) {
-          auto transfer = getTransferAsset(cmd);
-          if (not transfer) {
-            return query;
-          }
-          const auto &src_id = transfer.value().srcAccountId();
-          const auto &dest_id = transfer.value().destAccountId();
-
-          query += makeAccountHeightIndex(src_id, height);
-          query += makeAccountHeightIndex(dest_id, height);
-
-          const auto ids = {account_id, src_id, dest_id};
-          const auto &asset_id = transfer.value().assetId();
-          // flat map accounts to unindexed keys
-          for (const auto &id : ids) {
-            boost::format base(
-                "INSERT INTO position_by_account_asset(account_id, "
-                "height, asset_id, "
-                "index) "
-                "VALUES ('%s', '%s', '%s', '%s');");
-            query += (base % id % height % asset_id % index).str();
-          }
-          return query;
-        });
+    for (const auto &cmd : commands) {
+      auto transfer = getTransferAsset(cmd);
+      if (not transfer) {
+        continue;
+      }
+      const auto &src_id = transfer.value().srcAccountId();
+      const auto &dest_id = transfer.value().destAccountId();
+
+      rows.height_by_account_set.add(src_id, height);
+      rows.height_by_account_set.add(dest_id, height);
+
+      const auto &asset_id = transfer.value().assetId();
+      // flat map accounts to unindexed keys
+      for (const auto &id : {account_id, src_id, dest_id}) {
+        rows.position_by_account_asset.add(id, height, asset_id, index);
+      }
+    }
   }
 }  // namespace
 
@@ -121,43 +189,44 @@ namespace iroha {
     PostgresBlockIndex::PostgresBlockIndex(soci::session &sql)
         : sql_(sql), log_(logger::log("PostgresBlockIndex")) {}
 
-    void PostgresBlockIndex::index(
+    bool PostgresBlockIndex::index(
         const shared_model::interface::Block &block) {
-      auto height = block.height();
-      auto indexed_txs = block.transactions() | boost::adaptors::indexed(0);
-      auto rejected_txs_hashes = block.rejected_transactions_hashes();
-      std::string tx_index_query = std::accumulate(
-          indexed_txs.begin(),
-          indexed_txs.end(),
-          std::string{},
-          [height](auto query, const auto &tx) {
-            const auto &creator_id = tx.value().creatorAccountId();
-            const auto index = tx.index();
-
-            query += makeAccountHeightIndex(creator_id, height);
-            query += makeAccountAssetIndex(
-                creator_id, height, index, tx.value().commands());
-            query += makeHashIndex(tx.value().hash(), height, index);
-            query += makeCommittedTxHashIndex(tx.value().hash());
-            query += makeCreatorHeightIndex(creator_id, height, index);
-            return query;
-          });
-
-      std::string rejected_tx_index_query =
-          std::accumulate(rejected_txs_hashes.begin(),
-                          rejected_txs_hashes.end(),
-                          std::string{},
-                          [](auto query, const auto &rejected_tx_hash) {
-                            query += makeRejectedTxHashIndex(rejected_tx_hash);
-                            return query;
-                          });
-
-      auto index_query = tx_index_query + rejected_tx_index_query;
+      const uint64_t height = block.height();
+      IndexRows rows;
+      for (const auto &tx :
+           block.transactions() | boost::adaptors::indexed(0)) {
+        const auto &creator_id = tx.value().creatorAccountId();
+        const uint64_t index = tx.index();
+        const auto &hash = tx.value().hash();
+
+        rows.height_by_account_set.add(creator_id, height);
+        addAccountAssetIndex(
+            rows, creator_id, height, index, tx.value().commands());
+        rows.position_by_hash.add(hash, height, index);
+        rows.tx_status_by_hash.add(hash, true);
+        rows.index_by_creator_height.add(creator_id, height, index);
+      }
+      for (const auto &rejected_tx_hash :
+           block.rejected_transactions_hashes()) {
+        rows.tx_status_by_hash.add(rejected_tx_hash, false);
+      }
+
       try {
-        sql_ << index_query;
+        auto conn =
+            static_cast<soci::postgresql_session_backend *>(sql_.get_backend())
+                ->conn_;
+        for (const auto *table : {&rows.position_by_hash,
+                                  &rows.tx_status_by_hash,
+                                  &rows.index_by_creator_height,
+                                  &rows.height_by_account_set,
+                                  &rows.position_by_account_asset}) {
+          copy(conn, *table);
+        }
       } catch (const std::exception &e) {
-        log_->error(e.what());
+        log_->error("cannot index block {}: {}", height, e.what());
+        return false;
       }
+      return true;
     }
   }  // namespace ametsuchi
 }  // namespace iroha
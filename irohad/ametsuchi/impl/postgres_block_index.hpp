@@ -43,8 +43,11 @@ namespace iroha {
        *     c. destination account
        *   2. account -> block for source and destination accounts
        *   3. (account, height) -> list of txes
+       *
+       * Failed COPY aborts the current transaction, so the caller has to
+       * roll it back when false is returned
        */
-      void index(const shared_model::interface::Block &block) override;
+      bool index(const shared_model::interface::Block &block) override;
 
      private:
       soci::session &sql_;
@@ -5,12 +5,12 @@
 
 #include "ametsuchi/impl/postgres_block_query.hpp"
 
-#include <boost/format.hpp>
-#include <boost/range/adaptor/transformed.hpp>
-#include <boost/range/algorithm/for_each.hpp>
+#include <unordered_map>
 
+#include <boost/algorithm/string/join.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <soci/boost-tuple.h>
 #include "ametsuchi/impl/soci_utils.hpp"
-#include "common/byteutils.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -18,21 +18,25 @@ namespace iroha {
         soci::session &sql,
         KeyValueStorage &file_store,
         std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
-            converter)
+            converter,
+        std::shared_ptr<BlockCache> block_cache)
         : sql_(sql),
           block_store_(file_store),
-          converter_(std::move(converter)),
+          block_format_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
           log_(logger::log("PostgresBlockQuery")) {}
 
     PostgresBlockQuery::PostgresBlockQuery(
         std::unique_ptr<soci::session> sql,
         KeyValueStorage &file_store,
         std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
-            converter)
+            converter,
+        std::shared_ptr<BlockCache> block_cache)
         : psql_(std::move(sql)),
           sql_(*psql_),
           block_store_(file_store),
-          converter_(std::move(converter)),
+          block_format_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
           log_(logger::log("PostgresBlockQuery")) {}
 
     std::vector<BlockQuery::wBlock> PostgresBlockQuery::getBlocks(
@@ -47,9 +51,9 @@ namespace iroha {
       for (auto i = height; i <= to; i++) {
         auto block = getBlock(i);
         block.match(
-            [&result](
-                expected::Value<std::unique_ptr<shared_model::interface::Block>>
-                    &v) { result.emplace_back(std::move(v.value)); },
+            [&result](expected::Value<wBlock> &v) {
+              result.emplace_back(std::move(v.value));
+            },
             [this](const expected::Error<std::string> &e) {
               log_->error(e.error);
             });
@@ -74,55 +78,43 @@ namespace iroha {
         const shared_model::interface::types::AccountIdType &account_id) {
       std::vector<shared_model::interface::types::HeightType> result;
       soci::indicator ind;
-      std::string row;
+      shared_model::interface::types::HeightType row;
       soci::statement st =
           (sql_.prepare << "SELECT DISTINCT height FROM height_by_account_set "
-                           "WHERE account_id = :id",
+                           "WHERE account_id = :id ORDER BY height",
            soci::into(row, ind),
            soci::use(account_id));
       st.execute();
 
-      processSoci(st, ind, row, [&result](std::string &r) {
-        result.push_back(std::stoull(r));
-      });
+      processSoci(
+          st, ind, row, [&result](auto &height) { result.push_back(height); });
       return result;
     }
 
     boost::optional<shared_model::interface::types::HeightType>
     PostgresBlockQuery::getBlockId(const shared_model::crypto::Hash &hash) {
-      boost::optional<uint64_t> blockId = boost::none;
-      boost::optional<std::string> block_str;
+      boost::optional<shared_model::interface::types::HeightType> block_id;
       auto hash_str = hash.hex();
 
-      sql_ << "SELECT height FROM position_by_hash WHERE hash = :hash",
-          soci::into(block_str), soci::use(hash_str);
-      if (block_str) {
-        blockId = std::stoull(block_str.get());
-      } else {
+      sql_ << "SELECT height FROM position_by_hash "
+              "WHERE hash = decode(:hash, 'hex') LIMIT 1",
+          soci::into(block_id), soci::use(hash_str);
+      if (not block_id) {
         log_->info("No block with transaction {}", hash);
       }
-      return blockId;
+      return block_id;
     }
 
-    std::function<void(std::vector<std::string> &result)>
+    std::function<void(std::vector<uint64_t> &result)>
     PostgresBlockQuery::callback(std::vector<wTransaction> &blocks,
                                  uint64_t block_id) {
-      return [this, &blocks, block_id](std::vector<std::string> &result) {
+      return [this, &blocks, block_id](std::vector<uint64_t> &result) {
         auto block = getBlock(block_id);
         block.match(
-            [&result, &blocks](
-                expected::Value<std::unique_ptr<shared_model::interface::Block>>
-                    &v) {
-              boost::for_each(
-                  result | boost::adaptors::transformed([](const auto &x) {
-                    std::istringstream iss(x);
-                    size_t size;
-                    iss >> size;
-                    return size;
-                  }),
-                  [&](const auto &x) {
-                    blocks.emplace_back(clone(v.value->transactions()[x]));
-                  });
+            [&result, &blocks](expected::Value<wBlock> &v) {
+              for (auto index : result) {
+                blocks.emplace_back(clone(v.value->transactions()[index]));
+              }
             },
             [this](const expected::Error<std::string> &e) {
               log_->error(e.error);
@@ -139,20 +131,21 @@ namespace iroha {
         return result;
       }
       for (const auto &block_id : block_ids) {
-        std::vector<std::string> index;
+        std::vector<uint64_t> index;
         soci::indicator ind;
-        std::string row;
+        uint64_t row;
         soci::statement st =
             (sql_.prepare
                  << "SELECT DISTINCT index FROM index_by_creator_height "
-                    "WHERE creator_id = :id AND height = :height",
+                    "WHERE creator_id = :id AND height = :height "
+                    "ORDER BY index",
              soci::into(row, ind),
              soci::use(account_id),
              soci::use(block_id));
         st.execute();
 
         processSoci(
-            st, ind, row, [&index](std::string &r) { index.push_back(r); });
+            st, ind, row, [&index](auto &r) { index.push_back(r); });
         this->callback(result, block_id)(index);
       }
       return result;
@@ -169,14 +162,14 @@ namespace iroha {
       }
 
       for (const auto &block_id : block_ids) {
-        std::vector<std::string> index;
+        std::vector<uint64_t> index;
         soci::indicator ind;
-        std::string row;
+        uint64_t row;
         soci::statement st =
             (sql_.prepare
                  << "SELECT DISTINCT index FROM position_by_account_asset "
                     "WHERE account_id = :id AND height = :height "
-                    "AND asset_id = :asset_id",
+                    "AND asset_id = :asset_id ORDER BY index",
              soci::into(row, ind),
              soci::use(account_id),
              soci::use(block_id),
@@ -184,7 +177,7 @@ namespace iroha {
         st.execute();
 
         processSoci(
-            st, ind, row, [&index](std::string &r) { index.push_back(r); });
+            st, ind, row, [&index](auto &r) { index.push_back(r); });
         this->callback(result, block_id)(index);
       }
       return result;
@@ -209,15 +202,11 @@ namespace iroha {
           [this](const auto &block_id) {
             auto result = this->getBlock(block_id);
             return result.match(
-                [](expected::Value<
-                    std::unique_ptr<shared_model::interface::Block>> &v)
-                    -> boost::optional<
-                        std::unique_ptr<shared_model::interface::Block>> {
+                [](expected::Value<wBlock> &v) -> boost::optional<wBlock> {
                   return std::move(v.value);
                 },
                 [this](const expected::Error<std::string> &e)
-                    -> boost::optional<
-                        std::unique_ptr<shared_model::interface::Block>> {
+                    -> boost::optional<wBlock> {
                   log_->error(e.error);
                   return boost::none;
                 });
@@ -244,16 +233,24 @@ namespace iroha {
 
     boost::optional<TxCacheStatusType> PostgresBlockQuery::checkTxPresence(
         const shared_model::crypto::Hash &hash) {
-      int res = -1;
-      const auto &hash_str = hash.hex();
+      tx_status_hash_ = hash.hex();
+      tx_status_ = -1;
 
       try {
-        sql_ << "SELECT status FROM tx_status_by_hash WHERE hash = :hash",
-            soci::into(res), soci::use(hash_str);
+        if (not tx_status_statement_) {
+          tx_status_statement_ = std::make_unique<soci::statement>(
+              (sql_.prepare << "SELECT status FROM tx_status_by_hash "
+                               "WHERE hash = decode(:hash, 'hex')",
+               soci::into(tx_status_),
+               soci::use(tx_status_hash_)));
+        }
+        tx_status_statement_->execute(true);
       } catch (const std::exception &e) {
         log_->error("Failed to execute query: {}", e.what());
+        tx_status_statement_.reset();
         return boost::none;
       }
+      const auto res = tx_status_;
 
       // res > 0 => Committed
       // res == 0 => Rejected
@@ -269,36 +266,63 @@ namespace iroha {
           tx_cache_status_responses::Missing{hash});
     }
 
+    boost::optional<std::vector<TxCacheStatusType>>
+    PostgresBlockQuery::checkTxPresence(
+        const std::vector<shared_model::crypto::Hash> &hashes) {
+      std::vector<TxCacheStatusType> statuses;
+      if (hashes.empty()) {
+        return statuses;
+      }
+      // hex strings contain no commas, so the whole set of hashes is passed
+      // as a single parameter and split on the server
+      const auto hashes_str = boost::algorithm::join(
+          hashes | boost::adaptors::transformed([](const auto &hash) {
+            return hash.hex();
+          }),
+          ",");
+      std::unordered_map<std::string, bool> found;
+      try {
+        soci::rowset<boost::tuple<std::string, int>> rows =
+            (sql_.prepare << "SELECT encode(hash, 'hex'), status "
+                             "FROM tx_status_by_hash WHERE hash = ANY(ARRAY("
+                             "SELECT decode(h, 'hex') FROM "
+                             "unnest(string_to_array(:hashes, ',')) AS h))",
+             soci::use(hashes_str));
+        for (const auto &row : rows) {
+          found.emplace(row.get<0>(), row.get<1>() > 0);
+        }
+      } catch (const std::exception &e) {
+        log_->error("Failed to execute query: {}", e.what());
+        return boost::none;
+      }
+
+      statuses.reserve(hashes.size());
+      for (const auto &hash : hashes) {
+        auto it = found.find(hash.hex());
+        if (it == found.end()) {
+          statuses.emplace_back(tx_cache_status_responses::Missing{hash});
+        } else if (it->second) {
+          statuses.emplace_back(tx_cache_status_responses::Committed{hash});
+        } else {
+          statuses.emplace_back(tx_cache_status_responses::Rejected{hash});
+        }
+      }
+      return statuses;
+    }
+
     uint32_t PostgresBlockQuery::getTopBlockHeight() {
       return block_store_.last_id();
     }
 
     expected::Result<BlockQuery::wBlock, std::string>
     PostgresBlockQuery::getTopBlock() {
-      return getBlock(block_store_.last_id())
-          .match(
-              [](expected::Value<
-                  std::unique_ptr<shared_model::interface::Block>> &v)
-                  -> expected::Result<BlockQuery::wBlock, std::string> {
-                return expected::makeValue<BlockQuery::wBlock>(
-                    std::move(v.value));
-              },
-              [](expected::Error<std::string> &e)
-                  -> expected::Result<BlockQuery::wBlock, std::string> {
-                return expected::makeError(std::move(e.error));
-              });
+      return getBlock(block_store_.last_id());
     }
 
-    expected::Result<std::unique_ptr<shared_model::interface::Block>,
-                     std::string>
+    expected::Result<BlockQuery::wBlock, std::string>
     PostgresBlockQuery::getBlock(
         shared_model::interface::types::HeightType id) const {
-      auto serialized_block = block_store_.get(id);
-      if (not serialized_block) {
-        auto error = boost::format("Failed to retrieve block with id %d") % id;
-        return expected::makeError(error.str());
-      }
-      return converter_->deserialize(bytesToString(*serialized_block));
+      return loadBlock(id, block_store_, block_format_, block_cache_.get());
     }
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -10,6 +10,8 @@
 
 #include <soci/soci.h>
 #include <boost/optional.hpp>
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
 #include "interfaces/iroha_internal/block_json_deserializer.hpp"
 #include "logger/logger.hpp"
@@ -24,17 +26,23 @@ namespace iroha {
      */
     class PostgresBlockQuery : public BlockQuery {
      public:
+      /**
+       * @param block_cache - cache of decoded blocks shared between block
+       * queries, blocks are always read from file_store if it is null
+       */
       PostgresBlockQuery(
           soci::session &sql,
           KeyValueStorage &file_store,
           std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
-              converter);
+              converter,
+          std::shared_ptr<BlockCache> block_cache = nullptr);
 
       PostgresBlockQuery(
           std::unique_ptr<soci::session> sql,
           KeyValueStorage &file_store,
           std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
-              converter);
+              converter,
+          std::shared_ptr<BlockCache> block_cache = nullptr);
 
       std::vector<wTransaction> getAccountTransactions(
           const shared_model::interface::types::AccountIdType &account_id)
@@ -64,6 +72,9 @@ namespace iroha {
       boost::optional<TxCacheStatusType> checkTxPresence(
           const shared_model::crypto::Hash &hash) override;
 
+      boost::optional<std::vector<TxCacheStatusType>> checkTxPresence(
+          const std::vector<shared_model::crypto::Hash> &hashes) override;
+
       expected::Result<wBlock, std::string> getTopBlock() override;
 
      private:
@@ -89,26 +100,31 @@ namespace iroha {
        * @param block_id
        * @return
        */
-      std::function<void(std::vector<std::string> &result)> callback(
+      std::function<void(std::vector<uint64_t> &result)> callback(
           std::vector<wTransaction> &s, uint64_t block_id);
 
       /**
-       * Retrieve block with given id block storage
+       * Retrieve block with given id from block cache or block storage
        * @param id - height of a block to retrieve
        * @return block with given height
        */
-      expected::Result<std::unique_ptr<shared_model::interface::Block>,
-                       std::string>
-      getBlock(shared_model::interface::types::HeightType id) const;
+      expected::Result<wBlock, std::string> getBlock(
+          shared_model::interface::types::HeightType id) const;
 
       std::unique_ptr<soci::session> psql_;
       soci::session &sql_;
 
       KeyValueStorage &block_store_;
-      std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
-          converter_;
+      BlockStorageFormat block_format_;
+      std::shared_ptr<BlockCache> block_cache_;
 
       logger::Logger log_;
+
+      /// status query prepared on first use and reused while the object
+      /// lives, bound to the two fields below
+      std::unique_ptr<soci::statement> tx_status_statement_;
+      std::string tx_status_hash_;
+      int tx_status_;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -5,9 +5,9 @@
 
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 
-#include <soci/postgresql/soci-postgresql.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
+#include "ametsuchi/impl/libpq_utils.hpp"
 #include "ametsuchi/impl/soci_utils.hpp"
 #include "cryptography/public_key.hpp"
 #include "interfaces/commands/add_asset_quantity.hpp"
@@ -86,148 +86,76 @@ namespace {
         std::move(command_name), code, query_args()});
   }
 
-  /// mapping between pairs of SQL error substrings and related fake error
-  /// codes, which are indices in this collection
-  const std::vector<std::tuple<std::string, std::string>> kSqlToFakeErrorCode =
-      {std::make_tuple("Key (account_id)=", "is not present in table"),
-       std::make_tuple("Key (permittee_account_id)", "is not present in table"),
-       std::make_tuple("Key (role_id)=", "is not present in table"),
-       std::make_tuple("Key (domain_id)=", "is not present in table"),
-       std::make_tuple("Key (asset_id)=", "already exists"),
-       std::make_tuple("Key (domain_id)=", "already exists"),
-       std::make_tuple("Key (role_id)=", "already exists"),
-       std::make_tuple("Key (account_id, public_key)=", "already exists"),
-       std::make_tuple("Key (account_id)=", "already exists"),
-       std::make_tuple("Key (default_role)=", "is not present in table")};
-
-  /// mapping between command name, fake error code and related real error code
-  const std::map<std::string, std::map<int, int>> kCmdNameToErrorCode{
-      std::make_pair(
-          "AddSignatory",
-          std::map<int, int>{std::make_pair(0, 3), std::make_pair(7, 4)}),
-      std::make_pair(
-          "AppendRole",
-          std::map<int, int>{std::make_pair(0, 3), std::make_pair(2, 4)}),
-      std::make_pair(
-          "DetachRole",
-          std::map<int, int>{std::make_pair(0, 3), std::make_pair(2, 5)}),
-      std::make_pair("RemoveSignatory",
-                     std::map<int, int>{std::make_pair(0, 3)}),
-      std::make_pair("SetAccountDetail",
-                     std::map<int, int>{std::make_pair(0, 3)}),
-      std::make_pair("SetQuorum", std::map<int, int>{std::make_pair(0, 3)}),
-      std::make_pair("GrantPermission",
-                     std::map<int, int>{std::make_pair(1, 3)}),
-      std::make_pair("RevokePermission",
-                     std::map<int, int>{std::make_pair(1, 3)}),
-      std::make_pair(
-          "CreateAccount",
-          std::map<int, int>{std::make_pair(3, 3), std::make_pair(8, 4)}),
-      std::make_pair(
-          "CreateAsset",
-          std::map<int, int>{std::make_pair(3, 3), std::make_pair(4, 4)}),
-      std::make_pair(
-          "CreateDomain",
-          std::map<int, int>{std::make_pair(5, 3), std::make_pair(9, 4)}),
-      std::make_pair("CreateRole", std::map<int, int>{std::make_pair(6, 3)}),
-      std::make_pair("AddSignatory", std::map<int, int>{std::make_pair(7, 4)})};
-
-  /**
-   * Get a real error code based on the fake one and a command name
-   * @param fake_error_code - inner error code to be translated into the user's
-   * one
-   * @param command_name of the failed command
-   * @return real error code
-   */
-  boost::optional<iroha::ametsuchi::CommandError::ErrorCodeType>
-  getRealErrorCode(size_t fake_error_code, const std::string &command_name) {
-    auto fake_to_real_code = kCmdNameToErrorCode.find(command_name);
-    if (fake_to_real_code == kCmdNameToErrorCode.end()) {
-      return {};
-    }
-
-    auto real_code = fake_to_real_code->second.find(fake_error_code);
-    if (real_code == fake_to_real_code->second.end()) {
-      return {};
-    }
-
-    return real_code->second;
-  }
-
-  // TODO [IR-1830] Akvinikym 31.10.18: make benchmarks to compare exception
-  // parsing vs nested queries
   /**
-   * Get an error code from the text SQL error
+   * Get command result from result of statement prepared by
+   * prepareStatements
+   * Assumes that statement returns 0 in case of success
+   * or error code in case of failure. Statements check every failure
+   * condition explicitly, so an SQL error means an internal error
    * @tparam QueryArgsCallable - type of callable to get query arguments
-   * @param command_name - name of the failed command
-   * @param error - string error, which SQL gave out
+   * @param result - result of the statement
+   * @param command_name - which command executes a query
    * @param query_args - callable to get a string representation of query
    * arguments
-   * @return command_error structure
+   * @return CommandResult with command name and error message
    */
   template <typename QueryArgsCallable>
-  iroha::ametsuchi::CommandResult getCommandError(
-      std::string &&command_name,
-      const std::string &error,
+  iroha::ametsuchi::CommandResult statementResult(
+      const PGresult *result,
+      std::string command_name,
       QueryArgsCallable &&query_args) noexcept {
-    std::string key, to_be_presented;
-    bool errors_matched;
-
-    // go through mapping of SQL errors and get index of the current error - it
-    // is "fake" error code
-    for (size_t fakeErrorCode = 0; fakeErrorCode < kSqlToFakeErrorCode.size();
-         ++fakeErrorCode) {
-      std::tie(key, to_be_presented) = kSqlToFakeErrorCode[fakeErrorCode];
-      errors_matched = error.find(key) != std::string::npos
-          and error.find(to_be_presented) != std::string::npos;
-      if (errors_matched) {
-        if (auto real_error_code =
-                getRealErrorCode(fakeErrorCode, command_name)) {
-          return makeCommandError(std::move(command_name),
-                                  *real_error_code,
-                                  std::forward<QueryArgsCallable>(query_args));
-        }
-        break;
-      }
+    if (PQresultStatus(result) != PGRES_TUPLES_OK or PQntuples(result) != 1) {
+      return makeCommandError(std::move(command_name),
+                              1,
+                              std::forward<QueryArgsCallable>(query_args));
+    }
+    const iroha::ametsuchi::CommandError::ErrorCodeType code =
+        std::strtoul(PQgetvalue(result, 0, 0), nullptr, 10);
+    if (code != 0) {
+      return makeCommandError(std::move(command_name),
+                              code,
+                              std::forward<QueryArgsCallable>(query_args));
     }
-    // parsing is not successful, return the general error
-    return makeCommandError(std::move(command_name),
-                            1,
-                            std::forward<QueryArgsCallable>(query_args));
+    return {};
   }
 
   /**
-   * Executes sql query
-   * Assumes that statement query returns 0 in case of success
-   * or error code in case of failure
+   * Executes statement prepared by prepareStatements with bound parameters,
+   * which are sent separately from the statement and are neither formatted
+   * into a query nor parsed by the server as SQL
    * @tparam QueryArgsCallable - type of callable to get query arguments
    * @param sql - connection on which to execute statement
-   * @param cmd - sql query to be executed
+   * @param statement_name - name of prepared statement to be executed
+   * @param params - statement parameters in text format
    * @param command_name - which command executes a query
    * @param query_args - callable to get a string representation of query
    * arguments
    * @return CommandResult with command name and error message
    */
   template <typename QueryArgsCallable>
-  iroha::ametsuchi::CommandResult executeQuery(
+  iroha::ametsuchi::CommandResult executeStatement(
       soci::session &sql,
-      const std::string &cmd,
+      const std::string &statement_name,
+      const std::vector<std::string> &params,
       std::string command_name,
       QueryArgsCallable &&query_args) noexcept {
-    uint32_t result;
-    try {
-      sql << cmd, soci::into(result);
-      if (result != 0) {
-        return makeCommandError(std::move(command_name),
-                                result,
-                                std::forward<QueryArgsCallable>(query_args));
-      }
-      return {};
-    } catch (const std::exception &e) {
-      return getCommandError(std::move(command_name),
-                             e.what(),
-                             std::forward<QueryArgsCallable>(query_args));
+    std::vector<const char *> values;
+    values.reserve(params.size());
+    for (const auto &param : params) {
+      values.push_back(param.c_str());
     }
+    iroha::ametsuchi::PgResultPtr result(
+        PQexecPrepared(iroha::ametsuchi::getPgConnection(sql),
+                       statement_name.c_str(),
+                       static_cast<int>(values.size()),
+                       values.data(),
+                       nullptr,
+                       nullptr,
+                       0),
+        &PQclear);
+    return statementResult(result.get(),
+                           std::move(command_name),
+                           std::forward<QueryArgsCallable>(query_args));
   }
 
   std::string checkAccountRolePermission(
@@ -312,14 +240,10 @@ namespace {
         .str();
   }
 
-  template <typename Format>
-  void appendCommandName(const std::string &name,
-                         Format &cmd,
-                         bool do_validation) {
-    auto command_name = name
+  std::string statementName(const std::string &name, bool do_validation) {
+    return name
         + (do_validation ? PreparedStatement::validationPrefix
                          : PreparedStatement::noValidationPrefix);
-    cmd % command_name;
   }
 
   /**
@@ -333,8 +257,6 @@ namespace {
 
 namespace iroha {
   namespace ametsuchi {
-    // TODO [IR-1830] Akvinikym 31.10.18: make benchmarks to compare exception
-    // parsing vs nested queries
     const std::string PostgresCommandExecutor::addAssetQuantityBase = R"(
           PREPARE %s (text, text, int, text) AS
           WITH has_account AS (SELECT account_id FROM account
@@ -384,10 +306,13 @@ namespace iroha {
           PREPARE %s (text, text, text) AS
           WITH
           %s
+          has_peer AS (SELECT * FROM peer
+                       WHERE public_key = $2 OR address = $3 LIMIT 1),
           inserted AS (
               INSERT INTO peer(public_key, address)
               (
                   SELECT $2, $3
+                  WHERE NOT EXISTS (SELECT * FROM has_peer)
                   %s
               ) RETURNING (1)
           )
@@ -398,10 +323,19 @@ namespace iroha {
     const std::string PostgresCommandExecutor::addSignatoryBase = R"(
           PREPARE %s (text, text, text) AS
           WITH %s
+          has_account AS (SELECT account_id FROM account
+                          WHERE account_id = $2 LIMIT 1),
+          has_account_signatory AS (SELECT * FROM account_has_signatory
+                                    WHERE account_id = $2
+                                    AND public_key = $3 LIMIT 1),
           insert_signatory AS
           (
               INSERT INTO signatory(public_key)
-              (SELECT $3 %s) ON CONFLICT DO NOTHING RETURNING (1)
+              (
+                  SELECT $3 WHERE EXISTS (SELECT * FROM has_account)
+                  AND NOT EXISTS (SELECT * FROM has_account_signatory)
+                  %s
+              ) ON CONFLICT DO NOTHING RETURNING (1)
           ),
           has_signatory AS (SELECT * FROM signatory WHERE public_key = $3),
           insert_account_signatory AS
@@ -411,6 +345,8 @@ namespace iroha {
                   SELECT $2, $3 WHERE (EXISTS
                   (SELECT * FROM insert_signatory) OR
                   EXISTS (SELECT * FROM has_signatory))
+                  AND EXISTS (SELECT * FROM has_account)
+                  AND NOT EXISTS (SELECT * FROM has_account_signatory)
                   %s
               )
               RETURNING (1)
@@ -418,6 +354,8 @@ namespace iroha {
           SELECT CASE
               WHEN EXISTS (SELECT * FROM insert_account_signatory) THEN 0
               %s
+              WHEN NOT EXISTS (SELECT * FROM has_account) THEN 3
+              WHEN EXISTS (SELECT * FROM has_account_signatory) THEN 4
               ELSE 1
           END AS RESULT;)";
 
@@ -425,15 +363,23 @@ namespace iroha {
             PREPARE %s (text, text, text) AS
             WITH %s
             role_exists AS (SELECT * FROM role WHERE role_id = $3),
+            account_exists AS (SELECT account_id FROM account
+                               WHERE account_id = $2 LIMIT 1),
+            has_role AS (SELECT * FROM account_has_roles
+                         WHERE account_id = $2 AND role_id = $3),
             inserted AS (
                 INSERT INTO account_has_roles(account_id, role_id)
                 (
-                    SELECT $2, $3 %s) RETURNING (1)
+                    SELECT $2, $3 WHERE EXISTS (SELECT * FROM role_exists)
+                    AND EXISTS (SELECT * FROM account_exists)
+                    AND NOT EXISTS (SELECT * FROM has_role)
+                    %s) RETURNING (1)
             )
             SELECT CASE
                 WHEN EXISTS (SELECT * FROM inserted) THEN 0
                 WHEN NOT EXISTS (SELECT * FROM role_exists) THEN 4
                 %s
+                WHEN NOT EXISTS (SELECT * FROM account_exists) THEN 3
                 ELSE 1
             END AS result)";
 
@@ -441,6 +387,8 @@ namespace iroha {
           PREPARE %s (text, text, text, text) AS
           WITH get_domain_default_role AS (SELECT default_role FROM domain
                                            WHERE domain_id = $3),
+          has_account AS (SELECT account_id FROM account
+                          WHERE account_id = $2 LIMIT 1),
           %s
           insert_signatory AS
           (
@@ -448,6 +396,7 @@ namespace iroha {
               (
                   SELECT $4 WHERE EXISTS
                   (SELECT * FROM get_domain_default_role)
+                  AND NOT EXISTS (SELECT * FROM has_account)
               ) ON CONFLICT DO NOTHING RETURNING (1)
           ),
           has_signatory AS (SELECT * FROM signatory WHERE public_key = $4),
@@ -459,6 +408,7 @@ namespace iroha {
                       (SELECT * FROM insert_signatory) OR EXISTS
                       (SELECT * FROM has_signatory)
                   ) AND EXISTS (SELECT * FROM get_domain_default_role)
+                  AND NOT EXISTS (SELECT * FROM has_account)
                   %s
               ) RETURNING (1)
           ),
@@ -484,44 +434,63 @@ namespace iroha {
               WHEN EXISTS (SELECT * FROM insert_account_role) THEN 0
               %s
               WHEN NOT EXISTS (SELECT * FROM get_domain_default_role) THEN 3
+              WHEN EXISTS (SELECT * FROM has_account) THEN 4
               ELSE 1
               END AS result)";
 
     const std::string PostgresCommandExecutor::createAssetBase = R"(
               PREPARE %s (text, text, text, int) AS
               WITH %s
+              has_domain AS (SELECT domain_id FROM domain
+                             WHERE domain_id = $3 LIMIT 1),
+              has_asset AS (SELECT asset_id FROM asset
+                            WHERE asset_id = $2 LIMIT 1),
               inserted AS
               (
                   INSERT INTO asset(asset_id, domain_id, precision, data)
                   (
                       SELECT $2, $3, $4, NULL
+                      WHERE EXISTS (SELECT * FROM has_domain)
+                      AND NOT EXISTS (SELECT * FROM has_asset)
                       %s
                   ) RETURNING (1)
               )
               SELECT CASE WHEN EXISTS (SELECT * FROM inserted) THEN 0
               %s
+              WHEN NOT EXISTS (SELECT * FROM has_domain) THEN 3
+              WHEN EXISTS (SELECT * FROM has_asset) THEN 4
               ELSE 1 END AS result)";
 
     const std::string PostgresCommandExecutor::createDomainBase = R"(
               PREPARE %s (text, text, text) AS
               WITH %s
+              has_domain AS (SELECT domain_id FROM domain
+                             WHERE domain_id = $2 LIMIT 1),
+              has_role AS (SELECT role_id FROM role
+                           WHERE role_id = $3 LIMIT 1),
               inserted AS
               (
                   INSERT INTO domain(domain_id, default_role)
                   (
                       SELECT $2, $3
+                      WHERE NOT EXISTS (SELECT * FROM has_domain)
+                      AND EXISTS (SELECT * FROM has_role)
                       %s
                   ) RETURNING (1)
               )
               SELECT CASE WHEN EXISTS (SELECT * FROM inserted) THEN 0
               %s
+              WHEN EXISTS (SELECT * FROM has_domain) THEN 3
+              WHEN NOT EXISTS (SELECT * FROM has_role) THEN 4
               ELSE 1 END AS result)";
 
     const std::string PostgresCommandExecutor::createRoleBase = R"(
           PREPARE %s (text, text, bit) AS
           WITH %s
+          has_role AS (SELECT role_id FROM role WHERE role_id = $2 LIMIT 1),
           insert_role AS (INSERT INTO role(role_id)
                               (SELECT $2
+                              WHERE NOT EXISTS (SELECT * FROM has_role)
                               %s) RETURNING (1)),
           insert_role_permissions AS
           (
@@ -534,7 +503,7 @@ namespace iroha {
           SELECT CASE
               WHEN EXISTS (SELECT * FROM insert_role_permissions) THEN 0
               %s
-              WHEN EXISTS (SELECT * FROM role WHERE role_id = $2) THEN 2
+              WHEN EXISTS (SELECT * FROM has_role) THEN 3
               ELSE 1
               END AS result)";
 
@@ -562,17 +531,21 @@ namespace iroha {
     const std::string PostgresCommandExecutor::grantPermissionBase = R"(
           PREPARE %s (text, text, bit, bit) AS
           WITH %s
+            has_permittee AS (SELECT account_id FROM account
+                              WHERE account_id = $2 LIMIT 1),
             inserted AS (
               INSERT INTO account_has_grantable_permissions AS
               has_perm(permittee_account_id, account_id, permission)
-              (SELECT $2, $1, $3 %s) ON CONFLICT
+              (SELECT $2, $1, $3
+               WHERE EXISTS (SELECT * FROM has_permittee) %s) ON CONFLICT
               (permittee_account_id, account_id)
-              DO UPDATE SET permission=(SELECT has_perm.permission | $3
-              WHERE (has_perm.permission & $3) <> $3)
+              DO UPDATE SET permission = has_perm.permission | $3
+              WHERE (has_perm.permission & $3) <> $3
               RETURNING (1)
             )
             SELECT CASE WHEN EXISTS (SELECT * FROM inserted) THEN 0
               %s
+              WHEN NOT EXISTS (SELECT * FROM has_permittee) THEN 3
               ELSE 1 END AS result)";
 
     const std::string PostgresCommandExecutor::removeSignatoryBase = R"(
@@ -611,12 +584,10 @@ namespace iroha {
           WITH %s
               inserted AS (
                   UPDATE account_has_grantable_permissions as has_perm
-                  SET permission=(SELECT has_perm.permission & $4
-                  WHERE has_perm.permission & $3 = $3 AND
-                  has_perm.permittee_account_id=$2 AND
-                  has_perm.account_id=$1) WHERE
+                  SET permission = has_perm.permission & $4 WHERE
                   permittee_account_id=$2 AND
-                  account_id=$1 %s
+                  account_id=$1 AND
+                  has_perm.permission & $3 = $3 %s
                 RETURNING (1)
               )
               SELECT CASE WHEN EXISTS (SELECT * FROM inserted) THEN 0
@@ -794,6 +765,7 @@ namespace iroha {
             perm_converter)
         : sql_(sql),
           do_validation_(true),
+          defer_execution_(false),
           perm_converter_{std::move(perm_converter)} {}
 
     void PostgresCommandExecutor::setCreatorAccountId(
@@ -806,6 +778,103 @@ namespace iroha {
       do_validation_ = do_validation;
     }
 
+    void PostgresCommandExecutor::deferExecution(bool defer) {
+      defer_execution_ = defer;
+    }
+
+    std::vector<PostgresCommandExecutor::DeferredStatement>
+    PostgresCommandExecutor::takeDeferred() {
+      std::vector<DeferredStatement> deferred;
+      deferred.swap(deferred_);
+      return deferred;
+    }
+
+    CommandResult PostgresCommandExecutor::deferredResult(
+        const DeferredStatement &statement, const PGresult *result) {
+      return statementResult(result, statement.command_name, [&statement] {
+        return statement.query_args;
+      });
+    }
+
+    void PostgresCommandExecutor::setWsvCache(
+        std::shared_ptr<WsvCacheView> wsv_cache) {
+      wsv_cache_ = std::move(wsv_cache);
+    }
+
+    bool PostgresCommandExecutor::checkPermission(
+        shared_model::interface::permissions::Role perm) {
+      if (not do_validation_ or not wsv_cache_) {
+        return do_validation_;
+      }
+      auto permissions = wsv_cache_->permissions(creator_account_id_);
+      return not(permissions and permissions->test(perm));
+    }
+
+    bool PostgresCommandExecutor::checkPermission(
+        shared_model::interface::permissions::Role global_perm,
+        shared_model::interface::permissions::Role domain_perm,
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      if (not do_validation_ or not wsv_cache_) {
+        return do_validation_;
+      }
+      auto permissions = wsv_cache_->permissions(creator_account_id_);
+      if (not permissions) {
+        return true;
+      }
+      if (permissions->test(global_perm)) {
+        return false;
+      }
+      const auto account_domain =
+          creator_account_id_.substr(creator_account_id_.find('@') + 1);
+      const auto asset_domain = asset_id.substr(asset_id.find('#') + 1);
+      return not(account_domain == asset_domain
+                 and permissions->test(domain_perm));
+    }
+
+    boost::optional<CommandError::ErrorCodeType>
+    PostgresCommandExecutor::checkPrecision(
+        bool check_permission,
+        const shared_model::interface::types::AssetIdType &asset_id,
+        shared_model::interface::types::PrecisionType precision,
+        CommandError::ErrorCodeType error_code) {
+      // results of deferred commands are not checked by the caller
+      if (check_permission or defer_execution_ or not wsv_cache_) {
+        return boost::none;
+      }
+      auto asset_precision = wsv_cache_->precision(asset_id);
+      if (asset_precision and *asset_precision < precision) {
+        return error_code;
+      }
+      return boost::none;
+    }
+
+    template <typename QueryArgsCallable>
+    CommandResult PostgresCommandExecutor::execute(
+        const std::string &statement_name,
+        const std::vector<std::string> &params,
+        std::string command_name,
+        QueryArgsCallable &&query_args) {
+      if (not defer_execution_) {
+        return executeStatement(sql_,
+                                statement_name,
+                                params,
+                                std::move(command_name),
+                                std::forward<QueryArgsCallable>(query_args));
+      }
+      auto conn = getPgConnection(sql_);
+      std::vector<std::string> literals;
+      literals.reserve(params.size());
+      for (const auto &param : params) {
+        literals.push_back(escapeLiteral(conn, param));
+      }
+      deferred_.push_back(DeferredStatement{
+          "EXECUTE " + statement_name + " ("
+              + boost::algorithm::join(literals, ", ") + ")",
+          std::move(command_name),
+          query_args()});
+      return {};
+    }
+
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddAssetQuantity &command) {
       auto &account_id = creator_account_id_;
@@ -813,12 +882,8 @@ namespace iroha {
       auto amount = command.amount().toStringRepr();
       int precision = command.amount().precision();
 
-      // 14.09.2018 nickaleks: IR-1707 move common logic to separate function
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%, '%5%')");
-
-      appendCommandName("addAssetQuantity", cmd, do_validation_);
-
-      cmd = (cmd % account_id % asset_id % precision % amount);
+      const std::vector<std::string> params{
+          account_id, asset_id, std::to_string(precision), amount};
 
       auto str_args = [&account_id, &asset_id, &amount, precision] {
         return getQueryArgsStringBuilder()
@@ -829,19 +894,26 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "AddAssetQuantity", std::move(str_args));
+      const bool check_permission = checkPermission(
+          shared_model::interface::permissions::Role::kAddAssetQty,
+          shared_model::interface::permissions::Role::kAddDomainAssetQty,
+          asset_id);
+      if (auto error =
+              checkPrecision(check_permission, asset_id, precision, 3)) {
+        return makeCommandError("AddAssetQuantity", *error, str_args);
+      }
+      return execute(statementName("addAssetQuantity", check_permission),
+                     params,
+                     "AddAssetQuantity",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddPeer &command) {
       auto &peer = command.peer();
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("addPeer", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % peer.pubkey().hex() % peer.address());
+      const std::vector<std::string> params{
+          creator_account_id_, peer.pubkey().hex(), peer.address()};
 
       auto str_args = [&peer] {
         return getQueryArgsStringBuilder()
@@ -849,18 +921,20 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AddPeer", std::move(str_args));
+      const bool check_permission = checkPermission(
+          shared_model::interface::permissions::Role::kAddPeer);
+      return execute(statementName("addPeer", check_permission),
+                     params,
+                     "AddPeer",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddSignatory &command) {
       auto &account_id = command.accountId();
       auto pubkey = command.pubkey().hex();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("addSignatory", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % pubkey);
+      const std::vector<std::string> params{
+          creator_account_id_, account_id, pubkey};
 
       auto str_args = [&account_id, &pubkey] {
         return getQueryArgsStringBuilder()
@@ -869,18 +943,18 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AddSignatory", std::move(str_args));
+      return execute(statementName("addSignatory", do_validation_),
+                     params,
+                     "AddSignatory",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AppendRole &command) {
       auto &account_id = command.accountId();
       auto &role_name = command.roleName();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("appendRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % role_name);
+      const std::vector<std::string> params{
+          creator_account_id_, account_id, role_name};
 
       auto str_args = [&account_id, &role_name] {
         return getQueryArgsStringBuilder()
@@ -889,7 +963,10 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AppendRole", std::move(str_args));
+      return execute(statementName("appendRole", do_validation_),
+                     params,
+                     "AppendRole",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -900,11 +977,8 @@ namespace iroha {
       shared_model::interface::types::AccountIdType account_id =
           account_name + "@" + domain_id;
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("createAccount", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % domain_id % pubkey);
+      const std::vector<std::string> params{
+          creator_account_id_, account_id, domain_id, pubkey};
 
       auto str_args = [&account_id, &domain_id, &pubkey] {
         return getQueryArgsStringBuilder()
@@ -914,8 +988,12 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "CreateAccount", std::move(str_args));
+      const bool check_permission = checkPermission(
+          shared_model::interface::permissions::Role::kCreateAccount);
+      return execute(statementName("createAccount", check_permission),
+                     params,
+                     "CreateAccount",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -923,11 +1001,8 @@ namespace iroha {
       auto &domain_id = command.domainId();
       auto asset_id = command.assetName() + "#" + domain_id;
       int precision = command.precision();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', %5%)");
-
-      appendCommandName("createAsset", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % asset_id % domain_id % precision);
+      const std::vector<std::string> params{
+          creator_account_id_, asset_id, domain_id, std::to_string(precision)};
 
       auto str_args = [&domain_id, &asset_id, precision] {
         return getQueryArgsStringBuilder()
@@ -937,18 +1012,20 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateAsset", std::move(str_args));
+      const bool check_permission = checkPermission(
+          shared_model::interface::permissions::Role::kCreateAsset);
+      return execute(statementName("createAsset", check_permission),
+                     params,
+                     "CreateAsset",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::CreateDomain &command) {
       auto &domain_id = command.domainId();
       auto &default_role = command.userDefaultRole();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("createDomain", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % domain_id % default_role);
+      const std::vector<std::string> params{
+          creator_account_id_, domain_id, default_role};
 
       auto str_args = [&domain_id, &default_role] {
         return getQueryArgsStringBuilder()
@@ -957,7 +1034,12 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateDomain", std::move(str_args));
+      const bool check_permission = checkPermission(
+          shared_model::interface::permissions::Role::kCreateDomain);
+      return execute(statementName("createDomain", check_permission),
+                     params,
+                     "CreateDomain",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -965,11 +1047,8 @@ namespace iroha {
       auto &role_id = command.roleName();
       auto &permissions = command.rolePermissions();
       auto perm_str = permissions.toBitstring();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("createRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % role_id % perm_str);
+      const std::vector<std::string> params{
+          creator_account_id_, role_id, perm_str};
 
       auto str_args = [&role_id, &perm_str] {
         // TODO [IR-1889] Akvinikym 21.11.18: integrate
@@ -980,18 +1059,18 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateRole", std::move(str_args));
+      return execute(statementName("createRole", do_validation_),
+                     params,
+                     "CreateRole",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::DetachRole &command) {
       auto &account_id = command.accountId();
       auto &role_name = command.roleName();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("detachRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % role_name);
+      const std::vector<std::string> params{
+          creator_account_id_, account_id, role_name};
 
       auto str_args = [&account_id, &role_name] {
         return getQueryArgsStringBuilder()
@@ -1000,7 +1079,12 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "DetachRole", std::move(str_args));
+      const bool check_permission = checkPermission(
+          shared_model::interface::permissions::Role::kDetachRole);
+      return execute(statementName("detachRole", check_permission),
+                     params,
+                     "DetachRole",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1014,12 +1098,8 @@ namespace iroha {
       const auto perm_str =
           shared_model::interface::GrantablePermissionSet({permission})
               .toBitstring();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("grantPermission", cmd, do_validation_);
-
-      cmd =
-          (cmd % creator_account_id_ % permittee_account_id % perm_str % perm);
+      const std::vector<std::string> params{
+          creator_account_id_, permittee_account_id, perm_str, perm};
 
       auto str_args = [&creator_account_id = creator_account_id_,
                        &permittee_account_id,
@@ -1031,19 +1111,18 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "GrantPermission", std::move(str_args));
+      return execute(statementName("grantPermission", do_validation_),
+                     params,
+                     "GrantPermission",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::RemoveSignatory &command) {
       auto &account_id = command.accountId();
       auto &pubkey = command.pubkey().hex();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("removeSignatory", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % pubkey);
+      const std::vector<std::string> params{
+          creator_account_id_, account_id, pubkey};
 
       auto str_args = [&account_id, &pubkey] {
         return getQueryArgsStringBuilder()
@@ -1052,8 +1131,10 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "RemoveSignatory", std::move(str_args));
+      return execute(statementName("removeSignatory", do_validation_),
+                     params,
+                     "RemoveSignatory",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1069,12 +1150,8 @@ namespace iroha {
                              .set(permission)
                              .toBitstring();
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("revokePermission", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % permittee_account_id % perms
-             % without_perm_str);
+      const std::vector<std::string> params{
+          creator_account_id_, permittee_account_id, perms, without_perm_str};
 
       auto str_args = [&creator_account_id = creator_account_id_,
                        &permittee_account_id,
@@ -1086,8 +1163,10 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "RevokePermission", std::move(str_args));
+      return execute(statementName("revokePermission", do_validation_),
+                     params,
+                     "RevokePermission",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1104,13 +1183,8 @@ namespace iroha {
       std::string filled_json = "{" + creator_account_id_ + ", " + key + "}";
       std::string val = "\"" + value + "\"";
 
-      auto cmd = boost::format(
-          "EXECUTE %1% ('%2%', '%3%', '%4%', '%5%', '%6%', '%7%')");
-
-      appendCommandName("setAccountDetail", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % json % filled_json % val
-             % empty_json);
+      const std::vector<std::string> params{
+          creator_account_id_, account_id, json, filled_json, val, empty_json};
 
       auto str_args = [&account_id, &key, &value] {
         return getQueryArgsStringBuilder()
@@ -1120,19 +1194,18 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "SetAccountDetail", std::move(str_args));
+      return execute(statementName("setAccountDetail", do_validation_),
+                     params,
+                     "SetAccountDetail",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::SetQuorum &command) {
       auto &account_id = command.accountId();
       int quorum = command.newQuorum();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%)");
-
-      appendCommandName("setQuorum", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % quorum);
+      const std::vector<std::string> params{
+          creator_account_id_, account_id, std::to_string(quorum)};
 
       auto str_args = [&account_id, quorum] {
         return getQueryArgsStringBuilder()
@@ -1141,7 +1214,10 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "SetQuorum", std::move(str_args));
+      return execute(statementName("setQuorum", do_validation_),
+                     params,
+                     "SetQuorum",
+                     std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1149,11 +1225,8 @@ namespace iroha {
       auto &asset_id = command.assetId();
       auto amount = command.amount().toStringRepr();
       uint32_t precision = command.amount().precision();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%, '%5%')");
-
-      appendCommandName("subtractAssetQuantity", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % asset_id % precision % amount);
+      const std::vector<std::string> params{
+          creator_account_id_, asset_id, std::to_string(precision), amount};
 
       auto str_args = [&creator_account_id = creator_account_id_,
                        &asset_id,
@@ -1167,8 +1240,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "SubtractAssetQuantity", std::move(str_args));
+      const bool check_permission = checkPermission(
+          shared_model::interface::permissions::Role::kSubtractAssetQty,
+          shared_model::interface::permissions::Role::kSubtractDomainAssetQty,
+          asset_id);
+      if (auto error =
+              checkPrecision(check_permission, asset_id, precision, 3)) {
+        return makeCommandError("SubtractAssetQuantity", *error, str_args);
+      }
+      return execute(
+          statementName("subtractAssetQuantity", check_permission),
+          params,
+          "SubtractAssetQuantity",
+          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1178,13 +1262,9 @@ namespace iroha {
       auto &asset_id = command.assetId();
       auto amount = command.amount().toStringRepr();
       uint32_t precision = command.amount().precision();
-      auto cmd =
-          boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%', %6%, '%7%')");
-
-      appendCommandName("transferAsset", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % src_account_id % dest_account_id
-             % asset_id % precision % amount);
+      const std::vector<std::string> params{
+          creator_account_id_, src_account_id, dest_account_id, asset_id,
+          std::to_string(precision), amount};
 
       auto str_args =
           [&src_account_id, &dest_account_id, &asset_id, &amount, precision] {
@@ -1197,8 +1277,10 @@ namespace iroha {
                 .finalize();
           };
 
-      return executeQuery(
-          sql_, cmd.str(), "TransferAsset", std::move(str_args));
+      return execute(statementName("transferAsset", do_validation_),
+                     params,
+                     "TransferAsset",
+                     std::move(str_args));
     }
 
     void PostgresCommandExecutor::prepareStatements(soci::session &sql) {
@@ -1225,7 +1307,7 @@ namespace iroha {
              % checkAccountRolePermission(
                    shared_model::interface::permissions::Role::kAddPeer, "$1"))
                 .str(),
-            "WHERE (SELECT * FROM has_perm)",
+            "AND (SELECT * FROM has_perm)",
             "WHEN NOT (SELECT * from has_perm) THEN 2"}});
 
       statements.push_back(
@@ -1240,7 +1322,7 @@ namespace iroha {
                    "$1",
                    "$2"))
                 .str(),
-            " WHERE (SELECT * FROM has_perm)",
+            " AND (SELECT * FROM has_perm)",
             " AND (SELECT * FROM has_perm)",
             "WHEN NOT (SELECT * from has_perm) THEN 2"}});
 
@@ -1273,7 +1355,7 @@ namespace iroha {
                    "$1")
              % bits)
                 .str(),
-            R"( WHERE
+            R"( AND
                     EXISTS (SELECT * FROM account_roles) AND
                     (SELECT * FROM account_has_role_permissions)
                     AND (SELECT * FROM has_perm))",
@@ -1303,7 +1385,7 @@ namespace iroha {
                    shared_model::interface::permissions::Role::kCreateAsset,
                    "$1"))
                 .str(),
-            R"(WHERE (SELECT * FROM has_perm))",
+            R"(AND (SELECT * FROM has_perm))",
             R"(WHEN NOT (SELECT * FROM has_perm) THEN 2)"}});
 
       statements.push_back(
@@ -1315,7 +1397,7 @@ namespace iroha {
                    shared_model::interface::permissions::Role::kCreateDomain,
                    "$1"))
                 .str(),
-            R"(WHERE (SELECT * FROM has_perm))",
+            R"(AND (SELECT * FROM has_perm))",
             R"(WHEN NOT (SELECT * FROM has_perm) THEN 2)"}});
 
       statements.push_back(
@@ -1334,7 +1416,7 @@ namespace iroha {
                    shared_model::interface::permissions::Role::kCreateRole,
                    "$1"))
                 .str(),
-            R"(WHERE (SELECT * FROM account_has_role_permissions)
+            R"(AND (SELECT * FROM account_has_role_permissions)
                           AND (SELECT * FROM has_perm))",
             R"(WHEN NOT (SELECT * FROM
                                account_has_role_permissions) THEN 2
@@ -1361,7 +1443,7 @@ namespace iroha {
               WHERE ar.account_id = $1),)")
                               % bits)
                                  .str(),
-                             R"( WHERE (SELECT * FROM has_perm))",
+                             R"( AND (SELECT * FROM has_perm))",
                              R"(WHEN NOT (SELECT * FROM has_perm) THEN 2)"}});
 
       statements.push_back(
@@ -7,7 +7,9 @@
 #define IROHA_POSTGRES_COMMAND_EXECUTOR_HPP
 
 #include "ametsuchi/command_executor.hpp"
+#include "ametsuchi/impl/libpq_utils.hpp"
 #include "ametsuchi/impl/soci_utils.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -20,6 +22,17 @@ namespace iroha {
 
     class PostgresCommandExecutor : public CommandExecutor {
      public:
+      /**
+       * Command which was collected instead of being executed
+       */
+      struct DeferredStatement {
+        /// EXECUTE query with arguments as escaped literals
+        std::string query;
+        std::string command_name;
+        /// string representation of query arguments for error reports
+        std::string query_args;
+      };
+
       PostgresCommandExecutor(
           soci::session &transaction,
           std::shared_ptr<shared_model::interface::PermissionToString>
@@ -31,6 +44,32 @@ namespace iroha {
 
       void doValidation(bool do_validation) override;
 
+      /**
+       * Set deferred mode, in which commands are not executed, but collected
+       * to be sent by the caller together with other queries in a single
+       * round trip. Results of deferred commands are always successful
+       */
+      void deferExecution(bool defer);
+
+      /**
+       * @return commands collected in deferred mode since the last call
+       */
+      std::vector<DeferredStatement> takeDeferred();
+
+      /**
+       * Get command result from result of executed deferred statement
+       */
+      static CommandResult deferredResult(const DeferredStatement &statement,
+                                          const PGresult *result);
+
+      /**
+       * Set cache of committed WSV entities. Permission checks of commands,
+       * which only require a role permission of creator, are skipped when
+       * the permission is found in cache
+       * @param wsv_cache - cache, or nullptr to always check in statements
+       */
+      void setWsvCache(std::shared_ptr<WsvCacheView> wsv_cache);
+
       CommandResult operator()(
           const shared_model::interface::AddAssetQuantity &command) override;
 
@@ -83,8 +122,48 @@ namespace iroha {
       static void prepareStatements(soci::session &sql);
 
      private:
+      /**
+       * Execute statement prepared by prepareStatements, or collect it in
+       * deferred mode
+       */
+      template <typename QueryArgsCallable>
+      CommandResult execute(const std::string &statement_name,
+                            const std::vector<std::string> &params,
+                            std::string command_name,
+                            QueryArgsCallable &&query_args);
+
+      /**
+       * @return whether statement must check that creator has permission,
+       * false if it is known from cache
+       */
+      bool checkPermission(shared_model::interface::permissions::Role perm);
+
+      /**
+       * @return whether statement must check that creator has global
+       * permission, or domain permission for asset of creator domain
+       */
+      bool checkPermission(
+          shared_model::interface::permissions::Role global_perm,
+          shared_model::interface::permissions::Role domain_perm,
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      /**
+       * Check precision of amount against cached precision of asset, when
+       * permission of creator is already known, so the error is the same as
+       * the statement would return
+       * @return error_code if precision of asset is lower than of amount
+       */
+      boost::optional<CommandError::ErrorCodeType> checkPrecision(
+          bool check_permission,
+          const shared_model::interface::types::AssetIdType &asset_id,
+          shared_model::interface::types::PrecisionType precision,
+          CommandError::ErrorCodeType error_code);
+
       soci::session &sql_;
       bool do_validation_;
+      bool defer_execution_;
+      std::vector<DeferredStatement> deferred_;
+      std::shared_ptr<WsvCacheView> wsv_cache_;
 
       shared_model::interface::types::AccountIdType creator_account_id_;
       std::shared_ptr<shared_model::interface::PermissionToString>
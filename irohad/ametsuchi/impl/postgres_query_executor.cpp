@@ -155,24 +155,16 @@ namespace iroha {
                                                            RangeGen &&range_gen,
                                                            Pred &&pred) {
       std::vector<std::unique_ptr<shared_model::interface::Transaction>> result;
-      auto serialized_block = block_store_.get(block_id);
-      if (not serialized_block) {
-        log_->error("Failed to retrieve block with id {}", block_id);
-        return result;
-      }
-      auto deserialized_block =
-          converter_->deserialize(bytesToString(*serialized_block));
+      auto loaded_block = loadBlock(
+          block_id, block_store_, block_format_, block_cache_.get());
       // boost::get of pointer returns pointer to requested type, or nullptr
-      if (auto e =
-              boost::get<expected::Error<std::string>>(&deserialized_block)) {
+      if (auto e = boost::get<expected::Error<std::string>>(&loaded_block)) {
         log_->error(e->error);
         return result;
       }
 
       auto &block =
-          boost::get<
-              expected::Value<std::unique_ptr<shared_model::interface::Block>>>(
-              deserialized_block)
+          boost::get<expected::Value<BlockCache::BlockPtr>>(loaded_block)
               .value;
 
       boost::transform(range_gen(boost::size(block->transactions()))
@@ -240,7 +232,8 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::QueryResponseFactory>
             response_factory,
         std::shared_ptr<shared_model::interface::PermissionToString>
-            perm_converter)
+            perm_converter,
+        std::shared_ptr<BlockCache> block_cache)
         : sql_(std::move(sql)),
           block_store_(block_store),
           pending_txs_storage_(std::move(pending_txs_storage)),
@@ -249,7 +242,8 @@ namespace iroha {
                    pending_txs_storage_,
                    std::move(converter),
                    response_factory,
-                   perm_converter),
+                   perm_converter,
+                   std::move(block_cache)),
           query_response_factory_{std::move(response_factory)},
           log_(logger::log("PostgresQueryExecutor")) {}
 
@@ -285,11 +279,13 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::QueryResponseFactory>
             response_factory,
         std::shared_ptr<shared_model::interface::PermissionToString>
-            perm_converter)
+            perm_converter,
+        std::shared_ptr<BlockCache> block_cache)
         : sql_(sql),
           block_store_(block_store),
           pending_txs_storage_(std::move(pending_txs_storage)),
-          converter_(std::move(converter)),
+          block_format_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
           query_response_factory_{std::move(response_factory)},
           perm_converter_(std::move(perm_converter)),
           log_(logger::log("PostgresQueryExecutorVisitor")) {}
@@ -376,7 +372,7 @@ namespace iroha {
 
       // select tx with specified hash
       auto first_by_hash = R"(SELECT height, index FROM position_by_hash
-      WHERE hash = :hash LIMIT 1)";
+      WHERE hash = decode(:hash, 'hex') LIMIT 1)";
 
       // select first ever tx
       auto first_tx = R"(SELECT height, index FROM position_by_hash
@@ -590,7 +586,9 @@ namespace iroha {
 
     QueryExecutorResult PostgresQueryExecutorVisitor::operator()(
         const shared_model::interface::GetTransactions &q) {
-      auto escape = [](auto &hash) { return "'" + hash.hex() + "'"; };
+      auto escape = [](auto &hash) {
+        return "decode('" + hash.hex() + "', 'hex')";
+      };
       std::string hash_str = std::accumulate(
           std::next(q.transactionHashes().begin()),
           q.transactionHashes().end(),
@@ -604,7 +602,8 @@ namespace iroha {
       auto cmd = (boost::format(R"(WITH has_my_perm AS (%s),
       has_all_perm AS (%s),
       t AS (
-          SELECT height, hash FROM position_by_hash WHERE hash IN (%s)
+          SELECT height, encode(hash, 'hex') AS hash FROM position_by_hash
+          WHERE hash IN (%s)
       )
       SELECT height, hash, has_my_perm.perm, has_all_perm.perm FROM t
       RIGHT OUTER JOIN has_my_perm ON TRUE
@@ -8,6 +8,8 @@
 
 #include "ametsuchi/query_executor.hpp"
 
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
 #include "ametsuchi/impl/soci_utils.hpp"
 #include "ametsuchi/key_value_storage.hpp"
 #include "ametsuchi/storage.hpp"
@@ -57,7 +59,8 @@ namespace iroha {
           std::shared_ptr<shared_model::interface::QueryResponseFactory>
               response_factory,
           std::shared_ptr<shared_model::interface::PermissionToString>
-              perm_converter);
+              perm_converter,
+          std::shared_ptr<BlockCache> block_cache = nullptr);
 
       void setCreatorId(
           const shared_model::interface::types::AccountIdType &creator_id);
@@ -165,7 +168,8 @@ namespace iroha {
       shared_model::interface::types::AccountIdType creator_id_;
       shared_model::interface::types::HashType query_hash_;
       std::shared_ptr<PendingTransactionStorage> pending_txs_storage_;
-      std::shared_ptr<shared_model::interface::BlockJsonConverter> converter_;
+      BlockStorageFormat block_format_;
+      std::shared_ptr<BlockCache> block_cache_;
       std::shared_ptr<shared_model::interface::QueryResponseFactory>
           query_response_factory_;
       std::shared_ptr<shared_model::interface::PermissionToString>
@@ -184,7 +188,8 @@ namespace iroha {
           std::shared_ptr<shared_model::interface::QueryResponseFactory>
               response_factory,
           std::shared_ptr<shared_model::interface::PermissionToString>
-              perm_converter);
+              perm_converter,
+          std::shared_ptr<BlockCache> block_cache = nullptr);
 
       QueryExecutorResult validateAndExecute(
           const shared_model::interface::Query &query) override;
@@ -0,0 +1,157 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/postgres_query_pool.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    PostgresQueryPool::QuerySession::QuerySession(
+        std::unique_ptr<soci::session> sql, PostgresQueryPool &pool)
+        : sql(std::move(sql)),
+          wsv_query(*this->sql, pool.factory_),
+          block_query(*this->sql,
+                      pool.block_store_,
+                      pool.converter_,
+                      pool.block_cache_) {}
+
+    PostgresQueryPool::PostgresQueryPool(
+        std::shared_ptr<ConnectionPool> connections,
+        KeyValueStorage &block_store,
+        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
+        std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+            converter,
+        std::shared_ptr<BlockCache> block_cache)
+        : connections_(std::move(connections)),
+          block_store_(block_store),
+          factory_(std::move(factory)),
+          converter_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
+          waiting_(0),
+          closed_(false) {}
+
+    expected::Result<std::shared_ptr<WsvQuery>, std::string>
+    PostgresQueryPool::getWsvQuery() {
+      return acquire().match(
+          [this](expected::Value<std::unique_ptr<QuerySession>> &session)
+              -> expected::Result<std::shared_ptr<WsvQuery>, std::string> {
+            return expected::makeValue(
+                this->lend(std::move(session.value), &QuerySession::wsv_query));
+          },
+          [](expected::Error<std::string> &error)
+              -> expected::Result<std::shared_ptr<WsvQuery>, std::string> {
+            return error;
+          });
+    }
+
+    expected::Result<std::shared_ptr<BlockQuery>, std::string>
+    PostgresQueryPool::getBlockQuery() {
+      return acquire().match(
+          [this](expected::Value<std::unique_ptr<QuerySession>> &session)
+              -> expected::Result<std::shared_ptr<BlockQuery>, std::string> {
+            return expected::makeValue(this->lend(
+                std::move(session.value), &QuerySession::block_query));
+          },
+          [](expected::Error<std::string> &error)
+              -> expected::Result<std::shared_ptr<BlockQuery>, std::string> {
+            return error;
+          });
+    }
+
+    expected::Result<std::unique_ptr<soci::session>, std::string>
+    PostgresQueryPool::checkout() {
+      std::unique_ptr<QuerySession> session;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (not idle_.empty()) {
+          session = std::move(idle_.back());
+          idle_.pop_back();
+        } else {
+          ++waiting_;
+        }
+      }
+      if (not session) {
+        return waitConnection();
+      }
+      // queries refer to the connection, so they are destroyed before it is
+      // taken out
+      auto sql = std::move(session->sql);
+      session.reset();
+      return expected::makeValue(std::move(sql));
+    }
+
+    void PostgresQueryPool::close() {
+      std::vector<std::unique_ptr<QuerySession>> idle;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        idle.swap(idle_);
+      }
+    }
+
+    size_t PostgresQueryPool::idle() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return idle_.size();
+    }
+
+    expected::Result<std::unique_ptr<PostgresQueryPool::QuerySession>,
+                     std::string>
+    PostgresQueryPool::acquire() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+          return expected::makeError("Connection was closed");
+        }
+        if (not idle_.empty()) {
+          auto session = std::move(idle_.back());
+          idle_.pop_back();
+          return expected::makeValue(std::move(session));
+        }
+        ++waiting_;
+      }
+      return waitConnection().match(
+          [this](expected::Value<std::unique_ptr<soci::session>> &sql)
+              -> expected::Result<std::unique_ptr<QuerySession>,
+                                  std::string> {
+            return expected::makeValue(
+                std::make_unique<QuerySession>(std::move(sql.value), *this));
+          },
+          [](expected::Error<std::string> &error)
+              -> expected::Result<std::unique_ptr<QuerySession>,
+                                  std::string> { return error; });
+    }
+
+    template <typename Query>
+    std::shared_ptr<Query> PostgresQueryPool::lend(
+        std::unique_ptr<QuerySession> session, Query QuerySession::*query) {
+      auto raw = session.release();
+      std::weak_ptr<PostgresQueryPool> pool = shared_from_this();
+      return std::shared_ptr<Query>(&(raw->*query), [raw, pool](Query *) {
+        std::unique_ptr<QuerySession> session(raw);
+        if (auto locked = pool.lock()) {
+          locked->release(std::move(session));
+        }
+      });
+    }
+
+    void PostgresQueryPool::release(std::unique_ptr<QuerySession> session) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // connection of the session goes back to the connection pool when
+      // someone waits for it there
+      if (not closed_ and waiting_ == 0) {
+        idle_.push_back(std::move(session));
+      }
+    }
+
+    expected::Result<std::unique_ptr<soci::session>, std::string>
+    PostgresQueryPool::waitConnection() {
+      auto result = connections_->checkout();
+      std::lock_guard<std::mutex> lock(mutex_);
+      --waiting_;
+      return result;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_POSTGRES_QUERY_POOL_HPP
+#define IROHA_POSTGRES_QUERY_POOL_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/connection_pool.hpp"
+#include "ametsuchi/impl/postgres_block_query.hpp"
+#include "ametsuchi/impl/postgres_wsv_query.hpp"
+#include "interfaces/common_objects/common_objects_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Reuses block and WSV queries together with their connections and
+     * prepared statements, instead of creating new ones for every request.
+     *
+     * A query is used by a single owner at a time, and goes back to the pool
+     * when the last pointer to it is destroyed. Idle queries keep their
+     * connections, so connections are taken from idle queries first, and
+     * returned queries are dropped while someone waits for the connection
+     * pool.
+     */
+    class PostgresQueryPool
+        : public std::enable_shared_from_this<PostgresQueryPool> {
+     public:
+      PostgresQueryPool(
+          std::shared_ptr<ConnectionPool> connections,
+          KeyValueStorage &block_store,
+          std::shared_ptr<shared_model::interface::CommonObjectsFactory>
+              factory,
+          std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+              converter,
+          std::shared_ptr<BlockCache> block_cache);
+
+      expected::Result<std::shared_ptr<WsvQuery>, std::string> getWsvQuery();
+
+      expected::Result<std::shared_ptr<BlockQuery>, std::string>
+      getBlockQuery();
+
+      /**
+       * Take a connection for exclusive use, from an idle query if there is
+       * one
+       */
+      expected::Result<std::unique_ptr<soci::session>, std::string>
+      checkout();
+
+      /**
+       * Close idle queries and stop keeping returned ones, so that all
+       * connections get back to the connection pool
+       */
+      void close();
+
+      /**
+       * @return number of idle queries
+       */
+      size_t idle() const;
+
+     private:
+      /// connection with queries over it
+      struct QuerySession {
+        QuerySession(std::unique_ptr<soci::session> sql,
+                     PostgresQueryPool &pool);
+
+        std::unique_ptr<soci::session> sql;
+        PostgresWsvQuery wsv_query;
+        PostgresBlockQuery block_query;
+      };
+
+      /**
+       * @return idle query session or a new one
+       */
+      expected::Result<std::unique_ptr<QuerySession>, std::string> acquire();
+
+      /**
+       * Wrap a query of the session into a pointer which puts the session
+       * back to the pool when destroyed
+       */
+      template <typename Query>
+      std::shared_ptr<Query> lend(std::unique_ptr<QuerySession> session,
+                                  Query QuerySession::*query);
+
+      void release(std::unique_ptr<QuerySession> session);
+
+      /**
+       * Check out a connection from the connection pool, must be called
+       * after waiting_ is incremented
+       */
+      expected::Result<std::unique_ptr<soci::session>, std::string>
+      waitConnection();
+
+      std::shared_ptr<ConnectionPool> connections_;
+      KeyValueStorage &block_store_;
+      std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
+      std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+          converter_;
+      std::shared_ptr<BlockCache> block_cache_;
+
+      mutable std::mutex mutex_;
+      std::vector<std::unique_ptr<QuerySession>> idle_;
+      /// number of callers waiting for the connection pool
+      size_t waiting_;
+      bool closed_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_QUERY_POOL_HPP
@@ -308,19 +308,30 @@ namespace iroha {
 
     boost::optional<std::vector<std::shared_ptr<shared_model::interface::Peer>>>
     PostgresWsvQuery::getPeers() {
-      using T = boost::tuple<std::string, AddressType>;
-      auto result = execute<T>([&] {
-        return (sql_.prepare << "SELECT public_key, address FROM peer");
-      });
-
-      return flatMapValues<
-          std::vector<std::shared_ptr<shared_model::interface::Peer>>>(
-          result, [&](auto &public_key, auto &address) {
-            return this->fromResult(factory_->createPeer(
-                address,
-                shared_model::crypto::PublicKey{
-                    shared_model::crypto::Blob::fromHexString(public_key)}));
-          });
+      std::vector<std::shared_ptr<shared_model::interface::Peer>> peers;
+      try {
+        if (not peers_statement_) {
+          peers_statement_ = std::make_unique<soci::statement>(
+              (sql_.prepare << "SELECT public_key, address FROM peer",
+               soci::into(peer_key_),
+               soci::into(peer_address_)));
+        }
+        peers_statement_->execute();
+        while (peers_statement_->fetch()) {
+          auto peer = this->fromResult(factory_->createPeer(
+              peer_address_,
+              shared_model::crypto::PublicKey{
+                  shared_model::crypto::Blob::fromHexString(peer_key_)}));
+          if (peer) {
+            peers.push_back(std::move(*peer));
+          }
+        }
+      } catch (const std::exception &e) {
+        log_->error("Failed to execute query: {}", e.what());
+        peers_statement_.reset();
+        return boost::none;
+      }
+      return peers;
     }
   }  // namespace ametsuchi
 }  // namespace iroha
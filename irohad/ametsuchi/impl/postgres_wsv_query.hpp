@@ -118,6 +118,12 @@ namespace iroha {
       soci::session &sql_;
       std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
       logger::Logger log_;
+
+      /// peers query prepared on first use and reused while the object
+      /// lives, bound to the two fields below
+      std::unique_ptr<soci::statement> peers_statement_;
+      std::string peer_key_;
+      std::string peer_address_;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -5,10 +5,10 @@
 
 #include "ametsuchi/impl/storage_impl.hpp"
 
+#include <soci/boost-tuple.h>
 #include <soci/postgresql/soci-postgresql.h>
 #include <boost/format.hpp>
 
-#include "ametsuchi/impl/flat_file/flat_file.hpp"
 #include "ametsuchi/impl/mutable_storage_impl.hpp"
 #include "ametsuchi/impl/peer_query_wsv.hpp"
 #include "ametsuchi/impl/postgres_block_index.hpp"
@@ -24,11 +24,10 @@
 #include "postgres_ordering_service_persistent_state.hpp"
 
 namespace {
-  void prepareStatements(soci::connection_pool &connections, size_t pool_size) {
-    for (size_t i = 0; i != pool_size; i++) {
-      soci::session &session = connections.at(i);
+  void prepareStatements(iroha::ametsuchi::ConnectionPool &connections) {
+    connections.forEach([](soci::session &session) {
       iroha::ametsuchi::PostgresCommandExecutor::prepareStatements(session);
-    }
+    });
   }
 
   /**
@@ -40,6 +39,170 @@ namespace {
     return prepared_txs_count != 0;
   }
 
+  /**
+   * Fill tx hash index from block index tables, committed transactions are
+   * read in ranges of heights to bound memory taken by a single result
+   */
+  void loadTxHashIndex(soci::session &sql,
+                       iroha::ametsuchi::TxHashIndex &tx_hash_index) {
+    using shared_model::interface::types::HeightType;
+    const HeightType kHeightsPerQuery = 10000;
+
+    boost::optional<HeightType> top_height;
+    sql << "SELECT max(height) FROM position_by_hash", soci::into(top_height);
+    for (HeightType from = 0; from < top_height.value_or(0);
+         from += kHeightsPerQuery) {
+      const HeightType to = from + kHeightsPerQuery;
+      soci::rowset<boost::tuple<std::string, HeightType, uint64_t>> rows =
+          (sql.prepare << "SELECT encode(hash, 'hex'), height, index "
+                          "FROM position_by_hash "
+                          "WHERE height > :from AND height <= :to",
+           soci::use(from),
+           soci::use(to));
+      for (const auto &row : rows) {
+        tx_hash_index.insertCommitted(
+            shared_model::crypto::Hash::fromHexString(row.get<0>()),
+            row.get<1>(),
+            static_cast<uint32_t>(row.get<2>()));
+      }
+    }
+
+    soci::rowset<std::string> rejected =
+        (sql.prepare << "SELECT encode(hash, 'hex') FROM tx_status_by_hash "
+                        "WHERE NOT status");
+    for (const auto &hash : rejected) {
+      tx_hash_index.insertRejected(
+          shared_model::crypto::Hash::fromHexString(hash));
+    }
+  }
+
+  /**
+   * Block index table of databases created before typed columns, which
+   * keeps heights and indexes as text and hashes as hex strings
+   */
+  struct TextIndexTable {
+    const char *name;
+    /// definition of typed columns
+    const char *columns;
+    /// names of columns, the same in both tables
+    const char *names;
+    /// expressions converting text columns to typed ones
+    const char *converted;
+    /// text column by which rows are split into batches
+    const char *key;
+  };
+
+  const TextIndexTable kTextIndexTables[] = {
+      {"position_by_hash",
+       "hash bytea, height bigint, index bigint",
+       "hash, height, index",
+       "decode(hash, 'hex'), height::bigint, index::bigint",
+       "height"},
+      {"tx_status_by_hash",
+       "hash bytea, status boolean",
+       "hash, status",
+       "decode(hash, 'hex'), status",
+       "hash"},
+      {"height_by_account_set",
+       "account_id text, height bigint",
+       "account_id, height",
+       "account_id, height::bigint",
+       "height"},
+      {"index_by_creator_height",
+       "id serial, creator_id text, height bigint, index bigint",
+       "id, creator_id, height, index",
+       "id, creator_id, height::bigint, index::bigint",
+       "height"},
+      {"position_by_account_asset",
+       "account_id text, asset_id text, height bigint, index bigint",
+       "account_id, asset_id, height, index",
+       "account_id, asset_id, height::bigint, index::bigint",
+       "height"}};
+
+  /**
+   * Convert block index tables with text columns to typed ones. Rows are
+   * copied to new tables in batches, each in its own transaction, so the
+   * old tables are never locked exclusively during the copy. New tables
+   * replace the old ones in a single short transaction at the end, and a
+   * copy interrupted before it is started over on the next startup.
+   * It runs before storage is created, so the peer is offline for the
+   * whole copy: queries only work with typed columns, and the old tables
+   * cannot serve them
+   */
+  void migrateTextIndexTables(soci::session &sql,
+                              const logger::Logger &log) {
+    const int kRowsPerBatch = 10000;
+
+    int text_columns = 0;
+    sql << "SELECT count(*) FROM information_schema.columns "
+           "WHERE table_schema = current_schema() "
+           "AND table_name = 'position_by_hash' "
+           "AND column_name = 'height' AND data_type = 'text'",
+        soci::into(text_columns);
+    if (text_columns == 0) {
+      return;
+    }
+
+    for (const auto &table : kTextIndexTables) {
+      const std::string name = table.name;
+      const std::string typed = name + "_typed";
+      const std::string key = table.key;
+      log->info("converting block index table {}", name);
+      // batches are selected by ranges of the key, the index is dropped
+      // with the old table
+      sql << "CREATE INDEX IF NOT EXISTS " + name + "_migration_index ON "
+              + name + " (" + key + ")";
+      sql << "DROP TABLE IF EXISTS " + typed;
+      sql << "CREATE TABLE " + typed + " (" + table.columns + ")";
+
+      std::string last;
+      boost::optional<std::string> upto;
+      size_t batches = 0;
+      while (true) {
+        upto = boost::none;
+        sql << "SELECT max(k) FROM (SELECT " + key + " AS k FROM " + name
+                + " WHERE " + key + " > :last ORDER BY " + key
+                + " LIMIT :limit) batch",
+            soci::into(upto), soci::use(last), soci::use(kRowsPerBatch);
+        if (not upto) {
+          break;
+        }
+        sql << "INSERT INTO " + typed + " (" + table.names + ") SELECT "
+                + table.converted + " FROM " + name + " WHERE " + key
+                + " > :last AND " + key + " <= :upto",
+            soci::use(last), soci::use(*upto);
+        last = *upto;
+        ++batches;
+      }
+      log->info("copied table {} in {} batches", name, batches);
+    }
+
+    soci::transaction swap(sql);
+    for (const auto &table : kTextIndexTables) {
+      const std::string name = table.name;
+      sql << "DROP TABLE " + name;
+      sql << "ALTER TABLE " + name + "_typed RENAME TO " + name;
+    }
+    // sequence of the old table is dropped with it, ids are copied as is
+    sql << "SELECT setval('index_by_creator_height_typed_id_seq', "
+           "(SELECT coalesce(max(id), 0) + 1 FROM index_by_creator_height), "
+           "false)";
+    sql << "ALTER SEQUENCE index_by_creator_height_typed_id_seq "
+           "RENAME TO index_by_creator_height_id_seq";
+    swap.commit();
+  }
+
+  /**
+   * @return folder of WSV snapshots next to block store folder
+   */
+  std::string wsvSnapshotDir(const std::string &block_store_dir) {
+    auto dir = block_store_dir;
+    while (dir.size() > 1 and dir.back() == '/') {
+      dir.pop_back();
+    }
+    return dir + ".snapshots";
+  }
+
 }  // namespace
 
 namespace iroha {
@@ -48,6 +211,8 @@ namespace iroha {
     const char *kPsqlBroken = "Connection to PostgreSQL broken: %s";
     const char *kTmpWsv = "TemporaryWsv";
 
+    const size_t StorageImpl::kBlockCacheSize;
+
     ConnectionContext::ConnectionContext(
         std::unique_ptr<KeyValueStorage> block_store)
         : block_store(std::move(block_store)) {}
@@ -56,47 +221,114 @@ namespace iroha {
         std::string block_store_dir,
         PostgresOptions postgres_options,
         std::unique_ptr<KeyValueStorage> block_store,
-        std::shared_ptr<soci::connection_pool> connection,
+        std::shared_ptr<ConnectionPool> query_pool,
+        std::shared_ptr<ConnectionPool> validation_pool,
+        std::shared_ptr<ConnectionPool> commit_pool,
         std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
         std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
-        size_t pool_size,
-        bool enable_prepared_blocks)
+        bool enable_prepared_blocks,
+        shared_model::interface::types::HeightType wsv_snapshot_interval,
+        bool pipelined_validation,
+        bool wsv_cache,
+        bool async_commit)
         : block_store_dir_(std::move(block_store_dir)),
           postgres_options_(std::move(postgres_options)),
           block_store_(std::move(block_store)),
-          connection_(std::move(connection)),
+          commit_pipeline_(nullptr),
+          block_cache_(std::make_shared<BlockCache>(kBlockCacheSize)),
+          tx_hash_index_(std::make_shared<TxHashIndex>()),
+          query_pool_(std::move(query_pool)),
+          validation_pool_(std::move(validation_pool)),
+          commit_pool_(std::move(commit_pool)),
           factory_(std::move(factory)),
           converter_(std::move(converter)),
+          block_format_(converter_),
           perm_converter_(std::move(perm_converter)),
           log_(logger::log("StorageImpl")),
-          pool_size_(pool_size),
           prepared_blocks_enabled_(enable_prepared_blocks),
-          block_is_prepared(false) {
+          block_is_prepared(false),
+          wsv_snapshots_(wsvSnapshotDir(block_store_dir_)),
+          wsv_snapshot_interval_(wsv_snapshot_interval),
+          wsv_snapshot_in_progress_(false),
+          pipelined_validation_(pipelined_validation),
+          wsv_cache_(wsv_cache ? std::make_shared<WsvCache>() : nullptr) {
       prepared_block_name_ =
           "prepared_block" + postgres_options_.dbname().value_or("");
-      soci::session sql(*connection_);
-      // rollback current prepared transaction
-      // if there exists any since last session
-      if (prepared_blocks_enabled_) {
-        rollbackPrepared(sql);
+      if (async_commit) {
+        auto pipeline = std::make_unique<CommitPipeline>(
+            std::move(block_store_),
+            [this](const auto &block) { return this->indexBlock(block); },
+            [this](auto block) {
+              notifier_.get_subscriber().on_next(std::move(block));
+            });
+        commit_pipeline_ = pipeline.get();
+        block_store_ = std::move(pipeline);
+      }
+      query_sessions_ = std::make_shared<PostgresQueryPool>(
+          query_pool_, *block_store_, factory_, converter_, block_cache_);
+    }
+
+    expected::Result<void, std::string> StorageImpl::initialize() {
+      auto session = checkout(commit_pool_);
+      if (auto error = boost::get<expected::Error<std::string>>(&session)) {
+        return expected::makeError("cannot initialize storage: "
+                                   + error->error);
+      }
+      try {
+        {
+          auto sql = std::move(
+              boost::get<expected::Value<std::unique_ptr<soci::session>>>(
+                  session)
+                  .value);
+          // rollback current prepared transaction
+          // if there exists any since last session
+          if (prepared_blocks_enabled_) {
+            rollbackPrepared(*sql);
+          }
+          migrateTextIndexTables(*sql, log_);
+          *sql << init_;
+          loadTxHashIndex(*sql, *tx_hash_index_);
+          log_->info("loaded {} transaction hashes", tx_hash_index_->size());
+        }
+        // only temporary WSVs and mutable storages execute commands, every
+        // connection is prepared after the session is returned
+        prepareStatements(*validation_pool_);
+        prepareStatements(*commit_pool_);
+      } catch (const std::exception &e) {
+        return expected::makeError(
+            std::string("cannot initialize storage: ") + e.what());
+      }
+      return {};
+    }
+
+    expected::Result<std::unique_ptr<soci::session>, std::string>
+    StorageImpl::checkout(const std::shared_ptr<ConnectionPool> &pool) {
+      if (not pool) {
+        return expected::makeError("Connection was closed");
       }
-      sql << init_;
-      prepareStatements(*connection_, pool_size_);
+      return pool->checkout();
     }
 
     expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
     StorageImpl::createTemporaryWsv() {
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
-      if (connection_ == nullptr) {
-        return expected::makeError("Connection was closed");
+      auto sql = checkout(validation_pool_);
+      if (auto error = boost::get<expected::Error<std::string>>(&sql)) {
+        return *error;
       }
-      auto sql = std::make_unique<soci::session>(*connection_);
 
       return expected::makeValue<std::unique_ptr<TemporaryWsv>>(
           std::make_unique<TemporaryWsvImpl>(
-              std::move(sql), factory_, perm_converter_));
+              std::move(
+                  boost::get<expected::Value<std::unique_ptr<soci::session>>>(
+                      sql)
+                      .value),
+              factory_,
+              perm_converter_,
+              pipelined_validation_,
+              wsv_cache_));
     }
 
     expected::Result<std::unique_ptr<MutableStorage>, std::string>
@@ -104,18 +336,30 @@ namespace iroha {
       boost::optional<shared_model::interface::types::HashType> top_hash;
 
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
-      if (connection_ == nullptr) {
-        return expected::makeError("Connection was closed");
+      auto session = checkout(commit_pool_);
+      if (auto error = boost::get<expected::Error<std::string>>(&session)) {
+        return *error;
       }
 
-      auto sql = std::make_unique<soci::session>(*connection_);
+      if (blockStoreFailed()) {
+        return expected::makeError(
+            "block store cannot write blocks, commits are stopped");
+      }
+
+      auto sql = std::move(
+          boost::get<expected::Value<std::unique_ptr<soci::session>>>(session)
+              .value);
       // if we create mutable storage, then we intend to mutate wsv
       // this means that any state prepared before that moment is not needed
       // and must be removed to preventy locking
       if (block_is_prepared) {
         rollbackPrepared(*sql);
       }
-      auto block_result = getBlockQuery()->getTopBlock();
+      // top block is read with the commit connection, so commit does not
+      // wait for a connection of queries
+      auto block_result =
+          PostgresBlockQuery(*sql, *block_store_, converter_, block_cache_)
+              .getTopBlock();
       return expected::makeValue<std::unique_ptr<MutableStorage>>(
           std::make_unique<MutableStorageImpl>(
               block_result.match(
@@ -128,7 +372,9 @@ namespace iroha {
                   }),
               std::make_shared<PostgresCommandExecutor>(*sql, perm_converter_),
               std::move(sql),
-              factory_));
+              factory_,
+              // commit pipeline indexes blocks after WSV is committed
+              commit_pipeline_ == nullptr));
     }
 
     boost::optional<std::shared_ptr<PeerQuery>> StorageImpl::createPeerQuery()
@@ -154,14 +400,20 @@ namespace iroha {
     StorageImpl::createOsPersistentState() const {
       log_->info("create ordering service persistent state");
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
-      if (not connection_) {
-        log_->info("connection to database is not initialised");
-        return boost::none;
-      }
-      return boost::make_optional<
-          std::shared_ptr<OrderingServicePersistentState>>(
-          std::make_shared<PostgresOrderingServicePersistentState>(
-              std::make_unique<soci::session>(*connection_)));
+      return checkout(commit_pool_)
+          .match(
+              [](expected::Value<std::unique_ptr<soci::session>> &sql) {
+                return boost::make_optional<
+                    std::shared_ptr<OrderingServicePersistentState>>(
+                    std::make_shared<PostgresOrderingServicePersistentState>(
+                        std::move(sql.value)));
+              },
+              [this](expected::Error<std::string> &error)
+                  -> boost::optional<
+                      std::shared_ptr<OrderingServicePersistentState>> {
+                log_->warn(error.error);
+                return boost::none;
+              });
     }
 
     boost::optional<std::shared_ptr<QueryExecutor>>
@@ -170,18 +422,27 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::QueryResponseFactory>
             response_factory) const {
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
-      if (not connection_) {
-        log_->info("connection to database is not initialised");
+      if (not query_sessions_) {
+        log_->warn("Connection was closed");
         return boost::none;
       }
-      return boost::make_optional<std::shared_ptr<QueryExecutor>>(
-          std::make_shared<PostgresQueryExecutor>(
-              std::make_unique<soci::session>(*connection_),
-              *block_store_,
-              std::move(pending_txs_storage),
-              converter_,
-              std::move(response_factory),
-              perm_converter_));
+      return query_sessions_->checkout().match(
+          [&](expected::Value<std::unique_ptr<soci::session>> &sql) {
+            return boost::make_optional<std::shared_ptr<QueryExecutor>>(
+                std::make_shared<PostgresQueryExecutor>(
+                    std::move(sql.value),
+                    *block_store_,
+                    std::move(pending_txs_storage),
+                    converter_,
+                    std::move(response_factory),
+                    perm_converter_,
+                    block_cache_));
+          },
+          [this](expected::Error<std::string> &error)
+              -> boost::optional<std::shared_ptr<QueryExecutor>> {
+            log_->warn(error.error);
+            return boost::none;
+          });
     }
 
     bool StorageImpl::insertBlock(const shared_model::interface::Block &block) {
@@ -226,17 +487,70 @@ namespace iroha {
     }
 
     void StorageImpl::reset() {
-      log_->info("drop wsv records from db tables");
-      soci::session sql(*connection_);
-      sql << reset_;
+      resetWsv();
 
       log_->info("drop blocks from disk");
       block_store_->dropAll();
+      block_cache_->clear();
+      tx_hash_index_->clear();
+    }
+
+    void StorageImpl::resetWsv() {
+      // indexing of pushed blocks would refill the tables
+      flushCommitPipeline();
+      log_->info("drop wsv records from db tables");
+      checkout(commit_pool_)
+          .match(
+              [](expected::Value<std::unique_ptr<soci::session>> &sql) {
+                *sql.value << reset_;
+              },
+              [this](expected::Error<std::string> &error) {
+                log_->error("cannot drop wsv: {}", error.error);
+              });
+      if (wsv_cache_) {
+        wsv_cache_->clear();
+      }
+    }
+
+    shared_model::interface::types::HeightType StorageImpl::loadWsvSnapshot() {
+      auto block_query = getBlockQuery();
+      if (not block_query) {
+        return 0;
+      }
+      for (const auto &snapshot : wsv_snapshots_.list()) {
+        // snapshot is valid only for the chain it was taken from
+        auto blocks = block_query->getBlocks(snapshot.height, 1);
+        if (blocks.empty() or blocks.front()->hash().hex() != snapshot.hash) {
+          log_->info("skip wsv snapshot {} of unknown block {}",
+                     snapshot.path,
+                     snapshot.height);
+          continue;
+        }
+        auto result = checkout(commit_pool_) |
+            [&](const std::unique_ptr<soci::session> &sql) {
+              return wsv_snapshots_.load(*sql, snapshot);
+            };
+        if (auto error = boost::get<expected::Error<std::string>>(&result)) {
+          log_->warn("cannot load wsv snapshot {}: {}",
+                     snapshot.path,
+                     error->error);
+          resetWsv();
+          continue;
+        }
+        log_->info("loaded wsv snapshot of block {}", snapshot.height);
+        if (wsv_cache_) {
+          wsv_cache_->clear();
+        }
+        return snapshot.height;
+      }
+      return 0;
     }
 
     void StorageImpl::dropStorage() {
       log_->info("drop storage");
-      if (connection_ == nullptr) {
+      // pushed blocks are indexed under shared drop mutex
+      flushCommitPipeline();
+      if (commit_pool_ == nullptr) {
         log_->warn("Tried to drop storage without active connection");
         return;
       }
@@ -251,32 +565,51 @@ namespace iroha {
         // perform dropping
         sql << "DROP DATABASE " + db;
       } else {
-        soci::session(*connection_) << drop_;
+        checkout(commit_pool_)
+            .match(
+                [](expected::Value<std::unique_ptr<soci::session>> &sql) {
+                  *sql.value << drop_;
+                },
+                [this](expected::Error<std::string> &error) {
+                  log_->error("cannot drop storage: {}", error.error);
+                });
       }
 
       // erase blocks
       log_->info("drop block store");
       block_store_->dropAll();
+      block_cache_->clear();
+      tx_hash_index_->clear();
+      if (wsv_cache_) {
+        wsv_cache_->clear();
+      }
     }
 
     void StorageImpl::freeConnections() {
-      if (connection_ == nullptr) {
+      flushCommitPipeline();
+      waitWsvSnapshot();
+      if (commit_pool_ == nullptr) {
         log_->warn("Tried to free connections without active connection");
         return;
       }
       // rollback possible prepared transaction
       if (block_is_prepared) {
-        soci::session sql(*connection_);
-        rollbackPrepared(sql);
+        checkout(commit_pool_)
+            .match(
+                [this](expected::Value<std::unique_ptr<soci::session>> &sql) {
+                  rollbackPrepared(*sql.value);
+                },
+                [this](expected::Error<std::string> &error) {
+                  log_->warn(error.error);
+                });
       }
-      std::vector<std::shared_ptr<soci::session>> connections;
-      for (size_t i = 0; i < pool_size_; i++) {
-        connections.push_back(std::make_shared<soci::session>(*connection_));
-        connections[i]->close();
-        log_->debug("Closed connection {}", i);
+      // idle queries hold connections of query pool
+      query_sessions_->close();
+      query_sessions_.reset();
+      for (auto pool : {&query_pool_, &validation_pool_, &commit_pool_}) {
+        (*pool)->close();
+        pool->reset();
       }
-      connections.clear();
-      connection_.reset();
     }
 
     expected::Result<bool, std::string> StorageImpl::createDatabaseIfNotExist(
@@ -306,33 +639,28 @@ namespace iroha {
     }
 
     expected::Result<ConnectionContext, std::string>
-    StorageImpl::initConnections(std::string block_store_dir) {
+    StorageImpl::initConnections(std::string block_store_dir,
+                                 const BlockStorageFormat &block_format,
+                                 BlockStorageType block_storage_type,
+                                 SyncOptions block_store_sync) {
       auto log_ = logger::log("StorageImpl:initConnection");
       log_->info("Start storage creation");
 
-      auto block_store = FlatFile::create(block_store_dir);
-      if (not block_store) {
-        return expected::makeError(
-            (boost::format("Cannot create block store in %s") % block_store_dir)
-                .str());
+      auto block_store = createBlockStore(block_store_dir,
+                                          block_format,
+                                          block_storage_type,
+                                          block_store_sync);
+      if (auto error = boost::get<expected::Error<std::string>>(&block_store)) {
+        return *error;
       }
       log_->info("block store created");
 
-      return expected::makeValue(ConnectionContext(std::move(*block_store)));
+      return expected::makeValue(ConnectionContext(std::move(
+          boost::get<expected::Value<std::unique_ptr<KeyValueStorage>>>(
+              block_store)
+              .value)));
     }
 
-    expected::Result<std::shared_ptr<soci::connection_pool>, std::string>
-    StorageImpl::initPostgresConnection(std::string &options_str,
-                                        size_t pool_size) {
-      auto pool = std::make_shared<soci::connection_pool>(pool_size);
-
-      for (size_t i = 0; i != pool_size; i++) {
-        soci::session &session = pool->at(i);
-        session.open(soci::postgresql, options_str);
-      }
-      return expected::makeValue(pool);
-    };
-
     expected::Result<std::shared_ptr<StorageImpl>, std::string>
     StorageImpl::create(
         std::string block_store_dir,
@@ -341,7 +669,13 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
-        size_t pool_size) {
+        PoolOptions pool_options,
+        BlockStorageType block_storage_type,
+        shared_model::interface::types::HeightType wsv_snapshot_interval,
+        bool pipelined_validation,
+        bool wsv_cache,
+        bool async_commit,
+        SyncOptions block_store_sync) {
       boost::optional<std::string> string_res = boost::none;
 
       PostgresOptions options(postgres_options);
@@ -359,42 +693,119 @@ namespace iroha {
         return expected::makeError(string_res.value());
       }
 
-      auto ctx_result = initConnections(block_store_dir);
-      auto db_result = initPostgresConnection(postgres_options, pool_size);
-      expected::Result<std::shared_ptr<StorageImpl>, std::string> storage;
-      ctx_result.match(
-          [&](expected::Value<ConnectionContext> &ctx) {
-            db_result.match(
-                [&](expected::Value<std::shared_ptr<soci::connection_pool>>
-                        &connection) {
-                  soci::session sql(*connection.value);
-                  bool enable_prepared_transactions =
-                      preparedTransactionsAvailable(sql);
-                  storage = expected::makeValue(std::shared_ptr<StorageImpl>(
-                      new StorageImpl(block_store_dir,
-                                      options,
-                                      std::move(ctx.value.block_store),
-                                      connection.value,
-                                      factory,
-                                      converter,
-                                      perm_converter,
-                                      pool_size,
-                                      enable_prepared_transactions)));
-                },
-                [&](expected::Error<std::string> &error) { storage = error; });
-          },
-          [&](expected::Error<std::string> &error) { storage = error; });
-      return storage;
+      auto ctx_result = initConnections(block_store_dir,
+                                        BlockStorageFormat(converter),
+                                        block_storage_type,
+                                        block_store_sync);
+      if (auto error = boost::get<expected::Error<std::string>>(&ctx_result)) {
+        return *error;
+      }
+
+      // query, validation and commit pools
+      std::vector<std::shared_ptr<ConnectionPool>> pools;
+      for (const auto &pool :
+           {std::make_pair("query", pool_options.query_pool_size),
+            std::make_pair("validation", pool_options.validation_pool_size),
+            std::make_pair("commit", pool_options.commit_pool_size)}) {
+        auto result = ConnectionPool::create(pool.first,
+                                             pool.second,
+                                             pool_options.checkout_timeout,
+                                             postgres_options);
+        if (auto error = boost::get<expected::Error<std::string>>(&result)) {
+          return *error;
+        }
+        pools.push_back(
+            boost::get<expected::Value<std::shared_ptr<ConnectionPool>>>(
+                result)
+                .value);
+      }
+
+      auto prepared_transactions = pools[2]->checkout() |
+          [](const std::unique_ptr<soci::session> &sql)
+          -> expected::Result<bool, std::string> {
+        return expected::makeValue(preparedTransactionsAvailable(*sql));
+      };
+      if (auto error = boost::get<expected::Error<std::string>>(
+              &prepared_transactions)) {
+        return *error;
+      }
+
+      std::shared_ptr<StorageImpl> storage(new StorageImpl(
+          block_store_dir,
+          options,
+          std::move(
+              boost::get<expected::Value<ConnectionContext>>(ctx_result)
+                  .value.block_store),
+          pools[0],
+          pools[1],
+          pools[2],
+          factory,
+          converter,
+          perm_converter,
+          boost::get<expected::Value<bool>>(prepared_transactions).value,
+          wsv_snapshot_interval,
+          pipelined_validation,
+          wsv_cache,
+          async_commit));
+      auto initialized = storage->initialize();
+      if (auto error = boost::get<expected::Error<std::string>>(&initialized)) {
+        return *error;
+      }
+      return expected::makeValue(storage);
     }
 
     void StorageImpl::commit(std::unique_ptr<MutableStorage> mutableStorage) {
       auto storage_ptr = std::move(mutableStorage);  // get ownership of storage
       auto storage = static_cast<MutableStorageImpl *>(storage_ptr.get());
+      if (commit_pipeline_) {
+        // WSV must not get ahead of blocks which cannot be written, it is
+        // rolled back by mutable storage
+        if (blockStoreFailed()) {
+          log_->error("block store cannot write blocks, WSV is not committed");
+          return;
+        }
+        // pipeline writes blocks after WSV is committed, so their heights
+        // are checked before it
+        for (const auto &block : storage->block_store_) {
+          if (conflictsWithStoredBlock(*block.second)) {
+            log_->error("block {} differs from the stored one, WSV is not "
+                        "committed",
+                        block.first);
+            return;
+          }
+        }
+        // blocks are pushed after WSV is committed, so they are not read
+        // before the state they lead to
+        *(storage->sql_) << "COMMIT";
+        storage->committed = true;
+        for (const auto &block : storage->block_store_) {
+          storeBlock(*block.second);
+        }
+      } else {
+        for (const auto &block : storage->block_store_) {
+          if (not storeBlock(*block.second)) {
+            log_->error("cannot store block {}, WSV is not committed",
+                        block.first);
+            return;
+          }
+        }
+        *(storage->sql_) << "COMMIT";
+        storage->committed = true;
+      }
       for (const auto &block : storage->block_store_) {
-        storeBlock(*block.second);
+        invalidateWsvCache(*block.second);
+      }
+
+      if (not storage->block_store_.empty()) {
+        const auto &top = *storage->block_store_.rbegin()->second;
+        const auto from = storage->block_store_.begin()->first - 1;
+        // snapshot includes block index tables, so it waits for them to
+        // reach the committed WSV
+        if (wsvSnapshotDue(from, top.height())) {
+          flushCommitPipeline();
+        }
+        snapshotWsv(from, top.height(), top.hash());
       }
-      *(storage->sql_) << "COMMIT";
-      storage->committed = true;
     }
 
     bool StorageImpl::commitPrepared(
@@ -408,19 +819,34 @@ namespace iroha {
         log_->info("there are no prepared blocks");
         return false;
       }
+      if (blockStoreFailed()) {
+        log_->error("block store cannot write blocks, prepared block {} is "
+                    "not committed",
+                    block.hash().hex());
+        return false;
+      }
       log_->info("applying prepared block");
 
       try {
         std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
-        if (not connection_) {
-          log_->info("connection to database is not initialised");
+        auto session = checkout(commit_pool_);
+        if (auto error = boost::get<expected::Error<std::string>>(&session)) {
+          log_->warn(error->error);
           return false;
         }
-        soci::session sql(*connection_);
+        soci::session &sql =
+            *boost::get<expected::Value<std::unique_ptr<soci::session>>>(
+                 session)
+                 .value;
         sql << "COMMIT PREPARED '" + prepared_block_name_ + "';";
-        PostgresBlockIndex block_index(sql);
-        block_index.index(block);
+        // WSV is already committed, so the block is stored anyway and only
+        // its transactions are missing from block queries
+        if (not commit_pipeline_ and not indexBlock(sql, block)) {
+          log_->error("prepared block {} is committed without index",
+                      block.height());
+        }
         block_is_prepared = false;
+        invalidateWsvCache(block);
       } catch (const std::exception &e) {
         log_->warn("failed to apply prepared block {}: {}",
                    block.hash().hex(),
@@ -428,29 +854,48 @@ namespace iroha {
         return false;
       }
 
-      return storeBlock(block);
+      if (not storeBlock(block)) {
+        return false;
+      }
+      if (wsvSnapshotDue(block.height() - 1, block.height())) {
+        flushCommitPipeline();
+      }
+      snapshotWsv(block.height() - 1, block.height(), block.hash());
+      return true;
     }
 
     std::shared_ptr<WsvQuery> StorageImpl::getWsvQuery() const {
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
-      if (not connection_) {
-        log_->info("connection to database is not initialised");
+      if (not query_sessions_) {
+        log_->warn("Connection was closed");
         return nullptr;
       }
-      return std::make_shared<PostgresWsvQuery>(
-          std::make_unique<soci::session>(*connection_), factory_);
+      return query_sessions_->getWsvQuery().match(
+          [](expected::Value<std::shared_ptr<WsvQuery>> &query) {
+            return query.value;
+          },
+          [this](expected::Error<std::string> &error)
+              -> std::shared_ptr<WsvQuery> {
+            log_->warn(error.error);
+            return nullptr;
+          });
     }
 
     std::shared_ptr<BlockQuery> StorageImpl::getBlockQuery() const {
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
-      if (not connection_) {
-        log_->info("connection to database is not initialised");
+      if (not query_sessions_) {
+        log_->warn("Connection was closed");
         return nullptr;
       }
-      return std::make_shared<PostgresBlockQuery>(
-          std::make_unique<soci::session>(*connection_),
-          *block_store_,
-          converter_);
+      return query_sessions_->getBlockQuery().match(
+          [](expected::Value<std::shared_ptr<BlockQuery>> &query) {
+            return query.value;
+          },
+          [this](expected::Error<std::string> &error)
+              -> std::shared_ptr<BlockQuery> {
+            log_->warn(error.error);
+            return nullptr;
+          });
     }
 
     rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
@@ -458,6 +903,18 @@ namespace iroha {
       return notifier_.get_observable();
     }
 
+    std::shared_ptr<const BlockCache> StorageImpl::blockCache() const {
+      return block_cache_;
+    }
+
+    std::shared_ptr<const TxHashIndex> StorageImpl::txHashIndex() const {
+      return tx_hash_index_;
+    }
+
+    std::shared_ptr<const WsvCache> StorageImpl::wsvCache() const {
+      return wsv_cache_;
+    }
+
     void StorageImpl::prepareBlock(std::unique_ptr<TemporaryWsv> wsv) {
       auto &wsv_impl = static_cast<TemporaryWsvImpl &>(*wsv);
       if (not prepared_blocks_enabled_) {
@@ -477,6 +934,76 @@ namespace iroha {
       }
     }
 
+    void StorageImpl::snapshotWsv(
+        shared_model::interface::types::HeightType from,
+        shared_model::interface::types::HeightType to,
+        const shared_model::interface::types::HashType &hash) {
+      if (not wsvSnapshotDue(from, to)) {
+        return;
+      }
+      if (wsv_snapshot_in_progress_) {
+        log_->info("skip wsv snapshot of block {}, previous one is not done",
+                   to);
+        return;
+      }
+      waitWsvSnapshot();
+
+      std::shared_ptr<soci::session> sql;
+      try {
+        std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
+        auto session = checkout(commit_pool_);
+        if (auto error = boost::get<expected::Error<std::string>>(&session)) {
+          log_->warn("cannot start wsv snapshot: {}", error->error);
+          return;
+        }
+        sql = std::move(
+            boost::get<expected::Value<std::unique_ptr<soci::session>>>(
+                session)
+                .value);
+        // the first query takes the snapshot of the database, so the dump
+        // sees the state right after this commit while next blocks are
+        // committed concurrently
+        *sql << "BEGIN ISOLATION LEVEL REPEATABLE READ READ ONLY";
+        *sql << "SELECT 1";
+      } catch (const std::exception &e) {
+        log_->warn("cannot start wsv snapshot: {}", e.what());
+        return;
+      }
+
+      wsv_snapshot_in_progress_ = true;
+      wsv_snapshot_thread_ = std::thread([this, sql, to, hash] {
+        try {
+          wsv_snapshots_.create(*sql, to, hash)
+              .match(
+                  [this](const expected::Value<WsvSnapshotInfo> &v) {
+                    log_->info("wsv snapshot of block {} written to {}",
+                               v.value.height,
+                               v.value.path);
+                  },
+                  [this](const expected::Error<std::string> &e) {
+                    log_->warn("cannot write wsv snapshot: {}", e.error);
+                  });
+          *sql << "ROLLBACK";
+        } catch (const std::exception &e) {
+          log_->warn("wsv snapshot failed: {}", e.what());
+        }
+        wsv_snapshot_in_progress_ = false;
+      });
+    }
+
+    bool StorageImpl::wsvSnapshotDue(
+        shared_model::interface::types::HeightType from,
+        shared_model::interface::types::HeightType to) const {
+      return wsv_snapshot_interval_ != 0
+          and to / wsv_snapshot_interval_ != from / wsv_snapshot_interval_;
+    }
+
+    void StorageImpl::waitWsvSnapshot() {
+      if (wsv_snapshot_thread_.joinable()) {
+        wsv_snapshot_thread_.join();
+      }
+    }
+
     StorageImpl::~StorageImpl() {
       freeConnections();
     }
@@ -490,12 +1017,98 @@ namespace iroha {
       }
     }
 
+    void StorageImpl::invalidateWsvCache(
+        const shared_model::interface::Block &block) {
+      if (not wsv_cache_) {
+        return;
+      }
+      wsv_cache_->invalidate(block);
+      log_->debug("wsv cache: {} entries, {} hits, {} misses, {} invalidated",
+                  wsv_cache_->size(),
+                  wsv_cache_->hits(),
+                  wsv_cache_->misses(),
+                  wsv_cache_->invalidations());
+    }
+
+    bool StorageImpl::indexBlock(const shared_model::interface::Block &block) {
+      std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
+      auto session = checkout(commit_pool_);
+      if (auto error = boost::get<expected::Error<std::string>>(&session)) {
+        log_->warn(error->error);
+        return false;
+      }
+      return indexBlock(
+          *boost::get<expected::Value<std::unique_ptr<soci::session>>>(session)
+               .value,
+          block);
+    }
+
+    bool StorageImpl::indexBlock(soci::session &sql,
+                                 const shared_model::interface::Block &block) {
+      try {
+        sql << "BEGIN";
+        // COMMIT of the aborted transaction would roll it back silently
+        if (not PostgresBlockIndex(sql).index(block)) {
+          sql << "ROLLBACK";
+          return false;
+        }
+        sql << "COMMIT";
+      } catch (const std::exception &e) {
+        log_->warn("failed to index block {}: {}", block.height(), e.what());
+        try {
+          sql << "ROLLBACK";
+        } catch (const std::exception &) {
+        }
+        return false;
+      }
+      return true;
+    }
+
+    bool StorageImpl::blockStoreFailed() const {
+      return commit_pipeline_ and commit_pipeline_->failed();
+    }
+
+    void StorageImpl::flushCommitPipeline() {
+      if (commit_pipeline_) {
+        commit_pipeline_->flush();
+      }
+    }
+
     bool StorageImpl::storeBlock(const shared_model::interface::Block &block) {
-      auto json_result = converter_->serialize(block);
-      return json_result.match(
-          [this, &block](const expected::Value<std::string> &v) {
-            block_store_->add(block.height(), stringToBytes(v.value));
-            notifier_.get_subscriber().on_next(clone(block));
+      // blocks applied again while WSV is restored are already in block
+      // store, any other block of a stored height is rejected
+      if (conflictsWithStoredBlock(block)) {
+        log_->error("block {} differs from the stored one", block.height());
+        return false;
+      }
+      tx_hash_index_->insert(block);
+      if (block.height() <= block_store_->last_id()) {
+        if (commit_pipeline_) {
+          commit_pipeline_->push(clone(block), nullptr);
+        } else {
+          notifier_.get_subscriber().on_next(clone(block));
+        }
+        return true;
+      }
+      auto serialized_block = block_format_.serialize(block);
+      return serialized_block.match(
+          [this, &block](const expected::Value<BlockStorageFormat::Bytes> &v) {
+            // committed block is the most likely to be requested next, e.g.
+            // as top block by simulator and mutable storage
+            std::shared_ptr<shared_model::interface::Block> stored_block =
+                clone(block);
+            block_cache_->put(stored_block, v.value.size());
+            if (commit_pipeline_) {
+              commit_pipeline_->push(
+                  std::move(stored_block),
+                  std::make_shared<const BlockStorageFormat::Bytes>(v.value));
+              return true;
+            }
+            if (not block_store_->add(block.height(), v.value)) {
+              log_->error("cannot write block {}", block.height());
+              return false;
+            }
+            notifier_.get_subscriber().on_next(std::move(stored_block));
             return true;
           },
           [this](const expected::Error<std::string> &e) {
@@ -504,6 +1117,24 @@ namespace iroha {
           });
     }
 
+    bool StorageImpl::conflictsWithStoredBlock(
+        const shared_model::interface::Block &block) const {
+      if (block.height() > block_store_->last_id()) {
+        return false;
+      }
+      auto stored = block_store_->get(block.height());
+      if (not stored) {
+        return true;
+      }
+      auto stored_block = block_format_.deserialize(*stored);
+      return stored_block.match(
+          [&block](const expected::Value<
+                   std::unique_ptr<shared_model::interface::Block>> &v) {
+            return v.value->hash() != block.hash();
+          },
+          [](const expected::Error<std::string> &) { return true; });
+    }
+
     const std::string &StorageImpl::drop_ = R"(
 DROP TABLE IF EXISTS account_has_signatory;
 DROP TABLE IF EXISTS account_has_asset;
@@ -516,7 +1147,7 @@ DROP TABLE IF EXISTS domain;
 DROP TABLE IF EXISTS signatory;
 DROP TABLE IF EXISTS peer;
 DROP TABLE IF EXISTS role;
-DROP TABLE IF EXISTS height_by_hash;
+DROP TABLE IF EXISTS position_by_hash;
 DROP TABLE IF EXISTS tx_status_by_hash;
 DROP TABLE IF EXISTS height_by_account_set;
 DROP TABLE IF EXISTS index_by_creator_height;
@@ -609,32 +1240,42 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
     PRIMARY KEY (permittee_account_id, account_id)
 );
 CREATE TABLE IF NOT EXISTS position_by_hash (
-    hash varchar,
-    height text,
-    index text
+    hash bytea,
+    height bigint,
+    index bigint
 );
-
 CREATE TABLE IF NOT EXISTS tx_status_by_hash (
-    hash varchar,
+    hash bytea,
     status boolean
 );
-
 CREATE TABLE IF NOT EXISTS height_by_account_set (
     account_id text,
-    height text
+    height bigint
 );
 CREATE TABLE IF NOT EXISTS index_by_creator_height (
     id serial,
     creator_id text,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
 CREATE TABLE IF NOT EXISTS position_by_account_asset (
     account_id text,
     asset_id text,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
+CREATE INDEX IF NOT EXISTS position_by_hash_hash_index
+    ON position_by_hash (hash);
+CREATE INDEX IF NOT EXISTS position_by_hash_height_index
+    ON position_by_hash (height, index);
+CREATE INDEX IF NOT EXISTS tx_status_by_hash_hash_index
+    ON tx_status_by_hash (hash);
+CREATE INDEX IF NOT EXISTS height_by_account_set_account_id_index
+    ON height_by_account_set (account_id, height);
+CREATE INDEX IF NOT EXISTS index_by_creator_height_creator_id_index
+    ON index_by_creator_height (creator_id, height, index);
+CREATE INDEX IF NOT EXISTS position_by_account_asset_account_id_index
+    ON position_by_account_asset (account_id, asset_id, height, index);
 )";
   }  // namespace ametsuchi
 }  // namespace iroha
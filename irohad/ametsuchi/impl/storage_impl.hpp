@@ -11,11 +11,20 @@
 #include <atomic>
 #include <cmath>
 #include <shared_mutex>
+#include <thread>
 
 #include <soci/soci.h>
 #include <boost/optional.hpp>
 
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
+#include "ametsuchi/impl/commit_pipeline.hpp"
+#include "ametsuchi/impl/connection_pool.hpp"
 #include "ametsuchi/impl/postgres_options.hpp"
+#include "ametsuchi/impl/postgres_query_pool.hpp"
+#include "ametsuchi/impl/tx_hash_index.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
+#include "ametsuchi/impl/wsv_snapshot_storage.hpp"
 #include "ametsuchi/key_value_storage.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
 #include "interfaces/iroha_internal/block_json_converter.hpp"
@@ -40,13 +49,15 @@ namespace iroha {
           const std::string &options_str_without_dbname);
 
       static expected::Result<ConnectionContext, std::string> initConnections(
-          std::string block_store_dir);
-
-      static expected::Result<std::shared_ptr<soci::connection_pool>,
-                              std::string>
-      initPostgresConnection(std::string &options_str, size_t pool_size);
+          std::string block_store_dir,
+          const BlockStorageFormat &block_format,
+          BlockStorageType block_storage_type,
+          SyncOptions block_store_sync);
 
      public:
+      /// total size of block records kept decoded in block cache
+      static const size_t kBlockCacheSize = 64 * 1024 * 1024;
+
       static expected::Result<std::shared_ptr<StorageImpl>, std::string> create(
           std::string block_store_dir,
           std::string postgres_connection,
@@ -56,7 +67,14 @@ namespace iroha {
               converter,
           std::shared_ptr<shared_model::interface::PermissionToString>
               perm_converter,
-          size_t pool_size = 10);
+          PoolOptions pool_options = PoolOptions(),
+          BlockStorageType block_storage_type = BlockStorageType::kFlatFile,
+          shared_model::interface::types::HeightType wsv_snapshot_interval =
+              0,
+          bool pipelined_validation = false,
+          bool wsv_cache = false,
+          bool async_commit = false,
+          SyncOptions block_store_sync = SyncOptions());
 
       expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
       createTemporaryWsv() override;
@@ -96,6 +114,10 @@ namespace iroha {
 
       void reset() override;
 
+      void resetWsv() override;
+
+      shared_model::interface::types::HeightType loadWsvSnapshot() override;
+
       void dropStorage() override;
 
       void freeConnections() override;
@@ -111,6 +133,23 @@ namespace iroha {
       rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
       on_commit() override;
 
+      /**
+       * @return cache of decoded blocks shared by all block queries
+       */
+      std::shared_ptr<const BlockCache> blockCache() const;
+
+      /**
+       * @return index of all transaction hashes in the ledger, updated on
+       * every commit
+       */
+      std::shared_ptr<const TxHashIndex> txHashIndex() const;
+
+      /**
+       * @return cache of committed WSV entities used by temporary WSVs,
+       * nullptr if it is disabled
+       */
+      std::shared_ptr<const WsvCache> wsvCache() const;
+
       void prepareBlock(std::unique_ptr<TemporaryWsv> wsv) override;
 
       ~StorageImpl() override;
@@ -119,15 +158,21 @@ namespace iroha {
       StorageImpl(std::string block_store_dir,
                   PostgresOptions postgres_options,
                   std::unique_ptr<KeyValueStorage> block_store,
-                  std::shared_ptr<soci::connection_pool> connection,
+                  std::shared_ptr<ConnectionPool> query_pool,
+                  std::shared_ptr<ConnectionPool> validation_pool,
+                  std::shared_ptr<ConnectionPool> commit_pool,
                   std::shared_ptr<shared_model::interface::CommonObjectsFactory>
                       factory,
                   std::shared_ptr<shared_model::interface::BlockJsonConverter>
                       converter,
                   std::shared_ptr<shared_model::interface::PermissionToString>
                       perm_converter,
-                  size_t pool_size,
-                  bool enable_prepared_blocks);
+                  bool enable_prepared_blocks,
+                  shared_model::interface::types::HeightType
+                      wsv_snapshot_interval,
+                  bool pipelined_validation,
+                  bool wsv_cache,
+                  bool async_commit);
 
       /**
        * Folder with raw blocks
@@ -138,6 +183,21 @@ namespace iroha {
       const PostgresOptions postgres_options_;
 
      private:
+      /**
+       * Check out connection from pool, drop mutex must be held
+       * @return session or error if pool is closed or has no free
+       * connection in time
+       */
+      static expected::Result<std::unique_ptr<soci::session>, std::string>
+      checkout(const std::shared_ptr<ConnectionPool> &pool);
+
+      /**
+       * Migrate and create tables, load transaction hashes and prepare
+       * statements, called once by create
+       * @return error if the database cannot be reached or initialized
+       */
+      expected::Result<void, std::string> initialize();
+
       /**
        * revert prepared transaction
        */
@@ -148,9 +208,90 @@ namespace iroha {
        */
       bool storeBlock(const shared_model::interface::Block &block);
 
+      /**
+       * @return true if block store has another block of the same height,
+       * or it cannot be read
+       */
+      bool conflictsWithStoredBlock(
+          const shared_model::interface::Block &block) const;
+
+      /**
+       * Index written block in its own database transaction, called by
+       * commit pipeline
+       * @return true if the block is indexed
+       */
+      bool indexBlock(const shared_model::interface::Block &block);
+
+      /**
+       * Index committed block in its own database transaction with given
+       * session, which is rolled back if indexing fails
+       * @return true if the block is indexed
+       */
+      bool indexBlock(soci::session &sql,
+                      const shared_model::interface::Block &block);
+
+      /**
+       * @return true if commit pipeline failed to write or index a block, so
+       * WSV must not be committed any more
+       */
+      bool blockStoreFailed() const;
+
+      /**
+       * Wait until blocks committed to WSV are written and indexed, if
+       * commit pipeline is enabled
+       */
+      void flushCommitPipeline();
+
+      /**
+       * Remove entities changed by block from WSV cache, must be called
+       * after the block is committed to the database
+       */
+      void invalidateWsvCache(const shared_model::interface::Block &block);
+
+      /**
+       * @return whether a multiple of snapshot interval is in (from, to]
+       */
+      bool wsvSnapshotDue(
+          shared_model::interface::types::HeightType from,
+          shared_model::interface::types::HeightType to) const;
+
+      /**
+       * Start writing WSV snapshot in background if a multiple of snapshot
+       * interval is in (from, to] and no snapshot is being written. Must be
+       * called right after the block at height to is committed, before the
+       * next commit
+       * @param from - height of top block before commit
+       * @param to - height of committed top block
+       * @param hash - hash of committed top block
+       */
+      void snapshotWsv(shared_model::interface::types::HeightType from,
+                       shared_model::interface::types::HeightType to,
+                       const shared_model::interface::types::HashType &hash);
+
+      /**
+       * Wait until WSV snapshot being written is finished
+       */
+      void waitWsvSnapshot();
+
       std::unique_ptr<KeyValueStorage> block_store_;
 
-      std::shared_ptr<soci::connection_pool> connection_;
+      /// block store itself if commit pipeline is enabled, nullptr otherwise
+      CommitPipeline *commit_pipeline_;
+
+      std::shared_ptr<BlockCache> block_cache_;
+
+      std::shared_ptr<TxHashIndex> tx_hash_index_;
+
+      /// connections of queries, a burst of client queries can only
+      /// exhaust this pool and not delay validation or commit
+      std::shared_ptr<ConnectionPool> query_pool_;
+
+      std::shared_ptr<ConnectionPool> validation_pool_;
+
+      std::shared_ptr<ConnectionPool> commit_pool_;
+
+      /// block and WSV queries reused over connections of query pool
+      std::shared_ptr<PostgresQueryPool> query_sessions_;
 
       std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
 
@@ -159,6 +300,8 @@ namespace iroha {
 
       std::shared_ptr<shared_model::interface::BlockJsonConverter> converter_;
 
+      BlockStorageFormat block_format_;
+
       std::shared_ptr<shared_model::interface::PermissionToString>
           perm_converter_;
 
@@ -166,14 +309,34 @@ namespace iroha {
 
       mutable std::shared_timed_mutex drop_mutex;
 
-      size_t pool_size_;
-
       bool prepared_blocks_enabled_;
 
       std::atomic<bool> block_is_prepared;
 
       std::string prepared_block_name_;
 
+      WsvSnapshotStorage wsv_snapshots_;
+
+      /**
+       * Number of blocks between WSV snapshots, 0 if snapshots are disabled
+       */
+      const shared_model::interface::types::HeightType wsv_snapshot_interval_;
+
+      std::thread wsv_snapshot_thread_;
+
+      std::atomic<bool> wsv_snapshot_in_progress_;
+
+      /**
+       * Whether temporary WSV sends all statements of a transaction in a
+       * single round trip
+       */
+      const bool pipelined_validation_;
+
+      /**
+       * Cache of committed WSV entities, nullptr if it is disabled
+       */
+      std::shared_ptr<WsvCache> wsv_cache_;
+
      protected:
       static const std::string &drop_;
       static const std::string &reset_;
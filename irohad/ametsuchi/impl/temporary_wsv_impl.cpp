@@ -5,81 +5,169 @@
 
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
 
+#include <boost/algorithm/string/join.hpp>
 #include <boost/format.hpp>
+#include "ametsuchi/impl/libpq_utils.hpp"
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 #include "cryptography/public_key.hpp"
 #include "interfaces/commands/command.hpp"
 #include "interfaces/permission_to_string.hpp"
 #include "interfaces/transaction.hpp"
 
+namespace {
+  /// name of savepoint around each applied transaction
+  const std::string kTxSavepoint = "savepoint_temp_wsv";
+
+  /**
+   * Query which checks that transaction has at least quorum signatures and
+   * they are a subset of creator account signatories
+   * @param keys - public keys of signatures as VALUES rows
+   * @param signatures_count - number of signatures
+   * @param account_id - transaction creator
+   * @return query text, parameters are put into it as they are
+   */
+  std::string signaturesQuery(const std::string &keys,
+                              const std::string &signatures_count,
+                              const std::string &account_id) {
+    return (boost::format(R"(SELECT sum(count) = %2%
+                          AND sum(quorum) <= %2%
+                  FROM
+                      (SELECT count(public_key)
+                      FROM ( VALUES %1% ) AS CTE1(public_key)
+                      WHERE public_key IN
+                          (SELECT public_key
+                          FROM account_has_signatory
+                          WHERE account_id = %3% ) ) AS CTE2(count),
+                          (SELECT quorum
+                          FROM account
+                          WHERE account_id = %3%) AS CTE3(quorum))")
+            % keys % signatures_count % account_id)
+        .str();
+  }
+
+  // TODO [IR-1816] Akvinikym 29.10.18: substitute error code magic numbers
+  // with named constants
+  iroha::expected::Error<iroha::validation::CommandError> signaturesDbError(
+      const shared_model::interface::Transaction &transaction,
+      const std::string &error) {
+    auto error_str = "Transaction " + transaction.toString()
+        + " failed signatures validation with db error: " + error;
+    return iroha::expected::makeError(iroha::validation::CommandError{
+        "signatures validation", 1, error_str, false});
+  }
+
+  iroha::expected::Error<iroha::validation::CommandError> signaturesError(
+      const shared_model::interface::Transaction &transaction) {
+    auto error_str = "Transaction " + transaction.toString()
+        + " failed signatures validation";
+    return iroha::expected::makeError(iroha::validation::CommandError{
+        "signatures validation", 2, error_str, false});
+  }
+
+  /**
+   * Same check as of signaturesQuery against cached signatories
+   */
+  bool signaturesValid(
+      const shared_model::interface::Transaction &transaction,
+      const iroha::ametsuchi::WsvCache::Signatories &signatories) {
+    size_t count = 0;
+    for (const auto &signature : transaction.signatures()) {
+      if (signatories.public_keys.count(signature.publicKey().hex()) == 0) {
+        return false;
+      }
+      ++count;
+    }
+    return count >= signatories.quorum;
+  }
+}  // namespace
+
 namespace iroha {
   namespace ametsuchi {
     TemporaryWsvImpl::TemporaryWsvImpl(
         std::unique_ptr<soci::session> sql,
         std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
         std::shared_ptr<shared_model::interface::PermissionToString>
-            perm_converter)
+            perm_converter,
+        bool pipelined,
+        std::shared_ptr<WsvCache> wsv_cache)
         : sql_(std::move(sql)),
           command_executor_(std::make_unique<PostgresCommandExecutor>(
               *sql_, std::move(perm_converter))),
+          pipelined_(pipelined),
           log_(logger::log("TemporaryWSV")) {
       *sql_ << "BEGIN";
+      command_executor_->deferExecution(pipelined_);
+      if (wsv_cache) {
+        wsv_cache_ =
+            std::make_shared<WsvCacheView>(std::move(wsv_cache), *sql_);
+        command_executor_->setWsvCache(wsv_cache_);
+      }
+    }
+
+    boost::optional<bool> TemporaryWsvImpl::cachedSignaturesValid(
+        const shared_model::interface::Transaction &transaction) {
+      if (not wsv_cache_) {
+        return boost::none;
+      }
+      auto signatories =
+          wsv_cache_->signatories(transaction.creatorAccountId());
+      if (not signatories) {
+        return boost::none;
+      }
+      return signaturesValid(transaction, *signatories);
+    }
+
+    void TemporaryWsvImpl::markModified(
+        const shared_model::interface::Transaction &transaction) {
+      if (not wsv_cache_) {
+        return;
+      }
+      for (const auto &command : transaction.commands()) {
+        wsv_cache_->modify(command);
+      }
     }
 
     expected::Result<void, validation::CommandError>
     TemporaryWsvImpl::validateSignatures(
         const shared_model::interface::Transaction &transaction) {
+      if (auto valid = cachedSignaturesValid(transaction)) {
+        if (*valid) {
+          return {};
+        }
+        return signaturesError(transaction);
+      }
+
       auto keys_range = transaction.signatures()
-          | boost::adaptors::transformed(
-                            [](const auto &s) { return s.publicKey().hex(); });
-      auto keys = std::accumulate(
-          std::next(std::begin(keys_range)),
-          std::end(keys_range),
-          keys_range.front(),
-          [](auto acc, const auto &val) { return acc + "'), ('" + val; });
+          | boost::adaptors::transformed([](const auto &s) {
+                              return "('" + s.publicKey().hex() + "')";
+                            });
       // not using bool since it is not supported by SOCI
       boost::optional<uint8_t> signatories_valid;
 
-      boost::format query(R"(SELECT sum(count) = :signatures_count
-                          AND sum(quorum) <= :signatures_count
-                  FROM
-                      (SELECT count(public_key)
-                      FROM ( VALUES ('%s') ) AS CTE1(public_key)
-                      WHERE public_key IN
-                          (SELECT public_key
-                          FROM account_has_signatory
-                          WHERE account_id = :account_id ) ) AS CTE2(count),
-                          (SELECT quorum
-                          FROM account
-                          WHERE account_id = :account_id) AS CTE3(quorum))");
-
       try {
-        *sql_ << (query % keys).str(), soci::into(signatories_valid),
+        *sql_ << signaturesQuery(boost::algorithm::join(keys_range, ", "),
+                                 ":signatures_count",
+                                 ":account_id"),
+            soci::into(signatories_valid),
             soci::use(boost::size(keys_range), "signatures_count"),
             soci::use(transaction.creatorAccountId(), "account_id");
       } catch (const std::exception &e) {
-        auto error_str = "Transaction " + transaction.toString()
-            + " failed signatures validation with db error: " + e.what();
-        // TODO [IR-1816] Akvinikym 29.10.18: substitute error code magic number
-        // with named constant
-        return expected::makeError(validation::CommandError{
-            "signatures validation", 1, error_str, false});
+        return signaturesDbError(transaction, e.what());
       }
 
       if (signatories_valid and *signatories_valid) {
         return {};
       } else {
-        auto error_str = "Transaction " + transaction.toString()
-            + " failed signatures validation";
-        // TODO [IR-1816] Akvinikym 29.10.18: substitute error code magic number
-        // with named constant
-        return expected::makeError(validation::CommandError{
-            "signatures validation", 2, error_str, false});
+        return signaturesError(transaction);
       }
     }
 
     expected::Result<void, validation::CommandError> TemporaryWsvImpl::apply(
         const shared_model::interface::Transaction &transaction) {
+      markModified(transaction);
+      if (pipelined_) {
+        return applyPipelined(transaction);
+      }
       const auto &tx_creator = transaction.creatorAccountId();
       command_executor_->setCreatorAccountId(tx_creator);
       command_executor_->doValidation(true);
@@ -89,7 +177,7 @@ namespace iroha {
         return boost::apply_visitor(*command_executor_, command.get());
       };
 
-      auto savepoint_wrapper = createSavepoint("savepoint_temp_wsv");
+      auto savepoint_wrapper = createSavepoint(kTxSavepoint);
 
       return validateSignatures(transaction) |
                  [savepoint = std::move(savepoint_wrapper),
@@ -122,6 +210,102 @@ namespace iroha {
       };
     }
 
+    expected::Result<void, validation::CommandError>
+    TemporaryWsvImpl::applyPipelined(
+        const shared_model::interface::Transaction &transaction) {
+      const auto cached_signatures_valid = cachedSignaturesValid(transaction);
+      if (cached_signatures_valid and not *cached_signatures_valid) {
+        return signaturesError(transaction);
+      }
+      command_executor_->setCreatorAccountId(transaction.creatorAccountId());
+      command_executor_->doValidation(true);
+      auto conn = getPgConnection(*sql_);
+
+      std::vector<PostgresCommandExecutor::DeferredStatement> statements;
+      std::string query = "SAVEPOINT " + kTxSavepoint;
+      try {
+        for (const auto &command : transaction.commands()) {
+          boost::apply_visitor(*command_executor_, command.get());
+        }
+        statements = command_executor_->takeDeferred();
+
+        if (not cached_signatures_valid) {
+          auto keys_range = transaction.signatures()
+              | boost::adaptors::transformed([conn](const auto &s) {
+                              auto key = s.publicKey().hex();
+                              return "(" + escapeLiteral(conn, key) + ")";
+                            });
+          query += ";"
+              + signaturesQuery(
+                       boost::algorithm::join(keys_range, ", "),
+                       std::to_string(boost::size(keys_range)),
+                       escapeLiteral(conn, transaction.creatorAccountId()));
+        }
+      } catch (const std::exception &e) {
+        command_executor_->takeDeferred();
+        return signaturesDbError(transaction, e.what());
+      }
+      for (const auto &statement : statements) {
+        query += ";" + statement.query;
+      }
+
+      // The whole query is sent at once. Server stops at the first statement
+      // which raises an error, but executes commands after one which returns
+      // an error code. Their changes are discarded together with the failed
+      // command by rolling back to the savepoint, and the first failure is
+      // reported, so the result is the same as of sequential execution.
+      if (PQsendQuery(conn, query.c_str()) != 1) {
+        // nothing is sent, so there is no savepoint to roll back to
+        return signaturesDbError(transaction, PQerrorMessage(conn));
+      }
+      boost::optional<expected::Error<validation::CommandError>> error;
+      // results are: savepoint, signatures validation unless it is done with
+      // cached signatories, commands
+      const size_t first_command_result = cached_signatures_valid ? 1 : 2;
+      size_t i = 0;
+      while (PgResultPtr result{PQgetResult(conn), &PQclear}) {
+        const auto result_index = i++;
+        if (error) {
+          // results must be read up to the end anyway
+          continue;
+        }
+        if (result_index == 0) {
+          if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+            error = signaturesDbError(transaction,
+                                      PQresultErrorMessage(result.get()));
+          }
+        } else if (result_index < first_command_result) {
+          if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+            error = signaturesDbError(transaction,
+                                      PQresultErrorMessage(result.get()));
+          } else if (PQgetisnull(result.get(), 0, 0)
+                     or PQgetvalue(result.get(), 0, 0) != std::string("t")) {
+            error = signaturesError(transaction);
+          }
+        } else {
+          const auto index = result_index - first_command_result;
+          PostgresCommandExecutor::deferredResult(statements.at(index),
+                                                  result.get())
+              .match([](expected::Value<void> &) {},
+                     [&error, index](expected::Error<CommandError> &e) {
+                       error = expected::makeError(
+                           validation::CommandError{e.error.command_name,
+                                                    e.error.error_code,
+                                                    e.error.error_extra,
+                                                    true,
+                                                    index});
+                     });
+        }
+      }
+
+      if (error) {
+        *sql_ << "ROLLBACK TO SAVEPOINT " + kTxSavepoint;
+        return *error;
+      }
+      *sql_ << "RELEASE SAVEPOINT " + kTxSavepoint;
+      return {};
+    }
+
     std::unique_ptr<TemporaryWsv::SavepointWrapper>
     TemporaryWsvImpl::createSavepoint(const std::string &name) {
       return std::make_unique<TemporaryWsvImpl::SavepointWrapperImpl>(
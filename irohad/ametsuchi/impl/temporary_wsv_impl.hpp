@@ -9,7 +9,8 @@
 #include "ametsuchi/temporary_wsv.hpp"
 
 #include <soci/soci.h>
-#include "ametsuchi/command_executor.hpp"
+#include "ametsuchi/impl/postgres_command_executor.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
 #include "logger/logger.hpp"
 
@@ -40,12 +41,25 @@ namespace iroha {
         bool is_released_;
       };
 
+      /**
+       * @param sql - session, on which a transaction is opened until the
+       * object is destroyed
+       * @param factory - factory of common objects
+       * @param perm_converter - converter of permissions to strings
+       * @param pipelined - if true, all statements of a transaction are sent
+       * to the database in a single round trip, instead of one by one
+       * @param wsv_cache - cache of committed WSV entities used for
+       * signatures and permission checks, checks are done in the database if
+       * it is nullptr
+       */
       TemporaryWsvImpl(
           std::unique_ptr<soci::session> sql,
           std::shared_ptr<shared_model::interface::CommonObjectsFactory>
               factory,
           std::shared_ptr<shared_model::interface::PermissionToString>
-              perm_converter);
+              perm_converter,
+          bool pipelined = false,
+          std::shared_ptr<WsvCache> wsv_cache = nullptr);
 
       expected::Result<void, validation::CommandError> apply(
           const shared_model::interface::Transaction &transaction) override;
@@ -63,8 +77,32 @@ namespace iroha {
       expected::Result<void, validation::CommandError> validateSignatures(
           const shared_model::interface::Transaction &transaction);
 
+      /**
+       * Apply transaction with savepoint, signatures validation and all
+       * commands sent in a single query, followed by release or rollback
+       * of the savepoint
+       */
+      expected::Result<void, validation::CommandError> applyPipelined(
+          const shared_model::interface::Transaction &transaction);
+
+      /**
+       * @return result of signatures validation with cached signatories, if
+       * they are cached
+       */
+      boost::optional<bool> cachedSignaturesValid(
+          const shared_model::interface::Transaction &transaction);
+
+      /**
+       * Mark entities changed by commands of transaction, so they are not
+       * taken from cache anymore
+       */
+      void markModified(
+          const shared_model::interface::Transaction &transaction);
+
       std::unique_ptr<soci::session> sql_;
-      std::unique_ptr<CommandExecutor> command_executor_;
+      std::unique_ptr<PostgresCommandExecutor> command_executor_;
+      const bool pipelined_;
+      std::shared_ptr<WsvCacheView> wsv_cache_;
 
       logger::Logger log_;
     };
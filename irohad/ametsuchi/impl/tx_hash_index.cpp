@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/tx_hash_index.hpp"
+
+#include <mutex>
+
+#include <boost/range/adaptor/indexed.hpp>
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace {
+  /// filter bits per hash, with kFilterHashes gives ~1% false positives
+  const size_t kBitsPerHash = 10;
+
+  /// number of filter bits set per hash
+  const uint32_t kFilterHashes = 7;
+
+  /**
+   * Call f with every filter bit of key, derived from two halves of a single
+   * hash of the key
+   */
+  template <typename Function>
+  void forEachBit(const std::string &key, size_t bits, Function f) {
+    const uint64_t hash = std::hash<std::string>{}(key);
+    const auto h1 = static_cast<uint32_t>(hash);
+    const auto h2 = static_cast<uint32_t>(hash >> 32) | 1;
+    for (uint32_t i = 0; i < kFilterHashes; ++i) {
+      f((h1 + uint64_t{i} * h2) % bits);
+    }
+  }
+
+  std::string key(const shared_model::crypto::Hash &hash) {
+    return std::string(hash.blob().begin(), hash.blob().end());
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    const size_t TxHashIndex::kInitialCapacity;
+
+    TxHashIndex::TxHashIndex() {
+      rebuildFilter(kInitialCapacity);
+    }
+
+    void TxHashIndex::insert(const shared_model::interface::Block &block) {
+      std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+      for (const auto &tx :
+           block.transactions() | boost::adaptors::indexed(0)) {
+        add(tx.value().hash(),
+            Entry{block.height(), static_cast<uint32_t>(tx.index()), true});
+      }
+      for (const auto &hash : block.rejected_transactions_hashes()) {
+        add(hash, Entry{0, 0, false});
+      }
+    }
+
+    void TxHashIndex::insertCommitted(
+        const shared_model::crypto::Hash &hash,
+        shared_model::interface::types::HeightType height,
+        uint32_t index) {
+      std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+      add(hash, Entry{height, index, true});
+    }
+
+    void TxHashIndex::insertRejected(const shared_model::crypto::Hash &hash) {
+      std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+      add(hash, Entry{0, 0, false});
+    }
+
+    boost::optional<TxHashIndex::Entry> TxHashIndex::find(
+        const shared_model::crypto::Hash &hash) const {
+      const auto k = key(hash);
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      if (not filterContains(k)) {
+        return boost::none;
+      }
+      auto it = entries_.find(k);
+      if (it == entries_.end()) {
+        return boost::none;
+      }
+      return it->second;
+    }
+
+    void TxHashIndex::clear() {
+      std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+      entries_.clear();
+      rebuildFilter(kInitialCapacity);
+    }
+
+    size_t TxHashIndex::size() const {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      return entries_.size();
+    }
+
+    void TxHashIndex::add(const shared_model::crypto::Hash &hash,
+                          Entry entry) {
+      auto k = key(hash);
+      addToFilter(k);
+      entries_[std::move(k)] = entry;
+      if (entries_.size() > filter_capacity_) {
+        rebuildFilter(filter_capacity_ * 2);
+      }
+    }
+
+    void TxHashIndex::rebuildFilter(size_t capacity) {
+      filter_capacity_ = capacity;
+      filter_.assign((capacity * kBitsPerHash + 63) / 64, 0);
+      for (const auto &entry : entries_) {
+        addToFilter(entry.first);
+      }
+    }
+
+    void TxHashIndex::addToFilter(const std::string &key) {
+      forEachBit(key, filter_.size() * 64, [this](uint64_t bit) {
+        filter_[bit / 64] |= uint64_t{1} << (bit % 64);
+      });
+    }
+
+    bool TxHashIndex::filterContains(const std::string &key) const {
+      bool contains = true;
+      forEachBit(key, filter_.size() * 64, [this, &contains](uint64_t bit) {
+        contains &= (filter_[bit / 64] >> (bit % 64)) & 1;
+      });
+      return contains;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
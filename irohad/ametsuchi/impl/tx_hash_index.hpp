@@ -0,0 +1,116 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_TX_HASH_INDEX_HPP
+#define IROHA_TX_HASH_INDEX_HPP
+
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include "cryptography/hash.hpp"
+#include "interfaces/common_objects/types.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * In-memory index of all committed and rejected transaction hashes in
+     * the ledger.
+     *
+     * Lookups go through a Bloom filter first, so hashes which are not in
+     * the ledger, the most common case for new transactions, are answered
+     * without touching the hash table. The filter is rebuilt twice as large
+     * when the number of hashes exceeds its capacity, keeping false positive
+     * rate below one percent.
+     */
+    class TxHashIndex {
+     public:
+      /**
+       * Position of transaction in the ledger
+       */
+      struct Entry {
+        /// height of block with the transaction, 0 for rejected ones
+        shared_model::interface::types::HeightType height;
+        /// index of the transaction in block
+        uint32_t index;
+        /// false if transaction was rejected
+        bool committed;
+      };
+
+      /// number of hashes the filter is built for initially
+      static const size_t kInitialCapacity = 1 << 16;
+
+      TxHashIndex();
+
+      /**
+       * Add committed and rejected transactions of block
+       */
+      void insert(const shared_model::interface::Block &block);
+
+      /**
+       * Add committed transaction
+       */
+      void insertCommitted(const shared_model::crypto::Hash &hash,
+                           shared_model::interface::types::HeightType height,
+                           uint32_t index);
+
+      /**
+       * Add rejected transaction
+       */
+      void insertRejected(const shared_model::crypto::Hash &hash);
+
+      /**
+       * @return position of transaction with given hash, if it is in ledger
+       */
+      boost::optional<Entry> find(const shared_model::crypto::Hash &hash) const;
+
+      /**
+       * Remove all hashes
+       */
+      void clear();
+
+      /**
+       * @return number of indexed hashes
+       */
+      size_t size() const;
+
+     private:
+      /**
+       * Add entry, mutex must be locked
+       */
+      void add(const shared_model::crypto::Hash &hash, Entry entry);
+
+      /**
+       * Rebuild filter for given number of hashes, mutex must be locked
+       */
+      void rebuildFilter(size_t capacity);
+
+      void addToFilter(const std::string &key);
+
+      bool filterContains(const std::string &key) const;
+
+      /// hash table keyed by raw hash bytes
+      std::unordered_map<std::string, Entry> entries_;
+
+      std::vector<uint64_t> filter_;
+
+      size_t filter_capacity_;
+
+      mutable std::shared_timed_mutex mutex_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_TX_HASH_INDEX_HPP
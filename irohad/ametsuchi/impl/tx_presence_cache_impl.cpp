@@ -5,6 +5,7 @@
 
 #include "ametsuchi/impl/tx_presence_cache_impl.hpp"
 
+#include "ametsuchi/tx_presence_cache_utils.hpp"
 #include "common/bind.hpp"
 #include "common/visitor.hpp"
 #include "interfaces/iroha_internal/transaction_batch.hpp"
@@ -12,11 +13,17 @@
 
 namespace iroha {
   namespace ametsuchi {
-    TxPresenceCacheImpl::TxPresenceCacheImpl(std::shared_ptr<Storage> storage)
-        : storage_(std::move(storage)) {}
+    TxPresenceCacheImpl::TxPresenceCacheImpl(
+        std::shared_ptr<Storage> storage,
+        std::shared_ptr<const TxHashIndex> tx_hash_index)
+        : storage_(std::move(storage)),
+          tx_hash_index_(std::move(tx_hash_index)) {}
 
     boost::optional<TxCacheStatusType> TxPresenceCacheImpl::check(
         const shared_model::crypto::Hash &hash) const {
+      if (tx_hash_index_) {
+        return checkInIndex(hash);
+      }
       auto res = memory_cache_.findItem(hash);
       if (res) {
         return *res;
@@ -27,15 +34,73 @@ namespace iroha {
     boost::optional<TxPresenceCache::BatchStatusCollectionType>
     TxPresenceCacheImpl::check(
         const shared_model::interface::TransactionBatch &batch) const {
-      TxPresenceCache::BatchStatusCollectionType batch_statuses;
+      HashCollectionType hashes;
+      hashes.reserve(batch.transactions().size());
       for (const auto &tx : batch.transactions()) {
-        if (auto status = check(tx->hash())) {
-          batch_statuses.emplace_back(*status);
+        hashes.push_back(tx->hash());
+      }
+      return check(hashes);
+    }
+
+    boost::optional<TxPresenceCache::BatchStatusCollectionType>
+    TxPresenceCacheImpl::check(const HashCollectionType &hashes) const {
+      BatchStatusCollectionType statuses;
+      statuses.reserve(hashes.size());
+      if (tx_hash_index_) {
+        for (const auto &hash : hashes) {
+          statuses.push_back(checkInIndex(hash));
+        }
+        return statuses;
+      }
+
+      // positions of hashes which are not in memory cache
+      std::vector<size_t> missed;
+      HashCollectionType missed_hashes;
+      for (const auto &hash : hashes) {
+        if (auto res = memory_cache_.findItem(hash)) {
+          statuses.push_back(*res);
         } else {
-          return boost::none;
+          missed.push_back(statuses.size());
+          missed_hashes.push_back(hash);
+          statuses.emplace_back(tx_cache_status_responses::Missing{hash});
         }
       }
-      return batch_statuses;
+      if (missed_hashes.empty()) {
+        return statuses;
+      }
+
+      auto block_query = storage_->getBlockQuery();
+      if (not block_query) {
+        return boost::none;
+      }
+      auto stored = block_query->checkTxPresence(missed_hashes);
+      if (not stored or stored->size() != missed_hashes.size()) {
+        return boost::none;
+      }
+      for (size_t i = 0; i < missed.size(); ++i) {
+        cacheStatus(stored->at(i));
+        statuses[missed[i]] = std::move(stored->at(i));
+      }
+      return statuses;
+    }
+
+    TxCacheStatusType TxPresenceCacheImpl::checkInIndex(
+        const shared_model::crypto::Hash &hash) const {
+      auto entry = tx_hash_index_->find(hash);
+      if (not entry) {
+        return tx_cache_status_responses::Missing(hash);
+      }
+      if (entry->committed) {
+        return tx_cache_status_responses::Committed(hash);
+      }
+      return tx_cache_status_responses::Rejected(hash);
+    }
+
+    void TxPresenceCacheImpl::cacheStatus(
+        const TxCacheStatusType &status) const {
+      if (isAlreadyProcessed(status)) {
+        memory_cache_.addItem(getHash(status), status);
+      }
     }
 
     boost::optional<TxCacheStatusType> TxPresenceCacheImpl::checkInStorage(
@@ -45,15 +110,8 @@ namespace iroha {
         return boost::none;
       }
       return block_query->checkTxPresence(hash) |
-          [this, &hash](const auto &status) {
-            visit_in_place(status,
-                           [](const tx_cache_status_responses::Missing &) {
-                             // don't put this hash into cache since "Missing"
-                             // can become "Committed" or "Rejected" later
-                           },
-                           [this, &hash](const auto &status) {
-                             memory_cache_.addItem(hash, status);
-                           });
+          [this](const auto &status) {
+            this->cacheStatus(status);
             return status;
           };
     }
@@ -6,6 +6,7 @@
 #ifndef IROHA_TX_PRESENCE_CACHE_IMPL_HPP
 #define IROHA_TX_PRESENCE_CACHE_IMPL_HPP
 
+#include "ametsuchi/impl/tx_hash_index.hpp"
 #include "ametsuchi/storage.hpp"
 #include "ametsuchi/tx_presence_cache.hpp"
 #include "cache/cache.hpp"
@@ -15,7 +16,14 @@ namespace iroha {
 
     class TxPresenceCacheImpl : public TxPresenceCache {
      public:
-      explicit TxPresenceCacheImpl(std::shared_ptr<Storage> storage);
+      /**
+       * @param storage - storage to query for transaction status
+       * @param tx_hash_index - index of all transactions in the ledger, if
+       * present storage is not queried
+       */
+      explicit TxPresenceCacheImpl(
+          std::shared_ptr<Storage> storage,
+          std::shared_ptr<const TxHashIndex> tx_hash_index = nullptr);
 
       boost::optional<TxCacheStatusType> check(
           const shared_model::crypto::Hash &hash) const override;
@@ -24,7 +32,22 @@ namespace iroha {
           const shared_model::interface::TransactionBatch &batch)
           const override;
 
+      boost::optional<BatchStatusCollectionType> check(
+          const HashCollectionType &hashes) const override;
+
      private:
+      /**
+       * Look up hash status in the tx hash index, which must be present
+       */
+      TxCacheStatusType checkInIndex(
+          const shared_model::crypto::Hash &hash) const;
+
+      /**
+       * Put hash status to memory cache unless it is Missing, since
+       * "Missing" can become "Committed" or "Rejected" later
+       */
+      void cacheStatus(const TxCacheStatusType &status) const;
+
       /**
        * Performs an actual storage request about hash status
        * @param hash to check
@@ -35,6 +58,7 @@ namespace iroha {
           const shared_model::crypto::Hash &hash) const;
 
       std::shared_ptr<Storage> storage_;
+      std::shared_ptr<const TxHashIndex> tx_hash_index_;
       mutable cache::Cache<shared_model::crypto::Hash,
                            TxCacheStatusType,
                            shared_model::crypto::Hash::Hasher>
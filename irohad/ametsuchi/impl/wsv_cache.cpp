@@ -0,0 +1,269 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/wsv_cache.hpp"
+
+#include <mutex>
+
+#include "common/visitor.hpp"
+#include "interfaces/commands/add_signatory.hpp"
+#include "interfaces/commands/append_role.hpp"
+#include "interfaces/commands/command.hpp"
+#include "interfaces/commands/create_account.hpp"
+#include "interfaces/commands/create_asset.hpp"
+#include "interfaces/commands/detach_role.hpp"
+#include "interfaces/commands/remove_signatory.hpp"
+#include "interfaces/commands/set_quorum.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    void ModifiedEntities::add(
+        const shared_model::interface::Command &command) {
+      using namespace shared_model::interface;
+      visit_in_place(
+          command.get(),
+          [this](const AppendRole &c) { permissions.insert(c.accountId()); },
+          [this](const DetachRole &c) { permissions.insert(c.accountId()); },
+          [this](const CreateAccount &c) {
+            const auto account_id = c.accountName() + "@" + c.domainId();
+            permissions.insert(account_id);
+            signatories.insert(account_id);
+          },
+          [this](const AddSignatory &c) { signatories.insert(c.accountId()); },
+          [this](const RemoveSignatory &c) {
+            signatories.insert(c.accountId());
+          },
+          [this](const SetQuorum &c) { signatories.insert(c.accountId()); },
+          [this](const CreateAsset &c) {
+            assets.insert(c.assetName() + "#" + c.domainId());
+          },
+          [](const auto &) {});
+    }
+
+    WsvCache::WsvCache()
+        : version_(0), hits_(0), misses_(0), invalidations_(0) {}
+
+    WsvCache::Version WsvCache::version() const {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      return version_;
+    }
+
+    template <typename Map>
+    boost::optional<typename Map::mapped_type> WsvCache::get(
+        const Map &map, const std::string &key) {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      auto it = map.find(key);
+      if (it == map.end()) {
+        ++misses_;
+        return boost::none;
+      }
+      ++hits_;
+      return it->second;
+    }
+
+    template <typename Map>
+    bool WsvCache::put(Map &map,
+                       const std::string &key,
+                       typename Map::mapped_type value,
+                       Version version) {
+      std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+      if (version != version_) {
+        return false;
+      }
+      map[key] = std::move(value);
+      return true;
+    }
+
+    boost::optional<shared_model::interface::RolePermissionSet>
+    WsvCache::getPermissions(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      return get(permissions_, account_id);
+    }
+
+    boost::optional<WsvCache::Signatories> WsvCache::getSignatories(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      return get(signatories_, account_id);
+    }
+
+    boost::optional<shared_model::interface::types::PrecisionType>
+    WsvCache::getPrecision(
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      return get(precisions_, asset_id);
+    }
+
+    bool WsvCache::putPermissions(
+        const shared_model::interface::types::AccountIdType &account_id,
+        shared_model::interface::RolePermissionSet permissions,
+        Version version) {
+      return put(permissions_, account_id, std::move(permissions), version);
+    }
+
+    bool WsvCache::putSignatories(
+        const shared_model::interface::types::AccountIdType &account_id,
+        Signatories signatories,
+        Version version) {
+      return put(signatories_, account_id, std::move(signatories), version);
+    }
+
+    bool WsvCache::putPrecision(
+        const shared_model::interface::types::AssetIdType &asset_id,
+        shared_model::interface::types::PrecisionType precision,
+        Version version) {
+      return put(precisions_, asset_id, precision, version);
+    }
+
+    void WsvCache::invalidate(const shared_model::interface::Block &block) {
+      ModifiedEntities modified;
+      for (const auto &tx : block.transactions()) {
+        for (const auto &command : tx.commands()) {
+          modified.add(command);
+        }
+      }
+
+      std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+      ++version_;
+      size_t erased = 0;
+      for (const auto &account_id : modified.permissions) {
+        erased += permissions_.erase(account_id);
+      }
+      for (const auto &account_id : modified.signatories) {
+        erased += signatories_.erase(account_id);
+      }
+      for (const auto &asset_id : modified.assets) {
+        erased += precisions_.erase(asset_id);
+      }
+      invalidations_ += erased;
+    }
+
+    void WsvCache::clear() {
+      std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+      ++version_;
+      permissions_.clear();
+      signatories_.clear();
+      precisions_.clear();
+    }
+
+    size_t WsvCache::hits() const {
+      return hits_.load();
+    }
+
+    size_t WsvCache::misses() const {
+      return misses_.load();
+    }
+
+    size_t WsvCache::invalidations() const {
+      return invalidations_.load();
+    }
+
+    size_t WsvCache::size() const {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      return permissions_.size() + signatories_.size() + precisions_.size();
+    }
+
+    WsvCacheView::WsvCacheView(std::shared_ptr<WsvCache> cache,
+                               soci::session &sql)
+        : cache_(std::move(cache)),
+          sql_(sql),
+          log_(logger::log("WsvCacheView")) {}
+
+    void WsvCacheView::modify(const shared_model::interface::Command &command) {
+      modified_.add(command);
+    }
+
+    boost::optional<shared_model::interface::RolePermissionSet>
+    WsvCacheView::permissions(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      if (modified_.permissions.count(account_id) != 0) {
+        return boost::none;
+      }
+      if (auto permissions = cache_->getPermissions(account_id)) {
+        return permissions;
+      }
+
+      const auto version = cache_->version();
+      const auto bits = shared_model::interface::RolePermissionSet::size();
+      std::string bitstring;
+      try {
+        sql_ << "SELECT COALESCE(bit_or(rp.permission), '0'::bit("
+                    + std::to_string(bits)
+                    + ")) FROM role_has_permissions AS rp "
+                      "JOIN account_has_roles AS ar "
+                      "ON ar.role_id = rp.role_id "
+                      "WHERE ar.account_id = :account_id",
+            soci::into(bitstring), soci::use(account_id);
+      } catch (const std::exception &e) {
+        log_->warn("cannot read permissions of {}: {}", account_id, e.what());
+        return boost::none;
+      }
+      shared_model::interface::RolePermissionSet permissions(bitstring);
+      cache_->putPermissions(account_id, permissions, version);
+      return permissions;
+    }
+
+    boost::optional<WsvCache::Signatories> WsvCacheView::signatories(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      if (modified_.signatories.count(account_id) != 0) {
+        return boost::none;
+      }
+      if (auto signatories = cache_->getSignatories(account_id)) {
+        return signatories;
+      }
+
+      const auto version = cache_->version();
+      WsvCache::Signatories signatories;
+      try {
+        boost::optional<int> quorum;
+        sql_ << "SELECT quorum FROM account WHERE account_id = :account_id",
+            soci::into(quorum), soci::use(account_id);
+        if (not quorum) {
+          return boost::none;
+        }
+        signatories.quorum = *quorum;
+
+        soci::rowset<std::string> keys =
+            (sql_.prepare << "SELECT public_key FROM account_has_signatory "
+                             "WHERE account_id = :account_id",
+             soci::use(account_id));
+        signatories.public_keys.insert(keys.begin(), keys.end());
+      } catch (const std::exception &e) {
+        log_->warn("cannot read signatories of {}: {}", account_id, e.what());
+        return boost::none;
+      }
+      cache_->putSignatories(account_id, signatories, version);
+      return signatories;
+    }
+
+    boost::optional<shared_model::interface::types::PrecisionType>
+    WsvCacheView::precision(
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      if (modified_.assets.count(asset_id) != 0) {
+        return boost::none;
+      }
+      if (auto precision = cache_->getPrecision(asset_id)) {
+        return precision;
+      }
+
+      const auto version = cache_->version();
+      boost::optional<int> precision;
+      try {
+        sql_ << "SELECT precision FROM asset WHERE asset_id = :asset_id",
+            soci::into(precision), soci::use(asset_id);
+      } catch (const std::exception &e) {
+        log_->warn("cannot read precision of {}: {}", asset_id, e.what());
+        return boost::none;
+      }
+      if (not precision) {
+        return boost::none;
+      }
+      cache_->putPrecision(asset_id, *precision, version);
+      return boost::make_optional<
+          shared_model::interface::types::PrecisionType>(*precision);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,209 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_WSV_CACHE_HPP
+#define IROHA_WSV_CACHE_HPP
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <soci/soci.h>
+#include <boost/optional.hpp>
+#include "interfaces/common_objects/types.hpp"
+#include "interfaces/permissions.hpp"
+#include "logger/logger.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+    class Command;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Accounts and assets whose cached entities are changed by commands
+     */
+    struct ModifiedEntities {
+      /// accounts with changed roles
+      std::unordered_set<std::string> permissions;
+      /// accounts with changed signatories or quorum
+      std::unordered_set<std::string> signatories;
+      /// created assets
+      std::unordered_set<std::string> assets;
+
+      /**
+       * Add entities changed by command
+       */
+      void add(const shared_model::interface::Command &command);
+    };
+
+    /**
+     * In-memory cache of committed WSV entities used by stateful
+     * validation: role permissions and signatories of accounts, and
+     * precision of assets.
+     *
+     * Entries changed by a block are invalidated after the block is
+     * committed. Every invalidation increments the version of cache, and
+     * entries read from the database are put only if the version has not
+     * changed since the read started, so a read which raced with a commit
+     * cannot put a stale entry.
+     */
+    class WsvCache {
+     public:
+      using Version = uint64_t;
+
+      struct Signatories {
+        /// hex of public keys
+        std::unordered_set<std::string> public_keys;
+        shared_model::interface::types::QuorumType quorum;
+      };
+
+      WsvCache();
+
+      /**
+       * @return current version, to be passed to put methods
+       */
+      Version version() const;
+
+      /**
+       * @return union of permissions of all roles of account, if cached
+       */
+      boost::optional<shared_model::interface::RolePermissionSet>
+      getPermissions(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /**
+       * @return signatories and quorum of account, if cached
+       */
+      boost::optional<Signatories> getSignatories(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /**
+       * @return precision of asset, if cached
+       */
+      boost::optional<shared_model::interface::types::PrecisionType>
+      getPrecision(const shared_model::interface::types::AssetIdType &asset_id);
+
+      /**
+       * Put entries read from committed state
+       * @param version - version of cache before the read started
+       * @return true if entry is put, false if it is outdated
+       */
+      bool putPermissions(
+          const shared_model::interface::types::AccountIdType &account_id,
+          shared_model::interface::RolePermissionSet permissions,
+          Version version);
+
+      bool putSignatories(
+          const shared_model::interface::types::AccountIdType &account_id,
+          Signatories signatories,
+          Version version);
+
+      bool putPrecision(
+          const shared_model::interface::types::AssetIdType &asset_id,
+          shared_model::interface::types::PrecisionType precision,
+          Version version);
+
+      /**
+       * Remove entries changed by committed block
+       */
+      void invalidate(const shared_model::interface::Block &block);
+
+      /**
+       * Remove all entries, counters are kept
+       */
+      void clear();
+
+      /**
+       * @return number of get calls which found an entry
+       */
+      size_t hits() const;
+
+      /**
+       * @return number of get calls which did not find an entry
+       */
+      size_t misses() const;
+
+      /**
+       * @return number of entries removed by invalidate()
+       */
+      size_t invalidations() const;
+
+      /**
+       * @return number of cached entries
+       */
+      size_t size() const;
+
+     private:
+      template <typename Map>
+      boost::optional<typename Map::mapped_type> get(const Map &map,
+                                                     const std::string &key);
+
+      template <typename Map>
+      bool put(Map &map,
+               const std::string &key,
+               typename Map::mapped_type value,
+               Version version);
+
+      std::unordered_map<std::string,
+                         shared_model::interface::RolePermissionSet>
+          permissions_;
+
+      std::unordered_map<std::string, Signatories> signatories_;
+
+      std::unordered_map<std::string,
+                         shared_model::interface::types::PrecisionType>
+          precisions_;
+
+      Version version_;
+
+      std::atomic<size_t> hits_;
+      std::atomic<size_t> misses_;
+      std::atomic<size_t> invalidations_;
+
+      mutable std::shared_timed_mutex mutex_;
+    };
+
+    /**
+     * Cached committed entities as seen by a temporary WSV. Entities changed
+     * by transactions applied to the temporary WSV are not taken from cache,
+     * missing ones are read in its session and put to cache.
+     */
+    class WsvCacheView {
+     public:
+      WsvCacheView(std::shared_ptr<WsvCache> cache, soci::session &sql);
+
+      /**
+       * Mark entities changed by command, must be called before the command
+       * is executed
+       */
+      void modify(const shared_model::interface::Command &command);
+
+      boost::optional<shared_model::interface::RolePermissionSet> permissions(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      boost::optional<WsvCache::Signatories> signatories(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      boost::optional<shared_model::interface::types::PrecisionType>
+      precision(const shared_model::interface::types::AssetIdType &asset_id);
+
+     private:
+      std::shared_ptr<WsvCache> cache_;
+      soci::session &sql_;
+      ModifiedEntities modified_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_CACHE_HPP
@@ -17,25 +17,153 @@
 
 #include "wsv_restorer_impl.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+#include <boost/format.hpp>
 #include "ametsuchi/block_query.hpp"
+#include "ametsuchi/mutable_storage.hpp"
 #include "ametsuchi/storage.hpp"
 #include "interfaces/iroha_internal/block.hpp"
 
+namespace {
+  using HeightType = shared_model::interface::types::HeightType;
+
+  /// number of applied blocks between progress reports
+  const HeightType kProgressInterval = 10000;
+
+  /**
+   * Blocks decoded by worker threads, which wait for application in order
+   */
+  struct DecodeWindow {
+    std::mutex mutex;
+    std::condition_variable changed;
+    /// decoded blocks by height, null if block cannot be read
+    std::map<HeightType, std::shared_ptr<shared_model::interface::Block>>
+        decoded;
+    HeightType next_to_decode = 1;
+    HeightType applied = 0;
+    bool stopped = false;
+  };
+}  // namespace
+
 namespace iroha {
   namespace ametsuchi {
+    WsvRestorerImpl::WsvRestorerImpl(size_t window_size,
+                                     size_t decode_threads)
+        : window_size_(std::max<size_t>(window_size, 1)),
+          decode_threads_(decode_threads > 0
+                              ? decode_threads
+                              : std::max(1u,
+                                         std::thread::hardware_concurrency())),
+          log_(logger::log("WsvRestorer")) {}
+
     expected::Result<void, std::string> WsvRestorerImpl::restoreWsv(
         Storage &storage) {
-      // get all blocks starting from the genesis
-      std::vector<std::shared_ptr<shared_model::interface::Block>> blocks=
-      storage.getBlockQuery()->getBlocksFrom(1);
+      auto block_query = storage.getBlockQuery();
+      if (not block_query) {
+        return expected::makeError("cannot create block query");
+      }
+      const HeightType top_height = block_query->getTopBlockHeight();
+      log_->info("restoring WSV from {} blocks", top_height);
+
+      storage.resetWsv();
+      // blocks up to the snapshot are not applied again
+      const HeightType snapshot_height = storage.loadWsvSnapshot();
+      if (snapshot_height > 0) {
+        log_->info("WSV snapshot of block {} loaded", snapshot_height);
+      }
+
+      DecodeWindow window;
+      window.next_to_decode = snapshot_height + 1;
+      window.applied = snapshot_height;
+      // block query only reads block store, so it is shared by the workers
+      auto decode = [&] {
+        while (true) {
+          HeightType height;
+          {
+            std::unique_lock<std::mutex> lock(window.mutex);
+            window.changed.wait(lock, [&] {
+              return window.stopped or window.next_to_decode > top_height
+                  or window.next_to_decode <= window.applied + window_size_;
+            });
+            if (window.stopped or window.next_to_decode > top_height) {
+              return;
+            }
+            height = window.next_to_decode++;
+          }
+          auto blocks = block_query->getBlocks(height, 1);
+          {
+            std::lock_guard<std::mutex> lock(window.mutex);
+            window.decoded[height] =
+                blocks.empty() ? nullptr : std::move(blocks.front());
+          }
+          window.changed.notify_all();
+        }
+      };
+      std::vector<std::thread> workers;
+      for (size_t i = 0; i < decode_threads_; ++i) {
+        workers.emplace_back(decode);
+      }
+
+      boost::optional<std::string> error;
+      std::unique_ptr<MutableStorage> mutable_storage;
+      for (HeightType height = snapshot_height + 1; height <= top_height;
+           ++height) {
+        std::shared_ptr<shared_model::interface::Block> block;
+        {
+          std::unique_lock<std::mutex> lock(window.mutex);
+          window.changed.wait(
+              lock, [&] { return window.decoded.count(height) > 0; });
+          block = std::move(window.decoded[height]);
+          window.decoded.erase(height);
+          window.applied = height;
+        }
+        window.changed.notify_all();
 
-      storage.reset();
+        if (not block) {
+          error = (boost::format("cannot read block %d") % height).str();
+          break;
+        }
+        if (not mutable_storage) {
+          storage.createMutableStorage().match(
+              [&](expected::Value<std::unique_ptr<MutableStorage>> &v) {
+                mutable_storage = std::move(v.value);
+              },
+              [&](expected::Error<std::string> &e) { error = e.error; });
+          if (error) {
+            break;
+          }
+        }
+        if (not mutable_storage->apply(*block)) {
+          error = (boost::format("cannot apply block %d") % height).str();
+          break;
+        }
+        // commit periodically, as mutable storage keeps applied blocks
+        if (height % window_size_ == 0 or height == top_height) {
+          storage.commit(std::move(mutable_storage));
+        }
+        if (height % kProgressInterval == 0 or height == top_height) {
+          log_->info("restored {} of {} blocks", height, top_height);
+        }
+      }
 
-      if (not storage.insertBlocks(blocks))
-        return expected::makeError("cannot insert blocks");
+      {
+        std::lock_guard<std::mutex> lock(window.mutex);
+        window.stopped = true;
+      }
+      window.changed.notify_all();
+      for (auto &worker : workers) {
+        worker.join();
+      }
 
+      if (error) {
+        return expected::makeError(*error);
+      }
       return expected::Value<void>();
     }
   }  // namespace ametsuchi
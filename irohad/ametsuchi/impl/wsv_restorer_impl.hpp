@@ -20,6 +20,7 @@
 
 #include "ametsuchi/wsv_restorer.hpp"
 #include "common/result.hpp"
+#include "logger/logger.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -30,15 +31,37 @@ namespace iroha {
      */
     class WsvRestorerImpl : public WsvRestorer {
      public:
+      /// number of decoded blocks waiting for application if not specified
+      static const size_t kDefaultWindowSize = 100;
+
+      /**
+       * @param window_size - maximal number of blocks which are decoded ahead
+       * of the applied one, also the number of blocks applied in a single
+       * database transaction
+       * @param decode_threads - number of threads decoding blocks, number of
+       * hardware threads if zero
+       */
+      explicit WsvRestorerImpl(size_t window_size = kDefaultWindowSize,
+                               size_t decode_threads = 0);
+
       virtual ~WsvRestorerImpl() = default;
       /**
        * Recover WSV (World State View).
-       * Drop storage and apply blocks one by one.
+       * Drop WSV, load the newest valid WSV snapshot if any, and apply the
+       * following blocks from block store one by one. Blocks are read and
+       * decoded by worker threads and applied in order, at most window size
+       * blocks are kept in memory at once.
        * @param storage of blocks in ledger
        * @return void on success, otherwise error string
        */
       virtual expected::Result<void, std::string> restoreWsv(
           Storage &storage) override;
+
+     private:
+      const size_t window_size_;
+      const size_t decode_threads_;
+
+      logger::Logger log_;
     };
 
   }  // namespace ametsuchi
@@ -0,0 +1,261 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/wsv_snapshot_storage.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+
+namespace {
+  const std::string kFormatLine = "iroha_wsv_snapshot 1";
+  const std::string kHeightPrefix = "height ";
+  const std::string kHashPrefix = "hash ";
+  const std::string kTablePrefix = "table ";
+  const std::string kChecksumPrefix = "checksum ";
+  const std::string kExtension = ".snapshot";
+
+  /// number of rows inserted by a single statement on load
+  const size_t kBatchSize = 1000;
+
+  bool startsWith(const std::string &line, const std::string &prefix) {
+    return line.compare(0, prefix.size(), prefix) == 0;
+  }
+
+  std::string fileName(shared_model::interface::types::HeightType height) {
+    std::ostringstream os;
+    os << "wsv_" << std::setw(20) << std::setfill('0') << height << kExtension;
+    return os.str();
+  }
+
+  /**
+   * Add line with its line break to checksum
+   */
+  void process(boost::crc_32_type &crc, const std::string &line) {
+    crc.process_bytes(line.data(), line.size());
+    crc.process_byte('\n');
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    const std::vector<std::string> WsvSnapshotStorage::kTables = {
+        "role",
+        "domain",
+        "signatory",
+        "account",
+        "account_has_signatory",
+        "peer",
+        "asset",
+        "account_has_asset",
+        "role_has_permissions",
+        "account_has_roles",
+        "account_has_grantable_permissions",
+        "position_by_hash",
+        "tx_status_by_hash",
+        "height_by_account_set",
+        "index_by_creator_height",
+        "position_by_account_asset"};
+
+    WsvSnapshotStorage::WsvSnapshotStorage(std::string dir)
+        : dir_(std::move(dir)), log_(logger::log("WsvSnapshotStorage")) {}
+
+    expected::Result<WsvSnapshotInfo, std::string> WsvSnapshotStorage::create(
+        soci::session &sql,
+        shared_model::interface::types::HeightType height,
+        const shared_model::interface::types::HashType &hash) {
+      namespace fs = boost::filesystem;
+      boost::system::error_code err;
+      if (not fs::is_directory(dir_, err)
+          and not fs::create_directories(dir_, err)) {
+        return expected::makeError(
+            (boost::format("Cannot create snapshot dir %s: %s") % dir_
+             % err.message())
+                .str());
+      }
+
+      const auto path = (fs::path(dir_) / fileName(height)).string();
+      // snapshot is written under a temporary name, so a partially written
+      // file is never listed
+      const auto tmp_path = path + ".tmp";
+      try {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        boost::crc_32_type crc;
+        auto write_line = [&file, &crc](const std::string &line) {
+          process(crc, line);
+          file << line << '\n';
+        };
+
+        write_line(kFormatLine);
+        write_line(kHeightPrefix + std::to_string(height));
+        write_line(kHashPrefix + hash.hex());
+        for (const auto &table : kTables) {
+          write_line(kTablePrefix + table);
+          soci::rowset<std::string> rows =
+              (sql.prepare << "SELECT row_to_json(t)::text FROM " + table
+                       + " t");
+          for (const auto &row : rows) {
+            write_line(row);
+          }
+        }
+        file << kChecksumPrefix << crc.checksum() << '\n';
+        file.close();
+        if (not file) {
+          throw std::runtime_error("write to " + tmp_path + " failed");
+        }
+      } catch (const std::exception &e) {
+        fs::remove(tmp_path, err);
+        return expected::makeError(
+            (boost::format("Cannot create snapshot at height %d: %s") % height
+             % e.what())
+                .str());
+      }
+
+      fs::rename(tmp_path, path, err);
+      if (err) {
+        return expected::makeError(
+            (boost::format("Cannot rename snapshot %s: %s") % tmp_path
+             % err.message())
+                .str());
+      }
+      removeOld();
+      return expected::makeValue(WsvSnapshotInfo{height, hash.hex(), path});
+    }
+
+    std::vector<WsvSnapshotInfo> WsvSnapshotStorage::list() const {
+      namespace fs = boost::filesystem;
+      std::vector<WsvSnapshotInfo> result;
+      boost::system::error_code err;
+      if (not fs::is_directory(dir_, err)) {
+        return result;
+      }
+
+      for (const auto &entry : fs::directory_iterator(dir_)) {
+        if (entry.path().extension() != kExtension) {
+          continue;
+        }
+        std::ifstream file(entry.path().string());
+        std::string format, height, hash;
+        if (not std::getline(file, format) or format != kFormatLine
+            or not std::getline(file, height)
+            or not startsWith(height, kHeightPrefix)
+            or not std::getline(file, hash)
+            or not startsWith(hash, kHashPrefix)) {
+          log_->warn("skipping snapshot {} with broken header",
+                     entry.path().string());
+          continue;
+        }
+        try {
+          result.push_back(
+              WsvSnapshotInfo{std::stoull(height.substr(kHeightPrefix.size())),
+                              hash.substr(kHashPrefix.size()),
+                              entry.path().string()});
+        } catch (const std::exception &e) {
+          log_->warn("skipping snapshot {} with broken height",
+                     entry.path().string());
+        }
+      }
+
+      std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return a.height > b.height;
+      });
+      return result;
+    }
+
+    expected::Result<void, std::string> WsvSnapshotStorage::load(
+        soci::session &sql, const WsvSnapshotInfo &snapshot) const {
+      std::ifstream file(snapshot.path);
+      if (not file) {
+        return expected::makeError("Cannot open snapshot " + snapshot.path);
+      }
+
+      try {
+        // rolled back on destruction unless committed
+        soci::transaction tx(sql);
+        boost::crc_32_type crc;
+        std::string line, table, batch;
+        size_t batch_rows = 0, line_number = 0;
+        auto flush = [&] {
+          if (batch_rows == 0) {
+            return;
+          }
+          std::string rows = "[" + batch + "]";
+          sql << "INSERT INTO " + table
+                  + " SELECT * FROM json_populate_recordset(NULL::" + table
+                  + ", :rows)",
+              soci::use(rows);
+          batch.clear();
+          batch_rows = 0;
+        };
+
+        while (std::getline(file, line)) {
+          if (startsWith(line, kChecksumPrefix)) {
+            flush();
+            if (std::stoul(line.substr(kChecksumPrefix.size()))
+                != crc.checksum()) {
+              return expected::makeError("Checksum mismatch in snapshot "
+                                         + snapshot.path);
+            }
+            tx.commit();
+            return expected::Value<void>();
+          }
+          process(crc, line);
+          // header was parsed by list()
+          if (++line_number <= 3) {
+            continue;
+          }
+
+          if (startsWith(line, kTablePrefix)) {
+            flush();
+            table = line.substr(kTablePrefix.size());
+            // table name is put into the statement, so only known ones pass
+            if (std::find(kTables.begin(), kTables.end(), table)
+                == kTables.end()) {
+              return expected::makeError("Unknown table " + table
+                                         + " in snapshot " + snapshot.path);
+            }
+            continue;
+          }
+          if (table.empty()) {
+            return expected::makeError("Row without table in snapshot "
+                                       + snapshot.path);
+          }
+          batch += (batch_rows == 0 ? "" : ",") + line;
+          if (++batch_rows == kBatchSize) {
+            flush();
+          }
+        }
+      } catch (const std::exception &e) {
+        return expected::makeError(
+            (boost::format("Cannot load snapshot %s: %s") % snapshot.path
+             % e.what())
+                .str());
+      }
+      return expected::makeError("Snapshot " + snapshot.path
+                                 + " has no checksum");
+    }
+
+    void WsvSnapshotStorage::removeOld() const {
+      auto snapshots = list();
+      for (size_t i = kKeptSnapshots; i < snapshots.size(); ++i) {
+        boost::system::error_code err;
+        boost::filesystem::remove(snapshots[i].path, err);
+        if (err) {
+          log_->warn("Cannot remove snapshot {}: {}",
+                     snapshots[i].path,
+                     err.message());
+        } else {
+          log_->info("removed snapshot {}", snapshots[i].path);
+        }
+      }
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
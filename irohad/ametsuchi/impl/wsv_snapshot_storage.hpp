@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_WSV_SNAPSHOT_STORAGE_HPP
+#define IROHA_WSV_SNAPSHOT_STORAGE_HPP
+
+#include <string>
+#include <vector>
+
+#include <soci/soci.h>
+#include "common/result.hpp"
+#include "cryptography/hash.hpp"
+#include "interfaces/common_objects/types.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Block which a WSV snapshot corresponds to
+     */
+    struct WsvSnapshotInfo {
+      shared_model::interface::types::HeightType height;
+      /// hex of block hash
+      std::string hash;
+      /// path of snapshot file
+      std::string path;
+    };
+
+    /**
+     * Folder of WSV snapshots.
+     *
+     * A snapshot is a text file with a header holding the height and the hash
+     * of the last applied block, followed by the rows of every WSV table as
+     * JSON objects, and a checksum of everything before it. Rows are dumped
+     * and restored by PostgreSQL itself, so the format does not depend on
+     * table columns.
+     */
+    class WsvSnapshotStorage {
+     public:
+      /// number of the newest snapshots kept in the folder
+      static const size_t kKeptSnapshots = 2;
+
+      /// dumped tables, referenced tables go first
+      static const std::vector<std::string> kTables;
+
+      /**
+       * @param dir - folder of snapshots, created with the first snapshot
+       */
+      explicit WsvSnapshotStorage(std::string dir);
+
+      /**
+       * Write tables as they are visible to the current transaction of sql to
+       * a new snapshot, and remove the oldest snapshots
+       * @param sql - session with a transaction which sees the state after
+       * the given block
+       * @param height - height of the last applied block
+       * @param hash - hash of the last applied block
+       * @return written snapshot or an error
+       */
+      expected::Result<WsvSnapshotInfo, std::string> create(
+          soci::session &sql,
+          shared_model::interface::types::HeightType height,
+          const shared_model::interface::types::HashType &hash);
+
+      /**
+       * @return snapshots with a readable header, from the newest one
+       */
+      std::vector<WsvSnapshotInfo> list() const;
+
+      /**
+       * Insert rows of snapshot to empty tables in a single transaction,
+       * which is rolled back if the snapshot is damaged
+       * @param sql - session to insert rows with
+       * @param snapshot - snapshot to load
+       * @return void on success, otherwise an error
+       */
+      expected::Result<void, std::string> load(
+          soci::session &sql, const WsvSnapshotInfo &snapshot) const;
+
+     private:
+      /**
+       * Remove all but kKeptSnapshots newest snapshots
+       */
+      void removeOld() const;
+
+      const std::string dir_;
+
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_SNAPSHOT_STORAGE_HPP
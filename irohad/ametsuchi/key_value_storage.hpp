@@ -7,6 +7,7 @@
 #define IROHA_KV_STORAGE_HPP
 
 #include <boost/optional.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,16 @@ namespace iroha {
       using Identifier = uint32_t;
       using Bytes = std::vector<uint8_t>;
 
+      /**
+       * Read-only view of stored data. Viewed memory stays valid as long as
+       * the holder is alive, even if the storage is modified or dropped
+       */
+      struct BytesView {
+        std::shared_ptr<const void> holder;
+        const uint8_t *data;
+        size_t size;
+      };
+
       /**
        * Add entity with binary data
        * @param id - reference key
@@ -39,6 +50,21 @@ namespace iroha {
        */
       virtual boost::optional<Bytes> get(Identifier id) const = 0;
 
+      /**
+       * Get data associated with id without copying it to a new buffer.
+       * Default implementation falls back to get()
+       * @param id - reference key
+       * @return - view of blob, if exists
+       */
+      virtual boost::optional<BytesView> getView(Identifier id) const {
+        auto blob = get(id);
+        if (not blob) {
+          return boost::none;
+        }
+        auto holder = std::make_shared<const Bytes>(std::move(*blob));
+        return BytesView{holder, holder->data(), holder->size()};
+      }
+
       /**
        * @return folder of storage
        */
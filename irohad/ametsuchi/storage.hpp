@@ -16,6 +16,7 @@
 #include "ametsuchi/query_executor_factory.hpp"
 #include "ametsuchi/temporary_factory.hpp"
 #include "common/result.hpp"
+#include "interfaces/common_objects/types.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -73,6 +74,20 @@ namespace iroha {
        */
       virtual void reset() = 0;
 
+      /**
+       * Remove all records from the tables, keeping the blocks. Blocks which
+       * are already in block store are not stored again on commit
+       */
+      virtual void resetWsv() = 0;
+
+      /**
+       * Fill empty WSV from the newest snapshot which matches a block in
+       * block store
+       * @return height of the block WSV corresponds to, 0 if no snapshot
+       * was loaded
+       */
+      virtual shared_model::interface::types::HeightType loadWsvSnapshot() = 0;
+
       /**
        * Remove all information from ledger
        * Tables and the database will be removed too
@@ -40,6 +40,18 @@ namespace iroha {
       /// response type which reflects status of each transaction in a batch
       using BatchStatusCollectionType = std::vector<TxCacheStatusType>;
 
+      /// collection of transaction hashes to check at once
+      using HashCollectionType = std::vector<shared_model::crypto::Hash>;
+
+      /**
+       * Check statuses of several transactions at once. Hashes which are not
+       * cached are checked in storage with a single query
+       * @return a collection with answers about each hash in the same order
+       * if storage query was successful, boost::none otherwise
+       */
+      virtual boost::optional<BatchStatusCollectionType> check(
+          const HashCollectionType &hashes) const = 0;
+
       /**
        * Check batch status
        * @return a collection with answers about each transaction in the batch
@@ -48,9 +60,6 @@ namespace iroha {
       virtual boost::optional<BatchStatusCollectionType> check(
           const shared_model::interface::TransactionBatch &batch) const = 0;
 
-      // TODO: 09/11/2018 @muratovv add method for processing collection of
-      // batches IR-1857
-
       virtual ~TxPresenceCache() = default;
     };
   }  // namespace ametsuchi
@@ -16,20 +16,32 @@ namespace iroha {
           const shared_model::crypto::Keypair &keypair,
           std::shared_ptr<shared_model::interface::CommonObjectsFactory>
               factory)
-          : keypair_(keypair), factory_(std::move(factory)) {}
+          : keypair_(keypair),
+            factory_(std::move(factory)),
+            log_(logger::log("YacCryptoProvider")) {}
 
       bool CryptoProviderImpl::verify(const std::vector<VoteMessage> &msg) {
-        return std::all_of(
-            std::begin(msg), std::end(msg), [](const auto &vote) {
-              auto serialized =
-                  PbConverters::serializeVote(vote).hash().SerializeAsString();
-              auto blob = shared_model::crypto::Blob(serialized);
-
-              return shared_model::crypto::CryptoVerifier<>::verify(
-                  vote.signature->signedData(),
-                  blob,
-                  vote.signature->publicKey());
-            });
+        for (size_t i = 0; i < msg.size(); ++i) {
+          const auto &vote = msg[i];
+          // signed payload does not include the vote signature, so it is not
+          // serialized
+          const shared_model::crypto::Blob payload(
+              PbConverters::serializeVotePayload(vote)
+                  .hash()
+                  .SerializeAsString());
+          // checks interface does not throw on malformed keys and signatures
+          if (not shared_model::crypto::CryptoVerifier<>::verifyAll(
+                  {{vote.signature->signedData(),
+                    payload,
+                    vote.signature->publicKey()}})) {
+            log_->warn("incorrect signature of vote {} of {} by {}",
+                       i,
+                       msg.size(),
+                       vote.signature->publicKey().hex());
+            return false;
+          }
+        }
+        return true;
       }
 
       VoteMessage CryptoProviderImpl::getVote(YacHash hash) {
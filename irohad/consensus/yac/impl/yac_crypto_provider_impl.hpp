@@ -10,6 +10,7 @@
 
 #include "cryptography/keypair.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
+#include "logger/logger.hpp"
 
 namespace iroha {
   namespace consensus {
@@ -21,6 +22,10 @@ namespace iroha {
             std::shared_ptr<shared_model::interface::CommonObjectsFactory>
                 factory);
 
+        /**
+         * Verify signatures of votes until an incorrect one is found, which
+         * is logged
+         */
         bool verify(const std::vector<VoteMessage> &msg) override;
 
         VoteMessage getVote(YacHash hash) override;
@@ -28,6 +33,7 @@ namespace iroha {
        private:
         shared_model::crypto::Keypair keypair_;
         std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
+        logger::Logger log_;
       };
     }  // namespace yac
   }    // namespace consensus
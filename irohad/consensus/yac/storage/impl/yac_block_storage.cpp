@@ -5,6 +5,9 @@
 
 #include "consensus/yac/storage/yac_block_storage.hpp"
 
+#include "cryptography/public_key.hpp"
+#include "interfaces/common_objects/signature.hpp"
+
 using namespace logger;
 
 namespace iroha {
@@ -19,31 +22,21 @@ namespace iroha {
           std::shared_ptr<SupermajorityChecker> supermajority_checker)
           : storage_key_(std::move(hash)),
             peers_in_round_(peers_in_round),
+            has_supermajority_(false),
             supermajority_checker_(std::move(supermajority_checker)) {
         log_ = log("YacBlockStorage");
       }
 
       boost::optional<Answer> YacBlockStorage::insert(VoteMessage msg) {
-        if (validScheme(msg) and uniqueVote(msg)) {
-          votes_.push_back(msg);
-
-          log_->info(
-              "Vote with round {} and hashes ({}, {}) inserted, votes in "
-              "storage [{}/{}]",
-              msg.hash.vote_round,
-              msg.hash.vote_hashes.proposal_hash,
-              msg.hash.vote_hashes.block_hash,
-              votes_.size(),
-              peers_in_round_);
-        }
+        tryInsert(std::move(msg));
         return getState();
       }
 
       boost::optional<Answer> YacBlockStorage::insert(
           std::vector<VoteMessage> votes) {
-        std::for_each(votes.begin(), votes.end(), [this](auto vote) {
-          this->insert(vote);
-        });
+        for (auto &vote : votes) {
+          tryInsert(std::move(vote));
+        }
         return getState();
       }
 
@@ -56,35 +49,55 @@ namespace iroha {
       }
 
       boost::optional<Answer> YacBlockStorage::getState() {
-        auto supermajority =
-            supermajority_checker_->checkSize(votes_.size(), peers_in_round_);
-        if (supermajority) {
+        if (has_supermajority_) {
           return Answer(CommitMessage(votes_));
         }
         return boost::none;
       }
 
       bool YacBlockStorage::isContains(const VoteMessage &msg) const {
-        return std::count(votes_.begin(), votes_.end(), msg) != 0;
+        return voters_.count(voterKey(msg)) != 0;
       }
 
-      YacHash YacBlockStorage::getStorageKey() const {
+      const YacHash &YacBlockStorage::getStorageKey() const {
         return storage_key_;
       }
 
       // --------| private api |--------
 
-      bool YacBlockStorage::uniqueVote(VoteMessage &msg) {
-        // lookup take O(n) times
-        return std::all_of(votes_.begin(), votes_.end(), [&msg](auto vote) {
-          return vote != msg;
-        });
+      bool YacBlockStorage::tryInsert(VoteMessage &&msg) {
+        if (not validScheme(msg) or not uniqueVote(msg)) {
+          return false;
+        }
+        voters_.insert(voterKey(msg));
+        votes_.push_back(std::move(msg));
+        has_supermajority_ =
+            supermajority_checker_->checkSize(votes_.size(), peers_in_round_);
+
+        const auto &vote = votes_.back();
+        log_->info(
+            "Vote with round {} and hashes ({}, {}) inserted, votes in "
+            "storage [{}/{}]",
+            vote.hash.vote_round,
+            vote.hash.vote_hashes.proposal_hash,
+            vote.hash.vote_hashes.block_hash,
+            votes_.size(),
+            peers_in_round_);
+        return true;
+      }
+
+      bool YacBlockStorage::uniqueVote(const VoteMessage &msg) const {
+        return not isContains(msg);
       }
 
-      bool YacBlockStorage::validScheme(VoteMessage &vote) {
+      bool YacBlockStorage::validScheme(const VoteMessage &vote) const {
         return getStorageKey() == vote.hash;
       }
 
+      const std::string &YacBlockStorage::voterKey(const VoteMessage &vote) {
+        return vote.signature->publicKey().hex();
+      }
+
     }  // namespace yac
   }    // namespace consensus
 }  // namespace iroha
@@ -29,10 +29,9 @@ namespace iroha {
         // find exist
         auto iter = std::find_if(block_storages_.begin(),
                                  block_storages_.end(),
-                                 [&store_hash](auto block_storage) {
-                                   auto storage_key =
-                                       block_storage.getStorageKey();
-                                   return storage_key == store_hash;
+                                 [&store_hash](const auto &block_storage) {
+                                   return block_storage.getStorageKey()
+                                       == store_hash;
                                  });
         if (iter != block_storages_.end()) {
           return iter;
@@ -71,7 +70,7 @@ namespace iroha {
                      msg.hash.vote_hashes.block_hash);
 
           auto iter = findStore(msg.hash);
-          auto block_state = iter->insert(msg);
+          auto block_state = iter->insert(std::move(msg));
 
           // Single BlockStorage always returns CommitMessage because it
           // aggregates votes for a single hash.
@@ -92,7 +91,7 @@ namespace iroha {
 
       boost::optional<Answer> YacProposalStorage::insert(
           std::vector<VoteMessage> messages) {
-        std::for_each(messages.begin(), messages.end(), [this](auto vote) {
+        std::for_each(messages.begin(), messages.end(), [this](auto &vote) {
           this->insert(std::move(vote));
         });
         return getState();
@@ -106,6 +105,15 @@ namespace iroha {
         return current_state_;
       }
 
+      size_t YacProposalStorage::getNumberOfVotes() const {
+        return std::accumulate(block_storages_.begin(),
+                               block_storages_.end(),
+                               size_t{0},
+                               [](auto acc, const auto &storage) {
+                                 return acc + storage.getNumberOfVotes();
+                               });
+      }
+
       // --------| private api |--------
 
       bool YacProposalStorage::shouldInsert(const VoteMessage &msg) {
@@ -17,23 +17,23 @@
 
 #include "consensus/yac/storage/yac_vote_storage.hpp"
 
-#include <algorithm>
+#include <tuple>
 #include <utility>
 
-#include "consensus/yac/storage/yac_proposal_storage.hpp"
-
 namespace iroha {
   namespace consensus {
     namespace yac {
 
+      const BlockRoundType YacVoteStorage::kDefaultRoundsToKeep = 10;
+
       // --------| private api |--------
 
       auto YacVoteStorage::getProposalStorage(const Round &round) {
-        return std::find_if(proposal_storages_.begin(),
-                            proposal_storages_.end(),
-                            [&round](const auto &storage) {
-                              return storage.getStorageKey() == round;
-                            });
+        const auto start = std::chrono::steady_clock::now();
+        auto iter = proposal_storages_.find(round);
+        lookup_time_ += std::chrono::steady_clock::now() - start;
+        ++lookups_;
+        return iter;
       }
 
       auto YacVoteStorage::findProposalStorage(const VoteMessage &msg,
@@ -42,34 +42,108 @@ namespace iroha {
         if (val != proposal_storages_.end()) {
           return val;
         }
-        return proposal_storages_.emplace(
-            proposal_storages_.end(),
-            msg.hash.vote_round,
-            peers_in_round,
-            std::make_shared<SupermajorityCheckerImpl>());
+        return proposal_storages_
+            .emplace(std::piecewise_construct,
+                     std::forward_as_tuple(msg.hash.vote_round),
+                     std::forward_as_tuple(
+                         msg.hash.vote_round,
+                         peers_in_round,
+                         std::make_shared<SupermajorityCheckerImpl>()))
+            .first;
+      }
+
+      bool YacVoteStorage::isEvicted(const Round &round) const {
+        return round.block_round < first_kept_round_;
+      }
+
+      void YacVoteStorage::evict(const Round &committed_round) {
+        if (committed_round.block_round
+            <= first_kept_round_ + rounds_to_keep_) {
+          return;
+        }
+        first_kept_round_ = committed_round.block_round - rounds_to_keep_;
+
+        const auto evicted = evicted_rounds_;
+        for (auto it = proposal_storages_.begin();
+             it != proposal_storages_.end();) {
+          if (isEvicted(it->first)) {
+            it = proposal_storages_.erase(it);
+            ++evicted_rounds_;
+          } else {
+            ++it;
+          }
+        }
+        for (auto it = processing_state_.begin();
+             it != processing_state_.end();) {
+          if (isEvicted(it->first)) {
+            it = processing_state_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+
+        if (evicted_rounds_ != evicted) {
+          const auto current = stats();
+          log_->info(
+              "Dropped {} rounds before block round {}, kept {} rounds with {} "
+              "votes, average lookup {} ns",
+              evicted_rounds_ - evicted,
+              first_kept_round_,
+              current.rounds,
+              current.votes,
+              current.lookups == 0
+                  ? 0
+                  : current.lookup_time.count() / current.lookups);
+        }
       }
 
       // --------| public api |--------
 
+      YacVoteStorage::YacVoteStorage(BlockRoundType rounds_to_keep)
+          : rounds_to_keep_(rounds_to_keep),
+            first_kept_round_(0),
+            evicted_rounds_(0),
+            lookups_(0),
+            lookup_time_(0),
+            log_(logger::log("YacVoteStorage")) {}
+
       boost::optional<Answer> YacVoteStorage::store(
           std::vector<VoteMessage> state, PeersNumberType peers_in_round) {
+        const auto &round = state.at(0).hash.vote_round;
+        if (isEvicted(round)) {
+          return boost::none;
+        }
         auto storage = findProposalStorage(state.at(0), peers_in_round);
-        return storage->insert(state);
+        auto answer = storage->second.insert(state);
+        if (answer and boost::get<CommitMessage>(&*answer)) {
+          evict(round);
+        }
+        return answer;
       }
 
       bool YacVoteStorage::isCommitted(const Round &round) {
+        if (isEvicted(round)) {
+          return true;
+        }
         auto iter = getProposalStorage(round);
         if (iter == proposal_storages_.end()) {
           return false;
         }
-        return bool(iter->getState());
+        return bool(iter->second.getState());
       }
 
       ProposalState YacVoteStorage::getProcessingState(const Round &round) {
-        return processing_state_[round];
+        auto iter = processing_state_.find(round);
+        if (iter == processing_state_.end()) {
+          return ProposalState::kNotSentNotProcessed;
+        }
+        return iter->second;
       }
 
       void YacVoteStorage::nextProcessingState(const Round &round) {
+        if (isEvicted(round)) {
+          return;
+        }
         auto &val = processing_state_[round];
         switch (val) {
           case ProposalState::kNotSentNotProcessed:
@@ -83,6 +157,19 @@ namespace iroha {
         }
       }
 
+      YacVoteStorage::Stats YacVoteStorage::stats() const {
+        size_t votes = 0;
+        for (const auto &storage : proposal_storages_) {
+          votes += storage.second.getNumberOfVotes();
+        }
+        return Stats{proposal_storages_.size(),
+                     votes,
+                     processing_state_.size(),
+                     evicted_rounds_,
+                     lookups_,
+                     lookup_time_};
+      }
+
     }  // namespace yac
   }    // namespace consensus
 }  // namespace iroha
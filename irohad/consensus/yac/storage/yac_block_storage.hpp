@@ -19,6 +19,8 @@
 #define IROHA_YAC_BLOCK_VOTE_STORAGE_HPP
 
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/optional.hpp>
@@ -33,6 +35,9 @@ namespace iroha {
     namespace yac {
       /**
        * Class provide storage of votes for one block.
+       *
+       * Votes are indexed by public keys of their peers, so every peer has
+       * at most one vote in the storage.
        */
       class YacBlockStorage {
        private:
@@ -82,7 +87,8 @@ namespace iroha {
         boost::optional<Answer> getState();
 
         /**
-         * Verify that passed vote contains in storage
+         * Verify that storage contains a vote of the peer which made passed
+         * vote
          * @param msg  - vote for finding
          * @return true, if contains
          */
@@ -91,24 +97,36 @@ namespace iroha {
         /**
          * Provide key attached to this storage
          */
-        YacHash getStorageKey() const;
+        const YacHash &getStorageKey() const;
 
        private:
         // --------| private api |--------
 
+        /**
+         * Insert vote to storage without making its state
+         * @param vote - vote for insertion
+         * @return true if vote was inserted
+         */
+        bool tryInsert(VoteMessage &&vote);
+
         /**
          * Verify uniqueness of vote in storage
          * @param msg - vote for verification
          * @return true if vote doesn't appear in storage
          */
-        bool uniqueVote(VoteMessage &vote);
+        bool uniqueVote(const VoteMessage &vote) const;
 
         /**
          * Verify that vote has the same hash attached as the storage
          * @param vote - vote to be checked
          * @return true, if validation passed
          */
-        bool validScheme(VoteMessage &vote);
+        bool validScheme(const VoteMessage &vote) const;
+
+        /**
+         * @return key of peer which made the vote
+         */
+        static const std::string &voterKey(const VoteMessage &vote);
 
         // --------| fields |--------
 
@@ -122,6 +140,16 @@ namespace iroha {
          */
         PeersNumberType peers_in_round_;
 
+        /**
+         * Keys of peers whose votes are stored
+         */
+        std::unordered_set<std::string> voters_;
+
+        /**
+         * Whether stored votes are supermajority, updated on insertion
+         */
+        bool has_supermajority_;
+
         /**
          * Provide functions to check supermajority
          */
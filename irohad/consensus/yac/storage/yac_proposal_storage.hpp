@@ -87,6 +87,11 @@ namespace iroha {
          */
         boost::optional<Answer> getState() const;
 
+        /**
+         * @return number of votes for all hashes of the round
+         */
+        size_t getNumberOfVotes() const;
+
        private:
         // --------| private api |--------
 
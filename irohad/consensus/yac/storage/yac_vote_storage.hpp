@@ -18,6 +18,7 @@
 #ifndef IROHA_YAC_VOTE_STORAGE_HPP
 #define IROHA_YAC_VOTE_STORAGE_HPP
 
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -26,13 +27,13 @@
 #include "consensus/yac/messages.hpp"  // because messages passed by value
 #include "consensus/yac/storage/storage_result.hpp"  // for Answer
 #include "consensus/yac/storage/yac_common.hpp"      // for ProposalHash
+#include "consensus/yac/storage/yac_proposal_storage.hpp"
 #include "consensus/yac/yac_types.hpp"
+#include "logger/logger.hpp"
 
 namespace iroha {
   namespace consensus {
     namespace yac {
-      class YacProposalStorage;
-
       /**
        * Proposal outcome states for multicast propagation strategy
        *
@@ -67,6 +68,10 @@ namespace iroha {
 
       /**
        * Class provide storage for votes and useful methods for it.
+       *
+       * Votes of a round are dropped when a block is committed in a round
+       * which is more than rounds_to_keep block rounds later, so the storage
+       * does not grow with uptime. Votes for dropped rounds are ignored.
        */
       class YacVoteStorage {
        private:
@@ -79,6 +84,16 @@ namespace iroha {
          */
         auto getProposalStorage(const Round &round);
 
+        /**
+         * Check whether votes of the round are already dropped
+         */
+        bool isEvicted(const Round &round) const;
+
+        /**
+         * Drop rounds which are too old after a commit in given round
+         */
+        void evict(const Round &committed_round);
+
         /**
          * Find existed proposal storage or create new if required
          * @param msg - vote for finding
@@ -93,12 +108,39 @@ namespace iroha {
        public:
         // --------| public api |--------
 
+        /// number of block rounds before the last committed one which are kept
+        static const BlockRoundType kDefaultRoundsToKeep;
+
+        /**
+         * Size and lookup counters of the storage
+         */
+        struct Stats {
+          /// number of rounds with votes
+          size_t rounds;
+          /// number of stored votes of all rounds
+          size_t votes;
+          /// number of rounds with processing state
+          size_t processing_states;
+          /// number of dropped rounds
+          uint64_t evicted_rounds;
+          /// number of round lookups and total time they took
+          uint64_t lookups;
+          std::chrono::nanoseconds lookup_time;
+        };
+
+        /**
+         * @param rounds_to_keep - number of block rounds before the last
+         * committed round whose votes are kept
+         */
+        explicit YacVoteStorage(
+            BlockRoundType rounds_to_keep = kDefaultRoundsToKeep);
+
         /**
          * Insert votes in storage
          * @param state - current message with votes
          * @param peers_in_round - number of peers participated in round
          * @return structure with result of inserting.
-         * boost::none if msg not valid.
+         * boost::none if msg not valid or its round is already dropped.
          */
         boost::optional<Answer> store(std::vector<VoteMessage> state,
                                       PeersNumberType peers_in_round);
@@ -106,7 +148,7 @@ namespace iroha {
         /**
          * Provide status about closing round of proposal/block
          * @param round, in which proposal/block is supposed to be committed
-         * @return true, if round closed
+         * @return true, if round closed or already dropped
          */
         bool isCommitted(const Round &round);
 
@@ -128,13 +170,16 @@ namespace iroha {
          */
         void nextProcessingState(const Round &round);
 
+        Stats stats() const;
+
        private:
         // --------| fields |--------
 
         /**
          * Active proposal storages
          */
-        std::vector<YacProposalStorage> proposal_storages_;
+        std::unordered_map<Round, YacProposalStorage, RoundTypeHasher>
+            proposal_storages_;
 
         /**
          * Processing set provide user flags about processing some
@@ -143,6 +188,19 @@ namespace iroha {
          */
         std::unordered_map<Round, ProposalState, RoundTypeHasher>
             processing_state_;
+
+        BlockRoundType rounds_to_keep_;
+
+        /**
+         * Rounds with block round below it are dropped
+         */
+        BlockRoundType first_kept_round_;
+
+        uint64_t evicted_rounds_;
+        uint64_t lookups_;
+        std::chrono::nanoseconds lookup_time_;
+
+        logger::Logger log_;
       };
 
     }  // namespace yac
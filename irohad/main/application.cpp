@@ -5,6 +5,7 @@
 
 #include "main/application.hpp"
 
+#include "ametsuchi/impl/in_memory/in_memory_storage.hpp"
 #include "ametsuchi/impl/tx_presence_cache_impl.hpp"
 #include "ametsuchi/impl/wsv_restorer_impl.hpp"
 #include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
@@ -34,6 +35,8 @@
 #include "validators/protobuf/proto_block_validator.hpp"
 #include "validators/protobuf/proto_query_validator.hpp"
 #include "validators/protobuf/proto_transaction_validator.hpp"
+#include "validators/signature_cache.hpp"
+#include "validators/signature_verification_pool.hpp"
 
 using namespace iroha;
 using namespace iroha::ametsuchi;
@@ -46,6 +49,47 @@ using namespace iroha::consensus::yac;
 
 using namespace std::chrono_literals;
 
+namespace {
+  /**
+   * Log counters of the pool verifying signatures for stateless validation
+   */
+  void logVerificationPoolStats(const logger::Logger &log,
+                                spdlog::level::level_enum level) {
+    const auto stats =
+        shared_model::validation::SignatureVerificationPool::instance()
+            .stats();
+    const auto mean_latency =
+        stats.jobs == 0 ? 0 : stats.total_latency.count() / stats.jobs;
+    log->log(level,
+             "signature verification: {} jobs, {} run in place, {} stolen, "
+             "queue depth: {}, max: {}, latency: {} us, max: {} us",
+             stats.jobs,
+             stats.rejected,
+             stats.stolen,
+             stats.queue_depth,
+             stats.max_queue_depth,
+             mean_latency,
+             stats.max_latency.count());
+  }
+
+  /**
+   * Log counters of the cache of verified signatures
+   */
+  void logSignatureCacheStats(const logger::Logger &log,
+                              spdlog::level::level_enum level) {
+    const auto stats =
+        shared_model::validation::SignatureCache::instance().stats();
+    log->log(level,
+             "signature cache: {} entries, {} hits, {} misses, {} evicted, "
+             "hit rate: {:.3f}",
+             stats.size,
+             stats.hits,
+             stats.misses,
+             stats.evictions,
+             stats.hitRate());
+  }
+}  // namespace
+
 /**
  * Configuring iroha daemon
  */
@@ -59,7 +103,18 @@ Irohad::Irohad(const std::string &block_store_dir,
                std::chrono::milliseconds vote_delay,
                const shared_model::crypto::Keypair &keypair,
                const boost::optional<GossipPropagationStrategyParams>
-                   &opt_mst_gossip_params)
+                   &opt_mst_gossip_params,
+               iroha::ametsuchi::BlockStorageType block_storage_type,
+               shared_model::interface::types::HeightType
+                   wsv_snapshot_interval,
+               bool pipelined_validation,
+               bool wsv_cache,
+               size_t validation_workers,
+               bool in_memory_wsv,
+               iroha::ametsuchi::PoolOptions pool_options,
+               bool async_commit,
+               iroha::ametsuchi::SyncOptions block_store_sync,
+               iroha::consensus::BlockRoundType vote_rounds_to_keep)
     : block_store_dir_(block_store_dir),
       pg_conn_(pg_conn),
       listen_ip_(listen_ip),
@@ -70,6 +125,16 @@ Irohad::Irohad(const std::string &block_store_dir,
       vote_delay_(vote_delay),
       is_mst_supported_(opt_mst_gossip_params),
       opt_mst_gossip_params_(opt_mst_gossip_params),
+      block_storage_type_(block_storage_type),
+      wsv_snapshot_interval_(wsv_snapshot_interval),
+      pipelined_validation_(pipelined_validation),
+      wsv_cache_(wsv_cache),
+      validation_workers_(validation_workers),
+      in_memory_wsv_(in_memory_wsv),
+      pool_options_(pool_options),
+      async_commit_(async_commit),
+      block_store_sync_(block_store_sync),
+      vote_rounds_to_keep_(vote_rounds_to_keep),
       keypair(keypair) {
   log_ = logger::log("IROHAD");
   log_->info("created");
@@ -126,16 +191,46 @@ void Irohad::initStorage() {
       std::make_shared<shared_model::proto::ProtoPermissionToString>();
   auto block_converter =
       std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
-  auto storageResult = StorageImpl::create(block_store_dir_,
-                                           pg_conn_,
+  if (in_memory_wsv_) {
+    auto storageResult =
+        ametsuchi::InMemoryStorage::create(block_store_dir_,
                                            common_objects_factory_,
                                            std::move(block_converter),
-                                           perm_converter);
-  storageResult.match(
-      [&](expected::Value<std::shared_ptr<ametsuchi::StorageImpl>> &_storage) {
-        storage = _storage.value;
-      },
-      [&](expected::Error<std::string> &error) { log_->error(error.error); });
+                                           perm_converter,
+                                           block_storage_type_,
+                                           block_store_sync_);
+    storageResult.match(
+        [&](expected::Value<std::shared_ptr<ametsuchi::InMemoryStorage>>
+                &_storage) {
+          storage = _storage.value;
+          tx_hash_index_ = _storage.value->txHashIndex();
+        },
+        [&](expected::Error<std::string> &error) {
+          log_->error(error.error);
+        });
+  } else {
+    auto storageResult = StorageImpl::create(block_store_dir_,
+                                             pg_conn_,
+                                             common_objects_factory_,
+                                             std::move(block_converter),
+                                             perm_converter,
+                                             pool_options_,
+                                             block_storage_type_,
+                                             wsv_snapshot_interval_,
+                                             pipelined_validation_,
+                                             wsv_cache_,
+                                             async_commit_,
+                                             block_store_sync_);
+    storageResult.match(
+        [&](expected::Value<std::shared_ptr<ametsuchi::StorageImpl>>
+                &_storage) {
+          storage = _storage.value;
+          tx_hash_index_ = _storage.value->txHashIndex();
+        },
+        [&](expected::Error<std::string> &error) {
+          log_->error(error.error);
+        });
+  }
 
   log_->info("[Init] => storage", logger::logBool(storage));
 }
@@ -172,8 +267,8 @@ void Irohad::initBatchParser() {
 void Irohad::initValidators() {
   auto factory = std::make_unique<shared_model::proto::ProtoProposalFactory<
       shared_model::validation::DefaultProposalValidator>>();
-  stateful_validator =
-      std::make_shared<StatefulValidatorImpl>(std::move(factory), batch_parser);
+  stateful_validator = std::make_shared<StatefulValidatorImpl>(
+      std::move(factory), batch_parser, storage, validation_workers_);
   chain_validator = std::make_shared<ChainValidatorImpl>(
       std::make_shared<consensus::yac::SupermajorityCheckerImpl>());
 
@@ -233,7 +328,8 @@ void Irohad::initFactories() {
  * Initializing persistent cache
  */
 void Irohad::initPersistentCache() {
-  persistent_cache = std::make_shared<TxPresenceCacheImpl>(storage);
+  persistent_cache =
+      std::make_shared<TxPresenceCacheImpl>(storage, tx_hash_index_);
 
   log_->info("[Init] => persistent cache");
 }
@@ -335,6 +431,7 @@ void Irohad::initConsensusGate() {
                                               keypair,
                                               consensus_result_cache_,
                                               vote_delay_,
+                                              vote_rounds_to_keep_,
                                               async_call_,
                                               common_objects_factory_);
 
@@ -361,8 +458,11 @@ void Irohad::initPeerCommunicationService() {
   pcs->onProposal().subscribe(
       [this](auto) { log_->info("~~~~~~~~~| PROPOSAL ^_^ |~~~~~~~~~ "); });
 
-  pcs->on_commit().subscribe(
-      [this](auto) { log_->info("~~~~~~~~~| COMMIT =^._.^= |~~~~~~~~~ "); });
+  pcs->on_commit().subscribe([this](auto) {
+    log_->info("~~~~~~~~~| COMMIT =^._.^= |~~~~~~~~~ ");
+    logVerificationPoolStats(log_, spdlog::level::debug);
+    logSignatureCacheStats(log_, spdlog::level::debug);
+  });
 
   log_->info("[Init] => pcs");
 }
@@ -416,7 +516,7 @@ void Irohad::initTransactionCommandService() {
   auto tx_processor = std::make_shared<TransactionProcessorImpl>(
       pcs, mst_processor, status_bus_, status_factory);
   command_service = std::make_shared<::torii::CommandServiceImpl>(
-      tx_processor, storage, status_bus_, status_factory);
+      tx_processor, storage, status_bus_, status_factory, persistent_cache);
   command_service_transport =
       std::make_shared<::torii::CommandServiceTransportGrpc>(
           command_service,
@@ -517,4 +617,6 @@ Irohad::~Irohad() {
   // TODO andrei 17.09.18: IR-1710 Verify that all components' destructors are
   // called in irohad destructor
   storage->freeConnections();
+  logVerificationPoolStats(log_, spdlog::level::info);
+  logSignatureCacheStats(log_, spdlog::level::info);
 }
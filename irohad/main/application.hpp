@@ -67,6 +67,25 @@ class Irohad {
    * @param keypair - public and private keys for crypto signer
    * @param opt_mst_gossip_params - parameters for Gossip MST propagation
    * (optional). If not provided, disables mst processing support
+   * @param block_storage_type - layout of block store on disk
+   * @param wsv_snapshot_interval - number of blocks between WSV snapshots,
+   * snapshots are disabled if zero
+   * @param pipelined_validation - whether stateful validation sends all
+   * statements of a transaction to the database in a single round trip
+   * @param wsv_cache - whether stateful validation uses in-memory cache of
+   * committed permissions, signatories and asset precisions
+   * @param validation_workers - number of groups of independent transactions
+   * of a proposal validated in parallel, sequential validation if less than 2
+   * @param in_memory_wsv - whether WSV is kept in memory instead of
+   * PostgreSQL, pg_conn is not used then
+   * @param pool_options - sizes of database connection pools of queries,
+   * validation and commit, and how long a connection is waited for
+   * @param async_commit - whether committed blocks are written and indexed
+   * in background, while the next round is validated
+   * @param block_store_sync - when blocks written to block store are synced
+   * to disk
+   * @param vote_rounds_to_keep - number of block rounds before the last
+   * committed one whose consensus votes are kept
    *
    * TODO mboldyrev 03.11.2018 IR-1844 Refactor the constructor.
    */
@@ -80,7 +99,21 @@ class Irohad {
          std::chrono::milliseconds vote_delay,
          const shared_model::crypto::Keypair &keypair,
          const boost::optional<iroha::GossipPropagationStrategyParams>
-             &opt_mst_gossip_params = boost::none);
+             &opt_mst_gossip_params = boost::none,
+         iroha::ametsuchi::BlockStorageType block_storage_type =
+             iroha::ametsuchi::BlockStorageType::kFlatFile,
+         shared_model::interface::types::HeightType wsv_snapshot_interval = 0,
+         bool pipelined_validation = false,
+         bool wsv_cache = false,
+         size_t validation_workers = 0,
+         bool in_memory_wsv = false,
+         iroha::ametsuchi::PoolOptions pool_options =
+             iroha::ametsuchi::PoolOptions(),
+         bool async_commit = false,
+         iroha::ametsuchi::SyncOptions block_store_sync =
+             iroha::ametsuchi::SyncOptions(),
+         iroha::consensus::BlockRoundType vote_rounds_to_keep =
+             iroha::consensus::yac::YacVoteStorage::kDefaultRoundsToKeep);
 
   /**
    * Initialization of whole objects in system
@@ -164,6 +197,16 @@ class Irohad {
   bool is_mst_supported_;
   boost::optional<iroha::GossipPropagationStrategyParams>
       opt_mst_gossip_params_;
+  iroha::ametsuchi::BlockStorageType block_storage_type_;
+  shared_model::interface::types::HeightType wsv_snapshot_interval_;
+  bool pipelined_validation_;
+  bool wsv_cache_;
+  size_t validation_workers_;
+  bool in_memory_wsv_;
+  iroha::ametsuchi::PoolOptions pool_options_;
+  bool async_commit_;
+  iroha::ametsuchi::SyncOptions block_store_sync_;
+  iroha::consensus::BlockRoundType vote_rounds_to_keep_;
 
   // ------------------------| internal dependencies |-------------------------
 
@@ -192,6 +235,9 @@ class Irohad {
   std::shared_ptr<shared_model::interface::TransactionBatchFactory>
       transaction_batch_factory_;
 
+  // index of transaction hashes in the ledger
+  std::shared_ptr<const iroha::ametsuchi::TxHashIndex> tx_hash_index_;
+
   // persistent cache
   std::shared_ptr<iroha::ametsuchi::TxPresenceCache> persistent_cache;
 
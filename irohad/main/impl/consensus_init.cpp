@@ -89,13 +89,14 @@ namespace iroha {
           ClusterOrdering initial_order,
           const shared_model::crypto::Keypair &keypair,
           std::chrono::milliseconds delay_milliseconds,
+          BlockRoundType rounds_to_keep,
           std::shared_ptr<
               iroha::network::AsyncGrpcClient<google::protobuf::Empty>>
               async_call,
           std::shared_ptr<shared_model::interface::CommonObjectsFactory>
               common_objects_factory) {
         return Yac::create(
-            YacVoteStorage(),
+            YacVoteStorage(rounds_to_keep),
             createNetwork(std::move(async_call)),
             createCryptoProvider(keypair, std::move(common_objects_factory)),
             createTimer(delay_milliseconds),
@@ -110,6 +111,7 @@ namespace iroha {
           std::shared_ptr<consensus::ConsensusResultCache>
               consensus_result_cache,
           std::chrono::milliseconds vote_delay_milliseconds,
+          BlockRoundType vote_rounds_to_keep,
           std::shared_ptr<
               iroha::network::AsyncGrpcClient<google::protobuf::Empty>>
               async_call,
@@ -120,6 +122,7 @@ namespace iroha {
         auto yac = createYac(peer_orderer->getInitialOrdering().value(),
                              keypair,
                              vote_delay_milliseconds,
+                             vote_rounds_to_keep,
                              std::move(async_call),
                              std::move(common_objects_factory));
         consensus_network->subscribe(yac);
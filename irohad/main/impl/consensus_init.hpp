@@ -63,6 +63,7 @@ namespace iroha {
             ClusterOrdering initial_order,
             const shared_model::crypto::Keypair &keypair,
             std::chrono::milliseconds delay_milliseconds,
+            BlockRoundType rounds_to_keep,
             std::shared_ptr<
                 iroha::network::AsyncGrpcClient<google::protobuf::Empty>>
                 async_call,
@@ -77,6 +78,7 @@ namespace iroha {
             const shared_model::crypto::Keypair &keypair,
             std::shared_ptr<consensus::ConsensusResultCache> block_cache,
             std::chrono::milliseconds vote_delay_milliseconds,
+            BlockRoundType vote_rounds_to_keep,
             std::shared_ptr<
                 iroha::network::AsyncGrpcClient<google::protobuf::Empty>>
                 async_call,
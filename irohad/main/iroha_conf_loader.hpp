@@ -26,8 +26,33 @@ namespace config_members {
   const char *ProposalDelay = "proposal_delay";
   const char *VoteDelay = "vote_delay";
   const char *MstSupport = "mst_enable";
+  const char *BlockStoreType = "block_store_type";
+  const char *WsvSnapshotInterval = "wsv_snapshot_interval";
+  const char *PipelinedValidation = "pipelined_validation";
+  const char *WsvCache = "wsv_cache";
+  const char *ValidationWorkers = "validation_workers";
+  const char *WsvBackend = "wsv_backend";
+  const char *QueryPoolSize = "query_pool_size";
+  const char *ValidationPoolSize = "validation_pool_size";
+  const char *CommitPoolSize = "commit_pool_size";
+  const char *PoolCheckoutTimeout = "pool_checkout_timeout";
+  const char *AsyncCommit = "async_commit";
+  const char *BlockStoreSync = "block_store_sync";
+  const char *BlockStoreSyncInterval = "block_store_sync_interval";
+  const char *BlockStoreSyncBlocks = "block_store_sync_blocks";
+  const char *VoteRoundsToKeep = "vote_rounds_to_keep";
 }  // namespace config_members
 
+namespace config_values {
+  const char *BlockStoreFlatFile = "flat_file";
+  const char *BlockStoreBlockLog = "block_log";
+  const char *WsvBackendPostgres = "postgres";
+  const char *WsvBackendMemory = "memory";
+  const char *BlockStoreSyncNone = "none";
+  const char *BlockStoreSyncBlock = "block";
+  const char *BlockStoreSyncGroup = "group";
+}  // namespace config_values
+
 /**
  * parse and assert trusted peers json in `iroha.conf`
  * @param conf_path is a path to iroha's config
@@ -63,9 +88,27 @@ inline rapidjson::Document parse_iroha_config(const std::string &conf_path) {
   ac::assert_fatal(doc[mbr::InternalPort].IsUint(),
                    ac::type_error(mbr::InternalPort, kUintType));
 
-  ac::assert_fatal(doc.HasMember(mbr::PgOpt), ac::no_member_error(mbr::PgOpt));
-  ac::assert_fatal(doc[mbr::PgOpt].IsString(),
-                   ac::type_error(mbr::PgOpt, kStrType));
+  bool in_memory_wsv = false;
+  if (doc.HasMember(mbr::WsvBackend)) {
+    ac::assert_fatal(doc[mbr::WsvBackend].IsString(),
+                     ac::type_error(mbr::WsvBackend, kStrType));
+    const std::string backend = doc[mbr::WsvBackend].GetString();
+    const std::string kWsvBackends =
+        std::string(config_values::WsvBackendPostgres) + " or "
+        + config_values::WsvBackendMemory;
+    ac::assert_fatal(backend == config_values::WsvBackendPostgres
+                         or backend == config_values::WsvBackendMemory,
+                     ac::type_error(mbr::WsvBackend, kWsvBackends));
+    in_memory_wsv = backend == config_values::WsvBackendMemory;
+  }
+
+  // database is not used if WSV is kept in memory
+  if (not in_memory_wsv or doc.HasMember(mbr::PgOpt)) {
+    ac::assert_fatal(doc.HasMember(mbr::PgOpt),
+                     ac::no_member_error(mbr::PgOpt));
+    ac::assert_fatal(doc[mbr::PgOpt].IsString(),
+                     ac::type_error(mbr::PgOpt, kStrType));
+  }
 
   ac::assert_fatal(doc.HasMember(mbr::MaxProposalSize),
                    ac::no_member_error(mbr::MaxProposalSize));
@@ -86,6 +129,70 @@ inline rapidjson::Document parse_iroha_config(const std::string &conf_path) {
                    ac::no_member_error(mbr::MstSupport));
   ac::assert_fatal(doc[mbr::MstSupport].IsBool(),
                    ac::type_error(mbr::MstSupport, kBoolType));
+
+  if (doc.HasMember(mbr::BlockStoreType)) {
+    ac::assert_fatal(doc[mbr::BlockStoreType].IsString(),
+                     ac::type_error(mbr::BlockStoreType, kStrType));
+    const std::string type = doc[mbr::BlockStoreType].GetString();
+    const std::string kBlockStoreTypes =
+        std::string(config_values::BlockStoreFlatFile) + " or "
+        + config_values::BlockStoreBlockLog;
+    ac::assert_fatal(type == config_values::BlockStoreFlatFile
+                         or type == config_values::BlockStoreBlockLog,
+                     ac::type_error(mbr::BlockStoreType, kBlockStoreTypes));
+  }
+
+  if (doc.HasMember(mbr::WsvSnapshotInterval)) {
+    ac::assert_fatal(doc[mbr::WsvSnapshotInterval].IsUint(),
+                     ac::type_error(mbr::WsvSnapshotInterval, kUintType));
+  }
+
+  if (doc.HasMember(mbr::PipelinedValidation)) {
+    ac::assert_fatal(doc[mbr::PipelinedValidation].IsBool(),
+                     ac::type_error(mbr::PipelinedValidation, kBoolType));
+  }
+
+  if (doc.HasMember(mbr::WsvCache)) {
+    ac::assert_fatal(doc[mbr::WsvCache].IsBool(),
+                     ac::type_error(mbr::WsvCache, kBoolType));
+  }
+
+  if (doc.HasMember(mbr::AsyncCommit)) {
+    ac::assert_fatal(doc[mbr::AsyncCommit].IsBool(),
+                     ac::type_error(mbr::AsyncCommit, kBoolType));
+  }
+
+  if (doc.HasMember(mbr::ValidationWorkers)) {
+    ac::assert_fatal(doc[mbr::ValidationWorkers].IsUint(),
+                     ac::type_error(mbr::ValidationWorkers, kUintType));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreSync)) {
+    ac::assert_fatal(doc[mbr::BlockStoreSync].IsString(),
+                     ac::type_error(mbr::BlockStoreSync, kStrType));
+    const std::string mode = doc[mbr::BlockStoreSync].GetString();
+    const std::string kSyncModes =
+        std::string(config_values::BlockStoreSyncNone) + ", "
+        + config_values::BlockStoreSyncBlock + " or "
+        + config_values::BlockStoreSyncGroup;
+    ac::assert_fatal(mode == config_values::BlockStoreSyncNone
+                         or mode == config_values::BlockStoreSyncBlock
+                         or mode == config_values::BlockStoreSyncGroup,
+                     ac::type_error(mbr::BlockStoreSync, kSyncModes));
+  }
+
+  for (const auto member : {mbr::QueryPoolSize,
+                            mbr::ValidationPoolSize,
+                            mbr::CommitPoolSize,
+                            mbr::PoolCheckoutTimeout,
+                            mbr::BlockStoreSyncInterval,
+                            mbr::BlockStoreSyncBlocks,
+                            mbr::VoteRoundsToKeep}) {
+    if (doc.HasMember(member)) {
+      ac::assert_fatal(doc[member].IsUint(),
+                       ac::type_error(member, kUintType));
+    }
+  }
   return doc;
 }
 
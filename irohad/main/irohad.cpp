@@ -118,6 +118,66 @@ int main(int argc, char *argv[]) {
   auto config = parse_iroha_config(FLAGS_config);
   log->info("config initialized");
 
+  auto block_storage_type = iroha::ametsuchi::BlockStorageType::kFlatFile;
+  if (config.HasMember(mbr::BlockStoreType)
+      and config[mbr::BlockStoreType].GetString()
+          == std::string(config_values::BlockStoreBlockLog)) {
+    block_storage_type = iroha::ametsuchi::BlockStorageType::kBlockLog;
+  }
+  const auto wsv_snapshot_interval = config.HasMember(mbr::WsvSnapshotInterval)
+      ? config[mbr::WsvSnapshotInterval].GetUint()
+      : 0u;
+  const auto pipelined_validation = config.HasMember(mbr::PipelinedValidation)
+      and config[mbr::PipelinedValidation].GetBool();
+  const auto wsv_cache =
+      config.HasMember(mbr::WsvCache) and config[mbr::WsvCache].GetBool();
+  const auto async_commit =
+      config.HasMember(mbr::AsyncCommit) and config[mbr::AsyncCommit].GetBool();
+  const auto validation_workers = config.HasMember(mbr::ValidationWorkers)
+      ? config[mbr::ValidationWorkers].GetUint()
+      : 0u;
+  const auto in_memory_wsv = config.HasMember(mbr::WsvBackend)
+      and config[mbr::WsvBackend].GetString()
+          == std::string(config_values::WsvBackendMemory);
+  const std::string pg_opt =
+      config.HasMember(mbr::PgOpt) ? config[mbr::PgOpt].GetString() : "";
+  iroha::ametsuchi::PoolOptions pool_options;
+  if (config.HasMember(mbr::QueryPoolSize)) {
+    pool_options.query_pool_size = config[mbr::QueryPoolSize].GetUint();
+  }
+  if (config.HasMember(mbr::ValidationPoolSize)) {
+    pool_options.validation_pool_size =
+        config[mbr::ValidationPoolSize].GetUint();
+  }
+  if (config.HasMember(mbr::CommitPoolSize)) {
+    pool_options.commit_pool_size = config[mbr::CommitPoolSize].GetUint();
+  }
+  if (config.HasMember(mbr::PoolCheckoutTimeout)) {
+    pool_options.checkout_timeout =
+        std::chrono::milliseconds(config[mbr::PoolCheckoutTimeout].GetUint());
+  }
+  iroha::ametsuchi::SyncOptions block_store_sync;
+  if (config.HasMember(mbr::BlockStoreSync)) {
+    const std::string mode = config[mbr::BlockStoreSync].GetString();
+    if (mode == config_values::BlockStoreSyncBlock) {
+      block_store_sync.mode = iroha::ametsuchi::SyncMode::kBlock;
+    } else if (mode == config_values::BlockStoreSyncGroup) {
+      block_store_sync.mode = iroha::ametsuchi::SyncMode::kGroup;
+    }
+  }
+  if (config.HasMember(mbr::BlockStoreSyncInterval)) {
+    block_store_sync.group_interval = std::chrono::milliseconds(
+        config[mbr::BlockStoreSyncInterval].GetUint());
+  }
+  if (config.HasMember(mbr::BlockStoreSyncBlocks)) {
+    block_store_sync.group_blocks = config[mbr::BlockStoreSyncBlocks].GetUint();
+  }
+  auto vote_rounds_to_keep =
+      iroha::consensus::yac::YacVoteStorage::kDefaultRoundsToKeep;
+  if (config.HasMember(mbr::VoteRoundsToKeep)) {
+    vote_rounds_to_keep = config[mbr::VoteRoundsToKeep].GetUint();
+  }
+
   // Reading public and private key files
   iroha::KeysManagerImpl keysManager(FLAGS_keypair_name);
   auto keypair = keysManager.loadKeys();
@@ -130,7 +190,7 @@ int main(int argc, char *argv[]) {
 
   // Configuring iroha daemon
   Irohad irohad(config[mbr::BlockStorePath].GetString(),
-                config[mbr::PgOpt].GetString(),
+                pg_opt,
                 kListenIp,  // TODO(mboldyrev) 17/10/2018: add a parameter in
                             // config file and/or command-line arguments?
                 config[mbr::ToriiPort].GetUint(),
@@ -140,7 +200,17 @@ int main(int argc, char *argv[]) {
                 std::chrono::milliseconds(config[mbr::VoteDelay].GetUint()),
                 *keypair,
                 boost::make_optional(config[mbr::MstSupport].GetBool(),
-                                     iroha::GossipPropagationStrategyParams{}));
+                                     iroha::GossipPropagationStrategyParams{}),
+                block_storage_type,
+                wsv_snapshot_interval,
+                pipelined_validation,
+                wsv_cache,
+                validation_workers,
+                in_memory_wsv,
+                pool_options,
+                async_commit,
+                block_store_sync,
+                vote_rounds_to_keep);
 
   // Check if iroha daemon storage was successfully initialized
   if (not irohad.storage) {
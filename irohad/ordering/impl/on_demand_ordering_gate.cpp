@@ -6,8 +6,11 @@
 #include "ordering/impl/on_demand_ordering_gate.hpp"
 
 #include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/adaptor/indexed.hpp>
+#include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/empty.hpp>
 #include "ametsuchi/tx_presence_cache.hpp"
+#include "ametsuchi/tx_presence_cache_utils.hpp"
 #include "common/visitor.hpp"
 #include "ordering/impl/on_demand_common.hpp"
 
@@ -107,25 +110,26 @@ OnDemandOrderingGate::processProposalRequest(
 boost::optional<std::shared_ptr<shared_model::interface::Proposal>>
 OnDemandOrderingGate::removeReplays(
     shared_model::interface::Proposal &&proposal) const {
-  auto tx_is_not_processed = [this](const auto &tx) {
-    auto tx_result = tx_cache_->check(tx.hash());
-    if (not tx_result) {
-      // TODO andrei 30.11.18 IR-51 Handle database error
-      return false;
-    }
-    return iroha::visit_in_place(
-        *tx_result,
-        [](const ametsuchi::tx_cache_status_responses::Missing &) {
-          return true;
-        },
-        [](const auto &status) {
-          // TODO nickaleks 21.11.18: IR-1887 log replayed transactions
-          // when log is added
-          return false;
-        });
-  };
-  auto unprocessed_txs =
-      boost::adaptors::filter(proposal.transactions(), tx_is_not_processed);
+  ametsuchi::TxPresenceCache::HashCollectionType hashes;
+  for (const auto &tx : proposal.transactions()) {
+    hashes.push_back(tx.hash());
+  }
+  auto tx_results = tx_cache_->check(hashes);
+  if (not tx_results) {
+    // TODO andrei 30.11.18 IR-51 Handle database error
+    return boost::none;
+  }
+  // TODO nickaleks 21.11.18: IR-1887 log replayed transactions
+  // when log is added
+  auto unprocessed_txs = proposal.transactions() | boost::adaptors::indexed(0)
+      | boost::adaptors::filtered([&tx_results](const auto &tx) {
+          return not ametsuchi::isAlreadyProcessed(
+              tx_results->at(tx.index()));
+        })
+      | boost::adaptors::transformed(
+            [](const auto &tx) -> const shared_model::interface::Transaction & {
+              return tx.value();
+            });
 
   auto result = proposal_factory_->unsafeCreateProposal(
       proposal.height(), proposal.createdTime(), unprocessed_txs);
@@ -105,7 +105,9 @@ namespace iroha {
       std::shared_ptr<iroha::validation::VerifiedProposalAndErrors>
           validated_proposal_and_errors =
               validator_->validate(proposal, *storage);
-      ametsuchi_factory_->prepareBlock(std::move(storage));
+      if (validated_proposal_and_errors->state_complete) {
+        ametsuchi_factory_->prepareBlock(std::move(storage));
+      }
 
       notifier_.get_subscriber().on_next(
           VerifiedProposalCreatorEvent{validated_proposal_and_errors, round});
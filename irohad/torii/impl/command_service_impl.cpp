@@ -19,12 +19,14 @@ namespace torii {
       std::shared_ptr<iroha::torii::TransactionProcessor> tx_processor,
       std::shared_ptr<iroha::ametsuchi::Storage> storage,
       std::shared_ptr<iroha::torii::StatusBus> status_bus,
-      std::shared_ptr<shared_model::interface::TxStatusFactory> status_factory)
+      std::shared_ptr<shared_model::interface::TxStatusFactory> status_factory,
+      std::shared_ptr<iroha::ametsuchi::TxPresenceCache> tx_presence_cache)
       : tx_processor_(std::move(tx_processor)),
         storage_(std::move(storage)),
         status_bus_(std::move(status_bus)),
         cache_(std::make_shared<CacheType>()),
         status_factory_(std::move(status_factory)),
+        tx_presence_cache_(std::move(tx_presence_cache)),
         log_(logger::log("CommandServiceImpl")) {
     // Notifier for all clients
     status_bus_->statuses().subscribe([this](auto response) {
@@ -54,14 +56,18 @@ namespace torii {
       return cached.value();
     }
 
-    auto block_query = storage_->getBlockQuery();
-    if (not block_query) {
-      // TODO andrei 30.11.18 IR-51 Handle database error
-      log_->warn("Could not create block query. Tx: {}", request.hex());
-      return status_factory_->makeNotReceived(request);
+    boost::optional<iroha::ametsuchi::TxCacheStatusType> status;
+    if (tx_presence_cache_) {
+      status = tx_presence_cache_->check(request);
+    } else {
+      auto block_query = storage_->getBlockQuery();
+      if (not block_query) {
+        // TODO andrei 30.11.18 IR-51 Handle database error
+        log_->warn("Could not create block query. Tx: {}", request.hex());
+        return status_factory_->makeNotReceived(request);
+      }
+      status = block_query->checkTxPresence(request);
     }
-
-    auto status = block_query->checkTxPresence(request);
     if (not status) {
       // TODO andrei 30.11.18 IR-51 Handle database error
       log_->warn("Check tx presence database error. Tx: {}", request.hex());
@@ -9,6 +9,7 @@
 #include "torii/command_service.hpp"
 
 #include "ametsuchi/storage.hpp"
+#include "ametsuchi/tx_presence_cache.hpp"
 #include "cache/cache.hpp"
 #include "cryptography/hash.hpp"
 #include "interfaces/iroha_internal/tx_status_factory.hpp"
@@ -27,13 +28,18 @@ namespace torii {
      * @param tx_processor - processor of received transactions
      * @param storage - to query transactions outside the cache
      * @param status_bus is a common notifier for tx statuses
+     * @param status_factory - factory of tx statuses
+     * @param tx_presence_cache - cache to check transactions outside the
+     * cache with, storage is queried directly if not set
      */
     CommandServiceImpl(
         std::shared_ptr<iroha::torii::TransactionProcessor> tx_processor,
         std::shared_ptr<iroha::ametsuchi::Storage> storage,
         std::shared_ptr<iroha::torii::StatusBus> status_bus,
         std::shared_ptr<shared_model::interface::TxStatusFactory>
-            status_factory);
+            status_factory,
+        std::shared_ptr<iroha::ametsuchi::TxPresenceCache> tx_presence_cache =
+            nullptr);
 
     /**
      * Disable copying in any way to prevent potential issues with common
@@ -90,6 +96,7 @@ namespace torii {
     std::shared_ptr<iroha::torii::StatusBus> status_bus_;
     std::shared_ptr<CacheType> cache_;
     std::shared_ptr<shared_model::interface::TxStatusFactory> status_factory_;
+    std::shared_ptr<iroha::ametsuchi::TxPresenceCache> tx_presence_cache_;
 
     logger::Logger log_;
   };
@@ -0,0 +1,203 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "validation/impl/conflict_groups.hpp"
+
+#include <numeric>
+#include <unordered_map>
+
+#include "common/visitor.hpp"
+#include "cryptography/public_key.hpp"
+#include "interfaces/commands/add_asset_quantity.hpp"
+#include "interfaces/commands/add_peer.hpp"
+#include "interfaces/commands/add_signatory.hpp"
+#include "interfaces/commands/append_role.hpp"
+#include "interfaces/commands/command.hpp"
+#include "interfaces/commands/create_account.hpp"
+#include "interfaces/commands/create_asset.hpp"
+#include "interfaces/commands/create_domain.hpp"
+#include "interfaces/commands/create_role.hpp"
+#include "interfaces/commands/detach_role.hpp"
+#include "interfaces/commands/grant_permission.hpp"
+#include "interfaces/commands/remove_signatory.hpp"
+#include "interfaces/commands/revoke_permission.hpp"
+#include "interfaces/commands/set_account_detail.hpp"
+#include "interfaces/commands/set_quorum.hpp"
+#include "interfaces/commands/subtract_asset_quantity.hpp"
+#include "interfaces/commands/transfer_asset.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace {
+  std::string account(const std::string &id) {
+    return "account:" + id;
+  }
+
+  std::string asset(const std::string &id) {
+    return "asset:" + id;
+  }
+
+  std::string domain(const std::string &id) {
+    return "domain:" + id;
+  }
+
+  std::string role(const std::string &id) {
+    return "role:" + id;
+  }
+
+  /// rows of signatories are shared by all accounts with the same key
+  std::string signatory(
+      const shared_model::interface::types::PubkeyType &pubkey) {
+    return "signatory:" + pubkey.hex();
+  }
+
+  /// All peers conflict, since addresses and keys of peers are unique
+  const std::string kPeers = "peers";
+
+  /**
+   * Disjoint set forest over element indices
+   */
+  class DisjointSets {
+   public:
+    explicit DisjointSets(size_t size) : parents_(size) {
+      std::iota(parents_.begin(), parents_.end(), 0);
+    }
+
+    size_t find(size_t i) {
+      while (parents_[i] != i) {
+        parents_[i] = parents_[parents_[i]];
+        i = parents_[i];
+      }
+      return i;
+    }
+
+    void unite(size_t a, size_t b) {
+      a = find(a);
+      b = find(b);
+      // the smaller index is kept as root, so groups are ordered
+      if (a < b) {
+        parents_[b] = a;
+      } else {
+        parents_[a] = b;
+      }
+    }
+
+   private:
+    std::vector<size_t> parents_;
+  };
+}  // namespace
+
+namespace iroha {
+  namespace validation {
+
+    void ReadWriteSet::add(const shared_model::interface::Transaction &tx) {
+      using namespace shared_model::interface;
+      // signatories and permissions of creator are read by every command,
+      // and account is the smallest entity with balances and details
+      writes.insert(account(tx.creatorAccountId()));
+      for (const auto &command : tx.commands()) {
+        visit_in_place(
+            command.get(),
+            [&](const AddAssetQuantity &c) {
+              reads.insert(asset(c.assetId()));
+            },
+            [&](const SubtractAssetQuantity &c) {
+              reads.insert(asset(c.assetId()));
+            },
+            [&](const TransferAsset &c) {
+              writes.insert(account(c.srcAccountId()));
+              writes.insert(account(c.destAccountId()));
+              reads.insert(asset(c.assetId()));
+            },
+            [&](const AddPeer &c) {
+              writes.insert(kPeers);
+              writes.insert(signatory(c.peer().pubkey()));
+            },
+            [&](const AddSignatory &c) {
+              writes.insert(account(c.accountId()));
+              writes.insert(signatory(c.pubkey()));
+            },
+            [&](const RemoveSignatory &c) {
+              writes.insert(account(c.accountId()));
+              writes.insert(signatory(c.pubkey()));
+            },
+            [&](const SetQuorum &c) { writes.insert(account(c.accountId())); },
+            [&](const AppendRole &c) {
+              writes.insert(account(c.accountId()));
+              reads.insert(role(c.roleName()));
+            },
+            [&](const DetachRole &c) {
+              writes.insert(account(c.accountId()));
+              reads.insert(role(c.roleName()));
+            },
+            [&](const CreateAccount &c) {
+              writes.insert(account(c.accountName() + "@" + c.domainId()));
+              writes.insert(signatory(c.pubkey()));
+              reads.insert(domain(c.domainId()));
+            },
+            [&](const CreateAsset &c) {
+              writes.insert(asset(c.assetName() + "#" + c.domainId()));
+              reads.insert(domain(c.domainId()));
+            },
+            [&](const CreateDomain &c) {
+              writes.insert(domain(c.domainId()));
+              reads.insert(role(c.userDefaultRole()));
+            },
+            [&](const CreateRole &c) { writes.insert(role(c.roleName())); },
+            [&](const GrantPermission &c) {
+              writes.insert(account(c.accountId()));
+            },
+            [&](const RevokePermission &c) {
+              writes.insert(account(c.accountId()));
+            },
+            [&](const SetAccountDetail &c) {
+              writes.insert(account(c.accountId()));
+            });
+      }
+    }
+
+    std::vector<std::vector<size_t>> conflictGroups(
+        const std::vector<ReadWriteSet> &sets) {
+      struct Accessors {
+        std::vector<size_t> indices;
+        bool written = false;
+      };
+      std::unordered_map<std::string, Accessors> accessors;
+      for (size_t i = 0; i < sets.size(); ++i) {
+        for (const auto &entity : sets[i].reads) {
+          accessors[entity].indices.push_back(i);
+        }
+        for (const auto &entity : sets[i].writes) {
+          auto &entity_accessors = accessors[entity];
+          entity_accessors.indices.push_back(i);
+          entity_accessors.written = true;
+        }
+      }
+
+      // elements which only read an entity do not conflict
+      DisjointSets groups_forest(sets.size());
+      for (const auto &entity_accessors : accessors) {
+        if (not entity_accessors.second.written) {
+          continue;
+        }
+        const auto &indices = entity_accessors.second.indices;
+        for (size_t i = 1; i < indices.size(); ++i) {
+          groups_forest.unite(indices.front(), indices[i]);
+        }
+      }
+
+      std::vector<std::vector<size_t>> groups;
+      std::unordered_map<size_t, size_t> group_of_root;
+      for (size_t i = 0; i < sets.size(); ++i) {
+        auto it = group_of_root.emplace(groups_forest.find(i), groups.size());
+        if (it.second) {
+          groups.emplace_back();
+        }
+        groups[it.first->second].push_back(i);
+      }
+      return groups;
+    }
+
+  }  // namespace validation
+}  // namespace iroha
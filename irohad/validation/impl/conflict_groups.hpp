@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_CONFLICT_GROUPS_HPP
+#define IROHA_CONFLICT_GROUPS_HPP
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace shared_model {
+  namespace interface {
+    class Transaction;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace validation {
+
+    /// Ids of WSV entities, prefixed with their kind
+    using EntitySet = std::unordered_set<std::string>;
+
+    /**
+     * Entities which stateful validation of transactions reads or writes.
+     * Assets, domains and roles cannot be changed after creation, so they
+     * are read by all commands except the creating one.
+     */
+    struct ReadWriteSet {
+      EntitySet reads;
+      EntitySet writes;
+
+      /**
+       * Add entities accessed by transaction: creator and other accounts,
+       * assets, domains, roles and peers
+       */
+      void add(const shared_model::interface::Transaction &tx);
+    };
+
+    /**
+     * Split elements into groups, so that an entity written by an element
+     * is not accessed by elements of other groups
+     * @param sets - entities accessed by each element
+     * @return indices of elements of each group in ascending order, groups
+     * are ordered by their first element
+     */
+    std::vector<std::vector<size_t>> conflictGroups(
+        const std::vector<ReadWriteSet> &sets);
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_CONFLICT_GROUPS_HPP
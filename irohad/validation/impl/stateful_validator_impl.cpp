@@ -5,6 +5,8 @@
 
 #include "validation/impl/stateful_validator_impl.hpp"
 
+#include <algorithm>
+#include <future>
 #include <string>
 
 #include <boost/algorithm/cxx11/all_of.hpp>
@@ -14,6 +16,7 @@
 #include <boost/range/adaptor/transformed.hpp>
 #include "common/result.hpp"
 #include "interfaces/iroha_internal/batch_meta.hpp"
+#include "validation/impl/conflict_groups.hpp"
 #include "validation/utils.hpp"
 
 namespace iroha {
@@ -40,51 +43,101 @@ namespace iroha {
     };
 
     /**
-     * Validate all transactions supplied; includes special rules, such as batch
-     * validation etc
-     * @param txs to be validated
+     * Validate transactions of a batch; includes special rules for atomic
+     * batches
+     * @param batch to be validated
      * @param temporary_wsv to apply transactions on
      * @param transactions_errors_log to write errors to
-     * @param log to write errors to console
-     * @param batch_parser to parse batches from transaction range
-     * @return range of transactions, which passed stateful validation
+     * @return validation result of each transaction of the batch
      */
-    static auto validateTransactions(
-        const shared_model::interface::types::TransactionsCollectionType &txs,
+    static std::vector<bool> validateBatch(
+        const shared_model::interface::types::TransactionsCollectionType
+            &batch,
         ametsuchi::TemporaryWsv &temporary_wsv,
-        validation::TransactionsErrors &transactions_errors_log,
-        const logger::Logger &log,
-        const shared_model::interface::TransactionBatchParser &batch_parser) {
-      std::vector<bool> validation_results;
-      validation_results.reserve(boost::size(txs));
-
-      for (auto batch : batch_parser.parseBatches(txs)) {
-        auto validation = [&](auto &tx) {
-          return checkTransactions(temporary_wsv, transactions_errors_log, tx);
-        };
-        if (batch.front().batchMeta()
-            and batch.front().batchMeta()->get()->type()
-                == shared_model::interface::types::BatchType::ATOMIC) {
-          // check all batch's transactions for validness
-          auto savepoint = temporary_wsv.createSavepoint(
-              "batch_" + batch.front().hash().hex());
-          bool validation_result = false;
-
-          if (boost::algorithm::all_of(batch, validation)) {
-            // batch is successful; release savepoint
-            validation_result = true;
-            savepoint->release();
-          }
-
-          validation_results.insert(
-              validation_results.end(), boost::size(batch), validation_result);
-        } else {
-          for (const auto &tx : batch) {
-            validation_results.push_back(validation(tx));
-          }
+        validation::TransactionsErrors &transactions_errors_log) {
+      auto validation = [&](auto &tx) {
+        return checkTransactions(temporary_wsv, transactions_errors_log, tx);
+      };
+      if (batch.front().batchMeta()
+          and batch.front().batchMeta()->get()->type()
+              == shared_model::interface::types::BatchType::ATOMIC) {
+        // check all batch's transactions for validness
+        auto savepoint = temporary_wsv.createSavepoint(
+            "batch_" + batch.front().hash().hex());
+        bool validation_result = false;
+
+        if (boost::algorithm::all_of(batch, validation)) {
+          // batch is successful; release savepoint
+          validation_result = true;
+          savepoint->release();
         }
+
+        return std::vector<bool>(boost::size(batch), validation_result);
+      }
+
+      std::vector<bool> validation_results;
+      for (const auto &tx : batch) {
+        validation_results.push_back(validation(tx));
+      }
+      return validation_results;
+    }
+
+    /**
+     * Validate all batches one after another
+     * @param batches to be validated
+     * @param temporary_wsv to apply transactions on
+     * @param transactions_errors_log to write errors to
+     * @return validation result of each transaction
+     */
+    static std::vector<bool> validateBatches(
+        const std::vector<
+            shared_model::interface::types::TransactionsCollectionType>
+            &batches,
+        ametsuchi::TemporaryWsv &temporary_wsv,
+        validation::TransactionsErrors &transactions_errors_log) {
+      std::vector<bool> validation_results;
+      for (const auto &batch : batches) {
+        auto batch_results =
+            validateBatch(batch, temporary_wsv, transactions_errors_log);
+        validation_results.insert(validation_results.end(),
+                                  batch_results.begin(),
+                                  batch_results.end());
+      }
+      return validation_results;
+    }
+
+    /**
+     * Validate batches of each group one after another on a single
+     * temporary wsv
+     * @param batches to be validated
+     * @param groups - indices of batches in ascending order, which do not
+     * access entities of other groups
+     * @param temporary_wsv to apply transactions on
+     * @param transactions_errors_log to write errors to
+     * @return validation results of transactions of each batch by its index
+     */
+    static std::vector<std::pair<size_t, std::vector<bool>>> validateGroups(
+        const std::vector<
+            shared_model::interface::types::TransactionsCollectionType>
+            &batches,
+        const std::vector<size_t> &groups,
+        ametsuchi::TemporaryWsv &temporary_wsv,
+        validation::TransactionsErrors &transactions_errors_log) {
+      std::vector<std::pair<size_t, std::vector<bool>>> validation_results;
+      for (auto i : groups) {
+        validation_results.emplace_back(
+            i,
+            validateBatch(batches[i], temporary_wsv, transactions_errors_log));
       }
+      return validation_results;
+    }
 
+    /**
+     * @return range of transactions, which passed stateful validation
+     */
+    static auto filterValid(
+        const shared_model::interface::types::TransactionsCollectionType &txs,
+        std::vector<bool> validation_results) {
       return txs | boost::adaptors::indexed()
           | boost::adaptors::filtered(
                  [validation_results =
@@ -98,9 +151,13 @@ namespace iroha {
     StatefulValidatorImpl::StatefulValidatorImpl(
         std::unique_ptr<shared_model::interface::UnsafeProposalFactory> factory,
         std::shared_ptr<shared_model::interface::TransactionBatchParser>
-            batch_parser)
+            batch_parser,
+        std::shared_ptr<ametsuchi::TemporaryFactory> temporary_factory,
+        size_t workers)
         : factory_(std::move(factory)),
           batch_parser_(std::move(batch_parser)),
+          temporary_factory_(std::move(temporary_factory)),
+          workers_(workers),
           log_(logger::log("SFV")) {}
 
     std::unique_ptr<validation::VerifiedProposalAndErrors>
@@ -111,12 +168,15 @@ namespace iroha {
                  proposal.transactions().size());
 
       auto validation_result = std::make_unique<VerifiedProposalAndErrors>();
-      auto valid_txs =
-          validateTransactions(proposal.transactions(),
-                               temporaryWsv,
-                               validation_result->rejected_transactions,
-                               log_,
-                               *batch_parser_);
+      const auto batches = batch_parser_->parseBatches(proposal.transactions());
+      auto validation_results =
+          validateInParallel(batches, temporaryWsv, *validation_result);
+      if (not validation_results) {
+        validation_results = validateBatches(
+            batches, temporaryWsv, validation_result->rejected_transactions);
+      }
+      auto valid_txs = filterValid(proposal.transactions(),
+                                   std::move(*validation_results));
 
       // Since proposal came from ordering gate it was already validated.
       // All transactions has been validated as well
@@ -128,5 +188,106 @@ namespace iroha {
                  validation_result->verified_proposal->transactions().size());
       return validation_result;
     }
+
+    boost::optional<std::vector<bool>>
+    StatefulValidatorImpl::validateInParallel(
+        const std::vector<
+            shared_model::interface::types::TransactionsCollectionType>
+            &batches,
+        ametsuchi::TemporaryWsv &temporary_wsv,
+        VerifiedProposalAndErrors &validation_result) {
+      if (not temporary_factory_ or workers_ < 2) {
+        return boost::none;
+      }
+
+      std::vector<ReadWriteSet> sets(batches.size());
+      for (size_t i = 0; i < batches.size(); ++i) {
+        for (const auto &tx : batches[i]) {
+          sets[i].add(tx);
+        }
+      }
+      auto groups = conflictGroups(sets);
+      if (groups.size() < 2) {
+        return boost::none;
+      }
+
+      // groups are assigned to the least loaded worker, largest first
+      std::sort(groups.begin(), groups.end(), [](auto &a, auto &b) {
+        return a.size() > b.size();
+      });
+      const auto workers = std::min(workers_, groups.size());
+      std::vector<std::vector<size_t>> worker_batches(workers);
+      std::vector<size_t> worker_load(workers, 0);
+      for (const auto &group : groups) {
+        auto worker = std::distance(
+            worker_load.begin(),
+            std::min_element(worker_load.begin(), worker_load.end()));
+        for (auto i : group) {
+          worker_batches[worker].push_back(i);
+          worker_load[worker] += boost::size(batches[i]);
+        }
+      }
+      for (auto &indices : worker_batches) {
+        std::sort(indices.begin(), indices.end());
+      }
+
+      // the first worker uses the given temporary wsv, the rest use own ones
+      std::vector<std::unique_ptr<ametsuchi::TemporaryWsv>> worker_wsvs;
+      for (size_t i = 1; i < workers; ++i) {
+        auto wsv = temporary_factory_->createTemporaryWsv();
+        if (auto e = boost::get<expected::Error<std::string>>(&wsv)) {
+          log_->warn("could not create temporary storage: {}, validating "
+                     "transactions sequentially",
+                     e->error);
+          return boost::none;
+        }
+        worker_wsvs.push_back(std::move(
+            boost::get<
+                expected::Value<std::unique_ptr<ametsuchi::TemporaryWsv>>>(
+                wsv)
+                .value));
+      }
+      log_->info("validating {} independent groups of batches in {} workers",
+                 groups.size(),
+                 workers);
+
+      std::vector<TransactionsErrors> worker_errors(workers);
+      std::vector<
+          std::future<std::vector<std::pair<size_t, std::vector<bool>>>>>
+          futures;
+      for (size_t i = 1; i < workers; ++i) {
+        futures.push_back(std::async(std::launch::async, [&, i] {
+          return validateGroups(batches,
+                                worker_batches[i],
+                                *worker_wsvs[i - 1],
+                                worker_errors[i]);
+        }));
+      }
+      auto worker_results = validateGroups(
+          batches, worker_batches[0], temporary_wsv, worker_errors[0]);
+      for (auto &future : futures) {
+        auto results = future.get();
+        std::move(results.begin(),
+                  results.end(),
+                  std::back_inserter(worker_results));
+      }
+
+      std::vector<std::vector<bool>> batch_results(batches.size());
+      for (auto &result : worker_results) {
+        batch_results[result.first] = std::move(result.second);
+      }
+      std::vector<bool> validation_results;
+      for (const auto &results : batch_results) {
+        validation_results.insert(
+            validation_results.end(), results.begin(), results.end());
+      }
+      for (auto &errors : worker_errors) {
+        validation_result.rejected_transactions.insert(errors.begin(),
+                                                       errors.end());
+      }
+      // transactions of other workers are not applied to the given wsv
+      validation_result.state_complete = false;
+      return validation_results;
+    }
   }  // namespace validation
 }  // namespace iroha
@@ -8,6 +8,8 @@
 
 #include "validation/stateful_validator.hpp"
 
+#include <boost/optional.hpp>
+#include "ametsuchi/temporary_factory.hpp"
 #include "interfaces/iroha_internal/transaction_batch_parser.hpp"
 #include "interfaces/iroha_internal/unsafe_proposal_factory.hpp"
 #include "logger/logger.hpp"
@@ -20,20 +22,51 @@ namespace iroha {
      */
     class StatefulValidatorImpl : public StatefulValidator {
      public:
+      /**
+       * @param factory - factory of verified proposals
+       * @param batch_parser - parser of batches from proposal transactions
+       * @param temporary_factory - factory of temporary WSVs for parallel
+       * validation, sequential validation is used if null
+       * @param workers - maximum number of groups of independent batches
+       * validated in parallel
+       */
       explicit StatefulValidatorImpl(
           std::unique_ptr<shared_model::interface::UnsafeProposalFactory>
               factory,
           std::shared_ptr<shared_model::interface::TransactionBatchParser>
-              batch_parser);
+              batch_parser,
+          std::shared_ptr<ametsuchi::TemporaryFactory> temporary_factory =
+              nullptr,
+          size_t workers = 0);
 
       std::unique_ptr<validation::VerifiedProposalAndErrors> validate(
           const shared_model::interface::Proposal &proposal,
           ametsuchi::TemporaryWsv &temporaryWsv) override;
 
      private:
+      /**
+       * Split batches into groups, which do not access the same entities,
+       * and validate groups in parallel, each on its own temporary WSV. The
+       * result is the same as of sequential validation, since validity of a
+       * transaction depends only on preceding transactions of its group
+       * @param batches to be validated
+       * @param temporary_wsv to validate the first group of batches on
+       * @param validation_result to write errors to
+       * @return validation result of each transaction, none if batches cannot
+       * be validated in parallel
+       */
+      boost::optional<std::vector<bool>> validateInParallel(
+          const std::vector<
+              shared_model::interface::types::TransactionsCollectionType>
+              &batches,
+          ametsuchi::TemporaryWsv &temporary_wsv,
+          VerifiedProposalAndErrors &validation_result);
+
       std::unique_ptr<shared_model::interface::UnsafeProposalFactory> factory_;
       std::shared_ptr<shared_model::interface::TransactionBatchParser>
           batch_parser_;
+      std::shared_ptr<ametsuchi::TemporaryFactory> temporary_factory_;
+      size_t workers_;
       logger::Logger log_;
     };
 
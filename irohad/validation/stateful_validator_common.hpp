@@ -59,6 +59,10 @@ namespace iroha {
     struct VerifiedProposalAndErrors {
       std::shared_ptr<shared_model::interface::Proposal> verified_proposal;
       TransactionsErrors rejected_transactions;
+      /// False if verified transactions were applied to several temporary
+      /// WSVs, so the one given to the validator does not hold the whole
+      /// state and must not be prepared for commit
+      bool state_complete = true;
     };
 
   }  // namespace validation
@@ -18,7 +18,10 @@
 #ifndef IROHA_CRYPTO_VERIFIER_HPP
 #define IROHA_CRYPTO_VERIFIER_HPP
 
+#include <vector>
+
 #include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "cryptography/signature_check.hpp"
 
 namespace shared_model {
   namespace crypto {
@@ -48,6 +51,16 @@ namespace shared_model {
         return Algorithm::verify(signedData, source, pubKey);
       }
 
+      /**
+       * Verify signatures one by one until an incorrect one is found.
+       * Signatures and keys of wrong length are incorrect instead of throwing
+       * @param checks - signatures with data they were made for
+       * @return true if all signatures are correct
+       */
+      static bool verifyAll(const std::vector<SignatureCheck> &checks) {
+        return Algorithm::verifyAll(checks);
+      }
+
       /// close constructor for forbidding instantiation
       CryptoVerifier() = delete;
     };
@@ -18,8 +18,11 @@
 #ifndef IROHA_CRYPTOPROVIDER_HPP
 #define IROHA_CRYPTOPROVIDER_HPP
 
+#include <vector>
+
 #include "cryptography/keypair.hpp"
 #include "cryptography/seed.hpp"
+#include "cryptography/signature_check.hpp"
 #include "cryptography/signed.hpp"
 
 namespace shared_model {
@@ -47,6 +50,14 @@ namespace shared_model {
       static bool verify(const Signed &signedData,
                          const Blob &orig,
                          const PublicKey &publicKey);
+
+      /**
+       * Verifies signatures one by one.
+       * @param checks - signatures with their original messages
+       * @return true if all signatures are correct, false otherwise
+       */
+      static bool verifyAll(const std::vector<SignatureCheck> &checks);
+
       /**
        * Generates new seed
        * @return Seed generated
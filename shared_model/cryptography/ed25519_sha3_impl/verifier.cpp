@@ -16,6 +16,9 @@
  */
 
 #include "verifier.hpp"
+
+#include <algorithm>
+
 #include "cryptography/ed25519_sha3_impl/internal/ed25519_impl.hpp"
 #include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
 
@@ -29,5 +32,27 @@ namespace shared_model {
           iroha::pubkey_t::from_string(toBinaryString(publicKey)),
           iroha::sig_t::from_string(toBinaryString(signedData)));
     }
+
+    bool Verifier::verifyAll(const std::vector<SignatureCheck> &checks) {
+      // keys, signatures and messages are read in place instead of being
+      // copied to strings
+      iroha::pubkey_t public_key;
+      iroha::sig_t signature;
+      return std::all_of(
+          checks.begin(), checks.end(), [&](const SignatureCheck &check) {
+            const auto &key = check.public_key.blob();
+            const auto &sig = check.signed_data.blob();
+            if (key.size() != public_key.size()
+                or sig.size() != signature.size()) {
+              return false;
+            }
+            std::copy(key.begin(), key.end(), public_key.begin());
+            std::copy(sig.begin(), sig.end(), signature.begin());
+            const auto &source = check.source.blob();
+            const auto hash = iroha::sha3_256(source.data(), source.size());
+            return iroha::verify(
+                hash.data(), hash.size(), public_key, signature);
+          });
+    }
   }  // namespace crypto
 }  // namespace shared_model
@@ -18,7 +18,10 @@
 #ifndef IROHA_SHARED_MODEL_VERIFIER_HPP
 #define IROHA_SHARED_MODEL_VERIFIER_HPP
 
+#include <vector>
+
 #include "cryptography/public_key.hpp"
+#include "cryptography/signature_check.hpp"
 #include "cryptography/signed.hpp"
 
 namespace shared_model {
@@ -31,6 +34,13 @@ namespace shared_model {
       static bool verify(const Signed &signedData,
                          const Blob &orig,
                          const PublicKey &publicKey);
+
+      /**
+       * Verify signatures one by one, stopping at the first incorrect one.
+       * Signatures and keys of wrong length are incorrect
+       * @return true if all signatures are correct
+       */
+      static bool verifyAll(const std::vector<SignatureCheck> &checks);
     };
 
   }  // namespace crypto
@@ -0,0 +1,29 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SHARED_MODEL_SIGNATURE_CHECK_HPP
+#define IROHA_SHARED_MODEL_SIGNATURE_CHECK_HPP
+
+namespace shared_model {
+  namespace crypto {
+
+    class Signed;
+    class Blob;
+    class PublicKey;
+
+    /**
+     * Signature with the data it was made for, an entry of signatures
+     * verified one by one. Referenced objects must outlive it
+     */
+    struct SignatureCheck {
+      const Signed &signed_data;
+      const Blob &source;
+      const PublicKey &public_key;
+    };
+
+  }  // namespace crypto
+}  // namespace shared_model
+
+#endif  // IROHA_SHARED_MODEL_SIGNATURE_CHECK_HPP
@@ -13,6 +13,7 @@
 #include "interfaces/iroha_internal/transaction_batch_impl.hpp"
 #include "interfaces/transaction.hpp"
 #include "validators/answer.hpp"
+#include "validators/signature_verification_pool.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -44,24 +45,35 @@ namespace shared_model {
             "Transaction collection error",
             std::vector<std::string>{"sequence can not be empty"}));
       }
-      for (const auto &tx : transactions) {
-        // perform stateless validation checks
-        validation::ReasonsGroupType reason;
-        reason.first = "Transaction: ";
-        // check signatures validness
-        if (not boost::empty(tx->signatures())) {
-          field_validator.validateSignatures(
-              reason, tx->signatures(), tx->payload());
-          if (not reason.second.empty()) {
-            result.addReason(std::move(reason));
-            continue;
-          }
-        }
-        // check transaction validness
-        auto tx_errors = transaction_validator.validate(*tx);
-        if (tx_errors) {
-          reason.second.emplace_back(tx_errors.reason());
-          result.addReason(std::move(reason));
+      // perform stateless validation checks of transactions in parallel, and
+      // form batches in the order of transactions afterwards
+      std::vector<validation::ReasonsGroupType> reasons(transactions.size());
+      validation::SignatureVerificationPool::instance().parallelFor(
+          transactions.size(),
+          [&transactions, &reasons, &field_validator, &transaction_validator](
+              size_t i) {
+            const auto &tx = transactions[i];
+            auto &reason = reasons[i];
+            reason.first = "Transaction: ";
+            // check signatures validness
+            if (not boost::empty(tx->signatures())) {
+              field_validator.validateSignatures(
+                  reason, tx->signatures(), tx->payload());
+              if (not reason.second.empty()) {
+                return;
+              }
+            }
+            // check transaction validness
+            auto tx_errors = transaction_validator.validate(*tx);
+            if (tx_errors) {
+              reason.second.emplace_back(tx_errors.reason());
+            }
+          });
+
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        const auto &tx = transactions[i];
+        if (not reasons[i].second.empty()) {
+          result.addReason(std::move(reasons[i]));
           continue;
         }
 
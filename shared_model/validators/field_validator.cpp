@@ -11,11 +11,14 @@
 #include <boost/format.hpp>
 #include "cryptography/crypto_provider/crypto_defaults.hpp"
 #include "cryptography/crypto_provider/crypto_verifier.hpp"
+#include "cryptography/hash_providers/sha3_256.hpp"
 #include "interfaces/common_objects/amount.hpp"
 #include "interfaces/common_objects/peer.hpp"
 #include "interfaces/queries/query_payload_meta.hpp"
 #include "interfaces/queries/tx_pagination_meta.hpp"
 #include "validators/field_validator.hpp"
+#include "validators/signature_cache.hpp"
+#include "validators/signature_verification_pool.hpp"
 
 // TODO: 15.02.18 nickaleks Change structure to compositional IR-978
 
@@ -307,29 +310,65 @@ namespace shared_model {
       if (boost::empty(signatures)) {
         reason.second.emplace_back("Signatures cannot be empty");
       }
+      auto well_formed = [](const interface::Signature &signature) {
+        return signature.signedData().blob().size() == signature_size
+            and signature.publicKey().blob().size() == public_key_size;
+      };
+      // well-formed signatures which were not verified before are verified
+      // in parallel, and reasons are reported in the order of signatures
+      auto &cache = SignatureCache::instance();
+      const auto payload_hash = crypto::Sha3_256::makeHash(source);
+      std::vector<char> cached;
+      std::vector<std::string> keys;
+      std::vector<crypto::SignatureCheck> checks;
+      for (const auto &signature : signatures) {
+        if (not well_formed(signature)) {
+          continue;
+        }
+        auto key = SignatureCache::makeKey(
+            payload_hash, signature.publicKey(), signature.signedData());
+        cached.push_back(cache.contains(key));
+        if (not cached.back()) {
+          keys.push_back(std::move(key));
+          checks.push_back(crypto::SignatureCheck{
+              signature.signedData(), source, signature.publicKey()});
+        }
+      }
+      const auto verified = checks.size() > 1
+          ? SignatureVerificationPool::instance().verify(checks)
+          : std::vector<bool>{checks.empty()
+                              or crypto::CryptoVerifier<>::verifyAll(checks)};
+      for (size_t i = 0; i < checks.size(); ++i) {
+        if (verified[i]) {
+          cache.insert(std::move(keys[i]));
+        }
+      }
+
+      auto is_cached = cached.begin();
+      auto is_verified = verified.begin();
       for (const auto &signature : signatures) {
         const auto &sign = signature.signedData();
         const auto &pkey = signature.publicKey();
-        bool is_valid = true;
+
+        if (well_formed(signature)) {
+          // only signatures missing in the cache have verification results
+          const bool valid = *is_cached++ or *is_verified++;
+          if (not valid) {
+            reason.second.push_back((boost::format("Wrong signature [%s;%s]")
+                                     % sign.hex() % pkey.hex())
+                                        .str());
+          }
+          continue;
+        }
 
         if (sign.blob().size() != signature_size) {
           reason.second.push_back(
               (boost::format("Invalid signature: %s") % sign.hex()).str());
-          is_valid = false;
         }
 
         if (pkey.blob().size() != public_key_size) {
           reason.second.push_back(
               (boost::format("Invalid pubkey: %s") % pkey.hex()).str());
-          is_valid = false;
-        }
-
-        if (is_valid
-            && not shared_model::crypto::CryptoVerifier<>::verify(
-                   sign, source, pkey)) {
-          reason.second.push_back((boost::format("Wrong signature [%s;%s]")
-                                   % sign.hex() % pkey.hex())
-                                      .str());
         }
       }
     }
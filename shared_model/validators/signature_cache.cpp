@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "validators/signature_cache.hpp"
+
+#include <algorithm>
+
+#include "cryptography/hash.hpp"
+#include "cryptography/public_key.hpp"
+#include "cryptography/signed.hpp"
+
+namespace {
+  /// number of independently locked parts of the cache
+  const size_t kShards = 16;
+}  // namespace
+
+namespace shared_model {
+  namespace validation {
+
+    // about 20 MB of signatures, enough for several full proposals and the
+    // blocks made of them
+    const size_t SignatureCache::kDefaultCapacity = 100000;
+
+    double SignatureCache::Stats::hitRate() const {
+      const auto lookups = hits + misses;
+      return lookups == 0 ? 0. : static_cast<double>(hits) / lookups;
+    }
+
+    SignatureCache::SignatureCache(size_t capacity)
+        : shard_capacity_(std::max<size_t>(1, capacity / kShards)),
+          hits_(0),
+          misses_(0),
+          evictions_(0),
+          size_(0) {
+      for (size_t i = 0; i < kShards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+      }
+    }
+
+    SignatureCache &SignatureCache::instance() {
+      static SignatureCache cache(kDefaultCapacity);
+      return cache;
+    }
+
+    std::string SignatureCache::makeKey(const crypto::Hash &payload_hash,
+                                        const crypto::PublicKey &public_key,
+                                        const crypto::Signed &signature) {
+      std::string key;
+      key.reserve(payload_hash.size() + public_key.size() + signature.size());
+      for (const auto *blob : {static_cast<const crypto::Blob *>(&payload_hash),
+                               static_cast<const crypto::Blob *>(&public_key),
+                               static_cast<const crypto::Blob *>(&signature)}) {
+        key.append(blob->blob().begin(), blob->blob().end());
+      }
+      return key;
+    }
+
+    bool SignatureCache::contains(const std::string &key) {
+      auto &shard = this->shard(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.entries.find(key);
+      if (it == shard.entries.end()) {
+        ++misses_;
+        return false;
+      }
+      shard.order.splice(shard.order.begin(), shard.order, it->second);
+      ++hits_;
+      return true;
+    }
+
+    void SignatureCache::insert(std::string key) {
+      auto &shard = this->shard(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto inserted = shard.entries.emplace(std::move(key), shard.order.end());
+      if (not inserted.second) {
+        return;
+      }
+      // keys of unordered_map nodes keep their addresses until erased
+      shard.order.push_front(&inserted.first->first);
+      inserted.first->second = shard.order.begin();
+      ++size_;
+
+      if (shard.entries.size() > shard_capacity_) {
+        shard.entries.erase(*shard.order.back());
+        shard.order.pop_back();
+        --size_;
+        ++evictions_;
+      }
+    }
+
+    SignatureCache::Stats SignatureCache::stats() const {
+      return Stats{
+          hits_.load(), misses_.load(), evictions_.load(), size_.load()};
+    }
+
+    SignatureCache::Shard &SignatureCache::shard(const std::string &key) {
+      return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+    }
+
+  }  // namespace validation
+}  // namespace shared_model
@@ -0,0 +1,112 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SHARED_MODEL_SIGNATURE_CACHE_HPP
+#define IROHA_SHARED_MODEL_SIGNATURE_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace shared_model {
+  namespace crypto {
+    class Hash;
+    class PublicKey;
+    class Signed;
+  }  // namespace crypto
+
+  namespace validation {
+
+    /**
+     * Set of signatures which were verified successfully, so a signature
+     * seen again by torii, ordering, MST or block loader is not verified
+     * twice. Entries are keyed by hash of signed data, public key and
+     * signature, and the least recently used ones are evicted when the
+     * cache is full. Failed verifications are never cached.
+     */
+    class SignatureCache {
+     public:
+      /**
+       * Counters of the cache since its creation
+       */
+      struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t size;
+
+        /**
+         * @return share of lookups which found the signature, 0 without
+         * lookups
+         */
+        double hitRate() const;
+      };
+
+      /// number of entries of the shared cache
+      static const size_t kDefaultCapacity;
+
+      /**
+       * @param capacity - max number of cached signatures
+       */
+      explicit SignatureCache(size_t capacity);
+
+      /**
+       * Cache shared by validators
+       */
+      static SignatureCache &instance();
+
+      /**
+       * @return key of a signature made for data with given hash
+       */
+      static std::string makeKey(const crypto::Hash &payload_hash,
+                                 const crypto::PublicKey &public_key,
+                                 const crypto::Signed &signature);
+
+      /**
+       * Check whether signature was verified, and count a hit or a miss
+       * @param key - key made by makeKey()
+       */
+      bool contains(const std::string &key);
+
+      /**
+       * Remember successfully verified signature
+       * @param key - key made by makeKey()
+       */
+      void insert(std::string key);
+
+      Stats stats() const;
+
+     private:
+      /**
+       * Part of the cache under its own lock
+       */
+      struct Shard {
+        std::mutex mutex;
+        /// keys of entries, most recently used first
+        std::list<const std::string *> order;
+        std::unordered_map<std::string,
+                           std::list<const std::string *>::iterator>
+            entries;
+      };
+
+      Shard &shard(const std::string &key);
+
+      const size_t shard_capacity_;
+      std::vector<std::unique_ptr<Shard>> shards_;
+
+      std::atomic<uint64_t> hits_;
+      std::atomic<uint64_t> misses_;
+      std::atomic<uint64_t> evictions_;
+      std::atomic<size_t> size_;
+    };
+
+  }  // namespace validation
+}  // namespace shared_model
+
+#endif  // IROHA_SHARED_MODEL_SIGNATURE_CACHE_HPP
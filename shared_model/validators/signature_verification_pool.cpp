@@ -0,0 +1,251 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "validators/signature_verification_pool.hpp"
+
+#include <algorithm>
+
+#include "cryptography/crypto_provider/crypto_verifier.hpp"
+
+namespace {
+  /// max number of queued jobs of the shared pool per worker
+  const size_t kJobsPerWorker = 256;
+
+  template <typename T>
+  void updateMax(std::atomic<T> &max, T value) {
+    auto current = max.load();
+    while (current < value and not max.compare_exchange_weak(current, value)) {
+    }
+  }
+}  // namespace
+
+namespace shared_model {
+  namespace validation {
+
+    SignatureVerificationPool::SignatureVerificationPool(size_t workers,
+                                                         size_t capacity)
+        : capacity_(capacity),
+          next_queue_(0),
+          queued_(0),
+          stopped_(false),
+          jobs_(0),
+          rejected_(0),
+          stolen_(0),
+          max_queue_depth_(0),
+          total_latency_us_(0),
+          max_latency_us_(0) {
+      for (size_t i = 0; i < workers; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+      }
+      for (size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back([this, i] { this->work(i); });
+      }
+    }
+
+    SignatureVerificationPool::~SignatureVerificationPool() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+      submitted_.notify_all();
+      for (auto &thread : threads_) {
+        thread.join();
+      }
+    }
+
+    SignatureVerificationPool &SignatureVerificationPool::instance() {
+      static const size_t workers =
+          std::max(1u, std::thread::hardware_concurrency());
+      static SignatureVerificationPool pool(workers, workers * kJobsPerWorker);
+      return pool;
+    }
+
+    std::future<bool> SignatureVerificationPool::submit(
+        const crypto::SignatureCheck &check) {
+      auto promise = std::make_shared<std::promise<bool>>();
+      auto result = promise->get_future();
+      enqueue([check, promise] { promise->set_value(verifyOne(check)); });
+      return result;
+    }
+
+    void SignatureVerificationPool::submit(
+        const crypto::SignatureCheck &check,
+        std::function<void(bool)> callback) {
+      enqueue([check, callback = std::move(callback)] {
+        callback(verifyOne(check));
+      });
+    }
+
+    std::vector<bool> SignatureVerificationPool::verify(
+        const std::vector<crypto::SignatureCheck> &checks) {
+      // std::vector<bool> cannot be written from several threads
+      std::vector<char> verified(checks.size());
+      parallelFor(checks.size(), [&checks, &verified](size_t i) {
+        verified[i] = verifyOne(checks[i]);
+      });
+      return std::vector<bool>(verified.begin(), verified.end());
+    }
+
+    void SignatureVerificationPool::parallelFor(
+        size_t count, const std::function<void(size_t)> &f) {
+      if (count < 2 or threads_.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+          f(i);
+        }
+        return;
+      }
+
+      struct State {
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+      };
+      auto state = std::make_shared<State>();
+      state->remaining = count;
+      // f is referenced until the last call finishes, which is awaited below
+      auto call = [&f, state](size_t i) {
+        try {
+          f(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if (not state->error) {
+            state->error = std::current_exception();
+          }
+        }
+        if (--state->remaining == 0) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          state->done.notify_all();
+        }
+      };
+
+      for (size_t i = 1; i < count; ++i) {
+        enqueue([call, i] { call(i); });
+      }
+      call(0);
+
+      while (state->remaining > 0) {
+        // help with queued jobs, which may include the submitted ones, and
+        // sleep only when the rest of them are already running
+        if (runQueued(queues_.size())) {
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&state] { return state->remaining == 0; });
+      }
+
+      if (state->error) {
+        std::rethrow_exception(state->error);
+      }
+    }
+
+    size_t SignatureVerificationPool::workers() const {
+      return threads_.size();
+    }
+
+    size_t SignatureVerificationPool::queueDepth() const {
+      return queued_;
+    }
+
+    SignatureVerificationPool::Stats SignatureVerificationPool::stats() const {
+      return Stats{jobs_.load(),
+                   rejected_.load(),
+                   stolen_.load(),
+                   queued_.load(),
+                   max_queue_depth_.load(),
+                   std::chrono::microseconds(total_latency_us_.load()),
+                   std::chrono::microseconds(max_latency_us_.load())};
+    }
+
+    void SignatureVerificationPool::enqueue(Task task) {
+      Job job{std::move(task), Clock::now()};
+      // reserve a place before the job is visible to workers, so the counter
+      // never goes below the number of jobs in the queues
+      const auto depth = queued_++;
+      if (threads_.empty() or depth >= capacity_) {
+        --queued_;
+        ++rejected_;
+        run(job);
+        return;
+      }
+      updateMax(max_queue_depth_, depth + 1);
+
+      auto &queue = *queues_[next_queue_++ % queues_.size()];
+      {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+      }
+      // the lock orders the notification after a worker checked the counter
+      { std::lock_guard<std::mutex> lock(mutex_); }
+      submitted_.notify_one();
+    }
+
+    bool SignatureVerificationPool::runQueued(size_t index) {
+      const auto size = queues_.size();
+      const bool own = index < size;
+      const auto start = own ? index : next_queue_.load() % size;
+      for (size_t i = 0; i < size; ++i) {
+        const auto current = (start + i) % size;
+        auto &queue = *queues_[current];
+        Job job;
+        {
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          if (queue.jobs.empty()) {
+            continue;
+          }
+          // owner takes the latest job, which is likely to be hot in cache,
+          // and others take the oldest one
+          if (own and current == index) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+          } else {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+          }
+        }
+        --queued_;
+        if (own and current != index) {
+          ++stolen_;
+        }
+        run(job);
+        return true;
+      }
+      return false;
+    }
+
+    void SignatureVerificationPool::run(const Job &job) {
+      job.task();
+      using std::chrono::microseconds;
+      const auto latency =
+          std::chrono::duration_cast<microseconds>(Clock::now() - job.submitted)
+              .count();
+      total_latency_us_ += latency;
+      updateMax(max_latency_us_, static_cast<int64_t>(latency));
+      ++jobs_;
+    }
+
+    void SignatureVerificationPool::work(size_t index) {
+      while (true) {
+        if (runQueued(index)) {
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        submitted_.wait(lock, [this] { return stopped_ or queued_ > 0; });
+        if (stopped_ and queued_ == 0) {
+          return;
+        }
+      }
+    }
+
+    bool SignatureVerificationPool::verifyOne(
+        const crypto::SignatureCheck &check) {
+      // checks interface checks sizes of keys and signatures instead of
+      // throwing on malformed ones
+      return crypto::CryptoVerifier<>::verifyAll(
+          std::vector<crypto::SignatureCheck>{check});
+    }
+
+  }  // namespace validation
+}  // namespace shared_model
@@ -0,0 +1,170 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SHARED_MODEL_SIGNATURE_VERIFICATION_POOL_HPP
+#define IROHA_SHARED_MODEL_SIGNATURE_VERIFICATION_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cryptography/signature_check.hpp"
+
+namespace shared_model {
+  namespace validation {
+
+    /**
+     * Bounded pool of threads verifying signatures for stateless validators.
+     *
+     * Every worker has its own queue, jobs are spread over the queues round
+     * robin, and an idle worker steals jobs from the others. When the number
+     * of queued jobs reaches the capacity, a job is run by the thread which
+     * submits it. A thread waiting for its jobs runs queued jobs too, so jobs
+     * may submit and wait for other jobs.
+     */
+    class SignatureVerificationPool {
+     public:
+      using Task = std::function<void()>;
+      using Clock = std::chrono::steady_clock;
+
+      /**
+       * Counters of the pool since its creation
+       */
+      struct Stats {
+        /// number of finished jobs
+        uint64_t jobs;
+        /// jobs run by submitting thread because the pool was full
+        uint64_t rejected;
+        /// jobs taken from the queue of another worker
+        uint64_t stolen;
+        /// number of jobs in the queues
+        size_t queue_depth;
+        size_t max_queue_depth;
+        /// time from job submission to its completion
+        std::chrono::microseconds total_latency;
+        std::chrono::microseconds max_latency;
+      };
+
+      /**
+       * @param workers - number of threads, 0 runs all jobs in place
+       * @param capacity - max number of queued jobs
+       */
+      SignatureVerificationPool(size_t workers, size_t capacity);
+
+      /**
+       * Run remaining jobs and stop workers
+       */
+      ~SignatureVerificationPool();
+
+      /**
+       * Pool shared by validators, with a worker per hardware thread
+       */
+      static SignatureVerificationPool &instance();
+
+      /**
+       * Verify a signature asynchronously
+       * @param check - signature with its data, which must outlive the job
+       * @return future result of verification
+       */
+      std::future<bool> submit(const crypto::SignatureCheck &check);
+
+      /**
+       * Verify a signature asynchronously
+       * @param check - signature with its data, which must outlive the job
+       * @param callback - called with result of verification on the thread
+       * which verified it
+       */
+      void submit(const crypto::SignatureCheck &check,
+                  std::function<void(bool)> callback);
+
+      /**
+       * Verify signatures in parallel and wait for results
+       * @return result of verification for every check, in the same order
+       */
+      std::vector<bool> verify(
+          const std::vector<crypto::SignatureCheck> &checks);
+
+      /**
+       * Call function for indexes 0 to count - 1 in parallel and wait for
+       * all the calls. An exception thrown by a call is rethrown
+       */
+      void parallelFor(size_t count, const std::function<void(size_t)> &f);
+
+      /**
+       * @return number of worker threads
+       */
+      size_t workers() const;
+
+      /**
+       * @return number of queued jobs
+       */
+      size_t queueDepth() const;
+
+      Stats stats() const;
+
+      SignatureVerificationPool(const SignatureVerificationPool &) = delete;
+      SignatureVerificationPool &operator=(const SignatureVerificationPool &) =
+          delete;
+
+     private:
+      struct Job {
+        Task task;
+        Clock::time_point submitted;
+      };
+
+      struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+      };
+
+      /**
+       * Queue task or run it in place if the pool is full
+       */
+      void enqueue(Task task);
+
+      /**
+       * Take a job from queue with given index or steal it from another
+       * queue, and run it
+       * @return false if all queues are empty
+       */
+      bool runQueued(size_t index);
+
+      void run(const Job &job);
+
+      void work(size_t index);
+
+      static bool verifyOne(const crypto::SignatureCheck &check);
+
+      const size_t capacity_;
+      std::vector<std::unique_ptr<Queue>> queues_;
+      std::atomic<size_t> next_queue_;
+      std::atomic<size_t> queued_;
+
+      /// workers sleep on it while the queues are empty
+      std::mutex mutex_;
+      std::condition_variable submitted_;
+      bool stopped_;
+
+      std::atomic<uint64_t> jobs_;
+      std::atomic<uint64_t> rejected_;
+      std::atomic<uint64_t> stolen_;
+      std::atomic<size_t> max_queue_depth_;
+      std::atomic<int64_t> total_latency_us_;
+      std::atomic<int64_t> max_latency_us_;
+
+      std::vector<std::thread> threads_;
+    };
+
+  }  // namespace validation
+}  // namespace shared_model
+
+#endif  // IROHA_SHARED_MODEL_SIGNATURE_VERIFICATION_POOL_HPP
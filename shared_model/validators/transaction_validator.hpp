@@ -265,8 +265,11 @@ namespace shared_model {
           answer.addReason(std::move(tx_reason));
         }
 
+        // commands are numbered from zero in every transaction, and
+        // transactions validated in parallel do not share the counter
+        auto command_validator = command_validator_;
         for (const auto &command : tx.commands()) {
-          auto reason = boost::apply_visitor(command_validator_, command.get());
+          auto reason = boost::apply_visitor(command_validator, command.get());
           if (not reason.second.empty()) {
             answer.addReason(std::move(reason));
           }
@@ -13,6 +13,7 @@
 #include "validators/default_validator.hpp"
 #include "validators/field_validator.hpp"
 #include "validators/signable_validator.hpp"
+#include "validators/signature_verification_pool.hpp"
 #include "validators/transaction_validator.hpp"
 #include "validators/transactions_collection/batch_order_validator.hpp"
 
@@ -47,12 +48,24 @@ namespace shared_model {
         return res;
       }
 
+      // transactions are validated in parallel, mostly their signatures, and
+      // reasons are reported in the order of transactions
+      std::vector<const interface::Transaction *> txs;
       for (const auto &tx : transactions) {
-        auto answer = std::forward<Validator>(validator)(tx);
-        if (answer.hasErrors()) {
-          auto message =
-              (boost::format("Tx %s : %s") % tx.hash().hex() % answer.reason())
-                  .str();
+        txs.push_back(&tx);
+      }
+      std::vector<Answer> answers(txs.size());
+      SignatureVerificationPool::instance().parallelFor(
+          txs.size(),
+          [&txs, &answers, &validator](size_t i) {
+            answers[i] = validator(*txs[i]);
+          });
+
+      for (size_t i = 0; i < txs.size(); ++i) {
+        if (answers[i].hasErrors()) {
+          auto message = (boost::format("Tx %s : %s") % txs[i]->hash().hex()
+                          % answers[i].reason())
+                             .str();
           reason.second.push_back(message);
         }
       }
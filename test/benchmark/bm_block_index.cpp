@@ -0,0 +1,212 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Every committed block is indexed by tx hash, creator and transferred assets
+ * inside the commit transaction.
+ *
+ * The purpose of this benchmark is to measure the time of indexing a single
+ * block depending on the number of transactions in it, and the latency of tx
+ * lookups by hash depending on the number of indexed transactions. Requires
+ * a running PostgreSQL, see getPostgresCredsOrDefault.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <soci/postgresql/soci-postgresql.h>
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include "ametsuchi/impl/postgres_block_index.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "datetime/time.hpp"
+#include "framework/config_helper.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+#include "validators/field_validator.hpp"
+
+using namespace iroha::ametsuchi;
+
+/// number of transfer commands in a single transaction
+constexpr int number_of_commands = 3;
+
+class BlockIndexBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    const auto dbname = "d"
+        + boost::uuids::to_string(boost::uuids::random_generator()())
+              .substr(0, 8);
+    const auto pgopt = "dbname=" + dbname + " "
+        + integration_framework::getPostgresCredsOrDefault();
+    StorageImpl::create(
+        block_store_path,
+        pgopt,
+        std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+            shared_model::validation::FieldValidator>>(),
+        std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+        std::make_shared<shared_model::proto::ProtoPermissionToString>())
+        .match(
+            [&](iroha::expected::Value<std::shared_ptr<StorageImpl>> &v) {
+              storage = v.value;
+            },
+            [&](iroha::expected::Error<std::string> &e) {
+              st.SkipWithError(e.error.c_str());
+            });
+    if (storage) {
+      sql = std::make_unique<soci::session>(soci::postgresql, pgopt);
+    }
+  }
+
+  void TearDown(benchmark::State &) override {
+    sql.reset();
+    if (storage) {
+      storage->dropStorage();
+    }
+    boost::filesystem::remove_all(block_store_path);
+  }
+
+  /**
+   * @return block with given number of distinct transactions
+   */
+  static shared_model::proto::Block makeBlock(int number_of_txs) {
+    const auto now = iroha::time::now();
+    std::vector<shared_model::proto::Transaction> txs;
+    for (int i = 0; i < number_of_txs; i++) {
+      TestTransactionBuilder builder;
+      builder.creatorAccountId("player@one").createdTime(now + i).quorum(1);
+      for (int c = 0; c < number_of_commands; c++) {
+        builder.transferAsset("player@one", "player@two", "coin", "", "5.00");
+      }
+      txs.push_back(builder.build());
+    }
+    return TestBlockBuilder()
+        .createdTime(now)
+        .height(1)
+        .transactions(txs)
+        .build();
+  }
+
+  std::string block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+  std::shared_ptr<StorageImpl> storage;
+  std::unique_ptr<soci::session> sql;
+};
+
+/**
+ * Index a block in a transaction, which is rolled back outside of measured
+ * time, so every iteration starts with the same tables
+ */
+BENCHMARK_DEFINE_F(BlockIndexBenchmark, Index)(benchmark::State &st) {
+  if (not sql) {
+    return;
+  }
+  const auto block = makeBlock(st.range(0));
+  PostgresBlockIndex block_index(*sql);
+  while (st.KeepRunning()) {
+    st.PauseTiming();
+    *sql << "BEGIN";
+    st.ResumeTiming();
+
+    block_index.index(block);
+
+    st.PauseTiming();
+    *sql << "ROLLBACK";
+    st.ResumeTiming();
+  }
+  st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK_REGISTER_F(BlockIndexBenchmark, Index)
+    ->RangeMultiplier(10)
+    ->Range(1, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * Block index with given number of committed transactions
+ */
+class TxLookupBenchmark : public BlockIndexBenchmark {
+ public:
+  /// number of distinct looked up hashes
+  static constexpr int kSampleSize = 1000;
+
+  void SetUp(benchmark::State &st) override {
+    BlockIndexBenchmark::SetUp(st);
+    if (not sql) {
+      return;
+    }
+    // hashes are generated by the server, which is much faster than
+    // indexing blocks for the largest sizes
+    const int number_of_txs = st.range(0);
+    const int step = std::max(number_of_txs / kSampleSize, 1);
+    *sql << "INSERT INTO tx_status_by_hash(hash, status) "
+            "SELECT decode(md5(i::text) || md5(i::text), 'hex'), TRUE "
+            "FROM generate_series(1, :count) AS i",
+        soci::use(number_of_txs);
+    *sql << "ANALYZE tx_status_by_hash";
+
+    soci::rowset<std::string> rows =
+        (sql->prepare << "SELECT md5(i::text) || md5(i::text) "
+                         "FROM generate_series(1, :count, :step) AS i",
+         soci::use(number_of_txs),
+         soci::use(step));
+    for (const auto &hex : rows) {
+      hashes.push_back(shared_model::crypto::Hash::fromHexString(hex));
+    }
+  }
+
+  void TearDown(benchmark::State &st) override {
+    hashes.clear();
+    BlockIndexBenchmark::TearDown(st);
+  }
+
+  std::vector<shared_model::crypto::Hash> hashes;
+};
+
+BENCHMARK_DEFINE_F(TxLookupBenchmark, CheckTxPresence)
+(benchmark::State &st) {
+  if (not sql) {
+    return;
+  }
+  auto block_query = storage->getBlockQuery();
+  size_t i = 0;
+  while (st.KeepRunning()) {
+    auto status = block_query->checkTxPresence(hashes[i++ % hashes.size()]);
+    benchmark::DoNotOptimize(status);
+  }
+}
+
+BENCHMARK_REGISTER_F(TxLookupBenchmark, CheckTxPresence)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Check presence of the whole sample with a single query, as done for
+ * proposals and batches
+ */
+BENCHMARK_DEFINE_F(TxLookupBenchmark, CheckTxPresenceBatch)
+(benchmark::State &st) {
+  if (not sql) {
+    return;
+  }
+  auto block_query = storage->getBlockQuery();
+  while (st.KeepRunning()) {
+    auto statuses = block_query->checkTxPresence(hashes);
+    benchmark::DoNotOptimize(statuses);
+  }
+  st.SetItemsProcessed(st.iterations() * hashes.size());
+}
+
+BENCHMARK_REGISTER_F(TxLookupBenchmark, CheckTxPresenceBatch)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
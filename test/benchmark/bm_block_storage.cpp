@@ -0,0 +1,475 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Every committed block is serialized before it is put to block store, and is
+ * deserialized again on every block and transaction query.
+ *
+ * The purpose of this benchmark is to compare costs of writing and reading
+ * a chain of blocks using legacy JSON records and binary protobuf records,
+ * to compare copying and memory-mapped block reads, to compare startup
+ * time and random read latency of block store layouts, and to compare write
+ * throughput of block store sync modes on local disk.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/block_log/block_log.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "common/byteutils.hpp"
+#include "common/files.hpp"
+#include "datetime/time.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::ametsuchi;
+
+/// number of commands in a single transaction
+constexpr int number_of_commands = 5;
+
+/// number of transactions in a single block
+constexpr int number_of_txs = 10;
+
+/// length of the longest benchmarked chain
+constexpr int max_chain_length = 100000;
+
+/// number of heap allocations made by the process
+std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size) {
+  ++allocations;
+  if (auto ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+/**
+ * Report average number of heap allocations per read block
+ */
+void reportAllocations(benchmark::State &st,
+                       size_t allocations_before,
+                       size_t blocks_per_iteration) {
+  st.counters["allocs_per_block"] =
+      static_cast<double>(allocations - allocations_before)
+      / (st.iterations() * blocks_per_iteration);
+}
+
+/**
+ * @return chain of max_chain_length blocks, built once for all benchmarks
+ */
+const std::vector<shared_model::proto::Block> &chain() {
+  static const auto blocks = [] {
+    TestTransactionBuilder txbuilder;
+    auto base_tx = txbuilder.createdTime(iroha::time::now()).quorum(1);
+    for (int i = 0; i < number_of_commands; i++) {
+      base_tx.transferAsset("player@one", "player@two", "coin", "", "5.00");
+    }
+    std::vector<shared_model::proto::Transaction> txs;
+    for (int i = 0; i < number_of_txs; i++) {
+      txs.push_back(base_tx.build());
+    }
+
+    std::vector<shared_model::proto::Block> result;
+    result.reserve(max_chain_length);
+    for (int height = 1; height <= max_chain_length; height++) {
+      result.push_back(TestBlockBuilder()
+                           .createdTime(iroha::time::now())
+                           .height(height)
+                           .transactions(txs)
+                           .build());
+    }
+    return result;
+  }();
+  return blocks;
+}
+
+/**
+ * Block serialization with legacy JSON records
+ */
+struct JsonFormat {
+  shared_model::proto::ProtoBlockJsonConverter converter;
+
+  KeyValueStorage::Bytes serialize(const shared_model::interface::Block &b) {
+    return iroha::stringToBytes(
+        boost::get<iroha::expected::Value<std::string>>(converter.serialize(b))
+            .value);
+  }
+
+  void deserialize(const KeyValueStorage::Bytes &bytes) {
+    benchmark::DoNotOptimize(
+        converter.deserialize(iroha::bytesToString(bytes)));
+  }
+};
+
+/**
+ * Block serialization with binary records
+ */
+struct BinaryFormat {
+  BlockStorageFormat format{
+      std::make_shared<shared_model::proto::ProtoBlockJsonConverter>()};
+
+  KeyValueStorage::Bytes serialize(const shared_model::interface::Block &b) {
+    return boost::get<iroha::expected::Value<KeyValueStorage::Bytes>>(
+               format.serialize(b))
+        .value;
+  }
+
+  void deserialize(const KeyValueStorage::Bytes &bytes) {
+    benchmark::DoNotOptimize(format.deserialize(bytes));
+  }
+
+  void deserialize(const KeyValueStorage::BytesView &view) {
+    benchmark::DoNotOptimize(format.deserialize(view.data, view.size));
+  }
+};
+
+template <typename Format>
+class BlockStorageBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    chain_length = st.range(0);
+    chain();
+    boost::filesystem::create_directory(block_store_path);
+  }
+
+  void TearDown(benchmark::State &st) override {
+    boost::filesystem::remove_all(block_store_path);
+  }
+
+  /**
+   * Put first chain_length blocks of the chain to a new block store
+   */
+  std::unique_ptr<FlatFile> fill() {
+    auto store = std::move(*FlatFile::create(block_store_path));
+    for (int i = 0; i < chain_length; i++) {
+      const auto &block = chain()[i];
+      store->add(block.height(), format.serialize(block));
+    }
+    return store;
+  }
+
+  Format format;
+  int chain_length;
+  std::string block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+};
+
+/**
+ * Benchmark serialization and storing of the whole chain
+ */
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStorageBenchmark, JsonWrite, JsonFormat)
+(benchmark::State &st) {
+  while (st.KeepRunning()) {
+    fill();
+    st.PauseTiming();
+    iroha::remove_dir_contents(block_store_path);
+    st.ResumeTiming();
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStorageBenchmark, BinaryWrite, BinaryFormat)
+(benchmark::State &st) {
+  while (st.KeepRunning()) {
+    fill();
+    st.PauseTiming();
+    iroha::remove_dir_contents(block_store_path);
+    st.ResumeTiming();
+  }
+}
+
+/**
+ * Benchmark reading and deserialization of the whole chain
+ */
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStorageBenchmark, JsonRead, JsonFormat)
+(benchmark::State &st) {
+  auto store = fill();
+  while (st.KeepRunning()) {
+    for (int id = 1; id <= chain_length; id++) {
+      format.deserialize(*store->get(id));
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStorageBenchmark, BinaryRead, BinaryFormat)
+(benchmark::State &st) {
+  auto store = fill();
+  const size_t allocations_before = allocations;
+  while (st.KeepRunning()) {
+    for (int id = 1; id <= chain_length; id++) {
+      format.deserialize(*store->get(id));
+    }
+  }
+  reportAllocations(st, allocations_before, chain_length);
+}
+
+/**
+ * Benchmark reading of the whole chain through memory-mapped views, which are
+ * parsed without copying records to intermediate buffers
+ */
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStorageBenchmark,
+                            BinaryViewRead,
+                            BinaryFormat)
+(benchmark::State &st) {
+  auto store = fill();
+  const size_t allocations_before = allocations;
+  while (st.KeepRunning()) {
+    for (int id = 1; id <= chain_length; id++) {
+      format.deserialize(*store->getView(id));
+    }
+  }
+  reportAllocations(st, allocations_before, chain_length);
+}
+
+/// size of a blob in block store layout benchmarks
+constexpr size_t blob_size = 5000;
+
+template <typename Storage>
+class BlockStoreLayoutBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    boost::filesystem::create_directory(block_store_path);
+    store = std::move(*Storage::create(block_store_path));
+    const KeyValueStorage::Bytes blob(blob_size, 42);
+    for (int id = 1; id <= st.range(0); id++) {
+      store->add(id, blob);
+    }
+  }
+
+  void TearDown(benchmark::State &st) override {
+    store.reset();
+    boost::filesystem::remove_all(block_store_path);
+  }
+
+  std::unique_ptr<Storage> store;
+  std::string block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+};
+
+/**
+ * Benchmark opening of a filled block store, as done at peer startup
+ */
+template <typename Storage>
+void openStore(BlockStoreLayoutBenchmark<Storage> &fixture,
+               benchmark::State &st) {
+  fixture.store.reset();
+  while (st.KeepRunning()) {
+    benchmark::DoNotOptimize(Storage::create(fixture.block_store_path));
+  }
+}
+
+/**
+ * Benchmark reading of blobs with random ids
+ */
+template <typename Storage>
+void randomRead(BlockStoreLayoutBenchmark<Storage> &fixture,
+                benchmark::State &st) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<KeyValueStorage::Identifier> ids(
+      1, fixture.store->last_id());
+  const size_t allocations_before = allocations;
+  while (st.KeepRunning()) {
+    benchmark::DoNotOptimize(fixture.store->get(ids(gen)));
+  }
+  reportAllocations(st, allocations_before, 1);
+}
+
+/**
+ * Benchmark viewing of blobs with random ids
+ */
+template <typename Storage>
+void randomView(BlockStoreLayoutBenchmark<Storage> &fixture,
+                benchmark::State &st) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<KeyValueStorage::Identifier> ids(
+      1, fixture.store->last_id());
+  const size_t allocations_before = allocations;
+  while (st.KeepRunning()) {
+    benchmark::DoNotOptimize(fixture.store->getView(ids(gen)));
+  }
+  reportAllocations(st, allocations_before, 1);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreLayoutBenchmark, FlatFileOpen, FlatFile)
+(benchmark::State &st) {
+  openStore(*this, st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreLayoutBenchmark, BlockLogOpen, BlockLog)
+(benchmark::State &st) {
+  openStore(*this, st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreLayoutBenchmark,
+                            FlatFileRandomRead,
+                            FlatFile)
+(benchmark::State &st) {
+  randomRead(*this, st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreLayoutBenchmark,
+                            BlockLogRandomRead,
+                            BlockLog)
+(benchmark::State &st) {
+  randomRead(*this, st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreLayoutBenchmark,
+                            FlatFileRandomView,
+                            FlatFile)
+(benchmark::State &st) {
+  randomView(*this, st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreLayoutBenchmark,
+                            BlockLogRandomView,
+                            BlockLog)
+(benchmark::State &st) {
+  randomView(*this, st);
+}
+
+/// number of blobs written in a single iteration of sync mode benchmarks
+constexpr int synced_chain_length = 1000;
+
+/**
+ * Create block store which syncs written blobs
+ */
+std::unique_ptr<FlatFile> createSynced(FlatFile *,
+                                       const std::string &path,
+                                       SyncOptions sync) {
+  return std::move(*FlatFile::create(path, sync));
+}
+
+std::unique_ptr<BlockLog> createSynced(BlockLog *,
+                                       const std::string &path,
+                                       SyncOptions sync) {
+  return std::move(
+      *BlockLog::create(path, BlockLog::kDefaultSegmentSize, sync));
+}
+
+template <typename Storage>
+class BlockStoreSyncBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    sync.mode = static_cast<SyncMode>(st.range(0));
+  }
+
+  void TearDown(benchmark::State &st) override {
+    boost::filesystem::remove_all(block_store_path);
+  }
+
+  SyncOptions sync;
+  std::string block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+};
+
+/**
+ * Benchmark appending of blobs to a new block store until they are all
+ * written with the sync mode given by the argument: none, block or group
+ */
+template <typename Storage>
+void syncedWrite(BlockStoreSyncBenchmark<Storage> &fixture,
+                 benchmark::State &st) {
+  static const char *kModeNames[] = {"none", "block", "group"};
+  const KeyValueStorage::Bytes blob(blob_size, 42);
+  while (st.KeepRunning()) {
+    st.PauseTiming();
+    boost::filesystem::remove_all(fixture.block_store_path);
+    auto store = createSynced(static_cast<Storage *>(nullptr),
+                              fixture.block_store_path,
+                              fixture.sync);
+    st.ResumeTiming();
+    for (int id = 1; id <= synced_chain_length; id++) {
+      store->add(id, blob);
+    }
+    // the last group is synced when the store is closed
+    store.reset();
+  }
+  st.SetItemsProcessed(st.iterations() * synced_chain_length);
+  st.SetLabel(kModeNames[st.range(0)]);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreSyncBenchmark, FlatFileWrite, FlatFile)
+(benchmark::State &st) {
+  syncedWrite(*this, st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(BlockStoreSyncBenchmark, BlockLogWrite, BlockLog)
+(benchmark::State &st) {
+  syncedWrite(*this, st);
+}
+
+BENCHMARK_REGISTER_F(BlockStorageBenchmark, JsonWrite)
+    ->Arg(1000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStorageBenchmark, BinaryWrite)
+    ->Arg(1000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStorageBenchmark, JsonRead)
+    ->Arg(1000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStorageBenchmark, BinaryRead)
+    ->Arg(1000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStorageBenchmark, BinaryViewRead)
+    ->Arg(1000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStoreLayoutBenchmark, FlatFileOpen)
+    ->Arg(10000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStoreLayoutBenchmark, BlockLogOpen)
+    ->Arg(10000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStoreLayoutBenchmark, FlatFileRandomRead)
+    ->Arg(10000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(BlockStoreLayoutBenchmark, BlockLogRandomRead)
+    ->Arg(10000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(BlockStoreLayoutBenchmark, FlatFileRandomView)
+    ->Arg(10000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(BlockStoreLayoutBenchmark, BlockLogRandomView)
+    ->Arg(10000)
+    ->Arg(max_chain_length)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(BlockStoreSyncBenchmark, FlatFileWrite)
+    ->DenseRange(0, 2)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BlockStoreSyncBenchmark, BlockLogWrite)
+    ->DenseRange(0, 2)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
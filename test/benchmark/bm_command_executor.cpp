@@ -0,0 +1,209 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Commands are executed as server-side prepared statements.
+ *
+ * The purpose of this benchmark is to measure the latency of a single add
+ * asset quantity command, the one used by BM_AddAssetQuantity in
+ * bm_pipeline, when executed by PostgresCommandExecutor with bound
+ * parameters, compared to a formatted EXECUTE query, and the latency of a
+ * failing command, which returns an explicit error code, compared to
+ * parsing the text of a constraint violation error. Requires a running
+ * PostgreSQL, see getPostgresCredsOrDefault.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <soci/postgresql/soci-postgresql.h>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include "ametsuchi/impl/postgres_command_executor.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "framework/config_helper.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+#include "validators/field_validator.hpp"
+
+using namespace iroha::ametsuchi;
+
+const std::string kDomain = "domain";
+const std::string kAccountId = "user@" + kDomain;
+const std::string kAssetId = "coin#" + kDomain;
+const std::string kAmount = "1.0";
+
+class CommandExecutorBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    const auto dbname = "d"
+        + boost::uuids::to_string(boost::uuids::random_generator()())
+              .substr(0, 8);
+    const auto pgopt = "dbname=" + dbname + " "
+        + integration_framework::getPostgresCredsOrDefault();
+    auto perm_converter =
+        std::make_shared<shared_model::proto::ProtoPermissionToString>();
+    StorageImpl::create(
+        block_store_path,
+        pgopt,
+        std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+            shared_model::validation::FieldValidator>>(),
+        std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+        perm_converter)
+        .match(
+            [&](iroha::expected::Value<std::shared_ptr<StorageImpl>> &v) {
+              storage = v.value;
+            },
+            [&](iroha::expected::Error<std::string> &e) {
+              st.SkipWithError(e.error.c_str());
+            });
+    if (not storage) {
+      return;
+    }
+    sql = std::make_unique<soci::session>(soci::postgresql, pgopt);
+    PostgresCommandExecutor::prepareStatements(*sql);
+    executor = std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+    executor->doValidation(false);
+    executor->setCreatorAccountId(kAccountId);
+
+    shared_model::interface::RolePermissionSet permissions;
+    permissions.set();
+    for (const auto &builder :
+         {TestTransactionBuilder().createRole("user", permissions),
+          TestTransactionBuilder().createDomain(kDomain, "user"),
+          TestTransactionBuilder().createAccount(
+              "user",
+              kDomain,
+              shared_model::interface::types::PubkeyType(
+                  std::string(32, '1'))),
+          TestTransactionBuilder().createAsset("coin", kDomain, 1)}) {
+      execute(builder.build().commands().front());
+    }
+  }
+
+  void TearDown(benchmark::State &) override {
+    executor.reset();
+    sql.reset();
+    if (storage) {
+      storage->dropStorage();
+    }
+    boost::filesystem::remove_all(block_store_path);
+  }
+
+  CommandResult execute(const shared_model::interface::Command &command) {
+    return boost::apply_visitor(*executor, command.get());
+  }
+
+  std::string block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+  std::shared_ptr<StorageImpl> storage;
+  std::unique_ptr<soci::session> sql;
+  std::unique_ptr<PostgresCommandExecutor> executor;
+};
+
+/**
+ * Execute the command through PostgresCommandExecutor
+ */
+BENCHMARK_DEFINE_F(CommandExecutorBenchmark, AddAssetQuantity)
+(benchmark::State &st) {
+  if (not sql) {
+    return;
+  }
+  const auto tx =
+      TestTransactionBuilder().addAssetQuantity(kAssetId, kAmount).build();
+  const auto &command = tx.commands().front();
+  while (st.KeepRunning()) {
+    auto result = execute(command);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_REGISTER_F(CommandExecutorBenchmark, AddAssetQuantity)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Execute the same prepared statement with arguments formatted into a
+ * query, as a baseline
+ */
+BENCHMARK_DEFINE_F(CommandExecutorBenchmark, AddAssetQuantityFormatted)
+(benchmark::State &st) {
+  if (not sql) {
+    return;
+  }
+  while (st.KeepRunning()) {
+    uint32_t result;
+    *sql << (boost::format("EXECUTE addAssetQuantityWithOutValidation "
+                           "('%1%', '%2%', %3%, '%4%')")
+             % kAccountId % kAssetId % 1 % kAmount)
+                .str(),
+        soci::into(result);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_REGISTER_F(CommandExecutorBenchmark, AddAssetQuantityFormatted)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Create an account which already exists, the statement detects it and
+ * returns an error code
+ */
+BENCHMARK_DEFINE_F(CommandExecutorBenchmark, CreateExistingAccount)
+(benchmark::State &st) {
+  if (not sql) {
+    return;
+  }
+  const auto tx = TestTransactionBuilder()
+                      .createAccount("user",
+                                     kDomain,
+                                     shared_model::interface::types::PubkeyType(
+                                         std::string(32, '1')))
+                      .build();
+  const auto &command = tx.commands().front();
+  while (st.KeepRunning()) {
+    auto result = execute(command);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_REGISTER_F(CommandExecutorBenchmark, CreateExistingAccount)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Insert an account which already exists and get the error code from the
+ * text of the unique violation, as a baseline
+ */
+BENCHMARK_DEFINE_F(CommandExecutorBenchmark, CreateExistingAccountParsed)
+(benchmark::State &st) {
+  if (not sql) {
+    return;
+  }
+  const std::string query =
+      "INSERT INTO account(account_id, domain_id, quorum, data) VALUES ('"
+      + kAccountId + "', '" + kDomain + "', 1, '{}')";
+  while (st.KeepRunning()) {
+    uint32_t code = 0;
+    try {
+      *sql << query;
+    } catch (const std::exception &e) {
+      const std::string error = e.what();
+      code = error.find("Key (account_id)=") != std::string::npos
+              and error.find("already exists") != std::string::npos
+          ? 4
+          : 1;
+    }
+    benchmark::DoNotOptimize(code);
+  }
+}
+
+BENCHMARK_REGISTER_F(CommandExecutorBenchmark, CreateExistingAccountParsed)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,219 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Transactions of a proposal, which do not touch the same accounts, can be
+ * statefully validated in parallel, each group in its own temporary WSV.
+ *
+ * The purpose of this benchmark is to measure the time of validation of a
+ * proposal with transfers between distinct pairs of accounts depending on
+ * the number of workers and the percentage of transfers to a single shared
+ * account, which are conflicting and validated sequentially. Requires a
+ * running PostgreSQL, see getPostgresCredsOrDefault.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "ametsuchi/mutable_storage.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "backend/protobuf/proto_proposal_factory.hpp"
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "datetime/time.hpp"
+#include "framework/config_helper.hpp"
+#include "interfaces/iroha_internal/transaction_batch_parser_impl.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_proposal_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+#include "validation/impl/stateful_validator_impl.hpp"
+#include "validators/field_validator.hpp"
+
+using namespace iroha::ametsuchi;
+
+/// number of transfers in a proposal
+constexpr int kProposalSize = 500;
+
+const std::string kDomain = "bench";
+const std::string kAssetId = "coin#" + kDomain;
+const std::string kSharedAccountId = "shared@" + kDomain;
+
+std::string accountId(int i) {
+  return "user" + std::to_string(i) + "@" + kDomain;
+}
+
+class StatefulValidationBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    const auto dbname = "d"
+        + boost::uuids::to_string(boost::uuids::random_generator()())
+              .substr(0, 8);
+    const auto pgopt = "dbname=" + dbname + " "
+        + integration_framework::getPostgresCredsOrDefault();
+    StorageImpl::create(
+        block_store_path,
+        pgopt,
+        std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+            shared_model::validation::FieldValidator>>(),
+        std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+        std::make_shared<shared_model::proto::ProtoPermissionToString>())
+        .match(
+            [&](iroha::expected::Value<std::shared_ptr<StorageImpl>> &v) {
+              storage = v.value;
+            },
+            [&](iroha::expected::Error<std::string> &e) {
+              st.SkipWithError(e.error.c_str());
+            });
+    if (storage) {
+      applyGenesis();
+    }
+  }
+
+  void TearDown(benchmark::State &) override {
+    if (storage) {
+      storage->dropStorage();
+    }
+    boost::filesystem::remove_all(block_store_path);
+  }
+
+  /**
+   * Create senders with balances and receivers of transfers
+   */
+  void applyGenesis() {
+    using shared_model::interface::permissions::Role;
+    std::vector<shared_model::proto::Transaction> txs;
+    txs.push_back(TestTransactionBuilder()
+                      .creatorAccountId(kSharedAccountId)
+                      .createRole("user", {Role::kTransfer, Role::kReceive})
+                      .createDomain(kDomain, "user")
+                      .createAsset("coin", kDomain, 2)
+                      .createAccount("shared", kDomain, keypair.publicKey())
+                      .build());
+    for (int i = 0; i < kProposalSize; i++) {
+      txs.push_back(
+          TestTransactionBuilder()
+              .creatorAccountId(accountId(2 * i))
+              .createAccount(
+                  "user" + std::to_string(2 * i), kDomain, keypair.publicKey())
+              .createAccount("user" + std::to_string(2 * i + 1),
+                             kDomain,
+                             keypair.publicKey())
+              .addAssetQuantity(kAssetId, "100.00")
+              .build());
+    }
+    auto block = TestBlockBuilder()
+                     .height(1)
+                     .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+                     .createdTime(iroha::time::now())
+                     .transactions(txs)
+                     .build();
+
+    auto mutable_storage = storage->createMutableStorage();
+    if (auto e = boost::get<iroha::expected::Error<std::string>>(
+            &mutable_storage)) {
+      throw std::runtime_error(e->error);
+    }
+    auto &value = boost::get<
+        iroha::expected::Value<std::unique_ptr<MutableStorage>>>(
+        mutable_storage);
+    value.value->apply(block);
+    storage->commit(std::move(value.value));
+  }
+
+  /**
+   * @return proposal with transfers between distinct pairs of accounts, given
+   * percentage of them is made to the same account
+   */
+  shared_model::proto::Proposal makeProposal(int conflict_percent) {
+    const auto now = iroha::time::now();
+    std::vector<shared_model::proto::Transaction> txs;
+    for (int i = 0; i < kProposalSize; i++) {
+      const auto destination = i * 100 < conflict_percent * kProposalSize
+          ? kSharedAccountId
+          : accountId(2 * i + 1);
+      txs.push_back(TestUnsignedTransactionBuilder()
+                        .creatorAccountId(accountId(2 * i))
+                        .createdTime(now + i)
+                        .quorum(1)
+                        .transferAsset(accountId(2 * i),
+                                       destination,
+                                       kAssetId,
+                                       "",
+                                       "1.00")
+                        .build()
+                        .signAndAddSignature(keypair)
+                        .finish());
+    }
+    return TestProposalBuilder()
+        .height(2)
+        .createdTime(now)
+        .transactions(txs)
+        .build();
+  }
+
+  std::string block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+  shared_model::crypto::Keypair keypair =
+      shared_model::crypto::DefaultCryptoAlgorithmType::generateKeypair();
+  std::shared_ptr<StorageImpl> storage;
+};
+
+/**
+ * Validate a proposal in a new temporary WSV, which is created and rolled
+ * back outside of measured time
+ */
+BENCHMARK_DEFINE_F(StatefulValidationBenchmark, Validate)
+(benchmark::State &st) {
+  if (not storage) {
+    return;
+  }
+  const auto proposal = makeProposal(st.range(0));
+  iroha::validation::StatefulValidatorImpl validator(
+      std::make_unique<shared_model::proto::ProtoProposalFactory<
+          shared_model::validation::DefaultProposalValidator>>(),
+      std::make_shared<shared_model::interface::TransactionBatchParserImpl>(),
+      storage,
+      st.range(1));
+  while (st.KeepRunning()) {
+    st.PauseTiming();
+    auto wsv = std::move(
+        boost::get<iroha::expected::Value<std::unique_ptr<TemporaryWsv>>>(
+            storage->createTemporaryWsv())
+            .value);
+    st.ResumeTiming();
+
+    auto result = validator.validate(proposal, *wsv);
+    benchmark::DoNotOptimize(result);
+
+    st.PauseTiming();
+    wsv.reset();
+    st.ResumeTiming();
+  }
+  st.SetItemsProcessed(st.iterations() * kProposalSize);
+}
+
+/**
+ * Arguments are the percentage of conflicting transfers and the number of
+ * workers, one worker validates sequentially
+ */
+static void conflictsAndWorkers(benchmark::internal::Benchmark *b) {
+  for (auto conflict_percent : {0, 10, 50, 100}) {
+    for (auto workers : {1, 2, 4, 8}) {
+      b->Args({conflict_percent, workers});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(StatefulValidationBenchmark, Validate)
+    ->Apply(conflictsAndWorkers)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Block and WSV queries are requested from storage for every client query,
+ * transaction status request and validation round.
+ *
+ * The purpose of this benchmark is to measure the overhead of a single
+ * request of a query and a single lookup with it, when a new query is
+ * constructed over a checked out connection every time, as storage used to
+ * do, and when queries with their prepared statements are reused by
+ * storage. Requires a running PostgreSQL, see getPostgresCredsOrDefault.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include "ametsuchi/impl/connection_pool.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/postgres_block_query.hpp"
+#include "ametsuchi/impl/postgres_wsv_query.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "framework/config_helper.hpp"
+#include "validators/field_validator.hpp"
+
+using namespace iroha::ametsuchi;
+
+class StorageQueriesBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    const auto dbname = "d"
+        + boost::uuids::to_string(boost::uuids::random_generator()())
+              .substr(0, 8);
+    const auto pgopt = "dbname=" + dbname + " "
+        + integration_framework::getPostgresCredsOrDefault();
+    StorageImpl::create(block_store_path,
+                        pgopt,
+                        factory,
+                        converter,
+                        std::make_shared<
+                            shared_model::proto::ProtoPermissionToString>())
+        .match(
+            [&](iroha::expected::Value<std::shared_ptr<StorageImpl>> &v) {
+              storage = v.value;
+            },
+            [&](iroha::expected::Error<std::string> &e) {
+              st.SkipWithError(e.error.c_str());
+            });
+    if (not storage) {
+      return;
+    }
+    ConnectionPool::create("benchmark", 1, std::chrono::seconds(10), pgopt)
+        .match(
+            [&](iroha::expected::Value<std::shared_ptr<ConnectionPool>> &v) {
+              pool = v.value;
+            },
+            [&](iroha::expected::Error<std::string> &e) {
+              st.SkipWithError(e.error.c_str());
+            });
+    block_store = std::move(*FlatFile::create(query_block_store_path));
+  }
+
+  void TearDown(benchmark::State &) override {
+    if (pool) {
+      pool->close();
+      pool.reset();
+    }
+    if (storage) {
+      storage->dropStorage();
+      storage.reset();
+    }
+    block_store.reset();
+    boost::filesystem::remove_all(block_store_path);
+    boost::filesystem::remove_all(query_block_store_path);
+  }
+
+  /**
+   * @return session checked out from the benchmark pool
+   */
+  std::unique_ptr<soci::session> checkout() {
+    return std::move(boost::get<iroha::expected::Value<
+                         std::unique_ptr<soci::session>>>(pool->checkout())
+                         .value);
+  }
+
+  std::string block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+  /// block store of queries constructed by the benchmark
+  std::string query_block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+  std::shared_ptr<shared_model::proto::ProtoCommonObjectsFactory<
+      shared_model::validation::FieldValidator>>
+      factory = std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+          shared_model::validation::FieldValidator>>();
+  std::shared_ptr<shared_model::proto::ProtoBlockJsonConverter> converter =
+      std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+  std::shared_ptr<StorageImpl> storage;
+  std::shared_ptr<ConnectionPool> pool;
+  std::unique_ptr<KeyValueStorage> block_store;
+  const shared_model::crypto::Hash hash{std::string(32, '1')};
+};
+
+/**
+ * New block query over a checked out connection for every lookup
+ */
+BENCHMARK_F(StorageQueriesBenchmark, TxPresenceNewQuery)
+(benchmark::State &st) {
+  if (not pool) {
+    return;
+  }
+  while (st.KeepRunning()) {
+    PostgresBlockQuery block_query(checkout(), *block_store, converter);
+    benchmark::DoNotOptimize(block_query.checkTxPresence(hash));
+  }
+}
+
+/**
+ * Block query requested from storage for every lookup
+ */
+BENCHMARK_F(StorageQueriesBenchmark, TxPresenceStorageQuery)
+(benchmark::State &st) {
+  if (not pool) {
+    return;
+  }
+  while (st.KeepRunning()) {
+    auto block_query = storage->getBlockQuery();
+    benchmark::DoNotOptimize(block_query->checkTxPresence(hash));
+  }
+}
+
+/**
+ * New WSV query over a checked out connection for every lookup
+ */
+BENCHMARK_F(StorageQueriesBenchmark, PeersNewQuery)(benchmark::State &st) {
+  if (not pool) {
+    return;
+  }
+  while (st.KeepRunning()) {
+    PostgresWsvQuery wsv_query(checkout(), factory);
+    benchmark::DoNotOptimize(wsv_query.getPeers());
+  }
+}
+
+/**
+ * WSV query requested from storage for every lookup
+ */
+BENCHMARK_F(StorageQueriesBenchmark, PeersStorageQuery)
+(benchmark::State &st) {
+  if (not pool) {
+    return;
+  }
+  while (st.KeepRunning()) {
+    auto wsv_query = storage->getWsvQuery();
+    benchmark::DoNotOptimize(wsv_query->getPeers());
+  }
+}
+
+BENCHMARK_MAIN();
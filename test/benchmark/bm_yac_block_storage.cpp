@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Consensus thread checks every incoming vote against the votes already
+ * stored for the same block, and large networks have hundreds of peers.
+ *
+ * The purpose of this benchmark is to measure the cost of collecting votes
+ * of all peers for a block, one by one as they come from peers, and as a
+ * bundle propagated by a peer which has collected the outcome.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "backend/protobuf/common_objects/signature.hpp"
+#include "consensus/yac/storage/yac_block_storage.hpp"
+
+using namespace iroha::consensus::yac;
+
+class YacBlockStorageBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    for (int i = 0; i < st.range(0); ++i) {
+      iroha::protocol::Signature signature;
+      auto public_key = std::to_string(i);
+      public_key.resize(32, 'k');
+      signature.set_public_key(public_key);
+      signature.set_signature(std::string(64, 's'));
+
+      VoteMessage vote;
+      vote.hash = hash;
+      vote.signature =
+          std::make_shared<shared_model::proto::Signature>(signature);
+      votes.push_back(std::move(vote));
+    }
+  }
+
+  void TearDown(benchmark::State &st) override {
+    votes.clear();
+  }
+
+  YacHash hash{iroha::consensus::Round{1, 0}, "proposal", "block"};
+  std::vector<VoteMessage> votes;
+};
+
+/**
+ * Votes inserted one by one
+ */
+BENCHMARK_DEFINE_F(YacBlockStorageBenchmark, VoteByVote)
+(benchmark::State &st) {
+  while (st.KeepRunning()) {
+    YacBlockStorage storage(hash, votes.size());
+    for (const auto &vote : votes) {
+      benchmark::DoNotOptimize(storage.insert(vote));
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * votes.size());
+}
+
+/**
+ * Votes inserted as a single bundle
+ */
+BENCHMARK_DEFINE_F(YacBlockStorageBenchmark, Bundle)(benchmark::State &st) {
+  while (st.KeepRunning()) {
+    YacBlockStorage storage(hash, votes.size());
+    benchmark::DoNotOptimize(storage.insert(votes));
+  }
+  st.SetItemsProcessed(st.iterations() * votes.size());
+}
+
+BENCHMARK_REGISTER_F(YacBlockStorageBenchmark, VoteByVote)
+    ->Arg(4)
+    ->Arg(50)
+    ->Arg(200)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(YacBlockStorageBenchmark, Bundle)
+    ->Arg(4)
+    ->Arg(50)
+    ->Arg(200)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
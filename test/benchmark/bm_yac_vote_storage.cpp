@@ -0,0 +1,107 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Consensus stores votes of every round a peer takes part in, and a peer
+ * runs for weeks.
+ *
+ * The purpose of this benchmark is to check that the cost of storing a vote
+ * does not depend on the number of rounds passed before, with old rounds
+ * dropped and with all of them kept.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <limits>
+
+#include "backend/protobuf/common_objects/signature.hpp"
+#include "consensus/yac/storage/yac_vote_storage.hpp"
+
+using namespace iroha::consensus::yac;
+using iroha::consensus::BlockRoundType;
+using iroha::consensus::Round;
+
+class YacVoteStorageBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    for (PeersNumberType i = 0; i < kPeers; ++i) {
+      iroha::protocol::Signature signature;
+      signature.set_public_key(std::string(32, 'a' + i));
+      signature.set_signature(std::string(64, 's'));
+      signatures.push_back(
+          std::make_shared<shared_model::proto::Signature>(signature));
+    }
+
+    storage = std::make_unique<YacVoteStorage>(
+        st.range(1) == 0 ? std::numeric_limits<BlockRoundType>::max()
+                         : st.range(1));
+    for (round = 1; round <= static_cast<BlockRoundType>(st.range(0));
+         ++round) {
+      commitRound();
+    }
+  }
+
+  void TearDown(benchmark::State &st) override {
+    storage.reset();
+    signatures.clear();
+  }
+
+  /**
+   * Store votes of all peers for the current round one by one, as they
+   * come from the network
+   */
+  void commitRound() {
+    YacHash hash(Round{round, 0}, "proposal", "block");
+    for (const auto &signature : signatures) {
+      VoteMessage vote;
+      vote.hash = hash;
+      vote.signature = signature;
+      storage->store({vote}, kPeers);
+      storage->isCommitted(hash.vote_round);
+    }
+  }
+
+  static constexpr PeersNumberType kPeers = 4;
+  std::vector<std::shared_ptr<shared_model::interface::Signature>>
+      signatures;
+  std::unique_ptr<YacVoteStorage> storage;
+  BlockRoundType round;
+};
+
+/**
+ * Votes of next rounds after the given number of passed rounds
+ */
+BENCHMARK_DEFINE_F(YacVoteStorageBenchmark, StoreVotes)
+(benchmark::State &st) {
+  while (st.KeepRunning()) {
+    commitRound();
+    ++round;
+  }
+  const auto stats = storage->stats();
+  st.SetItemsProcessed(st.iterations() * kPeers);
+  st.counters["rounds"] = stats.rounds;
+  st.counters["votes"] = stats.votes;
+  st.counters["lookup_ns"] = stats.lookups == 0
+      ? 0
+      : stats.lookup_time.count() / static_cast<double>(stats.lookups);
+}
+
+/**
+ * Arguments are the number of passed rounds and the number of kept rounds,
+ * all rounds are kept if zero
+ */
+static void passedAndKeptRounds(benchmark::internal::Benchmark *b) {
+  for (auto passed : {100, 1000, 10000, 100000}) {
+    for (auto kept : {10, 0}) {
+      b->Args({passed, kept});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(YacVoteStorageBenchmark, StoreVotes)
+    ->Apply(passedAndKeptRounds)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -174,6 +174,9 @@ namespace iroha {
       MOCK_METHOD1(checkTxPresence,
                    boost::optional<TxCacheStatusType>(
                        const shared_model::crypto::Hash &));
+      MOCK_METHOD1(checkTxPresence,
+                   boost::optional<std::vector<TxCacheStatusType>>(
+                       const std::vector<shared_model::crypto::Hash> &));
       MOCK_METHOD0(getTopBlockHeight, uint32_t(void));
     };
 
@@ -283,6 +286,9 @@ namespace iroha {
                    bool(const std::vector<
                         std::shared_ptr<shared_model::interface::Block>> &));
       MOCK_METHOD0(reset, void(void));
+      MOCK_METHOD0(resetWsv, void(void));
+      MOCK_METHOD0(loadWsvSnapshot,
+                   shared_model::interface::types::HeightType(void));
       MOCK_METHOD0(dropStorage, void(void));
       MOCK_METHOD0(freeConnections, void(void));
       MOCK_METHOD1(prepareBlock_, void(std::unique_ptr<TemporaryWsv> &));
@@ -354,6 +360,11 @@ namespace iroha {
           check,
           boost::optional<TxPresenceCache::BatchStatusCollectionType>(
               const shared_model::interface::TransactionBatch &));
+
+      MOCK_CONST_METHOD1(
+          check,
+          boost::optional<TxPresenceCache::BatchStatusCollectionType>(
+              const TxPresenceCache::HashCollectionType &));
     };
 
     namespace tx_cache_status_responses {
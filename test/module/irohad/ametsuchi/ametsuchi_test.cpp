@@ -3,12 +3,15 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <future>
+
 #include <gtest/gtest.h>
 
 #include "ametsuchi/impl/postgres_block_query.hpp"
 #include "ametsuchi/impl/postgres_ordering_service_persistent_state.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
 #include "ametsuchi/impl/wsv_restorer_impl.hpp"
+#include "ametsuchi/impl/wsv_snapshot_storage.hpp"
 #include "ametsuchi/mutable_storage.hpp"
 #include "ametsuchi/temporary_wsv.hpp"
 #include "builders/default_builders.hpp"
@@ -620,6 +623,41 @@ TEST_F(AmetsuchiTest, TestingStorageWhenCommitBlock) {
   ASSERT_TRUE(wrapper.validate());
 }
 
+/**
+ * @given storage with committed block
+ * @when another block of the same height is committed
+ * @then it is not reported as committed @and the stored block is kept
+ */
+TEST_F(AmetsuchiTest, CommitBlockOfStoredHeightRejected) {
+  ASSERT_TRUE(storage);
+  auto block = getBlock();
+  auto other_block =
+      TestBlockBuilder()
+          .transactions(std::vector<shared_model::proto::Transaction>{
+              TestTransactionBuilder()
+                  .creatorAccountId("adminone")
+                  .addPeer("192.168.0.0:10002", fake_pubkey)
+                  .build()})
+          .height(1)
+          .prevHash(fake_hash)
+          .build();
+  ASSERT_NE(block.hash(), other_block.hash());
+
+  auto wrapper = make_test_subscriber<CallExact>(storage->on_commit(), 1);
+  wrapper.subscribe([&block](const auto &committed) {
+    EXPECT_EQ(committed->hash(), block.hash());
+  });
+
+  apply(storage, block);
+  apply(storage, other_block);
+
+  auto stored =
+      framework::expected::val(storage->getBlockQuery()->getTopBlock());
+  ASSERT_TRUE(stored);
+  EXPECT_EQ(stored->value->hash(), block.hash());
+  ASSERT_TRUE(wrapper.validate());
+}
+
 /**
  * @given initialized storage
  * @when insert block with 2 transactions in
@@ -817,6 +855,49 @@ TEST_F(AmetsuchiTest, TestRestoreWSV) {
   EXPECT_TRUE(res);
 }
 
+/**
+ * @given WSV snapshot of the genesis block
+ * @when WSV is spoiled and the snapshot is loaded
+ * @then WSV is valid and the snapshot height is reported
+ */
+TEST_F(AmetsuchiTest, TestLoadWsvSnapshot) {
+  std::vector<shared_model::proto::Transaction> genesis_tx;
+  genesis_tx.push_back(
+      shared_model::proto::TransactionBuilder()
+          .creatorAccountId("admin@test")
+          .createdTime(iroha::time::now())
+          .quorum(1)
+          .createRole("admin", {Role::kCreateDomain})
+          .createDomain("test", "admin")
+          .build()
+          .signAndAddSignature(
+              shared_model::crypto::DefaultCryptoAlgorithmType::
+                  generateKeypair())
+          .finish());
+  auto genesis_block = TestBlockBuilder()
+                           .transactions(genesis_tx)
+                           .height(1)
+                           .prevHash(shared_model::crypto::Sha3_256::makeHash(
+                               shared_model::crypto::Blob("")))
+                           .createdTime(iroha::time::now())
+                           .build();
+  apply(storage, genesis_block);
+
+  const auto snapshot_dir = block_store_path + ".snapshots";
+  WsvSnapshotStorage snapshots(snapshot_dir);
+  ASSERT_TRUE(framework::expected::val(
+      snapshots.create(*sql, 1, genesis_block.hash())));
+
+  *sql << "DELETE FROM domain";
+  ASSERT_FALSE(storage->getWsvQuery()->getDomain("test"));
+
+  storage->resetWsv();
+  EXPECT_EQ(storage->loadWsvSnapshot(), 1);
+  EXPECT_TRUE(storage->getWsvQuery()->getDomain("test"));
+
+  boost::filesystem::remove_all(snapshot_dir);
+}
+
 class PreparedBlockTest : public AmetsuchiTest {
  public:
   PreparedBlockTest()
@@ -978,3 +1059,268 @@ TEST_F(PreparedBlockTest, CommitPreparedFailsAfterCommit) {
   validateAccountAsset(
       storage->getWsvQuery(), "admin@test", "coin#test", resultingBalance);
 }
+
+/**
+ * Storage with options of stateful validation set by derived fixtures
+ */
+class ValidationOptionsTest : public PreparedBlockTest {
+ protected:
+  void connect() override {
+    perm_converter_ =
+        std::make_shared<shared_model::proto::ProtoPermissionToString>();
+    StorageImpl::create(
+        block_store_path,
+        pgopt_,
+        factory,
+        std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+        perm_converter_,
+        PoolOptions(),
+        BlockStorageType::kFlatFile,
+        0,
+        pipelined_validation,
+        wsv_cache,
+        async_commit)
+        .match([&](iroha::expected::Value<std::shared_ptr<StorageImpl>>
+                       &_storage) { storage = _storage.value; },
+               [](iroha::expected::Error<std::string> &error) {
+                 FAIL() << "StorageImpl: " << error.error;
+               });
+
+    sql = std::make_shared<soci::session>(soci::postgresql, pgopt_);
+  }
+
+  bool pipelined_validation = false;
+  bool wsv_cache = false;
+  bool async_commit = false;
+};
+
+/**
+ * Storage which sends all statements of a transaction to the database at once
+ */
+class PipelinedTemporaryWsvTest : public ValidationOptionsTest {
+ public:
+  PipelinedTemporaryWsvTest() {
+    pipelined_validation = true;
+  }
+};
+
+/**
+ * @given pipelined TemporaryWSV
+ * @when valid transaction is applied and the state is committed
+ * @then state of the ledger is changed
+ */
+TEST_F(PipelinedTemporaryWsvTest, ValidTransactionApplied) {
+  auto block = createBlock({*initial_tx});
+
+  auto result = temp_wsv->apply(*initial_tx);
+  ASSERT_FALSE(framework::expected::err(result));
+  storage->prepareBlock(std::move(temp_wsv));
+  ASSERT_TRUE(storage->commitPrepared(block));
+
+  validateAccountAsset(storage->getWsvQuery(),
+                       "admin@test",
+                       "coin#test",
+                       shared_model::interface::Amount("10.00"));
+}
+
+/**
+ * @given pipelined TemporaryWSV
+ * @when transaction with failing second command is applied
+ * @then error with index of that command is returned
+ * @and effects of the first command are rolled back
+ */
+TEST_F(PipelinedTemporaryWsvTest, FailedCommandRolledBack) {
+  auto failing_tx = shared_model::proto::TransactionBuilder()
+                        .creatorAccountId("admin@test")
+                        .createdTime(iroha::time::now())
+                        .quorum(1)
+                        .addAssetQuantity("coin#test", "1.00")
+                        .transferAsset("admin@test",
+                                       "nobody@test",
+                                       "coin#test",
+                                       "description",
+                                       "1.00")
+                        .build()
+                        .signAndAddSignature(key)
+                        .finish();
+  auto block = createBlock({*initial_tx});
+
+  auto error = framework::expected::err(temp_wsv->apply(failing_tx));
+  ASSERT_TRUE(error);
+  EXPECT_EQ(error->error.name, "TransferAsset");
+  EXPECT_EQ(error->error.index, 1u);
+  EXPECT_TRUE(error->error.tx_passed_initial_validation);
+
+  ASSERT_FALSE(framework::expected::err(temp_wsv->apply(*initial_tx)));
+  storage->prepareBlock(std::move(temp_wsv));
+  ASSERT_TRUE(storage->commitPrepared(block));
+
+  validateAccountAsset(storage->getWsvQuery(),
+                       "admin@test",
+                       "coin#test",
+                       shared_model::interface::Amount("10.00"));
+}
+
+/**
+ * @given pipelined TemporaryWSV
+ * @when transaction signed with unknown key is applied
+ * @then signatures validation error is returned
+ */
+TEST_F(PipelinedTemporaryWsvTest, InvalidSignatures) {
+  auto tx = shared_model::proto::TransactionBuilder()
+                .creatorAccountId("admin@test")
+                .createdTime(iroha::time::now())
+                .quorum(1)
+                .addAssetQuantity("coin#test", "1.00")
+                .build()
+                .signAndAddSignature(shared_model::crypto::
+                                         DefaultCryptoAlgorithmType::
+                                             generateKeypair())
+                .finish();
+
+  auto error = framework::expected::err(temp_wsv->apply(tx));
+  ASSERT_TRUE(error);
+  EXPECT_EQ(error->error.name, "signatures validation");
+  EXPECT_FALSE(error->error.tx_passed_initial_validation);
+}
+
+/**
+ * Storage which validates transactions with cached WSV entities
+ */
+class WsvCacheTest : public ValidationOptionsTest {
+ public:
+  WsvCacheTest() {
+    wsv_cache = true;
+  }
+
+  /**
+   * Commit block with given transaction on top of genesis block
+   */
+  void commitTransaction(const shared_model::proto::Transaction &tx) {
+    temp_wsv.reset();
+    auto block = TestBlockBuilder()
+                     .transactions(
+                         std::vector<shared_model::proto::Transaction>{tx})
+                     .height(2)
+                     .prevHash(genesis_block->hash())
+                     .createdTime(iroha::time::now())
+                     .build();
+    apply(storage, block);
+  }
+};
+
+/**
+ * @given TemporaryWSV with cache
+ * @when two transactions of the same creator are applied
+ * @then both are applied @and signatories of the second one are taken from
+ * cache
+ */
+TEST_F(WsvCacheTest, SignatoriesCached) {
+  ASSERT_FALSE(framework::expected::err(temp_wsv->apply(*initial_tx)));
+  const auto hits = storage->wsvCache()->hits();
+
+  ASSERT_FALSE(
+      framework::expected::err(temp_wsv->apply(createAddAsset("1.00"))));
+  EXPECT_GT(storage->wsvCache()->hits(), hits);
+}
+
+/**
+ * @given TemporaryWSV with cached signatories of creator
+ * @when block which adds a signatory to creator is committed
+ * @then transaction signed with the new key is valid in a new TemporaryWSV
+ */
+TEST_F(WsvCacheTest, CommittedSignatoryInvalidated) {
+  ASSERT_FALSE(framework::expected::err(temp_wsv->apply(*initial_tx)));
+
+  auto new_key =
+      shared_model::crypto::DefaultCryptoAlgorithmType::generateKeypair();
+  commitTransaction(shared_model::proto::TransactionBuilder()
+                        .creatorAccountId("admin@test")
+                        .createdTime(iroha::time::now())
+                        .quorum(1)
+                        .addSignatory("admin@test", new_key.publicKey())
+                        .build()
+                        .signAndAddSignature(key)
+                        .finish());
+  EXPECT_GT(storage->wsvCache()->invalidations(), 0);
+
+  temp_wsv = std::move(
+      framework::expected::val(storage->createTemporaryWsv())->value);
+  auto tx = shared_model::proto::TransactionBuilder()
+                .creatorAccountId("admin@test")
+                .createdTime(iroha::time::now())
+                .quorum(1)
+                .addAssetQuantity("coin#test", "1.00")
+                .build()
+                .signAndAddSignature(new_key)
+                .finish();
+  EXPECT_FALSE(framework::expected::err(temp_wsv->apply(tx)));
+}
+
+/**
+ * @given TemporaryWSV with cached permissions of creator
+ * @when block which detaches the role of creator is committed
+ * @then command requiring the permission fails in a new TemporaryWSV
+ */
+TEST_F(WsvCacheTest, CommittedPermissionsInvalidated) {
+  ASSERT_FALSE(framework::expected::err(temp_wsv->apply(*initial_tx)));
+
+  commitTransaction(shared_model::proto::TransactionBuilder()
+                        .creatorAccountId("admin@test")
+                        .createdTime(iroha::time::now())
+                        .quorum(1)
+                        .detachRole("admin@test", default_role)
+                        .build()
+                        .signAndAddSignature(key)
+                        .finish());
+
+  temp_wsv = std::move(
+      framework::expected::val(storage->createTemporaryWsv())->value);
+  auto error =
+      framework::expected::err(temp_wsv->apply(createAddAsset("1.00")));
+  ASSERT_TRUE(error);
+  EXPECT_EQ(error->error.error_code, 2);
+}
+
+/**
+ * Storage which writes and indexes committed blocks in background
+ */
+class AsyncCommitTest : public ValidationOptionsTest {
+ public:
+  AsyncCommitTest() {
+    async_commit = true;
+  }
+};
+
+/**
+ * @given storage with commit pipeline
+ * @when block is committed
+ * @then it is the top block right after commit @and its transaction is found
+ * after the block is reported as committed
+ */
+TEST_F(AsyncCommitTest, CommittedBlockReadableAndIndexed) {
+  temp_wsv.reset();
+  auto block =
+      TestBlockBuilder()
+          .transactions(
+              std::vector<shared_model::proto::Transaction>{*initial_tx})
+          .height(2)
+          .prevHash(genesis_block->hash())
+          .createdTime(iroha::time::now())
+          .build();
+  std::promise<void> reported;
+  auto subscription =
+      storage->on_commit().subscribe([&reported](const auto &committed) {
+        if (committed->height() == 2) {
+          reported.set_value();
+        }
+      });
+
+  apply(storage, block);
+  EXPECT_EQ(storage->getBlockQuery()->getTopBlockHeight(), 2);
+
+  ASSERT_EQ(reported.get_future().wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+  subscription.unsubscribe();
+  EXPECT_TRUE(storage->getBlockQuery()->getTxByHashSync(initial_tx->hash()));
+}
@@ -0,0 +1,119 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_cache.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace framework::expected;
+namespace fs = boost::filesystem;
+
+class BlockCacheTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    fs::remove_all(block_store_path);
+  }
+
+  BlockCache::BlockPtr makeBlock(
+      shared_model::interface::types::HeightType height) {
+    std::vector<shared_model::proto::Transaction> txs;
+    txs.push_back(TestTransactionBuilder().creatorAccountId("a@b").build());
+    return clone(TestBlockBuilder()
+                     .height(height)
+                     .transactions(txs)
+                     .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+                     .build());
+  }
+
+  BlockStorageFormat format{
+      std::make_shared<shared_model::proto::ProtoBlockJsonConverter>()};
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+};
+
+/**
+ * @given block cache with a block
+ * @when cached and missing blocks are requested
+ * @then cached block is returned and hits and misses are counted
+ */
+TEST_F(BlockCacheTest, HitsAndMisses) {
+  BlockCache cache(1000);
+  auto block = makeBlock(1);
+  cache.put(block, 100);
+
+  auto cached = cache.get(1);
+  ASSERT_TRUE(cached);
+  EXPECT_EQ(*cached, block);
+  EXPECT_FALSE(cache.get(2));
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.size(), 100);
+}
+
+/**
+ * @given block cache which fits two blocks
+ * @when the first block is used and the third one is put
+ * @then the least recently used second block is evicted
+ */
+TEST_F(BlockCacheTest, EvictsLeastRecentlyUsed) {
+  BlockCache cache(250);
+  cache.put(makeBlock(1), 100);
+  cache.put(makeBlock(2), 100);
+  ASSERT_TRUE(cache.get(1));
+
+  cache.put(makeBlock(3), 100);
+  EXPECT_TRUE(cache.get(1));
+  EXPECT_FALSE(cache.get(2));
+  EXPECT_TRUE(cache.get(3));
+  EXPECT_EQ(cache.size(), 200);
+}
+
+/**
+ * @given block cache
+ * @when block larger than capacity is put
+ * @then it is not cached and other blocks are kept
+ */
+TEST_F(BlockCacheTest, SkipsOversizedBlock) {
+  BlockCache cache(250);
+  cache.put(makeBlock(1), 100);
+  cache.put(makeBlock(2), 300);
+  EXPECT_TRUE(cache.get(1));
+  EXPECT_FALSE(cache.get(2));
+}
+
+/**
+ * @given block store with a block and empty block cache
+ * @when block is loaded twice and cache is cleared
+ * @then block is read from store once and is read again after clear()
+ */
+TEST_F(BlockCacheTest, LoadBlock) {
+  auto store = std::move(*FlatFile::create(block_store_path));
+  auto block = makeBlock(1);
+  ASSERT_TRUE(store->add(1, val(format.serialize(*block))->value));
+  BlockCache cache(1000000);
+
+  auto first = val(loadBlock(1, *store, format, &cache))->value;
+  auto second = val(loadBlock(1, *store, format, &cache))->value;
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first->hash(), block->hash());
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 1);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  auto third = val(loadBlock(1, *store, format, &cache))->value;
+  EXPECT_NE(third, first);
+  EXPECT_EQ(cache.misses(), 2);
+
+  EXPECT_TRUE(err(loadBlock(2, *store, format, &cache)));
+  EXPECT_TRUE(err(loadBlock(2, *store, format, nullptr)));
+}
@@ -0,0 +1,178 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_log/block_log.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+using namespace iroha::ametsuchi;
+namespace fs = boost::filesystem;
+using Identifier = BlockLog::Identifier;
+
+class BlockLogTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    fs::remove_all(block_store_path);
+  }
+
+  std::unique_ptr<BlockLog> create(
+      uint64_t segment_size = BlockLog::kDefaultSegmentSize) {
+    auto store = BlockLog::create(block_store_path, segment_size);
+    EXPECT_TRUE(store);
+    return std::move(*store);
+  }
+
+  /**
+   * @return blob which differs for every id
+   */
+  BlockLog::Bytes blob(Identifier id) {
+    return BlockLog::Bytes(1000 + id, static_cast<uint8_t>(id));
+  }
+
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+};
+
+/**
+ * @given empty block log
+ * @when blobs are added
+ * @then they can be read back and last id is updated
+ */
+TEST_F(BlockLogTest, ReadWrite) {
+  auto store = create();
+  ASSERT_EQ(store->last_id(), 0);
+
+  ASSERT_TRUE(store->add(1, blob(1)));
+  ASSERT_TRUE(store->add(2, blob(2)));
+
+  EXPECT_EQ(store->last_id(), 2);
+  EXPECT_EQ(*store->get(1), blob(1));
+  EXPECT_EQ(*store->get(2), blob(2));
+  EXPECT_FALSE(store->get(0));
+  EXPECT_FALSE(store->get(3));
+  EXPECT_EQ(store->directory(), block_store_path);
+}
+
+/**
+ * @given block log with one blob
+ * @when blob with non-consecutive id is added
+ * @then add() fails
+ */
+TEST_F(BlockLogTest, NonConsecutiveId) {
+  auto store = create();
+  ASSERT_TRUE(store->add(1, blob(1)));
+  EXPECT_FALSE(store->add(1, blob(1)));
+  EXPECT_FALSE(store->add(3, blob(3)));
+  EXPECT_EQ(store->last_id(), 1);
+}
+
+/**
+ * @given segment size smaller than a few blobs
+ * @when many blobs are added and block log is reopened
+ * @then several segments are created and all blobs are readable
+ */
+TEST_F(BlockLogTest, SegmentRollover) {
+  constexpr Identifier kBlobs = 10;
+  {
+    auto store = create(3000);
+    for (Identifier id = 1; id <= kBlobs; ++id) {
+      ASSERT_TRUE(store->add(id, blob(id)));
+    }
+  }
+  EXPECT_TRUE(fs::exists(fs::path(block_store_path)
+                         / BlockLog::segment_name(kBlobs / 2 - 1)));
+
+  auto store = create(3000);
+  ASSERT_EQ(store->last_id(), kBlobs);
+  for (Identifier id = 1; id <= kBlobs; ++id) {
+    EXPECT_EQ(*store->get(id), blob(id));
+  }
+}
+
+/**
+ * @given block log whose index lost its last entries
+ * @when block log is reopened
+ * @then missing entries are restored from the last segment
+ */
+TEST_F(BlockLogTest, ReplayMissingIndexEntries) {
+  {
+    auto store = create();
+    for (Identifier id = 1; id <= 3; ++id) {
+      ASSERT_TRUE(store->add(id, blob(id)));
+    }
+  }
+  fs::resize_file(fs::path(block_store_path) / BlockLog::kIndexFileName,
+                  sizeof(BlockLog::Position) + 3);
+
+  auto store = create();
+  ASSERT_EQ(store->last_id(), 3);
+  EXPECT_EQ(*store->get(2), blob(2));
+  EXPECT_EQ(*store->get(3), blob(3));
+  ASSERT_TRUE(store->add(4, blob(4)));
+}
+
+/**
+ * @given block log whose last record was written partially
+ * @when block log is reopened
+ * @then the broken record is cut off and new blobs can be appended
+ */
+TEST_F(BlockLogTest, CutsPartialRecord) {
+  const auto segment =
+      fs::path(block_store_path) / BlockLog::segment_name(0);
+  {
+    auto store = create();
+    for (Identifier id = 1; id <= 3; ++id) {
+      ASSERT_TRUE(store->add(id, blob(id)));
+    }
+  }
+  fs::resize_file(segment, fs::file_size(segment) - 10);
+
+  auto store = create();
+  ASSERT_EQ(store->last_id(), 2);
+  ASSERT_TRUE(store->add(3, blob(5)));
+  EXPECT_EQ(*store->get(3), blob(5));
+}
+
+/**
+ * @given block log with blobs
+ * @when dropAll() is called
+ * @then block log is empty and accepts blobs starting from the first id
+ */
+TEST_F(BlockLogTest, DropAll) {
+  auto store = create();
+  ASSERT_TRUE(store->add(1, blob(1)));
+  store->dropAll();
+  EXPECT_EQ(store->last_id(), 0);
+  EXPECT_FALSE(store->get(1));
+  ASSERT_TRUE(store->add(1, blob(2)));
+  EXPECT_EQ(*store->get(1), blob(2));
+}
+
+/**
+ * @given block log with blobs in several segments
+ * @when blobs are viewed, including ones appended after the first view
+ * @then views have the same contents as get() and survive dropAll()
+ */
+TEST_F(BlockLogTest, GetView) {
+  auto store = create(3000);
+  ASSERT_TRUE(store->add(1, blob(1)));
+  auto first = store->getView(1);
+  ASSERT_TRUE(first);
+
+  for (Identifier id = 2; id <= 5; ++id) {
+    ASSERT_TRUE(store->add(id, blob(id)));
+  }
+  for (Identifier id = 1; id <= 5; ++id) {
+    auto view = store->getView(id);
+    ASSERT_TRUE(view);
+    EXPECT_EQ(BlockLog::Bytes(view->data, view->data + view->size), blob(id));
+  }
+  EXPECT_FALSE(store->getView(6));
+
+  store->dropAll();
+  EXPECT_EQ(BlockLog::Bytes(first->data, first->data + first->size), blob(1));
+  EXPECT_FALSE(store->getView(1));
+}
@@ -387,6 +387,35 @@ TEST_F(BlockQueryTest, HasTxWithRejectedHash) {
   });
 }
 
+/**
+ * @given block store with preinserted blocks
+ * @when checkTxPresence is invoked on committed, missing and rejected hashes
+ * at once
+ * @then statuses are returned in the order of hashes
+ */
+TEST_F(BlockQueryTest, HasTxWithSeveralHashes) {
+  shared_model::crypto::Hash missing_tx_hash(zero_string);
+  std::vector<shared_model::crypto::Hash> hashes{
+      tx_hashes[2], missing_tx_hash, rejected_hash, tx_hashes[0]};
+  auto statuses = blocks->checkTxPresence(hashes);
+  ASSERT_TRUE(statuses);
+  ASSERT_EQ(4, statuses->size());
+  ASSERT_NO_THROW({
+    auto committed2 =
+        boost::get<tx_cache_status_responses::Committed>(statuses->at(0));
+    ASSERT_EQ(committed2.hash, tx_hashes[2]);
+    auto missing =
+        boost::get<tx_cache_status_responses::Missing>(statuses->at(1));
+    ASSERT_EQ(missing.hash, missing_tx_hash);
+    auto rejected =
+        boost::get<tx_cache_status_responses::Rejected>(statuses->at(2));
+    ASSERT_EQ(rejected.hash, rejected_hash);
+    auto committed0 =
+        boost::get<tx_cache_status_responses::Committed>(statuses->at(3));
+    ASSERT_EQ(committed0.hash, tx_hashes[0]);
+  });
+}
+
 /**
  * @given block store with preinserted blocks
  * @when getTopBlock is invoked on this block store
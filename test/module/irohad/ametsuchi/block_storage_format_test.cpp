@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_storage_format.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "common/byteutils.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace framework::expected;
+namespace fs = boost::filesystem;
+
+class BlockStorageFormatTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    fs::create_directory(block_store_path);
+  }
+
+  void TearDown() override {
+    fs::remove_all(block_store_path);
+  }
+
+  shared_model::proto::Block makeBlock(
+      shared_model::interface::types::HeightType height) {
+    std::vector<shared_model::proto::Transaction> txs;
+    txs.push_back(TestTransactionBuilder().creatorAccountId("a@b").build());
+    return TestBlockBuilder()
+        .height(height)
+        .transactions(txs)
+        .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+        .build();
+  }
+
+  std::string json(const shared_model::interface::Block &block) {
+    return val(converter->serialize(block))->value;
+  }
+
+  std::shared_ptr<shared_model::proto::ProtoBlockJsonConverter> converter =
+      std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+  BlockStorageFormat format{converter};
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+};
+
+/**
+ * @given a block
+ * @when it is serialized in block storage format
+ * @then the record is binary and is deserialized into the same block
+ */
+TEST_F(BlockStorageFormatTest, BinaryRoundTrip) {
+  auto block = makeBlock(1);
+  auto bytes = val(format.serialize(block))->value;
+
+  EXPECT_TRUE(BlockStorageFormat::version(bytes.data(), bytes.size())
+              == BlockStorageFormat::Version::kProtobufV1);
+  auto restored = val(format.deserialize(bytes));
+  ASSERT_TRUE(restored);
+  EXPECT_EQ(*restored->value, block);
+}
+
+/**
+ * @given a block serialized to json by previous versions
+ * @when it is deserialized
+ * @then legacy format is detected and the block is restored
+ */
+TEST_F(BlockStorageFormatTest, ReadsLegacyJson) {
+  auto block = makeBlock(1);
+  auto bytes = iroha::stringToBytes(json(block));
+
+  EXPECT_TRUE(BlockStorageFormat::version(bytes.data(), bytes.size())
+              == BlockStorageFormat::Version::kJson);
+  auto restored = val(format.deserialize(bytes));
+  ASSERT_TRUE(restored);
+  EXPECT_EQ(*restored->value, block);
+}
+
+/**
+ * @given a binary record with unsupported format version
+ * @when it is deserialized
+ * @then an error is returned
+ */
+TEST_F(BlockStorageFormatTest, UnknownVersion) {
+  auto bytes = val(format.serialize(makeBlock(1)))->value;
+  bytes[BlockStorageFormat::kMagic.size()] = 0xFF;
+
+  EXPECT_FALSE(BlockStorageFormat::version(bytes.data(), bytes.size()));
+  EXPECT_TRUE(err(format.deserialize(bytes)));
+}
+
+/**
+ * @given block store filled with json blocks
+ * @when block store is migrated
+ * @then every block is stored in binary format and no temporary directories
+ * are left
+ */
+TEST_F(BlockStorageFormatTest, MigratesJsonStore) {
+  constexpr FlatFile::Identifier kBlocks = 3;
+  std::vector<shared_model::proto::Block> blocks;
+  {
+    auto store = std::move(*FlatFile::create(block_store_path));
+    for (FlatFile::Identifier id = 1; id <= kBlocks; ++id) {
+      blocks.push_back(makeBlock(id));
+      ASSERT_TRUE(store->add(id, iroha::stringToBytes(json(blocks.back()))));
+    }
+  }
+
+  ASSERT_TRUE(val(migrateBlockStore(block_store_path, format)));
+
+  auto store = std::move(*FlatFile::create(block_store_path));
+  ASSERT_EQ(store->last_id(), kBlocks);
+  for (FlatFile::Identifier id = 1; id <= kBlocks; ++id) {
+    auto bytes = store->get(id);
+    ASSERT_TRUE(bytes);
+    EXPECT_TRUE(BlockStorageFormat::version(bytes->data(), bytes->size())
+                == BlockStorageFormat::Version::kProtobufV1);
+    EXPECT_EQ(*val(format.deserialize(*bytes))->value, blocks[id - 1]);
+  }
+  EXPECT_FALSE(fs::exists(block_store_path + ".json"));
+  EXPECT_FALSE(fs::exists(block_store_path + ".migration"));
+}
@@ -0,0 +1,178 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_store_flusher.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/block_log/block_log.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace std::chrono_literals;
+namespace fs = boost::filesystem;
+
+class BlockStoreFlusherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    fs::create_directory(block_store_path);
+  }
+
+  void TearDown() override {
+    fs::remove_all(block_store_path);
+  }
+
+  std::unique_ptr<BlockStoreFlusher> create(SyncMode mode) {
+    options.mode = mode;
+    auto flusher = BlockStoreFlusher::create(block_store_path, options);
+    EXPECT_TRUE(flusher);
+    return std::move(*flusher);
+  }
+
+  /**
+   * @return descriptor of a new file with some data written
+   */
+  int writeFile() {
+    const auto path =
+        fs::path(block_store_path) / std::to_string(files_written++);
+    auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(::write(fd, "block", 5), 5);
+    return fd;
+  }
+
+  /**
+   * Wait until flusher has done given number of syncs
+   * @return true if it has in a second
+   */
+  bool waitSyncs(const BlockStoreFlusher &flusher, uint64_t syncs) {
+    for (int i = 0; i < 1000 and flusher.syncs() < syncs; ++i) {
+      std::this_thread::sleep_for(1ms);
+    }
+    return flusher.syncs() == syncs;
+  }
+
+  SyncOptions options;
+  int files_written = 0;
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+};
+
+/**
+ * @given flusher in block mode
+ * @when blocks are written
+ * @then every block is synced before written() returns
+ */
+TEST_F(BlockStoreFlusherTest, BlockModeSyncsEveryBlock) {
+  auto flusher = create(SyncMode::kBlock);
+  EXPECT_TRUE(flusher->written({writeFile()}, true));
+  EXPECT_EQ(flusher->syncs(), 1);
+  EXPECT_TRUE(flusher->written({writeFile()}, true));
+  EXPECT_EQ(flusher->syncs(), 2);
+  EXPECT_EQ(flusher->failures(), 0);
+}
+
+/**
+ * @given flusher in group mode with long interval and large group
+ * @when blocks are written @and flush is requested
+ * @then all blocks are synced at once @and their files are closed
+ */
+TEST_F(BlockStoreFlusherTest, GroupModeSyncsOnFlush) {
+  options.group_interval = 1h;
+  options.group_blocks = 1000;
+  auto flusher = create(SyncMode::kGroup);
+  std::vector<int> fds;
+  for (int i = 0; i < 10; ++i) {
+    fds.push_back(writeFile());
+    EXPECT_TRUE(flusher->written({fds.back()}, true));
+  }
+  EXPECT_EQ(flusher->syncs(), 0);
+
+  EXPECT_TRUE(flusher->flush());
+  EXPECT_EQ(flusher->syncs(), 1);
+  for (auto fd : fds) {
+    EXPECT_EQ(::fcntl(fd, F_GETFD), -1);
+  }
+}
+
+/**
+ * @given flusher in group mode with long interval
+ * @when as many blocks as the group size are written
+ * @then they are synced without flush
+ */
+TEST_F(BlockStoreFlusherTest, GroupModeSyncsAfterBlockCount) {
+  options.group_interval = 1h;
+  options.group_blocks = 3;
+  auto flusher = create(SyncMode::kGroup);
+  for (int i = 0; i < 3; ++i) {
+    flusher->written({writeFile()}, true);
+  }
+  EXPECT_TRUE(waitSyncs(*flusher, 1));
+}
+
+/**
+ * @given flusher in group mode with large group
+ * @when a block is written
+ * @then it is synced after the group interval
+ */
+TEST_F(BlockStoreFlusherTest, GroupModeSyncsAfterInterval) {
+  options.group_interval = 10ms;
+  options.group_blocks = 1000;
+  auto flusher = create(SyncMode::kGroup);
+  flusher->written({writeFile()}, true);
+  EXPECT_TRUE(waitSyncs(*flusher, 1));
+}
+
+/**
+ * @given flat file and block log which sync every block
+ * @when blocks are added @and the stores are reopened
+ * @then all blocks are readable
+ */
+TEST_F(BlockStoreFlusherTest, StoresWithBlockSync) {
+  options.mode = SyncMode::kBlock;
+  const KeyValueStorage::Bytes blob(100, 42);
+  const auto flat_file_path = (fs::path(block_store_path) / "flat").string();
+  const auto block_log_path = (fs::path(block_store_path) / "log").string();
+  {
+    auto flat_file = std::move(*FlatFile::create(flat_file_path, options));
+    auto block_log = std::move(*BlockLog::create(
+        block_log_path, BlockLog::kDefaultSegmentSize, options));
+    for (KeyValueStorage::Identifier id = 1; id <= 3; ++id) {
+      ASSERT_TRUE(flat_file->add(id, blob));
+      ASSERT_TRUE(block_log->add(id, blob));
+    }
+  }
+
+  auto flat_file = std::move(*FlatFile::create(flat_file_path));
+  auto block_log = std::move(*BlockLog::create(block_log_path));
+  EXPECT_EQ(flat_file->last_id(), 3);
+  EXPECT_EQ(block_log->last_id(), 3);
+  EXPECT_EQ(*flat_file->get(3), blob);
+  EXPECT_EQ(*block_log->get(3), blob);
+}
+
+/**
+ * @given block log which syncs blocks in groups
+ * @when blocks are added @and block log is dropped
+ * @then dropAll() waits for pending syncs @and new blocks are accepted
+ */
+TEST_F(BlockStoreFlusherTest, BlockLogGroupSyncDropAll) {
+  options.mode = SyncMode::kGroup;
+  options.group_interval = 1h;
+  const KeyValueStorage::Bytes blob(100, 42);
+  auto block_log = std::move(*BlockLog::create(
+      block_store_path, BlockLog::kDefaultSegmentSize, options));
+  ASSERT_TRUE(block_log->add(1, blob));
+  ASSERT_TRUE(block_log->add(2, blob));
+
+  block_log->dropAll();
+  EXPECT_EQ(block_log->last_id(), 0);
+  ASSERT_TRUE(block_log->add(1, blob));
+  EXPECT_EQ(*block_log->get(1), blob);
+}
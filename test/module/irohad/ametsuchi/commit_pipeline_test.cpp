@@ -0,0 +1,171 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/commit_pipeline.hpp"
+
+#include <future>
+#include <limits>
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+
+using namespace iroha::ametsuchi;
+namespace fs = boost::filesystem;
+
+class CommitPipelineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto store = std::move(*FlatFile::create(block_store_path));
+    block_store = store.get();
+    pipeline = std::make_unique<CommitPipeline>(
+        std::move(store),
+        [this](const auto &block) {
+          indexed.push_back(block.height());
+          if (block.height() == blocked_height) {
+            index_allowed.get_future().wait();
+          }
+          if (block.height() == failing_height and failing_attempts > 0) {
+            --failing_attempts;
+            return false;
+          }
+          return true;
+        },
+        [this](auto block) { committed.push_back(block->height()); });
+  }
+
+  void TearDown() override {
+    pipeline.reset();
+    fs::remove_all(block_store_path);
+  }
+
+  std::shared_ptr<shared_model::interface::Block> makeBlock(
+      shared_model::interface::types::HeightType height) {
+    return clone(TestBlockBuilder()
+                     .height(height)
+                     .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+                     .build());
+  }
+
+  std::shared_ptr<const KeyValueStorage::Bytes> bytes =
+      std::make_shared<const KeyValueStorage::Bytes>(3, 7);
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+  /// indexing of block at this height waits for index_allowed
+  shared_model::interface::types::HeightType blocked_height = 0;
+  std::promise<void> index_allowed;
+  /// indexing of block at this height fails this many times
+  shared_model::interface::types::HeightType failing_height = 0;
+  int failing_attempts = 0;
+  std::vector<shared_model::interface::types::HeightType> indexed;
+  std::vector<shared_model::interface::types::HeightType> committed;
+  KeyValueStorage *block_store;
+  std::unique_ptr<CommitPipeline> pipeline;
+};
+
+/**
+ * @given commit pipeline blocked on indexing of the first block
+ * @when the second block is pushed
+ * @then the second block is readable from the pipeline before it is written
+ * @and both blocks are written and reported in order after the index is
+ * unblocked
+ */
+TEST_F(CommitPipelineTest, PushedBlockReadableBeforeWritten) {
+  blocked_height = 1;
+  pipeline->push(makeBlock(1), bytes);
+  pipeline->push(makeBlock(2), bytes);
+
+  EXPECT_EQ(pipeline->last_id(), 2);
+  auto pending = pipeline->getView(2);
+  ASSERT_TRUE(pending);
+  EXPECT_EQ(KeyValueStorage::Bytes(pending->data,
+                                   pending->data + pending->size),
+            *bytes);
+  EXPECT_LE(block_store->last_id(), 1);
+
+  index_allowed.set_value();
+  pipeline->flush();
+
+  EXPECT_EQ(block_store->last_id(), 2);
+  EXPECT_EQ(block_store->get(2), *bytes);
+  EXPECT_EQ(indexed, (decltype(indexed){1, 2}));
+  EXPECT_EQ(committed, (decltype(committed){1, 2}));
+  EXPECT_EQ(pipeline->failures(), 0);
+  EXPECT_FALSE(pipeline->failed());
+}
+
+/**
+ * @given commit pipeline
+ * @when a block already in block store is pushed without bytes
+ * @then it is only indexed and reported
+ */
+TEST_F(CommitPipelineTest, StoredBlockOnlyIndexed) {
+  ASSERT_TRUE(block_store->add(1, *bytes));
+  pipeline->push(makeBlock(1), nullptr);
+  pipeline->flush();
+
+  EXPECT_EQ(block_store->last_id(), 1);
+  EXPECT_EQ(indexed, (decltype(indexed){1}));
+  EXPECT_EQ(committed, (decltype(committed){1}));
+}
+
+/**
+ * @given commit pipeline
+ * @when a pushed block cannot be written to block store
+ * @then the pipeline is failed and does not write the next block
+ * @and neither block is reported, but both stay readable
+ */
+TEST_F(CommitPipelineTest, FailedWriteStopsPipeline) {
+  // block store accepts only the block following its top one
+  pipeline->push(makeBlock(2), bytes);
+  pipeline->push(makeBlock(3), bytes);
+  pipeline->flush();
+
+  EXPECT_TRUE(pipeline->failed());
+  EXPECT_EQ(pipeline->failures(), 2);
+  EXPECT_EQ(block_store->last_id(), 0);
+  EXPECT_TRUE(indexed.empty());
+  EXPECT_TRUE(committed.empty());
+  EXPECT_EQ(pipeline->get(3), *bytes);
+}
+
+/**
+ * @given commit pipeline
+ * @when indexing of a written block fails once
+ * @then it is indexed again and reported
+ */
+TEST_F(CommitPipelineTest, FailedIndexRetried) {
+  failing_height = 1;
+  failing_attempts = 1;
+  pipeline->push(makeBlock(1), bytes);
+  pipeline->flush();
+
+  EXPECT_EQ(indexed, (decltype(indexed){1, 1}));
+  EXPECT_EQ(committed, (decltype(committed){1}));
+  EXPECT_EQ(pipeline->failures(), 0);
+  EXPECT_FALSE(pipeline->failed());
+}
+
+/**
+ * @given commit pipeline
+ * @when a written block cannot be indexed in any attempt
+ * @then the pipeline is failed and does not write the next block
+ * @and neither block is reported
+ */
+TEST_F(CommitPipelineTest, FailedIndexStopsPipeline) {
+  failing_height = 1;
+  failing_attempts = std::numeric_limits<int>::max();
+  pipeline->push(makeBlock(1), bytes);
+  pipeline->push(makeBlock(2), bytes);
+  pipeline->flush();
+
+  EXPECT_TRUE(pipeline->failed());
+  EXPECT_EQ(pipeline->failures(), 2);
+  EXPECT_EQ(block_store->last_id(), 1);
+  EXPECT_EQ(indexed, (decltype(indexed){1, 1, 1}));
+  EXPECT_TRUE(committed.empty());
+  EXPECT_EQ(pipeline->get(2), *bytes);
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/connection_pool.hpp"
+
+#include <numeric>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "framework/config_helper.hpp"
+#include "framework/result_fixture.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace std::chrono_literals;
+
+class ConnectionPoolTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ConnectionPool> createPool(size_t size) {
+    auto pool = framework::expected::val(ConnectionPool::create(
+        "test",
+        size,
+        timeout,
+        integration_framework::getPostgresCredsOrDefault()));
+    return pool ? pool->value : nullptr;
+  }
+
+  /**
+   * @return total number of recorded waits
+   */
+  uint64_t waits(const ConnectionPool &pool) {
+    auto counts = pool.waitHistogram().counts();
+    return std::accumulate(counts.begin(), counts.end(), uint64_t(0));
+  }
+
+  std::chrono::milliseconds timeout = 100ms;
+};
+
+/**
+ * @given histogram of waits
+ * @when waits of different durations are recorded
+ * @then each is counted in the bucket of its duration
+ */
+TEST(WaitHistogramTest, WaitsCountedInBuckets) {
+  WaitHistogram histogram;
+  histogram.record(10us);
+  histogram.record(99us);
+  histogram.record(100us);
+  histogram.record(50ms);
+  histogram.record(5s);
+
+  std::array<uint64_t, WaitHistogram::kBuckets> expected{{2, 1, 0, 1, 0, 1}};
+  EXPECT_EQ(histogram.counts(), expected);
+  EXPECT_EQ(histogram.toString(),
+            "<0.1ms: 2, <1ms: 1, <10ms: 0, <100ms: 1, <1000ms: 0, >=1000ms: 1");
+}
+
+/**
+ * @given options of a database which does not accept connections
+ * @when pool is created
+ * @then an error is returned instead of an exception
+ */
+TEST(ConnectionPoolCreateTest, UnreachableDatabaseFails) {
+  auto result = ConnectionPool::create(
+      "test", 1, 100ms, "host=localhost port=1 connect_timeout=1");
+  EXPECT_TRUE(framework::expected::err(result));
+}
+
+/**
+ * @given pool with a single connection
+ * @when connection is checked out twice in turn
+ * @then both sessions can execute queries @and both waits are recorded
+ */
+TEST_F(ConnectionPoolTest, ConnectionReused) {
+  auto pool = createPool(1);
+  ASSERT_TRUE(pool);
+
+  for (int i = 0; i < 2; ++i) {
+    auto sql = framework::expected::val(pool->checkout());
+    ASSERT_TRUE(sql);
+    int one = 0;
+    *sql->value << "SELECT 1", soci::into(one);
+    EXPECT_EQ(one, 1);
+  }
+  EXPECT_EQ(waits(*pool), 2);
+  EXPECT_EQ(pool->timeouts(), 0);
+}
+
+/**
+ * @given pool with all connections checked out
+ * @when another connection is checked out
+ * @then checkout fails after the timeout @and the timeout is counted
+ */
+TEST_F(ConnectionPoolTest, CheckoutTimesOut) {
+  auto pool = createPool(1);
+  ASSERT_TRUE(pool);
+  auto sql = framework::expected::val(pool->checkout());
+  ASSERT_TRUE(sql);
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(framework::expected::err(pool->checkout()));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, timeout);
+  EXPECT_EQ(pool->timeouts(), 1);
+  EXPECT_EQ(waits(*pool), 1);
+}
+
+/**
+ * @given pool with all connections checked out
+ * @when a connection is returned while another checkout waits
+ * @then the waiting checkout gets it
+ */
+TEST_F(ConnectionPoolTest, WaitingCheckoutGetsReturnedConnection) {
+  timeout = 10s;
+  auto pool = createPool(1);
+  ASSERT_TRUE(pool);
+  auto sql = std::move(framework::expected::val(pool->checkout())->value);
+
+  std::thread release([&sql] {
+    std::this_thread::sleep_for(50ms);
+    sql.reset();
+  });
+  EXPECT_TRUE(framework::expected::val(pool->checkout()));
+  release.join();
+  EXPECT_EQ(pool->timeouts(), 0);
+}
@@ -228,3 +228,21 @@ TEST_F(BlStore_Test, WriteDeniedFolder) {
   auto res = bl_store->add(id, block);
   ASSERT_FALSE(res);
 }
+
+/**
+ * @given block store with an entry
+ * @when entry is viewed and the store is dropped
+ * @then view has the same contents as get() and stays readable
+ */
+TEST_F(BlStore_Test, GetView) {
+  auto store = FlatFile::create(block_store_path);
+  ASSERT_TRUE(store);
+  auto bl_store = std::move(*store);
+  ASSERT_TRUE(bl_store->add(1u, block));
+
+  auto view = bl_store->getView(1u);
+  ASSERT_TRUE(view);
+  bl_store->dropAll();
+  EXPECT_EQ(std::vector<uint8_t>(view->data, view->data + view->size), block);
+  EXPECT_FALSE(bl_store->getView(1u));
+}
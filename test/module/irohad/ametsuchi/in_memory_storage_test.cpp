@@ -0,0 +1,291 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory/in_memory_storage.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/block_query.hpp"
+#include "ametsuchi/impl/wsv_restorer_impl.hpp"
+#include "ametsuchi/mutable_storage.hpp"
+#include "ametsuchi/temporary_wsv.hpp"
+#include "ametsuchi/wsv_query.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "builders/protobuf/transaction.hpp"
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "datetime/time.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "validators/field_validator.hpp"
+
+using namespace iroha::ametsuchi;
+using shared_model::interface::permissions::Role;
+
+class InMemoryStorageTest : public ::testing::Test {
+ public:
+  InMemoryStorageTest()
+      : key(shared_model::crypto::DefaultCryptoAlgorithmType::
+                generateKeypair()) {}
+
+  void SetUp() override {
+    ASSERT_FALSE(boost::filesystem::exists(block_store_path));
+    storage = createStorage();
+    ASSERT_TRUE(storage);
+
+    genesis_block = createBlock(
+        1,
+        shared_model::crypto::Sha3_256::makeHash(
+            shared_model::crypto::Blob("")),
+        {signedTx(shared_model::proto::TransactionBuilder()
+                      .creatorAccountId("admin@test")
+                      .createdTime(iroha::time::now())
+                      .quorum(1)
+                      .createRole("admin",
+                                  {Role::kCreateDomain,
+                                   Role::kCreateAccount,
+                                   Role::kAddAssetQty,
+                                   Role::kReceive,
+                                   Role::kTransfer,
+                                   Role::kSetDetail,
+                                   Role::kGetMyAccount})
+                      .createDomain("test", "admin")
+                      .createAccount("admin", "test", key.publicKey())
+                      .createAsset("coin", "test", 2)
+                      .addAssetQuantity("coin#test", "5.00")
+                      .setAccountDetail("admin@test", "key", "value"))});
+    commit(*genesis_block);
+  }
+
+  void TearDown() override {
+    storage->dropStorage();
+    boost::filesystem::remove_all(block_store_path);
+  }
+
+  std::shared_ptr<InMemoryStorage> createStorage() {
+    std::shared_ptr<InMemoryStorage> result;
+    InMemoryStorage::create(
+        block_store_path,
+        std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+            shared_model::validation::FieldValidator>>(),
+        std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+        std::make_shared<shared_model::proto::ProtoPermissionToString>())
+        .match(
+            [&](iroha::expected::Value<std::shared_ptr<InMemoryStorage>>
+                    &_storage) { result = _storage.value; },
+            [](iroha::expected::Error<std::string> &error) {
+              FAIL() << "InMemoryStorage: " << error.error;
+            });
+    return result;
+  }
+
+  template <typename Builder>
+  shared_model::proto::Transaction signedTx(Builder &&builder) {
+    return builder.build().signAndAddSignature(key).finish();
+  }
+
+  shared_model::proto::Transaction addAsset(const std::string &amount) {
+    return signedTx(shared_model::proto::TransactionBuilder()
+                        .creatorAccountId("admin@test")
+                        .createdTime(iroha::time::now())
+                        .quorum(1)
+                        .addAssetQuantity("coin#test", amount));
+  }
+
+  std::unique_ptr<shared_model::proto::Block> createBlock(
+      shared_model::interface::types::HeightType height,
+      const shared_model::crypto::Hash &prev_hash,
+      std::vector<shared_model::proto::Transaction> txs) {
+    return clone(TestBlockBuilder()
+                     .transactions(txs)
+                     .height(height)
+                     .prevHash(prev_hash)
+                     .createdTime(iroha::time::now())
+                     .build());
+  }
+
+  void commit(const shared_model::interface::Block &block) {
+    auto ms = std::move(
+        framework::expected::val(storage->createMutableStorage())->value);
+    ASSERT_TRUE(ms->apply(block));
+    storage->commit(std::move(ms));
+  }
+
+  std::unique_ptr<TemporaryWsv> temporaryWsv() {
+    return std::move(
+        framework::expected::val(storage->createTemporaryWsv())->value);
+  }
+
+  void checkBalance(const std::string &balance) {
+    auto account_asset =
+        storage->getWsvQuery()->getAccountAsset("admin@test", "coin#test");
+    ASSERT_TRUE(account_asset);
+    EXPECT_EQ((*account_asset)->balance().toStringRepr(), balance);
+  }
+
+  std::string block_store_path = (boost::filesystem::temp_directory_path()
+                                  / boost::filesystem::unique_path())
+                                     .string();
+  shared_model::crypto::Keypair key;
+  std::shared_ptr<InMemoryStorage> storage;
+  std::unique_ptr<shared_model::proto::Block> genesis_block;
+};
+
+/**
+ * @given storage with committed genesis block
+ * @when WSV and blocks are queried
+ * @then state created by the block and the block itself are returned
+ */
+TEST_F(InMemoryStorageTest, CommittedBlockQueried) {
+  auto wsv = storage->getWsvQuery();
+  auto account = wsv->getAccount("admin@test");
+  ASSERT_TRUE(account);
+  EXPECT_EQ((*account)->domainId(), "test");
+  EXPECT_EQ((*account)->quorum(), 1);
+  EXPECT_EQ(wsv->getAccountDetail("admin@test"),
+            boost::make_optional<std::string>(
+                R"({"admin@test": {"key": "value"}})"));
+  auto roles = wsv->getAccountRoles("admin@test");
+  ASSERT_TRUE(roles);
+  EXPECT_EQ(*roles, std::vector<std::string>{"admin"});
+  checkBalance("5.00");
+
+  auto blocks = storage->getBlockQuery();
+  EXPECT_EQ(blocks->getTopBlockHeight(), 1);
+  EXPECT_EQ(blocks->getAccountTransactions("admin@test").size(), 1);
+  EXPECT_EQ(
+      blocks->getAccountAssetTransactions("admin@test", "coin#test").size(), 1);
+  EXPECT_TRUE(
+      blocks->getTxByHashSync(genesis_block->transactions().begin()->hash()));
+}
+
+/**
+ * @given temporary WSV
+ * @when transaction with failing second command is applied
+ * @then error with index of that command is returned
+ * @and effects of the first command are rolled back
+ */
+TEST_F(InMemoryStorageTest, FailedCommandRolledBack) {
+  auto temp_wsv = temporaryWsv();
+  auto failing_tx = signedTx(
+      shared_model::proto::TransactionBuilder()
+          .creatorAccountId("admin@test")
+          .createdTime(iroha::time::now())
+          .quorum(1)
+          .addAssetQuantity("coin#test", "1.00")
+          .transferAsset(
+              "admin@test", "nobody@test", "coin#test", "description", "1.00"));
+  auto error = framework::expected::err(temp_wsv->apply(failing_tx));
+  ASSERT_TRUE(error);
+  EXPECT_EQ(error->error.name, "TransferAsset");
+  EXPECT_EQ(error->error.index, 1u);
+  EXPECT_TRUE(error->error.tx_passed_initial_validation);
+
+  auto tx = addAsset("5.00");
+  ASSERT_FALSE(framework::expected::err(temp_wsv->apply(tx)));
+  storage->prepareBlock(std::move(temp_wsv));
+  ASSERT_TRUE(
+      storage->commitPrepared(*createBlock(2, genesis_block->hash(), {tx})));
+
+  checkBalance("10.00");
+}
+
+/**
+ * @given temporary WSV
+ * @when transaction signed with unknown key is applied
+ * @then signatures validation error is returned
+ */
+TEST_F(InMemoryStorageTest, InvalidSignatures) {
+  auto tx = shared_model::proto::TransactionBuilder()
+                .creatorAccountId("admin@test")
+                .createdTime(iroha::time::now())
+                .quorum(1)
+                .addAssetQuantity("coin#test", "1.00")
+                .build()
+                .signAndAddSignature(shared_model::crypto::
+                                         DefaultCryptoAlgorithmType::
+                                             generateKeypair())
+                .finish();
+
+  auto error = framework::expected::err(temporaryWsv()->apply(tx));
+  ASSERT_TRUE(error);
+  EXPECT_EQ(error->error.name, "signatures validation");
+  EXPECT_FALSE(error->error.tx_passed_initial_validation);
+}
+
+/**
+ * @given storage with prepared state
+ * @when another block is committed
+ * @then commitPrepared fails @and prepared state is not applied
+ */
+TEST_F(InMemoryStorageTest, CommitPreparedFailsAfterCommit) {
+  auto temp_wsv = temporaryWsv();
+  ASSERT_FALSE(framework::expected::err(temp_wsv->apply(addAsset("5.00"))));
+  storage->prepareBlock(std::move(temp_wsv));
+
+  auto block = createBlock(2, genesis_block->hash(), {addAsset("10.00")});
+  commit(*block);
+
+  EXPECT_FALSE(storage->commitPrepared(*block));
+  checkBalance("15.00");
+}
+
+/**
+ * @given WSV query created before a commit
+ * @when block is committed
+ * @then the query still returns the state it was created with
+ */
+TEST_F(InMemoryStorageTest, QueryWorksOnSnapshot) {
+  auto wsv = storage->getWsvQuery();
+  commit(*createBlock(2, genesis_block->hash(), {addAsset("1.00")}));
+
+  auto account_asset = wsv->getAccountAsset("admin@test", "coin#test");
+  ASSERT_TRUE(account_asset);
+  EXPECT_EQ((*account_asset)->balance().toStringRepr(), "5.00");
+  checkBalance("6.00");
+}
+
+/**
+ * @given storage with committed blocks
+ * @when a new storage is created over the same block store and WSV is
+ * restored
+ * @then the new storage has the same state
+ */
+TEST_F(InMemoryStorageTest, StateRestoredFromBlockStore) {
+  commit(*createBlock(2, genesis_block->hash(), {addAsset("1.00")}));
+  storage.reset();
+
+  storage = createStorage();
+  ASSERT_TRUE(storage);
+  EXPECT_FALSE(storage->getWsvQuery()->getAccount("admin@test"));
+
+  WsvRestorerImpl wsv_restorer;
+  ASSERT_TRUE(framework::expected::val(wsv_restorer.restoreWsv(*storage)));
+
+  checkBalance("6.00");
+  EXPECT_EQ(storage->getBlockQuery()->getTopBlockHeight(), 2);
+  EXPECT_EQ(
+      storage->getBlockQuery()->getAccountTransactions("admin@test").size(), 2);
+}
+
+/**
+ * @given storage with committed genesis block
+ * @when another block of the same height is committed
+ * @then the block is not stored @and the state is not changed
+ */
+TEST_F(InMemoryStorageTest, CommitBlockOfStoredHeightRejected) {
+  auto other_block = createBlock(1,
+                                 shared_model::crypto::Sha3_256::makeHash(
+                                     shared_model::crypto::Blob("")),
+                                 {addAsset("1.00")});
+  commit(*other_block);
+
+  checkBalance("5.00");
+  auto top_block =
+      framework::expected::val(storage->getBlockQuery()->getTopBlock());
+  ASSERT_TRUE(top_block);
+  EXPECT_EQ(top_block->value->hash(), genesis_block->hash());
+}
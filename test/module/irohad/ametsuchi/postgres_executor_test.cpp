@@ -10,6 +10,7 @@
 #include "framework/result_fixture.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/irohad/ametsuchi/wsv_backend_fixture.hpp"
 #include "module/shared_model/builders/protobuf/test_account_builder.hpp"
 #include "module/shared_model/builders/protobuf/test_asset_builder.hpp"
 #include "module/shared_model/builders/protobuf/test_domain_builder.hpp"
@@ -23,7 +24,9 @@ namespace iroha {
 
     using namespace framework::expected;
 
-    class CommandExecutorTest : public AmetsuchiTest {
+    class CommandExecutorTest
+        : public AmetsuchiTest,
+          public ::testing::WithParamInterface<WsvBackend> {
       // TODO [IR-1831] Akvinikym 31.10.18: rework the CommandExecutorTest
      public:
       CommandExecutorTest() {
@@ -51,10 +54,19 @@ namespace iroha {
         auto factory =
             std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
                 shared_model::validation::FieldValidator>>();
-        query = std::make_unique<PostgresWsvQuery>(*sql, factory);
         PostgresCommandExecutor::prepareStatements(*sql);
-        executor =
-            std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+        if (GetParam() == WsvBackend::kInMemory) {
+          in_memory = std::make_unique<InMemoryWsvBackend>(
+              factory,
+              std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+              perm_converter);
+          query = in_memory->getWsvQuery();
+          executor = in_memory->createCommandExecutor();
+        } else {
+          query = std::make_shared<PostgresWsvQuery>(*sql, factory);
+          executor =
+              std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+        }
 
         *sql << init_;
       }
@@ -155,7 +167,8 @@ namespace iroha {
 
       std::unique_ptr<shared_model::interface::Command> command;
 
-      std::unique_ptr<WsvQuery> query;
+      std::unique_ptr<InMemoryWsvBackend> in_memory;
+      std::shared_ptr<WsvQuery> query;
       std::unique_ptr<CommandExecutor> executor;
 
       std::shared_ptr<shared_model::interface::PermissionToString>
@@ -212,7 +225,7 @@ namespace iroha {
      * @when trying to add asset to account
      * @then account asset is successfully added
      */
-    TEST_F(AddAccountAssetTest, Valid) {
+    TEST_P(AddAccountAssetTest, Valid) {
       addAsset();
       addAllPerms();
       ASSERT_TRUE(val(execute(
@@ -238,7 +251,7 @@ namespace iroha {
      * @when trying to add asset to account with a domain permission
      * @then account asset is successfully added
      */
-    TEST_F(AddAccountAssetTest, DomainPermValid) {
+    TEST_P(AddAccountAssetTest, DomainPermValid) {
       addAsset();
       addOnePerm(shared_model::interface::permissions::Role::kAddDomainAssetQty);
       ASSERT_TRUE(val(execute(
@@ -264,7 +277,7 @@ namespace iroha {
    * @when trying to add asset
    * @then account asset is not added
    */
-  TEST_F(AddAccountAssetTest, DomainPermInvalid) {
+  TEST_P(AddAccountAssetTest, DomainPermInvalid) {
     std::unique_ptr<shared_model::interface::Domain> domain2;
     domain2 = clone(
         TestDomainBuilder().domainId("domain2").defaultRole(role).build());
@@ -307,7 +320,7 @@ namespace iroha {
    * @when trying to add account asset without permission
    * @then account asset not added
    */
-    TEST_F(AddAccountAssetTest, NoPerms) {
+    TEST_P(AddAccountAssetTest, NoPerms) {
       addAsset();
       ASSERT_TRUE(val(execute(
           buildCommand(TestTransactionBuilder()
@@ -335,7 +348,7 @@ namespace iroha {
      * @when trying to add account asset with non-existing asset
      * @then account asset fails to be added
      */
-    TEST_F(AddAccountAssetTest, InvalidAsset) {
+    TEST_P(AddAccountAssetTest, InvalidAsset) {
       auto cmd_result = execute(
           buildCommand(TestTransactionBuilder()
                            .addAssetQuantity(asset_id, asset_amount_one_zero)
@@ -352,7 +365,7 @@ namespace iroha {
      * @when trying to add account asset that overflows
      * @then account asset fails to added
      */
-    TEST_F(AddAccountAssetTest, Uint256Overflow) {
+    TEST_P(AddAccountAssetTest, Uint256Overflow) {
       addAsset();
       ASSERT_TRUE(val(
           execute(buildCommand(TestTransactionBuilder()
@@ -396,7 +409,7 @@ namespace iroha {
      * @when trying to add peer
      * @then peer is successfully added
      */
-    TEST_F(AddPeer, Valid) {
+    TEST_P(AddPeer, Valid) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(
           TestTransactionBuilder().addPeer(peer->address(), peer->pubkey())))));
@@ -407,7 +420,7 @@ namespace iroha {
      * @when trying to add peer without perms
      * @then peer is not added
      */
-    TEST_F(AddPeer, NoPerms) {
+    TEST_P(AddPeer, NoPerms) {
       auto cmd_result = execute(buildCommand(
           TestTransactionBuilder().addPeer(peer->address(), peer->pubkey())));
 
@@ -442,7 +455,7 @@ namespace iroha {
      * @when trying to add signatory with role permission
      * @then signatory is successfully added
      */
-    TEST_F(AddSignatory, Valid) {
+    TEST_P(AddSignatory, Valid) {
       addAllPerms();
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().addSignatory(
@@ -458,7 +471,7 @@ namespace iroha {
      * @when trying to add signatory with grantable permission
      * @then signatory is successfully added
      */
-    TEST_F(AddSignatory, ValidGrantablePerms) {
+    TEST_P(AddSignatory, ValidGrantablePerms) {
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().createAccount(
                           "id2",
@@ -486,7 +499,7 @@ namespace iroha {
      * @when trying to add signatory without permissions
      * @then signatory is not added
      */
-    TEST_F(AddSignatory, NoPerms) {
+    TEST_P(AddSignatory, NoPerms) {
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().addSignatory(
               account->accountId(), *pubkey)));
@@ -506,7 +519,7 @@ namespace iroha {
      * same signatory again
      * @then signatory is not added
      */
-    TEST_F(AddSignatory, ExistingPubKey) {
+    TEST_P(AddSignatory, ExistingPubKey) {
       addAllPerms();
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().addSignatory(
@@ -545,7 +558,7 @@ namespace iroha {
      * @when trying to append role
      * @then role is appended
      */
-    TEST_F(AppendRole, Valid) {
+    TEST_P(AppendRole, Valid) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
                                   another_role, role_permissions)),
@@ -563,7 +576,7 @@ namespace iroha {
      * @when trying append role, which does not have any permissions
      * @then role is appended
      */
-    TEST_F(AppendRole, ValidEmptyPerms) {
+    TEST_P(AppendRole, ValidEmptyPerms) {
       addAllPerms();
       ASSERT_TRUE(val(execute(
           buildCommand(TestTransactionBuilder().createRole(another_role, {})),
@@ -582,7 +595,7 @@ namespace iroha {
      * genesis block
      * @then role is appended
      */
-    TEST_F(AppendRole, AccountDoesNotHavePermsGenesis) {
+    TEST_P(AppendRole, AccountDoesNotHavePermsGenesis) {
       role_permissions2.set(
           shared_model::interface::permissions::Role::kRemoveMySignatory);
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
@@ -602,7 +615,7 @@ namespace iroha {
      * @when trying to append role having no permission to do so
      * @then role is not appended
      */
-    TEST_F(AppendRole, NoPerms) {
+    TEST_P(AppendRole, NoPerms) {
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
                                   another_role, role_permissions)),
                               true)));
@@ -624,7 +637,7 @@ namespace iroha {
      * @when trying to append role with perms that creator does not have
      * @then role is not appended
      */
-    TEST_F(AppendRole, NoRolePermsInAccount) {
+    TEST_P(AppendRole, NoRolePermsInAccount) {
       role_permissions2.set(
           shared_model::interface::permissions::Role::kRemoveMySignatory);
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
@@ -643,7 +656,7 @@ namespace iroha {
      * @when trying to append role to non-existing account
      * @then role is not appended
      */
-    TEST_F(AppendRole, NoAccount) {
+    TEST_P(AppendRole, NoAccount) {
       addAllPerms();
       ASSERT_TRUE(val(execute(
           buildCommand(TestTransactionBuilder().createRole(another_role, {})),
@@ -660,7 +673,7 @@ namespace iroha {
      * @when trying to append non-existing role
      * @then role is not appended
      */
-    TEST_F(AppendRole, NoRole) {
+    TEST_P(AppendRole, NoRole) {
       addAllPerms();
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().appendRole(
@@ -708,7 +721,7 @@ namespace iroha {
      * @when trying to create account
      * @then account is created
      */
-    TEST_F(CreateAccount, Valid) {
+    TEST_P(CreateAccount, Valid) {
       addAllPerms();
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().createAccount(
@@ -723,7 +736,7 @@ namespace iroha {
      * @when trying to create account without permission to do so
      * @then account is not created
      */
-    TEST_F(CreateAccount, NoPerms) {
+    TEST_P(CreateAccount, NoPerms) {
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().createAccount(
               account2->accountId(), domain->domainId(), *pubkey)));
@@ -740,7 +753,7 @@ namespace iroha {
      * @when trying to create account
      * @then account is not created
      */
-    TEST_F(CreateAccount, NoDomain) {
+    TEST_P(CreateAccount, NoDomain) {
       addAllPerms();
       auto cmd_result = execute(buildCommand(
           TestTransactionBuilder().createAccount("doge", "domain6", *pubkey)));
@@ -754,7 +767,7 @@ namespace iroha {
      * @when trying to create with an occupied name
      * @then account is not created
      */
-    TEST_F(CreateAccount, NameExists) {
+    TEST_P(CreateAccount, NameExists) {
       addAllPerms();
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().createAccount(
@@ -765,6 +778,35 @@ namespace iroha {
       CHECK_ERROR_CODE_AND_MESSAGE(cmd_result, 4, query_args);
     }
 
+    /**
+     * @given command inside of a database transaction
+     * @when trying to create with an occupied name @and then with a free one
+     * @then error code is returned for the first command without aborting
+     * the transaction @and the second account is created
+     */
+    TEST_P(CreateAccount, NameExistsTransactionNotAborted) {
+      addAllPerms();
+      const bool postgres = GetParam() == WsvBackend::kPostgres;
+      if (postgres) {
+        *sql << "BEGIN";
+      }
+      auto cmd_result =
+          execute(buildCommand(TestTransactionBuilder().createAccount(
+              "id", domain->domainId(), *pubkey)));
+
+      std::vector<std::string> query_args{
+          "id", domain->domainId(), pubkey->hex()};
+      CHECK_ERROR_CODE_AND_MESSAGE(cmd_result, 4, query_args);
+
+      ASSERT_TRUE(
+          val(execute(buildCommand(TestTransactionBuilder().createAccount(
+              "id2", domain->domainId(), *pubkey)))));
+      if (postgres) {
+        *sql << "COMMIT";
+      }
+      ASSERT_TRUE(query->getAccount(account2->accountId()));
+    }
+
     class CreateAsset : public CommandExecutorTest {
      public:
       void SetUp() override {
@@ -780,7 +822,7 @@ namespace iroha {
      * @when trying to create asset
      * @then asset is created
      */
-    TEST_F(CreateAsset, Valid) {
+    TEST_P(CreateAsset, Valid) {
       role_permissions.set(
           shared_model::interface::permissions::Role::kCreateAsset);
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
@@ -811,7 +853,7 @@ namespace iroha {
      * @when trying to create asset without permission
      * @then asset is not created
      */
-    TEST_F(CreateAsset, NoPerms) {
+    TEST_P(CreateAsset, NoPerms) {
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
                                   role, role_permissions)),
                               true)));
@@ -842,7 +884,7 @@ namespace iroha {
      * @when trying to create asset
      * @then asset is not created
      */
-    TEST_F(CreateAsset, NoDomain) {
+    TEST_P(CreateAsset, NoDomain) {
       role_permissions.set(
           shared_model::interface::permissions::Role::kCreateAsset);
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
@@ -868,7 +910,7 @@ namespace iroha {
      * @when trying to create asset with an occupied name
      * @then asset is not created
      */
-    TEST_F(CreateAsset, NameNotUnique) {
+    TEST_P(CreateAsset, NameNotUnique) {
       role_permissions.set(
           shared_model::interface::permissions::Role::kCreateAsset);
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
@@ -919,7 +961,7 @@ namespace iroha {
      * @when trying to create domain
      * @then domain is created
      */
-    TEST_F(CreateDomain, Valid) {
+    TEST_P(CreateDomain, Valid) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(
           TestTransactionBuilder().createDomain(domain2->domainId(), role)))));
@@ -933,7 +975,7 @@ namespace iroha {
      * @when trying to create domain
      * @then domain is not created
      */
-    TEST_F(CreateDomain, NoPerms) {
+    TEST_P(CreateDomain, NoPerms) {
       auto cmd_result = execute(buildCommand(
           TestTransactionBuilder().createDomain(domain2->domainId(), role)));
       auto dom = query->getDomain(domain2->domainId());
@@ -948,7 +990,7 @@ namespace iroha {
      * @when trying to create domain with an occupied name
      * @then domain is not created
      */
-    TEST_F(CreateDomain, NameNotUnique) {
+    TEST_P(CreateDomain, NameNotUnique) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(
           TestTransactionBuilder().createDomain(domain2->domainId(), role)))));
@@ -964,7 +1006,7 @@ namespace iroha {
      * @when trying to create domain
      * @then domain is not created
      */
-    TEST_F(CreateDomain, NoDefaultRole) {
+    TEST_P(CreateDomain, NoDefaultRole) {
       addAllPerms();
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().createDomain(
@@ -999,7 +1041,7 @@ namespace iroha {
      * @when trying to create role
      * @then role is created
      */
-    TEST_F(CreateRole, Valid) {
+    TEST_P(CreateRole, Valid) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
           another_role, role_permissions)))));
@@ -1013,7 +1055,7 @@ namespace iroha {
      * @when trying to create role when creator doesn't have all permissions
      * @then role is not created
      */
-    TEST_F(CreateRole, NoPerms) {
+    TEST_P(CreateRole, NoPerms) {
       role_permissions2.set(
           shared_model::interface::permissions::Role::kRemoveMySignatory);
       auto cmd_result =
@@ -1033,7 +1075,7 @@ namespace iroha {
      * @when trying to create role with an occupied name
      * @then role is not created
      */
-    TEST_F(CreateRole, NameNotUnique) {
+    TEST_P(CreateRole, NameNotUnique) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().createRole(
           another_role, role_permissions)))));
@@ -1077,7 +1119,7 @@ namespace iroha {
      * @when trying to detach role
      * @then role is detached
      */
-    TEST_F(DetachRole, Valid) {
+    TEST_P(DetachRole, Valid) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().detachRole(
           account->accountId(), another_role)))));
@@ -1092,7 +1134,7 @@ namespace iroha {
      * @when trying to detach role without permission
      * @then role is detached
      */
-    TEST_F(DetachRole, NoPerms) {
+    TEST_P(DetachRole, NoPerms) {
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().detachRole(
               account->accountId(), another_role)));
@@ -1111,7 +1153,7 @@ namespace iroha {
      * @when trying to detach role from non-existing account
      * @then correspondent error code is returned
      */
-    TEST_F(DetachRole, NoAccount) {
+    TEST_P(DetachRole, NoAccount) {
       addAllPerms();
       auto cmd_result = execute(buildCommand(
           TestTransactionBuilder().detachRole("doge@noaccount", another_role)));
@@ -1125,7 +1167,7 @@ namespace iroha {
      * @when trying to detach role, which the account does not have
      * @then correspondent error code is returned
      */
-    TEST_F(DetachRole, NoSuchRoleInAccount) {
+    TEST_P(DetachRole, NoSuchRoleInAccount) {
       addAllPerms();
       ASSERT_TRUE(val(execute(buildCommand(TestTransactionBuilder().detachRole(
           account->accountId(), another_role)))));
@@ -1142,7 +1184,7 @@ namespace iroha {
      * @when trying to detach a non-existing role
      * @then correspondent error code is returned
      */
-    TEST_F(DetachRole, NoRole) {
+    TEST_P(DetachRole, NoRole) {
       addAllPerms();
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().detachRole(
@@ -1181,7 +1223,7 @@ namespace iroha {
      * @when trying to grant permission
      * @then permission is granted
      */
-    TEST_F(GrantPermission, Valid) {
+    TEST_P(GrantPermission, Valid) {
       addAllPerms();
       auto perm = shared_model::interface::permissions::Grantable::kSetMyQuorum;
       ASSERT_TRUE(val(
@@ -1198,7 +1240,7 @@ namespace iroha {
      * @when trying to grant permission without permission
      * @then permission is not granted
      */
-    TEST_F(GrantPermission, NoPerms) {
+    TEST_P(GrantPermission, NoPerms) {
       auto perm = shared_model::interface::permissions::Grantable::kSetMyQuorum;
       auto cmd_result =
 
@@ -1219,7 +1261,7 @@ namespace iroha {
      * @when trying to grant permission to non-existent account
      * @then corresponding error code is returned
      */
-    TEST_F(GrantPermission, NoAccount) {
+    TEST_P(GrantPermission, NoAccount) {
       addAllPerms();
       auto perm = shared_model::interface::permissions::Grantable::kSetMyQuorum;
       auto cmd_result =
@@ -1264,7 +1306,7 @@ namespace iroha {
      * @when trying to remove signatory
      * @then signatory is successfully removed
      */
-    TEST_F(RemoveSignatory, Valid) {
+    TEST_P(RemoveSignatory, Valid) {
       addAllPerms();
       shared_model::interface::types::PubkeyType pk(std::string('5', 32));
       ASSERT_TRUE(
@@ -1287,7 +1329,7 @@ namespace iroha {
      * @when trying to remove signatory
      * @then signatory is successfully removed
      */
-    TEST_F(RemoveSignatory, ValidGrantablePerm) {
+    TEST_P(RemoveSignatory, ValidGrantablePerm) {
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().createAccount(
                           "id2", domain->domainId(), *pubkey)),
@@ -1322,7 +1364,7 @@ namespace iroha {
      * @when trying to remove signatory without permission
      * @then signatory is not removed
      */
-    TEST_F(RemoveSignatory, NoPerms) {
+    TEST_P(RemoveSignatory, NoPerms) {
       shared_model::interface::types::PubkeyType pk(std::string('5', 32));
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().addSignatory(
@@ -1348,7 +1390,7 @@ namespace iroha {
      * @when trying to remove signatory from a non existing account
      * @then corresponding error code is returned
      */
-    TEST_F(RemoveSignatory, NoAccount) {
+    TEST_P(RemoveSignatory, NoAccount) {
       addAllPerms();
       shared_model::interface::types::PubkeyType pk(std::string('5', 32));
       ASSERT_TRUE(
@@ -1368,7 +1410,7 @@ namespace iroha {
      * @when trying to remove signatory, which is not attached to this account
      * @then corresponding error code is returned
      */
-    TEST_F(RemoveSignatory, NoSuchSignatory) {
+    TEST_P(RemoveSignatory, NoSuchSignatory) {
       addAllPerms();
       shared_model::interface::types::PubkeyType pk(std::string('5', 32));
       ASSERT_TRUE(
@@ -1399,7 +1441,7 @@ namespace iroha {
      * have signatories less, than its quorum
      * @then signatory is not removed
      */
-    TEST_F(RemoveSignatory, SignatoriesLessThanQuorum) {
+    TEST_P(RemoveSignatory, SignatoriesLessThanQuorum) {
       addAllPerms();
       shared_model::interface::types::PubkeyType pk(std::string('5', 32));
       ASSERT_TRUE(
@@ -1446,7 +1488,7 @@ namespace iroha {
      * @when trying to revoke permission
      * @then permission is revoked
      */
-    TEST_F(RevokePermission, Valid) {
+    TEST_P(RevokePermission, Valid) {
       auto perm =
           shared_model::interface::permissions::Grantable::kRemoveMySignatory;
       ASSERT_TRUE(query->hasAccountGrantablePermission(
@@ -1481,7 +1523,7 @@ namespace iroha {
      * @when trying to revoke permission without permission
      * @then permission is revoked
      */
-    TEST_F(RevokePermission, NoPerms) {
+    TEST_P(RevokePermission, NoPerms) {
       auto perm =
           shared_model::interface::permissions::Grantable::kRemoveMySignatory;
       auto cmd_result =
@@ -1532,7 +1574,7 @@ namespace iroha {
      * @when trying to set kv
      * @then kv is set
      */
-    TEST_F(SetAccountDetail, Valid) {
+    TEST_P(SetAccountDetail, Valid) {
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().setAccountDetail(
               account->accountId(), "key", "value")))));
@@ -1541,12 +1583,27 @@ namespace iroha {
       ASSERT_EQ(kv.get(), "{\"id@domain\": {\"key\": \"value\"}}");
     }
 
+    /**
+     * @given command with value containing a single quote
+     * @when trying to set kv
+     * @then kv is set with value unchanged, since parameters are bound and not
+     * formatted into the query
+     */
+    TEST_P(SetAccountDetail, ValueWithQuote) {
+      ASSERT_TRUE(
+          val(execute(buildCommand(TestTransactionBuilder().setAccountDetail(
+              account->accountId(), "key", "it's")))));
+      auto kv = query->getAccountDetail(account->accountId());
+      ASSERT_TRUE(kv);
+      ASSERT_EQ(kv.get(), "{\"id@domain\": {\"key\": \"it's\"}}");
+    }
+
     /**
      * @given command
      * @when trying to set kv when has grantable permission
      * @then kv is set
      */
-    TEST_F(SetAccountDetail, ValidGrantablePerm) {
+    TEST_P(SetAccountDetail, ValidGrantablePerm) {
       auto perm =
           shared_model::interface::permissions::Grantable::kSetMyAccountDetail;
       ASSERT_TRUE(
@@ -1569,7 +1626,7 @@ namespace iroha {
      * @when trying to set kv when has role permission
      * @then kv is set
      */
-    TEST_F(SetAccountDetail, ValidRolePerm) {
+    TEST_P(SetAccountDetail, ValidRolePerm) {
       addAllPerms();
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().setAccountDetail(
@@ -1586,7 +1643,7 @@ namespace iroha {
      * @when trying to set kv while having no permissions
      * @then corresponding error code is returned
      */
-    TEST_F(SetAccountDetail, NoPerms) {
+    TEST_P(SetAccountDetail, NoPerms) {
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().setAccountDetail(
                       account2->accountId(), "key", "value")),
@@ -1607,7 +1664,7 @@ namespace iroha {
      * @when trying to set kv to non-existing account
      * @then corresponding error code is returned
      */
-    TEST_F(SetAccountDetail, NoAccount) {
+    TEST_P(SetAccountDetail, NoAccount) {
       addAllPerms();
       auto cmd_result =
           execute(buildCommand(TestTransactionBuilder().setAccountDetail(
@@ -1653,7 +1710,7 @@ namespace iroha {
      * @when trying to set quorum
      * @then quorum is set
      */
-    TEST_F(SetQuorum, Valid) {
+    TEST_P(SetQuorum, Valid) {
       addAllPerms();
 
       ASSERT_TRUE(
@@ -1666,7 +1723,7 @@ namespace iroha {
      * @when trying to set quorum
      * @then quorum is set
      */
-    TEST_F(SetQuorum, ValidGrantablePerms) {
+    TEST_P(SetQuorum, ValidGrantablePerms) {
       ASSERT_TRUE(
           val(execute(buildCommand(TestTransactionBuilder().createAccount(
                           "id2", domain->domainId(), *pubkey)),
@@ -1693,7 +1750,7 @@ namespace iroha {
      * @when trying to set quorum without perms
      * @then quorum is not set
      */
-    TEST_F(SetQuorum, NoPerms) {
+    TEST_P(SetQuorum, NoPerms) {
       auto cmd_result = execute(buildCommand(
           TestTransactionBuilder().setAccountQuorum(account->accountId(), 3)));
 
@@ -1706,7 +1763,7 @@ namespace iroha {
      * @when trying to set quorum more than amount of signatories
      * @then quorum is not set
      */
-    TEST_F(SetQuorum, LessSignatoriesThanNewQuorum) {
+    TEST_P(SetQuorum, LessSignatoriesThanNewQuorum) {
       addAllPerms();
       shared_model::interface::types::PubkeyType pk(std::string('5', 32));
       ASSERT_TRUE(
@@ -1767,7 +1824,7 @@ namespace iroha {
      * @when trying to subtract account asset
      * @then account asset is successfully subtracted
      */
-    TEST_F(SubtractAccountAssetTest, Valid) {
+    TEST_P(SubtractAccountAssetTest, Valid) {
       addAllPerms();
       addAsset();
       ASSERT_TRUE(val(execute(
@@ -1803,7 +1860,7 @@ namespace iroha {
      * @when trying to subtract account asset without permissions
      * @then corresponding error code is returned
      */
-    TEST_F(SubtractAccountAssetTest, NoPerms) {
+    TEST_P(SubtractAccountAssetTest, NoPerms) {
       addAsset();
       ASSERT_TRUE(val(execute(
           buildCommand(TestTransactionBuilder()
@@ -1837,7 +1894,7 @@ namespace iroha {
   * @when trying to subtract account asset
   * @then account asset is successfully subtracted
   */
-  TEST_F(SubtractAccountAssetTest, DomainPermValid) {
+  TEST_P(SubtractAccountAssetTest, DomainPermValid) {
     addAsset();
     addOnePerm(shared_model::interface::permissions::Role::kSubtractDomainAssetQty);
 
@@ -1874,7 +1931,7 @@ namespace iroha {
    * @when trying to subtract asset
    * @then no account asset is subtracted
    */
-  TEST_F(SubtractAccountAssetTest, DomainPermInvalid) {
+  TEST_P(SubtractAccountAssetTest, DomainPermInvalid) {
     std::unique_ptr<shared_model::interface::Domain> domain2;
     domain2 = clone(
         TestDomainBuilder().domainId("domain2").defaultRole(role).build());
@@ -1919,7 +1976,7 @@ namespace iroha {
      * @when trying to subtract account asset with non-existing asset
      * @then account asset fails to be subtracted
      */
-    TEST_F(SubtractAccountAssetTest, NoAsset) {
+    TEST_P(SubtractAccountAssetTest, NoAsset) {
       addAllPerms();
       auto cmd_result = execute(buildCommand(
           TestTransactionBuilder()
@@ -1936,7 +1993,7 @@ namespace iroha {
      * @when trying to add account asset with wrong precision
      * @then account asset fails to be added
      */
-    TEST_F(SubtractAccountAssetTest, InvalidPrecision) {
+    TEST_P(SubtractAccountAssetTest, InvalidPrecision) {
       addAllPerms();
       addAsset();
       auto cmd_result =
@@ -1954,7 +2011,7 @@ namespace iroha {
      * @when trying to subtract more account asset than account has
      * @then account asset fails to be subtracted
      */
-    TEST_F(SubtractAccountAssetTest, NotEnoughAsset) {
+    TEST_P(SubtractAccountAssetTest, NotEnoughAsset) {
       addAllPerms();
       addAsset();
       ASSERT_TRUE(val(execute(
@@ -2028,7 +2085,7 @@ namespace iroha {
      * @when trying to add transfer asset
      * @then account asset is successfully transferred
      */
-    TEST_F(TransferAccountAssetTest, Valid) {
+    TEST_P(TransferAccountAssetTest, Valid) {
       addAllPerms();
       addAllPerms(account2->accountId(), "all2");
       addAsset();
@@ -2071,7 +2128,7 @@ namespace iroha {
      * @when trying to add transfer asset
      * @then account asset is successfully transferred
      */
-    TEST_F(TransferAccountAssetTest, ValidGrantablePerms) {
+    TEST_P(TransferAccountAssetTest, ValidGrantablePerms) {
       addAllPerms(account2->accountId(), "all2");
       addAsset();
       auto perm =
@@ -2115,7 +2172,7 @@ namespace iroha {
      * @when trying to transfer account asset with no permissions
      * @then account asset fails to be transferred
      */
-    TEST_F(TransferAccountAssetTest, NoPerms) {
+    TEST_P(TransferAccountAssetTest, NoPerms) {
       auto cmd_result = execute(buildCommand(
           TestTransactionBuilder().transferAsset(account->accountId(),
                                                  account2->accountId(),
@@ -2136,7 +2193,7 @@ namespace iroha {
      * @when trying to transfer asset back and forth with non-existing account
      * @then account asset fails to be transferred
      */
-    TEST_F(TransferAccountAssetTest, NoAccount) {
+    TEST_P(TransferAccountAssetTest, NoAccount) {
       addAllPerms();
       addAllPerms(account2->accountId(), "all2");
       addAsset();
@@ -2186,7 +2243,7 @@ namespace iroha {
      * @when trying to transfer account asset with non-existing asset
      * @then account asset fails to be transferred
      */
-    TEST_F(TransferAccountAssetTest, NoAsset) {
+    TEST_P(TransferAccountAssetTest, NoAsset) {
       addAllPerms();
       addAllPerms(account2->accountId(), "all2");
       auto cmd_result = execute(buildCommand(
@@ -2209,7 +2266,7 @@ namespace iroha {
      * @when trying to transfer account asset, but has insufficient amount of it
      * @then account asset fails to be transferred
      */
-    TEST_F(TransferAccountAssetTest, Overdraft) {
+    TEST_P(TransferAccountAssetTest, Overdraft) {
       addAllPerms();
       addAllPerms(account2->accountId(), "all2");
       addAsset();
@@ -2236,7 +2293,7 @@ namespace iroha {
      * destination's asset value
      * @then account asset fails to be transferred
      */
-    TEST_F(TransferAccountAssetTest, OverflowDestination) {
+    TEST_P(TransferAccountAssetTest, OverflowDestination) {
       addAllPerms();
       addAllPerms(account2->accountId(), "all2");
       addAsset();
@@ -2267,5 +2324,61 @@ namespace iroha {
       CHECK_ERROR_CODE_AND_MESSAGE(cmd_result, 7, query_args);
     }
 
+    /**
+     * @given account with some amount of asset
+     * @when trying to transfer the asset to the same account
+     * @then the transfer fails @and the balance is not changed
+     */
+    TEST_P(TransferAccountAssetTest, SameAccount) {
+      addAllPerms();
+      addAsset();
+      ASSERT_TRUE(val(execute(
+          buildCommand(TestTransactionBuilder()
+                           .addAssetQuantity(asset_id, asset_amount_one_zero)
+                           .creatorAccountId(account->accountId())),
+          true)));
+      auto cmd_result =
+          execute(buildCommand(TestTransactionBuilder().transferAsset(
+                      account->accountId(),
+                      account->accountId(),
+                      asset_id,
+                      "desc",
+                      asset_amount_one_zero)),
+                  true);
+
+      std::vector<std::string> query_args{account->accountId(),
+                                          account->accountId(),
+                                          asset_id,
+                                          asset_amount_one_zero,
+                                          "1"};
+      CHECK_ERROR_CODE_AND_MESSAGE(cmd_result, 1, query_args);
+      auto account_asset =
+          query->getAccountAsset(account->accountId(), asset_id);
+      ASSERT_TRUE(account_asset);
+      ASSERT_EQ(asset_amount_one_zero,
+                account_asset.get()->balance().toStringRepr());
+    }
+
+    INSTANTIATE_TEST_CASE_P(Backends, AddAccountAssetTest, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, AddPeer, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, AddSignatory, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, AppendRole, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, CreateAccount, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, CreateAsset, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, CreateDomain, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, CreateRole, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, DetachRole, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, GrantPermission, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, RemoveSignatory, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, RevokePermission, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, SetAccountDetail, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, SetQuorum, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            SubtractAccountAssetTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            TransferAccountAssetTest,
+                            wsvBackends(), );
+
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -32,6 +32,7 @@
 #include "interfaces/query_responses/transactions_response.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/irohad/ametsuchi/wsv_backend_fixture.hpp"
 #include "module/irohad/pending_txs_storage/pending_txs_storage_mock.hpp"
 #include "module/shared_model/builders/protobuf/test_account_builder.hpp"
 #include "module/shared_model/builders/protobuf/test_asset_builder.hpp"
@@ -122,7 +123,9 @@ namespace iroha {
       }) << exec_result->toString();
     }
 
-    class QueryExecutorTest : public AmetsuchiTest {
+    class QueryExecutorTest
+        : public AmetsuchiTest,
+          public ::testing::WithParamInterface<WsvBackend> {
      public:
       QueryExecutorTest() {
         role_permissions.set(
@@ -152,10 +155,19 @@ namespace iroha {
         auto factory =
             std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
                 shared_model::validation::FieldValidator>>();
-        query_executor = storage;
         PostgresCommandExecutor::prepareStatements(*sql);
-        executor =
-            std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+        if (backend() == WsvBackend::kInMemory) {
+          in_memory = std::make_shared<InMemoryWsvBackend>(
+              factory,
+              std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+              perm_converter);
+          query_executor = in_memory;
+          executor = in_memory->createCommandExecutor();
+        } else {
+          query_executor = storage;
+          executor =
+              std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+        }
         pending_txs_storage = std::make_shared<MockPendingTransactionStorage>();
 
         auto result = execute(buildCommand(TestTransactionBuilder().createRole(
@@ -186,6 +198,13 @@ namespace iroha {
         AmetsuchiTest::TearDown();
       }
 
+      /**
+       * @return backend the test is run against
+       */
+      virtual WsvBackend backend() const {
+        return GetParam();
+      }
+
       auto executeQuery(shared_model::interface::Query &query) {
         return query_executor->createQueryExecutor(pending_txs_storage,
                                                    query_response_factory)
@@ -267,6 +286,7 @@ namespace iroha {
 
       std::unique_ptr<shared_model::interface::Command> command;
 
+      std::shared_ptr<InMemoryWsvBackend> in_memory;
       std::shared_ptr<QueryExecutorFactory> query_executor;
       std::unique_ptr<CommandExecutor> executor;
       std::shared_ptr<MockPendingTransactionStorage> pending_txs_storage;
@@ -288,7 +308,7 @@ namespace iroha {
      * @when get blocks query is validated
      * @then result is successful
      */
-    TEST_F(BlocksQueryExecutorTest, BlocksQueryExecutorTestValid) {
+    TEST_P(BlocksQueryExecutorTest, BlocksQueryExecutorTestValid) {
       addAllPerms();
       auto blocks_query = TestBlocksQueryBuilder()
                               .creatorAccountId(account->accountId())
@@ -305,7 +325,7 @@ namespace iroha {
      * @when get blocks query is validated
      * @then result is error
      */
-    TEST_F(BlocksQueryExecutorTest, BlocksQueryExecutorTestInvalid) {
+    TEST_P(BlocksQueryExecutorTest, BlocksQueryExecutorTestInvalid) {
       auto blocks_query = TestBlocksQueryBuilder()
                               .creatorAccountId(account->accountId())
                               .build();
@@ -343,7 +363,7 @@ namespace iroha {
      * @when get account information
      * @then Return account
      */
-    TEST_F(GetAccountExecutorTest, ValidMyAccount) {
+    TEST_P(GetAccountExecutorTest, ValidMyAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetMyAccount});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -361,7 +381,7 @@ namespace iroha {
      * @when get account information about other user
      * @then Return account
      */
-    TEST_F(GetAccountExecutorTest, ValidAllAccounts) {
+    TEST_P(GetAccountExecutorTest, ValidAllAccounts) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccounts});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -379,7 +399,7 @@ namespace iroha {
      * @when get account information about other user in the same domain
      * @then Return account
      */
-    TEST_F(GetAccountExecutorTest, ValidDomainAccount) {
+    TEST_P(GetAccountExecutorTest, ValidDomainAccount) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainAccounts});
       auto query = TestQueryBuilder()
@@ -398,7 +418,7 @@ namespace iroha {
      * @when get account information about other user in the other domain
      * @then Return error
      */
-    TEST_F(GetAccountExecutorTest, InvalidDifferentDomain) {
+    TEST_P(GetAccountExecutorTest, InvalidDifferentDomain) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainAccounts});
       auto query = TestQueryBuilder()
@@ -415,7 +435,7 @@ namespace iroha {
      * @when get account information about non existing account
      * @then Return error
      */
-    TEST_F(GetAccountExecutorTest, InvalidNoAccount) {
+    TEST_P(GetAccountExecutorTest, InvalidNoAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccounts});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -458,7 +478,7 @@ namespace iroha {
      * @when get signatories
      * @then Return signatories of user
      */
-    TEST_F(GetSignatoriesExecutorTest, ValidMyAccount) {
+    TEST_P(GetSignatoriesExecutorTest, ValidMyAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetMySignatories});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -475,7 +495,7 @@ namespace iroha {
      * @when get signatories of other user
      * @then Return signatories
      */
-    TEST_F(GetSignatoriesExecutorTest, ValidAllAccounts) {
+    TEST_P(GetSignatoriesExecutorTest, ValidAllAccounts) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetAllSignatories});
       auto query = TestQueryBuilder()
@@ -493,7 +513,7 @@ namespace iroha {
      * @when get signatories of other user in the same domain
      * @then Return signatories
      */
-    TEST_F(GetSignatoriesExecutorTest, ValidDomainAccount) {
+    TEST_P(GetSignatoriesExecutorTest, ValidDomainAccount) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainSignatories});
       auto query = TestQueryBuilder()
@@ -511,7 +531,7 @@ namespace iroha {
      * @when get signatories of other user in the other domain
      * @then Return error
      */
-    TEST_F(GetSignatoriesExecutorTest, InvalidDifferentDomain) {
+    TEST_P(GetSignatoriesExecutorTest, InvalidDifferentDomain) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainAccounts});
       auto query = TestQueryBuilder()
@@ -528,7 +548,7 @@ namespace iroha {
      * @when get signatories of non existing account
      * @then Return error
      */
-    TEST_F(GetSignatoriesExecutorTest, InvalidNoAccount) {
+    TEST_P(GetSignatoriesExecutorTest, InvalidNoAccount) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetAllSignatories});
       auto query = TestQueryBuilder()
@@ -592,7 +612,7 @@ namespace iroha {
      * @when get account assets
      * @then Return account asset of user
      */
-    TEST_F(GetAccountAssetExecutorTest, ValidMyAccount) {
+    TEST_P(GetAccountAssetExecutorTest, ValidMyAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetMyAccAst});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -612,7 +632,7 @@ namespace iroha {
      * @when get account assets of other user
      * @then Return account asset
      */
-    TEST_F(GetAccountAssetExecutorTest, ValidAllAccounts) {
+    TEST_P(GetAccountAssetExecutorTest, ValidAllAccounts) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccAst});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -632,7 +652,7 @@ namespace iroha {
      * @when get account assets of other user in the same domain
      * @then Return account asset
      */
-    TEST_F(GetAccountAssetExecutorTest, ValidDomainAccount) {
+    TEST_P(GetAccountAssetExecutorTest, ValidDomainAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetDomainAccAst});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -652,7 +672,7 @@ namespace iroha {
      * @when get account assets of other user in the other domain
      * @then Return error
      */
-    TEST_F(GetAccountAssetExecutorTest, InvalidDifferentDomain) {
+    TEST_P(GetAccountAssetExecutorTest, InvalidDifferentDomain) {
       addPerms({shared_model::interface::permissions::Role::kGetDomainAccAst});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -668,7 +688,7 @@ namespace iroha {
      * @when get account assets of non existing account
      * @then Return error
      */
-    TEST_F(GetAccountAssetExecutorTest, DISABLED_InvalidNoAccount) {
+    TEST_P(GetAccountAssetExecutorTest, DISABLED_InvalidNoAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccAst});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -736,7 +756,7 @@ namespace iroha {
      * @when get account detail
      * @then Return account detail
      */
-    TEST_F(GetAccountDetailExecutorTest, ValidMyAccount) {
+    TEST_P(GetAccountDetailExecutorTest, ValidMyAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetMyAccDetail});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -753,7 +773,7 @@ namespace iroha {
      * @when get account detail of other user
      * @then Return account detail
      */
-    TEST_F(GetAccountDetailExecutorTest, ValidAllAccounts) {
+    TEST_P(GetAccountDetailExecutorTest, ValidAllAccounts) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccDetail});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -771,7 +791,7 @@ namespace iroha {
      * @when get account detail of other user in the same domain
      * @then Return account detail
      */
-    TEST_F(GetAccountDetailExecutorTest, ValidDomainAccount) {
+    TEST_P(GetAccountDetailExecutorTest, ValidDomainAccount) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainAccDetail});
       auto query = TestQueryBuilder()
@@ -790,7 +810,7 @@ namespace iroha {
      * @when get account detail of other user in the other domain
      * @then Return error
      */
-    TEST_F(GetAccountDetailExecutorTest, InvalidDifferentDomain) {
+    TEST_P(GetAccountDetailExecutorTest, InvalidDifferentDomain) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainAccDetail});
       auto query = TestQueryBuilder()
@@ -807,7 +827,7 @@ namespace iroha {
      * @when get account detail of non existing account
      * @then Return error
      */
-    TEST_F(GetAccountDetailExecutorTest, InvalidNoAccount) {
+    TEST_P(GetAccountDetailExecutorTest, InvalidNoAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccDetail});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -825,7 +845,7 @@ namespace iroha {
      * @then getAccountDetail will return details from both writers under the
      * specified key
      */
-    TEST_F(GetAccountDetailExecutorTest, ValidKey) {
+    TEST_P(GetAccountDetailExecutorTest, ValidKey) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccDetail});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -846,7 +866,7 @@ namespace iroha {
      * @then getAccountDetail will return only details, added by the specified
      * writer
      */
-    TEST_F(GetAccountDetailExecutorTest, ValidWriter) {
+    TEST_P(GetAccountDetailExecutorTest, ValidWriter) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccDetail});
       auto query =
           TestQueryBuilder()
@@ -869,7 +889,7 @@ namespace iroha {
      * @then getAccountDetail will return only details, which are under the
      * specified key and added by the specified writer
      */
-    TEST_F(GetAccountDetailExecutorTest, ValidKeyWriter) {
+    TEST_P(GetAccountDetailExecutorTest, ValidKeyWriter) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccDetail});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -896,7 +916,7 @@ namespace iroha {
      * @when get system roles
      * @then Return roles
      */
-    TEST_F(GetRolesExecutorTest, Valid) {
+    TEST_P(GetRolesExecutorTest, Valid) {
       addPerms({shared_model::interface::permissions::Role::kGetRoles});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -916,7 +936,7 @@ namespace iroha {
      * @when get system roles
      * @then Return Error
      */
-    TEST_F(GetRolesExecutorTest, Invalid) {
+    TEST_P(GetRolesExecutorTest, Invalid) {
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
                        .getRoles()
@@ -938,7 +958,7 @@ namespace iroha {
      * @when get role permissions
      * @then Return role permissions
      */
-    TEST_F(GetRolePermsExecutorTest, Valid) {
+    TEST_P(GetRolePermsExecutorTest, Valid) {
       addPerms({shared_model::interface::permissions::Role::kGetRoles});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -958,7 +978,7 @@ namespace iroha {
      * @when get role permissions
      * @then Return error
      */
-    TEST_F(GetRolePermsExecutorTest, InvalidNoRole) {
+    TEST_P(GetRolePermsExecutorTest, InvalidNoRole) {
       addPerms({shared_model::interface::permissions::Role::kGetRoles});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -974,7 +994,7 @@ namespace iroha {
      * @when get role permissions
      * @then Return error
      */
-    TEST_F(GetRolePermsExecutorTest, Invalid) {
+    TEST_P(GetRolePermsExecutorTest, Invalid) {
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
                        .getRolePermissions("role")
@@ -1004,7 +1024,7 @@ namespace iroha {
      * @when get asset info
      * @then Return asset
      */
-    TEST_F(GetAssetInfoExecutorTest, Valid) {
+    TEST_P(GetAssetInfoExecutorTest, Valid) {
       addPerms({shared_model::interface::permissions::Role::kReadAssets});
       createAsset();
       auto query = TestQueryBuilder()
@@ -1025,7 +1045,7 @@ namespace iroha {
      * @when get asset info of non existing asset
      * @then Error
      */
-    TEST_F(GetAssetInfoExecutorTest, InvalidNoAsset) {
+    TEST_P(GetAssetInfoExecutorTest, InvalidNoAsset) {
       addPerms({shared_model::interface::permissions::Role::kReadAssets});
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
@@ -1041,7 +1061,7 @@ namespace iroha {
      * @when get asset info
      * @then Error
      */
-    TEST_F(GetAssetInfoExecutorTest, Invalid) {
+    TEST_P(GetAssetInfoExecutorTest, Invalid) {
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
                        .getAssetInfo(asset_id)
@@ -1079,13 +1099,14 @@ namespace iroha {
       }
 
       /**
-       * Apply block to given storage
-       * @tparam S storage type
-       * @param storage storage object
+       * Apply block to the storage of the tested backend
        * @param block to apply
        */
-      template <typename S>
-      void apply(S &&storage, const shared_model::interface::Block &block) {
+      void apply(const shared_model::interface::Block &block) {
+        if (in_memory) {
+          in_memory->apply(block);
+          return;
+        }
         std::unique_ptr<MutableStorage> ms;
         auto storageResult = storage->createMutableStorage();
         storageResult.match(
@@ -1127,7 +1148,7 @@ namespace iroha {
                           .prevHash(fake_hash)
                           .build();
 
-        apply(storage, block1);
+        apply(block1);
 
         std::vector<shared_model::proto::Transaction> txs2;
         txs2.push_back(TestTransactionBuilder()
@@ -1149,7 +1170,7 @@ namespace iroha {
                           .prevHash(block1.hash())
                           .build();
 
-        apply(storage, block2);
+        apply(block2);
 
         hash1 = txs1.at(0).hash();
         hash2 = txs1.at(1).hash();
@@ -1164,8 +1185,7 @@ namespace iroha {
     };
 
     template <typename QueryTxPaginationTest>
-    class GetPagedTransactionsExecutorTest
-        : public GetTransactionsExecutorTest {
+    class PagedTransactionsExecutorTest : public GetTransactionsExecutorTest {
      protected:
       using Impl = QueryTxPaginationTest;
 
@@ -1189,7 +1209,7 @@ namespace iroha {
                          .prevHash(fake_hash)
                          .build();
 
-        apply(storage, block);
+        apply(block);
       }
 
       auto queryPage(
@@ -1352,14 +1372,14 @@ namespace iroha {
     };
 
     using GetAccountTransactionsExecutorTest =
-        GetPagedTransactionsExecutorTest<GetAccountTxPaginationImpl>;
+        PagedTransactionsExecutorTest<GetAccountTxPaginationImpl>;
 
     /**
      * @given initialized storage, permission to his/her account
      * @when get account transactions
      * @then Return account transactions of user
      */
-    TEST_F(GetAccountTransactionsExecutorTest, ValidMyAccount) {
+    TEST_P(GetAccountTransactionsExecutorTest, ValidMyAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetMyAccTxs});
 
       commitBlocks();
@@ -1387,7 +1407,7 @@ namespace iroha {
      * @when get account transactions of other user
      * @then Return account transactions
      */
-    TEST_F(GetAccountTransactionsExecutorTest, ValidAllAccounts) {
+    TEST_P(GetAccountTransactionsExecutorTest, ValidAllAccounts) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccTxs});
 
       commitBlocks();
@@ -1413,7 +1433,7 @@ namespace iroha {
      * @when get account transactions of other user in the same domain
      * @then Return account transactions
      */
-    TEST_F(GetAccountTransactionsExecutorTest, ValidDomainAccount) {
+    TEST_P(GetAccountTransactionsExecutorTest, ValidDomainAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetDomainAccTxs});
 
       commitBlocks();
@@ -1439,7 +1459,7 @@ namespace iroha {
      * @when get account transactions of other user in the other domain
      * @then Return error
      */
-    TEST_F(GetAccountTransactionsExecutorTest, InvalidDifferentDomain) {
+    TEST_P(GetAccountTransactionsExecutorTest, InvalidDifferentDomain) {
       addPerms({shared_model::interface::permissions::Role::kGetDomainAccTxs});
       auto query =
           TestQueryBuilder()
@@ -1456,7 +1476,7 @@ namespace iroha {
      * @when get account transactions of non existing account
      * @then Return empty account transactions
      */
-    TEST_F(GetAccountTransactionsExecutorTest, DISABLED_InvalidNoAccount) {
+    TEST_P(GetAccountTransactionsExecutorTest, DISABLED_InvalidNoAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccTxs});
 
       auto query = TestQueryBuilder()
@@ -1470,9 +1490,34 @@ namespace iroha {
 
     // ------------------------/ tx pagination tests \----------------------- //
 
-    using QueryTxPaginationTestingTypes =
-        ::testing::Types<GetAccountTxPaginationImpl,
-                         GetAccountAssetTxPaginationImpl>;
+    /**
+     * Pagination query checked against a backend
+     */
+    template <typename QueryTxPaginationImpl, WsvBackend kBackend>
+    struct QueryTxPaginationCase {
+      using Impl = QueryTxPaginationImpl;
+      static constexpr WsvBackend backend = kBackend;
+    };
+
+    template <typename Case>
+    class GetPagedTransactionsExecutorTest
+        : public PagedTransactionsExecutorTest<typename Case::Impl> {
+     protected:
+      // typed tests have no value parameter
+      WsvBackend backend() const override {
+        return Case::backend;
+      }
+    };
+
+    using QueryTxPaginationTestingTypes = ::testing::Types<
+        QueryTxPaginationCase<GetAccountTxPaginationImpl,
+                              WsvBackend::kPostgres>,
+        QueryTxPaginationCase<GetAccountTxPaginationImpl,
+                              WsvBackend::kInMemory>,
+        QueryTxPaginationCase<GetAccountAssetTxPaginationImpl,
+                              WsvBackend::kPostgres>,
+        QueryTxPaginationCase<GetAccountAssetTxPaginationImpl,
+                              WsvBackend::kInMemory>>;
     TYPED_TEST_CASE(GetPagedTransactionsExecutorTest,
                     QueryTxPaginationTestingTypes);
 
@@ -1587,7 +1632,7 @@ namespace iroha {
      * @when get transactions of other user
      * @then Return transactions
      */
-    TEST_F(GetTransactionsHashExecutorTest, ValidAllAccounts) {
+    TEST_P(GetTransactionsHashExecutorTest, ValidAllAccounts) {
       addPerms({shared_model::interface::permissions::Role::kGetAllTxs});
 
       commitBlocks();
@@ -1612,7 +1657,7 @@ namespace iroha {
      * @when get transactions
      * @then Return transactions of user
      */
-    TEST_F(GetTransactionsHashExecutorTest, ValidMyAccount) {
+    TEST_P(GetTransactionsHashExecutorTest, ValidMyAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetMyTxs});
 
       commitBlocks();
@@ -1636,14 +1681,14 @@ namespace iroha {
     }
 
     using GetAccountAssetTransactionsExecutorTest =
-        GetPagedTransactionsExecutorTest<GetAccountAssetTxPaginationImpl>;
+        PagedTransactionsExecutorTest<GetAccountAssetTxPaginationImpl>;
 
     /**
      * @given initialized storage, permission to his/her account
      * @when get account asset transactions
      * @then Return account asset transactions of user
      */
-    TEST_F(GetAccountAssetTransactionsExecutorTest, ValidMyAccount) {
+    TEST_P(GetAccountAssetTransactionsExecutorTest, ValidMyAccount) {
       addPerms({shared_model::interface::permissions::Role::kGetMyAccAstTxs});
 
       commitBlocks();
@@ -1667,7 +1712,7 @@ namespace iroha {
      * @when get account asset transactions of other user
      * @then Return account asset transactions
      */
-    TEST_F(GetAccountAssetTransactionsExecutorTest, ValidAllAccounts) {
+    TEST_P(GetAccountAssetTransactionsExecutorTest, ValidAllAccounts) {
       addPerms({shared_model::interface::permissions::Role::kGetAllAccAstTxs});
 
       commitBlocks();
@@ -1691,7 +1736,7 @@ namespace iroha {
      * @when get account asset transactions of other user in the same domain
      * @then Return account asset transactions
      */
-    TEST_F(GetAccountAssetTransactionsExecutorTest, ValidDomainAccount) {
+    TEST_P(GetAccountAssetTransactionsExecutorTest, ValidDomainAccount) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainAccAstTxs});
 
@@ -1716,7 +1761,7 @@ namespace iroha {
      * @when get account asset transactions of other user in the other domain
      * @then Return error
      */
-    TEST_F(GetAccountAssetTransactionsExecutorTest, InvalidDifferentDomain) {
+    TEST_P(GetAccountAssetTransactionsExecutorTest, InvalidDifferentDomain) {
       addPerms(
           {shared_model::interface::permissions::Role::kGetDomainAccAstTxs});
 
@@ -1735,7 +1780,7 @@ namespace iroha {
      * @when get pending transactions
      * @then pending txs storage will be requested for query creator account
      */
-    TEST_F(QueryExecutorTest, TransactionsStorageIsAccessed) {
+    TEST_P(QueryExecutorTest, TransactionsStorageIsAccessed) {
       auto query = TestQueryBuilder()
                        .creatorAccountId(account->accountId())
                        .getPendingTransactions()
@@ -1748,5 +1793,34 @@ namespace iroha {
       executeQuery(query);
     }
 
+    INSTANTIATE_TEST_CASE_P(Backends, BlocksQueryExecutorTest, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, GetAccountExecutorTest, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetSignatoriesExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetAccountAssetExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetAccountDetailExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, GetRolesExecutorTest, wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetRolePermsExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetAssetInfoExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetAccountTransactionsExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetTransactionsHashExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends,
+                            GetAccountAssetTransactionsExecutorTest,
+                            wsvBackends(), );
+    INSTANTIATE_TEST_CASE_P(Backends, QueryExecutorTest, wsvBackends(), );
+
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -0,0 +1,127 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/postgres_query_pool.hpp"
+
+#include <thread>
+
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace std::chrono_literals;
+using framework::expected::err;
+using framework::expected::val;
+
+class PostgresQueryPoolTest : public AmetsuchiTest {
+ protected:
+  void SetUp() override {
+    AmetsuchiTest::SetUp();
+    auto pool = val(ConnectionPool::create("test", 1, timeout, pgopt_));
+    ASSERT_TRUE(pool);
+    connections = pool->value;
+    block_store = std::move(*FlatFile::create(query_block_store_path));
+    query_pool = std::make_shared<PostgresQueryPool>(
+        connections,
+        *block_store,
+        factory,
+        std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+        nullptr);
+  }
+
+  void TearDown() override {
+    query_pool->close();
+    connections->close();
+    boost::filesystem::remove_all(query_block_store_path);
+    AmetsuchiTest::TearDown();
+  }
+
+  std::chrono::milliseconds timeout = 100ms;
+  std::string query_block_store_path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path())
+          .string();
+  std::unique_ptr<KeyValueStorage> block_store;
+  std::shared_ptr<ConnectionPool> connections;
+  std::shared_ptr<PostgresQueryPool> query_pool;
+};
+
+/**
+ * @given query pool over a single connection
+ * @when block query is requested, released and requested again
+ * @then the same query is returned @and both can execute statements
+ */
+TEST_F(PostgresQueryPoolTest, QueryReused) {
+  auto first = val(query_pool->getBlockQuery());
+  ASSERT_TRUE(first);
+  auto query = first->value.get();
+  EXPECT_FALSE(query->checkTxPresence(shared_model::crypto::Hash("1")));
+  first->value.reset();
+  EXPECT_EQ(query_pool->idle(), 1);
+
+  auto second = val(query_pool->getBlockQuery());
+  ASSERT_TRUE(second);
+  EXPECT_EQ(second->value.get(), query);
+  EXPECT_FALSE(query->checkTxPresence(shared_model::crypto::Hash("1")));
+  EXPECT_EQ(query_pool->idle(), 0);
+}
+
+/**
+ * @given query pool with its only connection held by an idle query
+ * @when a connection is checked out
+ * @then the connection of the idle query is returned without waiting
+ */
+TEST_F(PostgresQueryPoolTest, CheckoutTakesIdleConnection) {
+  ASSERT_TRUE(val(query_pool->getWsvQuery()));
+  ASSERT_EQ(query_pool->idle(), 1);
+
+  auto sql = val(query_pool->checkout());
+  ASSERT_TRUE(sql);
+  EXPECT_EQ(query_pool->idle(), 0);
+  EXPECT_EQ(connections->timeouts(), 0);
+}
+
+/**
+ * @given query pool with its only connection held by a query
+ * @when the query is released while a connection is checked out
+ * @then the waiting checkout gets the connection @and the query is dropped
+ */
+TEST_F(PostgresQueryPoolTest, ReleasedQueryGivesConnectionToWaiting) {
+  timeout = 10s;
+  connections->close();
+  connections =
+      val(ConnectionPool::create("test", 1, timeout, pgopt_))->value;
+  query_pool = std::make_shared<PostgresQueryPool>(
+      connections,
+      *block_store,
+      factory,
+      std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+      nullptr);
+  auto query = std::move(val(query_pool->getWsvQuery())->value);
+
+  std::thread release([&query] {
+    std::this_thread::sleep_for(50ms);
+    query.reset();
+  });
+  EXPECT_TRUE(val(query_pool->checkout()));
+  release.join();
+  EXPECT_EQ(query_pool->idle(), 0);
+  EXPECT_EQ(connections->timeouts(), 0);
+}
+
+/**
+ * @given closed query pool
+ * @when a query taken before closing is released @and another is requested
+ * @then the released query is not kept @and the request fails
+ */
+TEST_F(PostgresQueryPoolTest, ClosedPoolKeepsNoQueries) {
+  auto query = std::move(val(query_pool->getBlockQuery())->value);
+  query_pool->close();
+  query.reset();
+
+  EXPECT_EQ(query_pool->idle(), 0);
+  EXPECT_TRUE(err(query_pool->getBlockQuery()));
+}
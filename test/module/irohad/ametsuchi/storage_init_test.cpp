@@ -103,3 +103,65 @@ TEST_F(StorageInitTest, CreateStorageWithInvalidPgOpt) {
           },
           [](const Error<std::string> &) { SUCCEED(); });
 }
+
+/**
+ * @given database with index tables which keep heights and hashes as text
+ * @when Create storage on that database
+ * @then index tables are converted to typed columns and keep their rows
+ * @and ids of creator index continue after the copied ones
+ */
+TEST_F(StorageInitTest, MigrateTextIndexTables) {
+  const std::string hash(64, 'a');
+  {
+    soci::session sql(soci::postgresql, pg_opt_without_dbname_);
+    sql << "CREATE DATABASE " + dbname_;
+  }
+  {
+    soci::session sql(soci::postgresql, pgopt_);
+    sql << R"(
+CREATE TABLE position_by_hash (hash varchar, height text, index text);
+CREATE TABLE tx_status_by_hash (hash varchar, status boolean);
+CREATE TABLE height_by_account_set (account_id text, height text);
+CREATE TABLE index_by_creator_height (
+    id serial, creator_id text, height text, index text);
+CREATE TABLE position_by_account_asset (
+    account_id text, asset_id text, height text, index text);
+)";
+    sql << "INSERT INTO position_by_hash VALUES (:hash, '12', '3')",
+        soci::use(hash);
+    sql << "INSERT INTO index_by_creator_height (creator_id, height, index) "
+           "VALUES ('id@domain', '12', '3')";
+  }
+
+  std::shared_ptr<StorageImpl> storage;
+  StorageImpl::create(
+      block_store_path, pgopt_, factory, converter, perm_converter_)
+      .match(
+          [&storage](const Value<std::shared_ptr<StorageImpl>> &value) {
+            storage = value.value;
+          },
+          [](const Error<std::string> &error) { FAIL() << error.error; });
+  ASSERT_TRUE(storage);
+
+  soci::session sql(soci::postgresql, pgopt_);
+  std::string type;
+  sql << "SELECT data_type FROM information_schema.columns "
+         "WHERE table_name = 'position_by_hash' AND column_name = 'height'",
+      soci::into(type);
+  EXPECT_EQ(type, "bigint");
+
+  int height = 0;
+  sql << "SELECT height FROM position_by_hash "
+         "WHERE hash = decode(:hash, 'hex')",
+      soci::into(height), soci::use(hash);
+  EXPECT_EQ(height, 12);
+
+  int id = 0;
+  sql << "INSERT INTO index_by_creator_height (creator_id, height, index) "
+         "VALUES ('id@domain', 13, 0) RETURNING id",
+      soci::into(id);
+  EXPECT_EQ(id, 2);
+
+  sql.close();
+  storage->dropStorage();
+}
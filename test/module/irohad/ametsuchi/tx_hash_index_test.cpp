@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/tx_hash_index.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace iroha::ametsuchi;
+
+/**
+ * @return distinct hash for given number
+ */
+shared_model::crypto::Hash makeHash(size_t i) {
+  return shared_model::crypto::Hash(std::to_string(i));
+}
+
+/**
+ * @given index with committed and rejected transactions
+ * @when transactions are looked up
+ * @then their positions are found and unknown hashes are missing
+ */
+TEST(TxHashIndexTest, FindsInsertedHashes) {
+  TxHashIndex index;
+  index.insertCommitted(makeHash(1), 5, 2);
+  index.insertRejected(makeHash(2));
+
+  auto committed = index.find(makeHash(1));
+  ASSERT_TRUE(committed);
+  EXPECT_TRUE(committed->committed);
+  EXPECT_EQ(committed->height, 5);
+  EXPECT_EQ(committed->index, 2);
+
+  auto rejected = index.find(makeHash(2));
+  ASSERT_TRUE(rejected);
+  EXPECT_FALSE(rejected->committed);
+
+  EXPECT_FALSE(index.find(makeHash(3)));
+  EXPECT_EQ(index.size(), 2);
+}
+
+/**
+ * @given index with more hashes than initial filter capacity
+ * @when all hashes and as many unknown ones are looked up
+ * @then every inserted hash is found after the filter is rebuilt, and
+ * unknown ones are missing
+ */
+TEST(TxHashIndexTest, GrowsFilter) {
+  const size_t count = TxHashIndex::kInitialCapacity * 2 + 1;
+  TxHashIndex index;
+  for (size_t i = 0; i < count; ++i) {
+    index.insertCommitted(makeHash(i), i + 1, 0);
+  }
+  ASSERT_EQ(index.size(), count);
+  for (size_t i = 0; i < count; ++i) {
+    auto entry = index.find(makeHash(i));
+    ASSERT_TRUE(entry);
+    ASSERT_EQ(entry->height, i + 1);
+  }
+  for (size_t i = count; i < 2 * count; ++i) {
+    ASSERT_FALSE(index.find(makeHash(i)));
+  }
+}
+
+/**
+ * @given index with hashes
+ * @when it is cleared
+ * @then no hashes are found
+ */
+TEST(TxHashIndexTest, Clear) {
+  TxHashIndex index;
+  index.insertCommitted(makeHash(1), 1, 0);
+  index.clear();
+  EXPECT_FALSE(index.find(makeHash(1)));
+  EXPECT_EQ(index.size(), 0);
+}
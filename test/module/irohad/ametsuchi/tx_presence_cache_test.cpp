@@ -109,15 +109,13 @@ TEST_F(TxPresenceCacheTest, BatchHashTest) {
   shared_model::crypto::Hash hash1("1");
   shared_model::crypto::Hash hash2("2");
   shared_model::crypto::Hash hash3("3");
-  EXPECT_CALL(*mock_block_query, checkTxPresence(hash1))
-      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
-          tx_cache_status_responses::Rejected(hash1))));
-  EXPECT_CALL(*mock_block_query, checkTxPresence(hash2))
-      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
-          tx_cache_status_responses::Committed(hash2))));
-  EXPECT_CALL(*mock_block_query, checkTxPresence(hash3))
-      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
-          tx_cache_status_responses::Missing(hash3))));
+  EXPECT_CALL(*mock_block_query,
+              checkTxPresence(std::vector<shared_model::crypto::Hash>{
+                  hash1, hash2, hash3}))
+      .WillOnce(Return(std::vector<TxCacheStatusType>{
+          tx_cache_status_responses::Rejected(hash1),
+          tx_cache_status_responses::Committed(hash2),
+          tx_cache_status_responses::Missing(hash3)}));
   auto tx1 = std::make_shared<MockTransaction>();
   EXPECT_CALL(*tx1, hash()).WillOnce(ReturnRefOfCopy(hash1));
   auto tx2 = std::make_shared<MockTransaction>();
@@ -165,3 +163,61 @@ TEST_F(TxPresenceCacheTest, BatchHashTest) {
         FAIL() << error.error;
       });
 }
+
+/**
+ * @given hash with Committed status in memory cache and two unknown hashes
+ * @when cache asked for statuses of all three hashes
+ * @then only the unknown hashes are checked in storage with a single query
+ * AND statuses are returned in the order of hashes
+ */
+TEST_F(TxPresenceCacheTest, HashCollectionChecksMissesAtOnce) {
+  shared_model::crypto::Hash hash1("1");
+  shared_model::crypto::Hash hash2("2");
+  shared_model::crypto::Hash hash3("3");
+  EXPECT_CALL(*mock_block_query, checkTxPresence(hash2))
+      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Committed(hash2))));
+  EXPECT_CALL(
+      *mock_block_query,
+      checkTxPresence(std::vector<shared_model::crypto::Hash>{hash1, hash3}))
+      .WillOnce(Return(std::vector<TxCacheStatusType>{
+          tx_cache_status_responses::Missing(hash1),
+          tx_cache_status_responses::Rejected(hash3)}));
+
+  TxPresenceCacheImpl cache(mock_storage);
+  cache.check(hash2);
+  auto statuses = cache.check(TxPresenceCache::HashCollectionType{
+      hash1, hash2, hash3});
+
+  ASSERT_TRUE(statuses);
+  ASSERT_EQ(3, statuses->size());
+  EXPECT_NO_THROW(
+      boost::get<tx_cache_status_responses::Missing>(statuses->at(0)));
+  EXPECT_NO_THROW(
+      boost::get<tx_cache_status_responses::Committed>(statuses->at(1)));
+  EXPECT_NO_THROW(
+      boost::get<tx_cache_status_responses::Rejected>(statuses->at(2)));
+}
+
+/**
+ * @given tx hash index with committed and rejected transactions
+ * @when cache is asked for statuses of them and of an unknown hash
+ * @then statuses are taken from the index and storage is not queried
+ */
+TEST_F(TxPresenceCacheTest, UsesTxHashIndex) {
+  shared_model::crypto::Hash committed("1");
+  shared_model::crypto::Hash rejected("2");
+  shared_model::crypto::Hash missing("3");
+  auto tx_hash_index = std::make_shared<TxHashIndex>();
+  tx_hash_index->insertCommitted(committed, 1, 0);
+  tx_hash_index->insertRejected(rejected);
+  EXPECT_CALL(*mock_storage, getBlockQuery()).Times(0);
+
+  TxPresenceCacheImpl cache(mock_storage, tx_hash_index);
+  EXPECT_NO_THROW(boost::get<tx_cache_status_responses::Committed>(
+      *cache.check(committed)));
+  EXPECT_NO_THROW(
+      boost::get<tx_cache_status_responses::Rejected>(*cache.check(rejected)));
+  EXPECT_NO_THROW(
+      boost::get<tx_cache_status_responses::Missing>(*cache.check(missing)));
+}
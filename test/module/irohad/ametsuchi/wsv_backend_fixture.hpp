@@ -0,0 +1,168 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_WSV_BACKEND_FIXTURE_HPP
+#define IROHA_WSV_BACKEND_FIXTURE_HPP
+
+#include <ostream>
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_storage_format.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_block_index.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_command_executor.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_query_executor.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_storage.hpp"
+#include "ametsuchi/impl/in_memory/in_memory_wsv_query.hpp"
+#include "ametsuchi/impl/in_memory/wsv_state.hpp"
+#include "ametsuchi/impl/tx_hash_index.hpp"
+#include "ametsuchi/query_executor_factory.hpp"
+#include "interfaces/commands/command.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * WSV backend which executor tests are run against
+     */
+    enum class WsvBackend { kPostgres, kInMemory };
+
+    inline std::ostream &operator<<(std::ostream &os, WsvBackend backend) {
+      return os << (backend == WsvBackend::kPostgres ? "Postgres"
+                                                     : "InMemory");
+    }
+
+    /**
+     * @return parameters to instantiate a test case for every backend
+     */
+    inline auto wsvBackends() {
+      return ::testing::Values(WsvBackend::kPostgres, WsvBackend::kInMemory);
+    }
+
+    /**
+     * In-memory WSV for executor tests, so the same test cases check that
+     * the in-memory backend gives the same results as the Postgres one.
+     * Commands are executed directly against its state, and blocks are
+     * applied, stored and indexed the way InMemoryStorage does it.
+     */
+    class InMemoryWsvBackend : public QueryExecutorFactory {
+     public:
+      InMemoryWsvBackend(
+          std::shared_ptr<shared_model::interface::CommonObjectsFactory>
+              factory,
+          std::shared_ptr<shared_model::interface::BlockJsonConverter>
+              converter,
+          std::shared_ptr<shared_model::interface::PermissionToString>
+              perm_converter)
+          : block_store_path_((boost::filesystem::temp_directory_path()
+                               / boost::filesystem::unique_path())
+                                  .string()),
+            block_store_(std::move(*FlatFile::create(block_store_path_))),
+            block_cache_(std::make_shared<BlockCache>(
+                InMemoryStorage::kBlockCacheSize)),
+            tx_hash_index_(std::make_shared<TxHashIndex>()),
+            block_index_(std::make_shared<InMemoryBlockIndex>()),
+            factory_(std::move(factory)),
+            converter_(std::move(converter)),
+            block_format_(converter_),
+            perm_converter_(std::move(perm_converter)),
+            state_(WsvState()),
+            block_executor_(state_, perm_converter_) {}
+
+      ~InMemoryWsvBackend() override {
+        block_store_.reset();
+        boost::filesystem::remove_all(block_store_path_);
+      }
+
+      /**
+       * @return executor of commands changing the state of the backend
+       */
+      std::unique_ptr<CommandExecutor> createCommandExecutor() {
+        return std::make_unique<InMemoryCommandExecutor>(state_,
+                                                         perm_converter_);
+      }
+
+      /**
+       * @return query which sees all later changes of the state
+       */
+      std::shared_ptr<WsvQuery> getWsvQuery() const {
+        // the query does not own the state, which outlives it
+        return std::make_shared<InMemoryWsvQuery>(
+            std::shared_ptr<const WsvState>(std::shared_ptr<void>(),
+                                            &state_.state()),
+            factory_);
+      }
+
+      boost::optional<std::shared_ptr<QueryExecutor>> createQueryExecutor(
+          std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
+          std::shared_ptr<shared_model::interface::QueryResponseFactory>
+              response_factory) const override {
+        return boost::make_optional<std::shared_ptr<QueryExecutor>>(
+            std::make_shared<InMemoryQueryExecutor>(
+                std::make_shared<const WsvState>(state_.state()),
+                *block_store_,
+                block_cache_,
+                tx_hash_index_,
+                block_index_,
+                std::move(pending_txs_storage),
+                converter_,
+                std::move(response_factory),
+                perm_converter_));
+      }
+
+      /**
+       * Execute commands of the block without validation and store it, or
+       * roll the state back if a command fails
+       * @return true if the block is applied
+       */
+      bool apply(const shared_model::interface::Block &block) {
+        const auto savepoint = state_.savepoint();
+        for (const auto &tx : block.transactions()) {
+          block_executor_.setCreatorAccountId(tx.creatorAccountId());
+          block_executor_.doValidation(false);
+          for (const auto &command : tx.commands()) {
+            auto result = boost::apply_visitor(block_executor_, command.get());
+            if (boost::get<expected::Error<CommandError>>(&result)) {
+              state_.rollbackTo(savepoint);
+              return false;
+            }
+          }
+        }
+        state_.releaseSavepoint(savepoint);
+
+        auto bytes = block_format_.serialize(block);
+        auto stored = boost::get<expected::Value<BlockStorageFormat::Bytes>>(
+            &bytes);
+        if (not stored or not block_store_->add(block.height(), stored->value)
+            or not block_index_->index(block)) {
+          return false;
+        }
+        tx_hash_index_->insert(block);
+        return true;
+      }
+
+     private:
+      std::string block_store_path_;
+      std::unique_ptr<KeyValueStorage> block_store_;
+      std::shared_ptr<BlockCache> block_cache_;
+      std::shared_ptr<TxHashIndex> tx_hash_index_;
+      std::shared_ptr<InMemoryBlockIndex> block_index_;
+      std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
+      std::shared_ptr<shared_model::interface::BlockJsonConverter> converter_;
+      BlockStorageFormat block_format_;
+      std::shared_ptr<shared_model::interface::PermissionToString>
+          perm_converter_;
+      MutableWsvState state_;
+      InMemoryCommandExecutor block_executor_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_BACKEND_FIXTURE_HPP
@@ -0,0 +1,113 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/wsv_cache.hpp"
+
+#include <gtest/gtest.h>
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::ametsuchi;
+using shared_model::interface::permissions::Role;
+
+class WsvCacheTest : public ::testing::Test {
+ protected:
+  /**
+   * @return block with a single transaction built by given function
+   */
+  template <typename F>
+  shared_model::proto::Block makeBlock(F &&commands) {
+    std::vector<shared_model::proto::Transaction> txs;
+    txs.push_back(
+        commands(TestTransactionBuilder().creatorAccountId("a@b")).build());
+    return TestBlockBuilder()
+        .height(2)
+        .transactions(txs)
+        .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+        .build();
+  }
+
+  WsvCache::Signatories signatories{{"aa", "bb"}, 2};
+  shared_model::interface::RolePermissionSet permissions{Role::kReceive};
+  WsvCache cache;
+};
+
+/**
+ * @given cache with entries
+ * @when cached and missing entries are requested
+ * @then cached entries are returned and hits and misses are counted
+ */
+TEST_F(WsvCacheTest, HitsAndMisses) {
+  const auto version = cache.version();
+  ASSERT_TRUE(cache.putPermissions("a@b", permissions, version));
+  ASSERT_TRUE(cache.putSignatories("a@b", signatories, version));
+  ASSERT_TRUE(cache.putPrecision("coin#b", 2, version));
+
+  auto cached_permissions = cache.getPermissions("a@b");
+  ASSERT_TRUE(cached_permissions);
+  EXPECT_EQ(*cached_permissions, permissions);
+  auto cached_signatories = cache.getSignatories("a@b");
+  ASSERT_TRUE(cached_signatories);
+  EXPECT_EQ(cached_signatories->public_keys, signatories.public_keys);
+  EXPECT_EQ(cached_signatories->quorum, signatories.quorum);
+  EXPECT_EQ(cache.getPrecision("coin#b"), boost::make_optional<uint8_t>(2));
+  EXPECT_FALSE(cache.getSignatories("c@b"));
+
+  EXPECT_EQ(cache.hits(), 3);
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.size(), 3);
+}
+
+/**
+ * @given version of cache taken before a read
+ * @when block is committed before the read result is put
+ * @then outdated entry is not put
+ */
+TEST_F(WsvCacheTest, OutdatedPutRejected) {
+  const auto version = cache.version();
+  cache.invalidate(makeBlock([](auto builder) {
+    return builder.addSignatory("a@b", shared_model::crypto::PublicKey("cc"));
+  }));
+
+  EXPECT_FALSE(cache.putSignatories("a@b", signatories, version));
+  EXPECT_FALSE(cache.getSignatories("a@b"));
+}
+
+/**
+ * @given cache with entries of several accounts
+ * @when block which changes one of them is committed
+ * @then only entries of changed account are removed
+ */
+TEST_F(WsvCacheTest, InvalidateChangedEntries) {
+  const auto version = cache.version();
+  cache.putSignatories("a@b", signatories, version);
+  cache.putSignatories("c@b", signatories, version);
+  cache.putPermissions("a@b", permissions, version);
+
+  cache.invalidate(makeBlock([](auto builder) {
+    return builder.setAccountQuorum("a@b", 1).detachRole("c@b", "role");
+  }));
+
+  EXPECT_FALSE(cache.getSignatories("a@b"));
+  EXPECT_TRUE(cache.getSignatories("c@b"));
+  EXPECT_TRUE(cache.getPermissions("a@b"));
+  EXPECT_EQ(cache.invalidations(), 1);
+}
+
+/**
+ * @given cache with entries
+ * @when cache is cleared
+ * @then all entries are removed
+ */
+TEST_F(WsvCacheTest, Clear) {
+  const auto version = cache.version();
+  cache.putSignatories("a@b", signatories, version);
+  cache.putPrecision("coin#b", 2, version);
+
+  cache.clear();
+
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_NE(cache.version(), version);
+}
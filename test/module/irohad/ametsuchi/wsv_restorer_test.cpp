@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/wsv_restorer_impl.hpp"
+
+#include <gtest/gtest.h>
+#include "framework/result_fixture.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/shared_model/interface_mocks.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace framework::expected;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+class WsvRestorerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (shared_model::interface::types::HeightType height = 1;
+         height <= kChainLength;
+         ++height) {
+      auto block = std::make_shared<MockBlock>();
+      EXPECT_CALL(*block, height()).WillRepeatedly(Return(height));
+      blocks.push_back(block);
+    }
+
+    EXPECT_CALL(storage, getBlockQuery()).WillOnce(Return(block_query));
+    EXPECT_CALL(*block_query, getTopBlockHeight())
+        .WillOnce(Return(kChainLength));
+    EXPECT_CALL(*block_query, getBlocks(_, 1))
+        .WillRepeatedly(Invoke([this](auto height, auto) {
+          return std::vector<std::shared_ptr<shared_model::interface::Block>>{
+              blocks.at(height - 1)};
+        }));
+    EXPECT_CALL(storage, createMutableStorage())
+        .WillRepeatedly(Invoke([this] {
+          auto mutable_storage = std::make_unique<MockMutableStorage>();
+          EXPECT_CALL(*mutable_storage, apply(_))
+              .WillRepeatedly(Invoke([this](const auto &block) {
+                applied.push_back(block.height());
+                return applied.back() != failing_height;
+              }));
+          return iroha::expected::makeValue<std::unique_ptr<MutableStorage>>(
+              std::move(mutable_storage));
+        }));
+  }
+
+  static constexpr uint32_t kChainLength = 10;
+
+  std::vector<std::shared_ptr<MockBlock>> blocks;
+  std::vector<shared_model::interface::types::HeightType> applied;
+  shared_model::interface::types::HeightType failing_height = 0;
+  MockStorage storage;
+  std::shared_ptr<MockBlockQuery> block_query =
+      std::make_shared<MockBlockQuery>();
+};
+
+constexpr uint32_t WsvRestorerTest::kChainLength;
+
+/**
+ * @given block store with a chain
+ * @when WSV is restored with window smaller than the chain
+ * @then WSV is reset, all blocks are applied in order and committed
+ * in batches of window size
+ */
+TEST_F(WsvRestorerTest, AppliesBlocksInOrder) {
+  EXPECT_CALL(storage, resetWsv()).Times(1);
+  EXPECT_CALL(storage, reset()).Times(0);
+  EXPECT_CALL(storage, doCommit(_)).Times(4);
+
+  WsvRestorerImpl restorer(3, 4);
+  ASSERT_TRUE(val(restorer.restoreWsv(storage)));
+
+  std::vector<shared_model::interface::types::HeightType> expected;
+  for (shared_model::interface::types::HeightType height = 1;
+       height <= kChainLength;
+       ++height) {
+    expected.push_back(height);
+  }
+  EXPECT_EQ(applied, expected);
+}
+
+/**
+ * @given block store with a chain and a WSV snapshot of a block in the middle
+ * @when WSV is restored
+ * @then only blocks after the snapshot are applied
+ */
+TEST_F(WsvRestorerTest, StartsAfterSnapshot) {
+  const shared_model::interface::types::HeightType snapshot_height = 4;
+  EXPECT_CALL(storage, resetWsv()).Times(1);
+  EXPECT_CALL(storage, loadWsvSnapshot()).WillOnce(Return(snapshot_height));
+  EXPECT_CALL(storage, doCommit(_)).Times(3);
+
+  WsvRestorerImpl restorer(3, 4);
+  ASSERT_TRUE(val(restorer.restoreWsv(storage)));
+
+  std::vector<shared_model::interface::types::HeightType> expected;
+  for (auto height = snapshot_height + 1; height <= kChainLength; ++height) {
+    expected.push_back(height);
+  }
+  EXPECT_EQ(applied, expected);
+}
+
+/**
+ * @given block store with a chain
+ * @when application of a block in the middle fails
+ * @then restore stops with an error and blocks after it are not committed
+ */
+TEST_F(WsvRestorerTest, StopsOnFailedBlock) {
+  failing_height = 5;
+  EXPECT_CALL(storage, resetWsv()).Times(1);
+  EXPECT_CALL(storage, doCommit(_)).Times(1);
+
+  WsvRestorerImpl restorer(3, 4);
+  ASSERT_TRUE(err(restorer.restoreWsv(storage)));
+  EXPECT_EQ(applied.back(), failing_height);
+}
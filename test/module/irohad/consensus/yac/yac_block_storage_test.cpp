@@ -85,3 +85,34 @@ TEST_F(YacBlockStorageTest, YacBlockStorageWhenIsContains) {
   ASSERT_TRUE(storage.isContains(valid_votes.at(0)));
   ASSERT_FALSE(storage.isContains(valid_votes.at(3)));
 }
+
+/**
+ * @given block storage with votes of two peers
+ * @when another vote of one of the peers for the same hash, signed over
+ * different data, is inserted
+ * @then it is not stored @and does not count for supermajority
+ */
+TEST_F(YacBlockStorageTest, YacBlockStorageWhenSecondVoteOfPeer) {
+  storage.insert({valid_votes.at(0), valid_votes.at(1)});
+
+  auto signature = std::make_shared<MockSignature>();
+  EXPECT_CALL(*signature, publicKey())
+      .WillRepeatedly(::testing::ReturnRefOfCopy(
+          valid_votes.at(0).signature->publicKey()));
+  EXPECT_CALL(*signature, signedData())
+      .WillRepeatedly(::testing::ReturnRefOfCopy(
+          shared_model::crypto::Signed("second")));
+  VoteMessage second_vote;
+  second_vote.hash = hash;
+  second_vote.signature = signature;
+  ASSERT_NE(second_vote.signature->signedData(),
+            valid_votes.at(0).signature->signedData());
+
+  ASSERT_EQ(boost::none, storage.insert(second_vote));
+  ASSERT_EQ(2, storage.getNumberOfVotes());
+  auto votes = storage.getVotes();
+  ASSERT_EQ(2, votes.size());
+  ASSERT_EQ(votes.at(0).signature->signedData(),
+            valid_votes.at(0).signature->signedData());
+  ASSERT_TRUE(storage.isContains(create_vote(hash, "two")));
+}
@@ -86,6 +86,37 @@ namespace iroha {
         ASSERT_FALSE(crypto_provider->verify({vote}));
       }
 
+      /**
+       * @given votes of several peers for the same hash, one of them with
+       * block hash changed after signing
+       * @when the votes are verified together
+       * @then the bundle without the changed vote is correct @and the bundle
+       * with it is not
+       */
+      TEST_F(YacCryptoProviderTest, BundleInvalidWhenOneMessageChanged) {
+        YacHash hash(Round{1, 1}, "1", "1");
+        hash.block_signature = makeSignature();
+
+        EXPECT_CALL(*factory, createSignature(_, _))
+            .Times(3)
+            .WillRepeatedly(Invoke([this](auto &pubkey, auto &sig) {
+              return expected::makeValue(this->makeSignature(pubkey, sig));
+            }));
+
+        std::vector<VoteMessage> votes;
+        for (int i = 0; i < 3; ++i) {
+          CryptoProviderImpl peer_provider(
+              shared_model::crypto::DefaultCryptoAlgorithmType::
+                  generateKeypair(),
+              factory);
+          votes.push_back(peer_provider.getVote(hash));
+        }
+        ASSERT_TRUE(crypto_provider->verify(votes));
+
+        votes[1].hash.vote_hashes.block_hash = "hash changed";
+        ASSERT_FALSE(crypto_provider->verify(votes));
+      }
+
     }  // namespace yac
   }    // namespace consensus
 }  // namespace iroha
@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/yac/storage/yac_vote_storage.hpp"
+
+#include <gtest/gtest.h>
+#include "module/irohad/consensus/yac/yac_mocks.hpp"
+
+using namespace iroha::consensus::yac;
+using iroha::consensus::Round;
+
+class YacVoteStorageTest : public ::testing::Test {
+ public:
+  /**
+   * @return votes of all peers for the same hash in given round
+   */
+  std::vector<VoteMessage> commitVotes(Round round) {
+    YacHash hash(round, "proposal", "block");
+    std::vector<VoteMessage> votes;
+    for (auto i = 0u; i < number_of_peers; ++i) {
+      votes.push_back(create_vote(hash, std::to_string(i)));
+    }
+    return votes;
+  }
+
+  const PeersNumberType number_of_peers = 4;
+  const iroha::consensus::BlockRoundType rounds_to_keep = 2;
+  YacVoteStorage storage{rounds_to_keep};
+};
+
+/**
+ * @given vote storage
+ * @when supermajority of votes for a round is stored
+ * @then round is committed @and lookups are counted
+ */
+TEST_F(YacVoteStorageTest, CommitsRound) {
+  auto answer = storage.store(commitVotes(Round{1, 0}), number_of_peers);
+
+  ASSERT_TRUE(answer);
+  EXPECT_TRUE(boost::get<CommitMessage>(&*answer));
+  EXPECT_TRUE(storage.isCommitted(Round{1, 0}));
+  EXPECT_FALSE(storage.isCommitted(Round{1, 1}));
+
+  const auto stats = storage.stats();
+  EXPECT_EQ(stats.rounds, 1u);
+  EXPECT_EQ(stats.votes, number_of_peers);
+  EXPECT_GE(stats.lookups, 3u);
+}
+
+/**
+ * @given vote storage with processing states of several rounds
+ * @when a round further than rounds_to_keep is committed
+ * @then votes and processing states of older rounds are dropped @and votes
+ * for dropped rounds are ignored
+ */
+TEST_F(YacVoteStorageTest, DropsOldRounds) {
+  for (iroha::consensus::BlockRoundType round = 1; round <= 3; ++round) {
+    storage.store(commitVotes(Round{round, 0}), number_of_peers);
+    storage.nextProcessingState(Round{round, 0});
+  }
+  EXPECT_EQ(storage.stats().rounds, 3u);
+  EXPECT_EQ(storage.stats().evicted_rounds, 0u);
+
+  storage.store(commitVotes(Round{5, 0}), number_of_peers);
+
+  const auto stats = storage.stats();
+  EXPECT_EQ(stats.rounds, 2u);
+  EXPECT_EQ(stats.processing_states, 1u);
+  EXPECT_EQ(stats.evicted_rounds, 2u);
+  EXPECT_EQ(storage.getProcessingState(Round{3, 0}),
+            ProposalState::kSentNotProcessed);
+  EXPECT_EQ(storage.getProcessingState(Round{1, 0}),
+            ProposalState::kNotSentNotProcessed);
+
+  EXPECT_TRUE(storage.isCommitted(Round{1, 0}));
+  EXPECT_FALSE(storage.store(commitVotes(Round{2, 1}), number_of_peers));
+  storage.nextProcessingState(Round{2, 1});
+  EXPECT_EQ(storage.stats().rounds, 2u);
+  EXPECT_EQ(storage.stats().processing_states, 1u);
+}
+
+/**
+ * @given vote storage
+ * @when processing state of a round without votes is read
+ * @then it is the initial one @and no state is stored for the round
+ */
+TEST_F(YacVoteStorageTest, ReadingProcessingStateDoesNotStoreIt) {
+  EXPECT_EQ(storage.getProcessingState(Round{1, 0}),
+            ProposalState::kNotSentNotProcessed);
+  EXPECT_EQ(storage.stats().processing_states, 0u);
+}
@@ -22,6 +22,7 @@ using namespace framework::test_subscriber;
 
 using ::testing::_;
 using ::testing::ByMove;
+using ::testing::ElementsAre;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::ReturnRefOfCopy;
@@ -39,10 +40,14 @@ class OnDemandOrderingGateTest : public ::testing::Test {
     factory = ufactory.get();
     tx_cache = std::make_shared<ametsuchi::MockTxPresenceCache>();
     ON_CALL(*tx_cache,
-            check(testing::Matcher<const shared_model::crypto::Hash &>(_)))
-        .WillByDefault(
-            Return(boost::make_optional<ametsuchi::TxCacheStatusType>(
-                iroha::ametsuchi::tx_cache_status_responses::Missing())));
+            check(testing::Matcher<
+                  const ametsuchi::TxPresenceCache::HashCollectionType &>(_)))
+        .WillByDefault(testing::Invoke([](const auto &hashes) {
+          return boost::make_optional(
+              ametsuchi::TxPresenceCache::BatchStatusCollectionType(
+                  hashes.size(),
+                  iroha::ametsuchi::tx_cache_status_responses::Missing()));
+        }));
     ordering_gate =
         std::make_shared<OnDemandOrderingGate>(ordering_service,
                                                notification,
@@ -233,9 +238,13 @@ TEST_F(OnDemandOrderingGateTest, ReplayedTransactionInProposal) {
   EXPECT_CALL(*notification, onRequestProposal(round))
       .WillOnce(Return(ByMove(std::move(arriving_proposal))));
   EXPECT_CALL(*tx_cache,
-              check(testing::Matcher<const shared_model::crypto::Hash &>(_)))
-      .WillOnce(Return(boost::make_optional<ametsuchi::TxCacheStatusType>(
-          iroha::ametsuchi::tx_cache_status_responses::Committed())));
+              check(testing::Matcher<
+                    const ametsuchi::TxPresenceCache::HashCollectionType &>(
+                  ElementsAre(hash))))
+      .WillOnce(
+          Return(boost::make_optional(
+              ametsuchi::TxPresenceCache::BatchStatusCollectionType{
+                  iroha::ametsuchi::tx_cache_status_responses::Committed()})));
   // expect proposal to be created without any transactions because it was
   // removed by tx cache
   auto ufactory_proposal = std::make_unique<MockProposal>();
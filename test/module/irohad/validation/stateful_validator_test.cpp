@@ -4,6 +4,7 @@
  */
 
 #include "validation/impl/stateful_validator_impl.hpp"
+#include "validation/impl/conflict_groups.hpp"
 
 #include <gtest/gtest.h>
 #include <boost/range/adaptor/transformed.hpp>
@@ -324,3 +325,179 @@ TEST_F(Validator, Batches) {
                 ->second.error_extra,
             sample_error_extra);
 }
+
+class ParallelValidator : public Validator {
+ public:
+  void SetUp() override {
+    Validator::SetUp();
+    temporary_factory =
+        std::make_shared<iroha::ametsuchi::MockTemporaryFactory>();
+    sfv = std::make_shared<StatefulValidatorImpl>(
+        std::make_unique<shared_model::proto::ProtoProposalFactory<
+            shared_model::validation::DefaultProposalValidator>>(),
+        std::make_shared<shared_model::interface::TransactionBatchParserImpl>(),
+        temporary_factory,
+        2);
+  }
+
+  /**
+   * @return transaction which accesses only the creator account
+   */
+  shared_model::proto::Transaction makeTx(const std::string &creator) {
+    return TestTransactionBuilder()
+        .creatorAccountId(creator)
+        .createdTime(iroha::time::now())
+        .quorum(1)
+        .setAccountDetail(creator, "key", "value")
+        .build();
+  }
+
+  shared_model::proto::Proposal makeProposal(
+      const std::vector<shared_model::proto::Transaction> &txs) {
+    return TestProposalBuilder()
+        .createdTime(iroha::time::now())
+        .height(3)
+        .transactions(txs)
+        .build();
+  }
+
+  std::shared_ptr<iroha::ametsuchi::MockTemporaryFactory> temporary_factory;
+};
+
+/**
+ * @given transactions of two creators, one of them is invalid
+ * @when statefully validating these transactions in parallel
+ * @then transactions of each creator are applied in their order to separate
+ * temporary wsvs @and the result is the same as of sequential validation
+ */
+TEST_F(ParallelValidator, IndependentGroups) {
+  std::vector<shared_model::proto::Transaction> txs{
+      makeTx("a@d"), makeTx("b@d"), makeTx("a@d"), makeTx("b@d")};
+
+  auto other_wsv = std::make_unique<iroha::ametsuchi::MockTemporaryWsv>();
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*temp_wsv_mock, apply(Eq(ByRef(txs[0]))))
+        .WillOnce(Return(iroha::expected::Value<void>({})));
+    EXPECT_CALL(*temp_wsv_mock, apply(Eq(ByRef(txs[2]))))
+        .WillOnce(Return(iroha::expected::makeError(
+            CommandError{"", sample_error_code, sample_error_extra, true})));
+  }
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*other_wsv, apply(Eq(ByRef(txs[1]))))
+        .WillOnce(Return(iroha::expected::Value<void>({})));
+    EXPECT_CALL(*other_wsv, apply(Eq(ByRef(txs[3]))))
+        .WillOnce(Return(iroha::expected::Value<void>({})));
+  }
+  EXPECT_CALL(*temporary_factory, createTemporaryWsv())
+      .WillOnce(Return(ByMove(
+          iroha::expected::makeValue<
+              std::unique_ptr<iroha::ametsuchi::TemporaryWsv>>(
+              std::move(other_wsv)))));
+
+  auto verified_proposal_and_errors =
+      sfv->validate(makeProposal(txs), *temp_wsv_mock);
+  const auto &verified_txs =
+      verified_proposal_and_errors->verified_proposal->transactions();
+  ASSERT_EQ(verified_txs.size(), 3);
+  EXPECT_EQ(verified_txs[0], txs[0]);
+  EXPECT_EQ(verified_txs[1], txs[1]);
+  EXPECT_EQ(verified_txs[2], txs[3]);
+  ASSERT_EQ(verified_proposal_and_errors->rejected_transactions.size(), 1);
+  EXPECT_EQ(verified_proposal_and_errors->rejected_transactions.begin()->first,
+            txs[2].hash());
+  EXPECT_FALSE(verified_proposal_and_errors->state_complete);
+}
+
+/**
+ * @given transactions which transfer assets between accounts of two creators
+ * @when statefully validating these transactions in parallel
+ * @then they are validated sequentially on the given temporary wsv
+ */
+TEST_F(ParallelValidator, ConflictingTransactions) {
+  std::vector<shared_model::proto::Transaction> txs{
+      makeTx("a@d"),
+      TestTransactionBuilder()
+          .creatorAccountId("b@d")
+          .createdTime(iroha::time::now())
+          .quorum(1)
+          .transferAsset("b@d", "a@d", "coin#d", "", "1.0")
+          .build()};
+
+  EXPECT_CALL(*temporary_factory, createTemporaryWsv()).Times(0);
+  EXPECT_CALL(*temp_wsv_mock, apply(_))
+      .Times(2)
+      .WillRepeatedly(Return(iroha::expected::Value<void>({})));
+
+  auto verified_proposal_and_errors =
+      sfv->validate(makeProposal(txs), *temp_wsv_mock);
+  EXPECT_EQ(
+      verified_proposal_and_errors->verified_proposal->transactions().size(),
+      2);
+  EXPECT_TRUE(verified_proposal_and_errors->state_complete);
+}
+
+/**
+ * @given read and write sets, where the first and the third write an entity
+ * which the fourth one reads
+ * @when conflict groups are built
+ * @then they are ordered by the first element @and keep order of elements
+ */
+TEST(ConflictGroups, TransitiveConflicts) {
+  std::vector<ReadWriteSet> sets(5);
+  sets[0].writes = {"a"};
+  sets[1].writes = {"b"};
+  sets[2].writes = {"c"};
+  sets[3].reads = {"a", "c"};
+  sets[4].writes = {"d"};
+  auto groups = conflictGroups(sets);
+  ASSERT_EQ(groups.size(), 3);
+  EXPECT_EQ(groups[0], (std::vector<size_t>{0, 2, 3}));
+  EXPECT_EQ(groups[1], (std::vector<size_t>{1}));
+  EXPECT_EQ(groups[2], (std::vector<size_t>{4}));
+}
+
+/**
+ * @given transfers of the same asset between distinct pairs of accounts
+ * @when conflict groups are built
+ * @then transfers are independent, since the asset is only read
+ */
+TEST(ConflictGroups, SharedReadsIndependent) {
+  std::vector<ReadWriteSet> sets(2);
+  sets[0].add(TestTransactionBuilder()
+                  .creatorAccountId("a@d")
+                  .transferAsset("a@d", "b@d", "coin#d", "", "1.0")
+                  .build());
+  sets[1].add(TestTransactionBuilder()
+                  .creatorAccountId("c@d")
+                  .transferAsset("c@d", "e@d", "coin#d", "", "1.0")
+                  .build());
+  EXPECT_EQ(conflictGroups(sets).size(), 2);
+}
+
+/**
+ * @given transactions of different accounts, which add the same key to
+ * their accounts, create an account with it and remove it
+ * @when conflict groups are built
+ * @then all of them are in one group, since the signatory row is shared
+ */
+TEST(ConflictGroups, SharedSignatoryConflicts) {
+  const PublicKey key(std::string(32, '1'));
+  std::vector<ReadWriteSet> sets(3);
+  sets[0].add(TestTransactionBuilder()
+                  .creatorAccountId("a@d")
+                  .addSignatory("a@d", key)
+                  .build());
+  sets[1].add(TestTransactionBuilder()
+                  .creatorAccountId("b@d")
+                  .createAccount("c", "d", key)
+                  .build());
+  sets[2].add(TestTransactionBuilder()
+                  .creatorAccountId("e@d")
+                  .removeSignatory("e@d", key)
+                  .build());
+  auto groups = conflictGroups(sets);
+  ASSERT_EQ(groups.size(), 1);
+  EXPECT_EQ(groups[0], (std::vector<size_t>{0, 1, 2}));
+}
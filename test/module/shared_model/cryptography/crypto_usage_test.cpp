@@ -101,6 +101,43 @@ TEST_F(CryptoUsageTest, RawSignAndVerifyTest) {
   ASSERT_TRUE(verified);
 }
 
+/**
+ * @given signatures of several messages by different keys
+ * @when they are verified one by one
+ * @then all of them are correct
+ */
+TEST_F(CryptoUsageTest, VerifyAll) {
+  const auto other_keypair = DefaultCryptoAlgorithmType::generateKeypair();
+  const Blob other_data("other raw data");
+  const auto signed_blob = DefaultCryptoAlgorithmType::sign(data, keypair);
+  const auto other_signed_blob =
+      DefaultCryptoAlgorithmType::sign(other_data, other_keypair);
+
+  ASSERT_TRUE(CryptoVerifier<>::verifyAll(
+      {{signed_blob, data, keypair.publicKey()},
+       {other_signed_blob, other_data, other_keypair.publicKey()}}));
+}
+
+/**
+ * @given signatures with one made for another message @and a signature
+ * with a key of wrong length
+ * @when they are verified one by one
+ * @then neither set is correct
+ */
+TEST_F(CryptoUsageTest, VerifyAllWithWrongSignature) {
+  const Blob other_data("other raw data");
+  const auto signed_blob = DefaultCryptoAlgorithmType::sign(data, keypair);
+  const auto other_signed_blob =
+      DefaultCryptoAlgorithmType::sign(other_data, keypair);
+  const PublicKey short_key(std::string(3, 'k'));
+
+  ASSERT_FALSE(CryptoVerifier<>::verifyAll(
+      {{signed_blob, data, keypair.publicKey()},
+       {other_signed_blob, data, keypair.publicKey()}}));
+  ASSERT_FALSE(
+      CryptoVerifier<>::verifyAll({{signed_blob, data, short_key}}));
+}
+
 /**
  * @given unsigned block
  * @when verify block
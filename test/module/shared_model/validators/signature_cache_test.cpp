@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "validators/signature_cache.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "cryptography/hash.hpp"
+#include "cryptography/public_key.hpp"
+#include "cryptography/signed.hpp"
+
+using namespace shared_model::crypto;
+using shared_model::validation::SignatureCache;
+
+class SignatureCacheTest : public ::testing::Test {
+ protected:
+  /**
+   * @return key of a signature which differs for every number
+   */
+  std::string key(size_t number) {
+    return SignatureCache::makeKey(
+        hash, public_key, Signed(std::to_string(number)));
+  }
+
+  Hash hash{std::string(32, 'h')};
+  PublicKey public_key{std::string(32, 'k')};
+};
+
+/**
+ * @given cache with a signature
+ * @when the signature is looked up @and signatures differing in one part of
+ * the key are looked up
+ * @then only the inserted one is found @and hits and misses are counted
+ */
+TEST_F(SignatureCacheTest, FindsOnlyInsertedSignature) {
+  SignatureCache cache(100);
+  const Signed signature(std::string(64, 's'));
+  cache.insert(SignatureCache::makeKey(hash, public_key, signature));
+
+  EXPECT_TRUE(
+      cache.contains(SignatureCache::makeKey(hash, public_key, signature)));
+  EXPECT_FALSE(cache.contains(SignatureCache::makeKey(
+      Hash(std::string(32, 'o')), public_key, signature)));
+  EXPECT_FALSE(cache.contains(SignatureCache::makeKey(
+      hash, PublicKey(std::string(32, 'o')), signature)));
+  EXPECT_FALSE(cache.contains(
+      SignatureCache::makeKey(hash, public_key, Signed(std::string(64, 'o')))));
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.size, 1u);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.25);
+}
+
+/**
+ * @given cache of limited capacity
+ * @when many more signatures are inserted
+ * @then size of the cache stays bounded @and the latest signature is found
+ */
+TEST_F(SignatureCacheTest, EvictsWhenFull) {
+  const size_t capacity = 64;
+  SignatureCache cache(capacity);
+  for (size_t i = 0; i < capacity * 10; ++i) {
+    cache.insert(key(i));
+  }
+
+  const auto stats = cache.stats();
+  EXPECT_LE(stats.size, capacity);
+  EXPECT_EQ(stats.size + stats.evictions, capacity * 10);
+  EXPECT_TRUE(cache.contains(key(capacity * 10 - 1)));
+}
+
+/**
+ * @given cache
+ * @when several threads insert and look up signatures
+ * @then every signature inserted by a thread is found by it
+ */
+TEST_F(SignatureCacheTest, ConcurrentAccess) {
+  SignatureCache cache(10000);
+  std::vector<std::thread> threads;
+  std::atomic<size_t> found{0};
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = t * 1000; i < (t + 1) * 1000; ++i) {
+        cache.insert(key(i));
+        found += cache.contains(key(i));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(found, 4000u);
+  EXPECT_EQ(cache.stats().hits, 4000u);
+}
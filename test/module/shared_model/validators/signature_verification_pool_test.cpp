@@ -0,0 +1,124 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "validators/signature_verification_pool.hpp"
+
+#include <gtest/gtest.h>
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+
+using namespace shared_model::crypto;
+using shared_model::validation::SignatureVerificationPool;
+
+class SignatureVerificationPoolTest : public ::testing::Test {
+ protected:
+  Keypair keypair = DefaultCryptoAlgorithmType::generateKeypair();
+  Blob data{"raw data for signing"};
+  Blob other_data{"other raw data"};
+  Signed signed_blob = DefaultCryptoAlgorithmType::sign(data, keypair);
+  PublicKey short_key{std::string(3, 'k')};
+};
+
+/**
+ * @given pool @and correct, wrong and malformed signatures
+ * @when they are verified in parallel
+ * @then result of every signature is reported in order
+ */
+TEST_F(SignatureVerificationPoolTest, VerifyReportsEverySignature) {
+  SignatureVerificationPool pool(4, 100);
+  std::vector<SignatureCheck> checks;
+  std::vector<bool> expected;
+  for (int i = 0; i < 30; ++i) {
+    switch (i % 3) {
+      case 0:
+        checks.push_back({signed_blob, data, keypair.publicKey()});
+        expected.push_back(true);
+        break;
+      case 1:
+        checks.push_back({signed_blob, other_data, keypair.publicKey()});
+        expected.push_back(false);
+        break;
+      default:
+        checks.push_back({signed_blob, data, short_key});
+        expected.push_back(false);
+    }
+  }
+
+  EXPECT_EQ(pool.verify(checks), expected);
+  EXPECT_EQ(pool.queueDepth(), 0u);
+}
+
+/**
+ * @given pool
+ * @when signatures are submitted with a future and with a callback
+ * @then both report results of verification
+ */
+TEST_F(SignatureVerificationPoolTest, SubmitReportsResult) {
+  SignatureVerificationPool pool(2, 100);
+  auto correct = pool.submit({signed_blob, data, keypair.publicKey()});
+  auto wrong = pool.submit({signed_blob, other_data, keypair.publicKey()});
+
+  std::promise<bool> called;
+  pool.submit({signed_blob, data, keypair.publicKey()},
+              [&called](bool verified) { called.set_value(verified); });
+
+  EXPECT_TRUE(correct.get());
+  EXPECT_FALSE(wrong.get());
+  EXPECT_TRUE(called.get_future().get());
+}
+
+/**
+ * @given pool with two workers
+ * @when jobs wait for nested jobs, more than there are workers
+ * @then all of them are done
+ */
+TEST_F(SignatureVerificationPoolTest, NestedJobsDoNotDeadlock) {
+  SignatureVerificationPool pool(2, 100);
+  std::vector<std::atomic<int>> calls(8 * 8);
+  pool.parallelFor(8, [&](size_t i) {
+    pool.parallelFor(8, [&, i](size_t j) { ++calls[i * 8 + j]; });
+  });
+
+  for (const auto &count : calls) {
+    EXPECT_EQ(count, 1);
+  }
+  const auto stats = pool.stats();
+  EXPECT_GT(stats.jobs, 0u);
+  EXPECT_LE(stats.max_queue_depth, 100u);
+  EXPECT_GE(stats.max_latency, std::chrono::microseconds::zero());
+}
+
+/**
+ * @given pool which cannot queue any job
+ * @when signatures are verified
+ * @then they are verified by the calling thread
+ */
+TEST_F(SignatureVerificationPoolTest, FullPoolRunsJobsInPlace) {
+  SignatureVerificationPool pool(2, 0);
+  std::vector<SignatureCheck> checks(
+      4, SignatureCheck{signed_blob, data, keypair.publicKey()});
+
+  EXPECT_EQ(pool.verify(checks), std::vector<bool>(4, true));
+  EXPECT_EQ(pool.stats().rejected, 3u);
+  EXPECT_EQ(pool.stats().max_queue_depth, 0u);
+}
+
+/**
+ * @given pool
+ * @when a parallel call throws
+ * @then the exception is rethrown to the caller after all calls are done
+ */
+TEST_F(SignatureVerificationPoolTest, ParallelForRethrows) {
+  SignatureVerificationPool pool(2, 100);
+  std::atomic<int> calls{0};
+  EXPECT_THROW(pool.parallelFor(10,
+                                [&calls](size_t i) {
+                                  ++calls;
+                                  if (i == 5) {
+                                    throw std::runtime_error("error");
+                                  }
+                                }),
+               std::runtime_error);
+  EXPECT_EQ(calls, 10);
+}